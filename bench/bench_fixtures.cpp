@@ -0,0 +1,43 @@
+#include <map>
+#include <mutex>
+#include "crypto-suites/crypto-zkp/zkp.h"
+#include "crypto-suites/common/custom_assert.h"
+#include "bench_fixtures.h"
+
+namespace safeheron{
+namespace bench{
+
+const PailKeyPair &GetPailKeyPair(int key_bits) {
+    static std::mutex mutex;
+    static std::map<int, PailKeyPair> key_pairs;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto iter = key_pairs.find(key_bits);
+    if (iter == key_pairs.end()) {
+        PailKeyPair key_pair;
+        safeheron::pail::CreateKeyPair(key_pair.priv, key_pair.pub, key_bits);
+        iter = key_pairs.emplace(key_bits, key_pair).first;
+    }
+    return iter->second;
+}
+
+static RingPedersenSetup create_ring_pedersen_setup() {
+    RingPedersenSetup setup;
+    // The primes of a Paillier key are safe primes, as a ring-Pedersen modulus needs.
+    safeheron::pail::PailPrivKey priv;
+    safeheron::pail::PailPubKey pub;
+    safeheron::pail::CreateKeyPair2048(priv, pub);
+    setup.P = priv.p();
+    setup.Q = priv.q();
+    bool ok = safeheron::zkp::dln_proof::GenerateN_tilde_with_PQ(setup.P, setup.Q, setup.N_tilde, setup.h1, setup.h2,
+                                                                 setup.p, setup.q, setup.alpha, setup.beta);
+    ASSERT_THROW(ok);
+    return setup;
+}
+
+const RingPedersenSetup &GetRingPedersenSetup() {
+    static const RingPedersenSetup setup = create_ring_pedersen_setup();
+    return setup;
+}
+
+}
+}
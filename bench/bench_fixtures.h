@@ -0,0 +1,43 @@
+#ifndef SAFEHERON_BENCH_FIXTURES_H
+#define SAFEHERON_BENCH_FIXTURES_H
+
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/crypto-paillier/pail.h"
+
+namespace safeheron{
+namespace bench{
+
+/**
+ * A Paillier key pair, generated on first use and kept for the whole run.
+ */
+struct PailKeyPair {
+    safeheron::pail::PailPrivKey priv;
+    safeheron::pail::PailPubKey pub;
+};
+
+/**
+ * @param key_bits 2048, 3072 or 4096
+ */
+const PailKeyPair &GetPailKeyPair(int key_bits);
+
+/**
+ * A ring-Pedersen setup N_tilde = P * Q with its trapdoor, generated on first use and kept for the whole run.
+ */
+struct RingPedersenSetup {
+    safeheron::bignum::BN P;
+    safeheron::bignum::BN Q;
+    safeheron::bignum::BN N_tilde;
+    safeheron::bignum::BN h1;
+    safeheron::bignum::BN h2;
+    safeheron::bignum::BN p;  // (P - 1) / 2
+    safeheron::bignum::BN q;  // (Q - 1) / 2
+    safeheron::bignum::BN alpha;
+    safeheron::bignum::BN beta;
+};
+
+const RingPedersenSetup &GetRingPedersenSetup();
+
+}
+}
+
+#endif //SAFEHERON_BENCH_FIXTURES_H
@@ -0,0 +1,70 @@
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-bip32/bip32.h"
+#include "crypto-suites/common/executor.h"
+
+using safeheron::bip32::HDKey;
+using safeheron::curve::CurveType;
+
+static HDKey random_root(CurveType c_type) {
+    uint8_t seed[64];
+    safeheron::rand::RandomBytes(seed, sizeof(seed));
+    HDKey root;
+    root.FromSeed(c_type, seed, sizeof(seed));
+    return root;
+}
+
+static void BM_BIP32_FromSeed(benchmark::State &state, CurveType c_type) {
+    uint8_t seed[64];
+    safeheron::rand::RandomBytes(seed, sizeof(seed));
+    for (auto _ : state) {
+        HDKey root;
+        if (!root.FromSeed(c_type, seed, sizeof(seed))) {
+            state.SkipWithError("FromSeed failed");
+            break;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_BIP32_FromSeed, secp256k1, CurveType::SECP256K1);
+BENCHMARK_CAPTURE(BM_BIP32_FromSeed, ed25519, CurveType::ED25519);
+
+static void BM_BIP32_PrivateCKDPath(benchmark::State &state, CurveType c_type) {
+    HDKey root = random_root(c_type);
+    for (auto _ : state) {
+        HDKey child;
+        if (!root.PrivateCKDPath(child, "m/44/60/0/0/1")) {
+            state.SkipWithError("PrivateCKDPath failed");
+            break;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_BIP32_PrivateCKDPath, secp256k1, CurveType::SECP256K1);
+BENCHMARK_CAPTURE(BM_BIP32_PrivateCKDPath, ed25519, CurveType::ED25519);
+
+static void BM_BIP32_PublicCKDPath(benchmark::State &state, CurveType c_type) {
+    HDKey root = random_root(c_type);
+    for (auto _ : state) {
+        HDKey child;
+        if (!root.PublicCKDPath(child, "m/44/60/0/0/1")) {
+            state.SkipWithError("PublicCKDPath failed");
+            break;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_BIP32_PublicCKDPath, secp256k1, CurveType::SECP256K1);
+BENCHMARK_CAPTURE(BM_BIP32_PublicCKDPath, ed25519, CurveType::ED25519);
+
+static void BM_BIP32_PublicCKDRange(benchmark::State &state) {
+    HDKey root = random_root(CurveType::SECP256K1);
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    for (auto _ : state) {
+        std::vector<HDKey> children;
+        if (!root.PublicCKDRange(0, state.range(0), children, &pool)) {
+            state.SkipWithError("PublicCKDRange failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_BIP32_PublicCKDRange)->Arg(16)->Arg(256)->UseRealTime();
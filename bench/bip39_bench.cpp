@@ -0,0 +1,81 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bip39/bip39.h"
+#include "crypto-suites/crypto-hash/hmac_sha512.h"
+#include "crypto-suites/crypto-hash/pbkdf2_hmac_sha512.h"
+#include "crypto-suites/common/executor.h"
+
+using std::string;
+using std::vector;
+using safeheron::bip39::Language;
+
+static const string MNEMONIC = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+static const string PASSPHRASE = "TREZOR";
+
+// Argument: number of mnemonics.
+#define BIP39_ARGS Arg(1)->Arg(8)->Arg(32)
+
+/**
+ * The BIP-39 seed derivation, PBKDF2-HMAC-SHA512 with 2048 iterations, keying a new HMAC at every iteration as a
+ * straightforward implementation does, against PBKDF2_HMAC_SHA512 which keys it once.
+ */
+static void BM_PBKDF2_HMAC_SHA512_Naive(benchmark::State &state) {
+    const string salt = "mnemonic" + PASSPHRASE;
+    const string first = salt + string("\x00\x00\x00\x01", 4);
+    unsigned char u[64];
+    unsigned char out[64];
+    for (auto _ : state) {
+        safeheron::hash::CHMAC_SHA512((const unsigned char *) MNEMONIC.c_str(), MNEMONIC.length())
+                .Write((const unsigned char *) first.c_str(), first.length()).Finalize(u);
+        memcpy(out, u, 64);
+        for (int i = 1; i < 2048; i++) {
+            safeheron::hash::CHMAC_SHA512((const unsigned char *) MNEMONIC.c_str(), MNEMONIC.length())
+                    .Write(u, 64).Finalize(u);
+            for (int k = 0; k < 64; k++) out[k] ^= u[k];
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_PBKDF2_HMAC_SHA512_Naive);
+
+static void BM_PBKDF2_HMAC_SHA512(benchmark::State &state) {
+    const string salt = "mnemonic" + PASSPHRASE;
+    unsigned char out[64];
+    for (auto _ : state) {
+        safeheron::hash::PBKDF2_HMAC_SHA512((const unsigned char *) MNEMONIC.c_str(), MNEMONIC.length(),
+                                            (const unsigned char *) salt.c_str(), salt.length(), 2048, out, 64);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_PBKDF2_HMAC_SHA512);
+
+static void BM_BIP39_MnemonicToSeed(benchmark::State &state) {
+    for (auto _ : state) {
+        for (int i = 0; i < state.range(0); ++i) {
+            string seed;
+            if (!safeheron::bip39::MnemonicToSeed(seed, MNEMONIC, PASSPHRASE, Language::ENGLISH)) {
+                state.SkipWithError("MnemonicToSeed failed");
+                break;
+            }
+            benchmark::DoNotOptimize(seed);
+        }
+    }
+}
+BENCHMARK(BM_BIP39_MnemonicToSeed)->BIP39_ARGS;
+
+static void BM_BIP39_MnemonicToSeedMany(benchmark::State &state) {
+    vector<string> mnemonics(state.range(0), MNEMONIC);
+    vector<string> passphrases(1, PASSPHRASE);
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    for (auto _ : state) {
+        vector<string> seeds;
+        if (!safeheron::bip39::MnemonicToSeedMany(seeds, mnemonics, passphrases, Language::ENGLISH, &pool)) {
+            state.SkipWithError("MnemonicToSeedMany failed");
+            break;
+        }
+        benchmark::DoNotOptimize(seeds);
+    }
+}
+BENCHMARK(BM_BIP39_MnemonicToSeedMany)->BIP39_ARGS->UseRealTime();
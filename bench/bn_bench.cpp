@@ -0,0 +1,59 @@
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/crypto-bn/rand.h"
+
+using safeheron::bignum::BN;
+using safeheron::rand::RandomBNStrict;
+
+static BN random_odd_modulus(size_t bits) {
+    BN m = RandomBNStrict(bits);
+    if (m.IsEven()) m += 1;
+    return m;
+}
+
+static void BM_BN_Mul(benchmark::State &state) {
+    BN a = RandomBNStrict(state.range(0));
+    BN b = RandomBNStrict(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+BENCHMARK(BM_BN_Mul)->Arg(256)->Arg(1024)->Arg(2048)->Arg(4096);
+
+static void BM_BN_MulMod(benchmark::State &state) {
+    BN m = random_odd_modulus(state.range(0));
+    BN a = RandomBNStrict(state.range(0)) % m;
+    BN b = RandomBNStrict(state.range(0)) % m;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.MulMod(b, m));
+    }
+}
+BENCHMARK(BM_BN_MulMod)->Arg(256)->Arg(1024)->Arg(2048)->Arg(4096);
+
+static void BM_BN_PowM(benchmark::State &state) {
+    BN m = random_odd_modulus(state.range(0));
+    BN a = RandomBNStrict(state.range(0)) % m;
+    BN e = RandomBNStrict(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.PowM(e, m));
+    }
+}
+BENCHMARK(BM_BN_PowM)->Arg(256)->Arg(1024)->Arg(2048)->Arg(4096)->Unit(benchmark::kMicrosecond);
+
+static void BM_BN_InvM(benchmark::State &state) {
+    BN m = random_odd_modulus(state.range(0));
+    BN a = safeheron::rand::RandomBNLtCoPrime(m);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.InvM(m));
+    }
+}
+BENCHMARK(BM_BN_InvM)->Arg(256)->Arg(1024)->Arg(2048)->Arg(4096);
+
+static void BM_BN_Gcd(benchmark::State &state) {
+    BN a = RandomBNStrict(state.range(0));
+    BN b = RandomBNStrict(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.Gcd(b));
+    }
+}
+BENCHMARK(BM_BN_Gcd)->Arg(256)->Arg(1024)->Arg(2048)->Arg(4096);
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON outputs.
+
+Prints the change of the CPU time of every benchmark found in both files and exits with status 1 when any
+of them is slower than the baseline by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    with open(path) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    # With --benchmark_repetitions the median is the figure to compare, otherwise the single run.
+    medians = {b["run_name"]: b for b in benchmarks
+               if b.get("run_type") == "aggregate" and b.get("aggregate_name") == "median"}
+    results = {}
+    for b in benchmarks:
+        if b.get("run_type") == "aggregate":
+            continue
+        name = b.get("run_name", b["name"])
+        if "error_occurred" in b:
+            continue
+        b = medians.get(name, b)
+        results[name] = b["cpu_time"] * TIME_UNITS[b.get("time_unit", "ns")]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("result")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown tolerated, 0.10 by default")
+    args = parser.parse_args()
+
+    try:
+        baseline = load(args.baseline)
+    except FileNotFoundError:
+        print("No baseline at %s, run the bench-baseline target first." % args.baseline)
+        return 1
+    result = load(args.result)
+
+    regressions = []
+    width = max([len(name) for name in result] + [9])
+    print("%-*s %14s %14s %8s" % (width, "Benchmark", "Baseline(ns)", "Result(ns)", "Change"))
+    for name in sorted(result):
+        if name not in baseline:
+            print("%-*s %14s %14.0f %8s" % (width, name, "-", result[name], "new"))
+            continue
+        change = result[name] / baseline[name] - 1.0
+        mark = ""
+        if change > args.threshold:
+            regressions.append(name)
+            mark = " !"
+        print("%-*s %14.0f %14.0f %+7.1f%%%s" % (width, name, baseline[name], result[name], change * 100, mark))
+    for name in sorted(set(baseline) - set(result)):
+        print("%-*s %14.0f %14s %8s" % (width, name, baseline[name], "-", "missing"))
+
+    if regressions:
+        print("\n%d benchmark(s) slower than the baseline by more than %.0f%%:" % (len(regressions), args.threshold * 100))
+        for name in regressions:
+            print("  " + name)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
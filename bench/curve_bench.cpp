@@ -0,0 +1,170 @@
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
+#include "crypto-suites/crypto-curve/ecdsa.h"
+#include "crypto-suites/crypto-curve/eddsa.h"
+#include "crypto-suites/crypto-curve/schnorr.h"
+#include "crypto-suites/crypto-hash/sha256.h"
+
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+using safeheron::curve::FixedBaseTable;
+using safeheron::rand::RandomBNLt;
+
+#if ENABLE_STARK
+#define BENCHMARK_CURVES(func)                                  \
+    BENCHMARK_CAPTURE(func, secp256k1, CurveType::SECP256K1);   \
+    BENCHMARK_CAPTURE(func, p256, CurveType::P256);             \
+    BENCHMARK_CAPTURE(func, ed25519, CurveType::ED25519);       \
+    BENCHMARK_CAPTURE(func, stark, CurveType::STARK)
+#else
+#define BENCHMARK_CURVES(func)                                  \
+    BENCHMARK_CAPTURE(func, secp256k1, CurveType::SECP256K1);   \
+    BENCHMARK_CAPTURE(func, p256, CurveType::P256);             \
+    BENCHMARK_CAPTURE(func, ed25519, CurveType::ED25519)
+#endif //ENABLE_STARK
+
+static void BM_Curve_MulG(benchmark::State &state, CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    BN k = RandomBNLt(curv->n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(curv->g * k);
+    }
+}
+BENCHMARK_CURVES(BM_Curve_MulG);
+
+static void BM_Curve_Mul(benchmark::State &state, CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    CurvePoint P = curv->g * RandomBNLt(curv->n);
+    BN k = RandomBNLt(curv->n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(P * k);
+    }
+}
+BENCHMARK_CURVES(BM_Curve_Mul);
+
+static void BM_Curve_FixedBaseTableMul(benchmark::State &state, CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    FixedBaseTable table(curv->g * RandomBNLt(curv->n));
+    BN k = RandomBNLt(curv->n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table.Mul(k));
+    }
+}
+BENCHMARK_CURVES(BM_Curve_FixedBaseTableMul);
+
+static void BM_Curve_Add(benchmark::State &state, CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    CurvePoint P = curv->g * RandomBNLt(curv->n);
+    CurvePoint Q = curv->g * RandomBNLt(curv->n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(P + Q);
+    }
+}
+BENCHMARK_CURVES(BM_Curve_Add);
+
+static void random_digest(uint8_t digest[32]) {
+    uint8_t msg[64];
+    safeheron::rand::RandomBytes(msg, sizeof(msg));
+    safeheron::hash::CSHA256().Write(msg, sizeof(msg)).Finalize(digest);
+}
+
+static void BM_ECDSA_Sign(benchmark::State &state, CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    BN priv = RandomBNLt(curv->n);
+    uint8_t digest[32];
+    uint8_t sig[64];
+    random_digest(digest);
+    for (auto _ : state) {
+        safeheron::curve::ecdsa::Sign(c_type, priv, digest, sig);
+        benchmark::DoNotOptimize(sig);
+    }
+}
+BENCHMARK_CAPTURE(BM_ECDSA_Sign, secp256k1, CurveType::SECP256K1);
+BENCHMARK_CAPTURE(BM_ECDSA_Sign, p256, CurveType::P256);
+#if ENABLE_STARK
+BENCHMARK_CAPTURE(BM_ECDSA_Sign, stark, CurveType::STARK);
+#endif //ENABLE_STARK
+
+static void BM_ECDSA_Verify(benchmark::State &state, CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    BN priv = RandomBNLt(curv->n);
+    CurvePoint pub = curv->g * priv;
+    uint8_t digest[32];
+    uint8_t sig[64];
+    random_digest(digest);
+    safeheron::curve::ecdsa::Sign(c_type, priv, digest, sig);
+    for (auto _ : state) {
+        if (!safeheron::curve::ecdsa::Verify(c_type, pub, digest, sig)) {
+            state.SkipWithError("Invalid signature");
+            break;
+        }
+    }
+}
+BENCHMARK_CAPTURE(BM_ECDSA_Verify, secp256k1, CurveType::SECP256K1);
+BENCHMARK_CAPTURE(BM_ECDSA_Verify, p256, CurveType::P256);
+#if ENABLE_STARK
+BENCHMARK_CAPTURE(BM_ECDSA_Verify, stark, CurveType::STARK);
+#endif //ENABLE_STARK
+
+static void BM_EdDSA_Sign(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::ED25519);
+    BN priv = RandomBNLt(curv->n);
+    uint8_t msg[64];
+    safeheron::rand::RandomBytes(msg, sizeof(msg));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(safeheron::curve::eddsa::Sign(CurveType::ED25519, priv, msg, sizeof(msg)));
+    }
+}
+BENCHMARK(BM_EdDSA_Sign);
+
+static void BM_EdDSA_Verify(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::ED25519);
+    BN priv = RandomBNLt(curv->n);
+    CurvePoint pub = curv->g * priv;
+    uint8_t msg[64];
+    safeheron::rand::RandomBytes(msg, sizeof(msg));
+    std::string sig = safeheron::curve::eddsa::Sign(CurveType::ED25519, priv, msg, sizeof(msg));
+    for (auto _ : state) {
+        if (!safeheron::curve::eddsa::Verify(CurveType::ED25519, pub, (const uint8_t *)sig.c_str(), msg, sizeof(msg))) {
+            state.SkipWithError("Invalid signature");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_EdDSA_Verify);
+
+static void BM_Schnorr_Sign(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN priv = RandomBNLt(curv->n);
+    uint8_t digest[32];
+    random_digest(digest);
+    std::string aux(32, '\0');
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(safeheron::curve::schnorr::Sign(CurveType::SECP256K1, priv, digest, sizeof(digest), aux,
+                                                                 safeheron::curve::schnorr::SchnorrPattern::BIP340));
+    }
+}
+BENCHMARK(BM_Schnorr_Sign);
+
+static void BM_Schnorr_Verify(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN priv = RandomBNLt(curv->n);
+    CurvePoint pub = curv->g * priv;
+    uint8_t digest[32];
+    random_digest(digest);
+    std::string aux(32, '\0');
+    std::string sig = safeheron::curve::schnorr::Sign(CurveType::SECP256K1, priv, digest, sizeof(digest), aux,
+                                                      safeheron::curve::schnorr::SchnorrPattern::BIP340);
+    for (auto _ : state) {
+        if (!safeheron::curve::schnorr::Verify(CurveType::SECP256K1, pub, (const uint8_t *)sig.c_str(), digest, sizeof(digest),
+                                               safeheron::curve::schnorr::SchnorrPattern::BIP340)) {
+            state.SkipWithError("Invalid signature");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_Schnorr_Verify);
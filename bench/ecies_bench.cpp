@@ -0,0 +1,54 @@
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-ecies/ecies.h"
+#include "crypto-suites/common/executor.h"
+
+using std::string;
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+using safeheron::ecies::ECIES;
+
+// Argument: number of recipients.
+#define ECIES_ARGS Arg(1)->Arg(8)->Arg(32)
+
+static vector<CurvePoint> recipient_keys(int num) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    vector<CurvePoint> pubs;
+    for (int i = 0; i < num; ++i) pubs.push_back(curv->g * safeheron::rand::RandomBNLt(curv->n));
+    return pubs;
+}
+
+static void BM_ECIES_EncryptPack(benchmark::State &state) {
+    vector<CurvePoint> pubs = recipient_keys(state.range(0));
+    string plain(1024, 'a');
+    ECIES enc;
+    enc.set_curve_type(CurveType::SECP256K1);
+    for (auto _ : state) {
+        for (const CurvePoint &pub : pubs) {
+            string cypher;
+            enc.EncryptPack(pub, plain, cypher);
+            benchmark::DoNotOptimize(cypher);
+        }
+    }
+}
+BENCHMARK(BM_ECIES_EncryptPack)->ECIES_ARGS;
+
+static void BM_ECIES_EncryptPackMany(benchmark::State &state) {
+    vector<CurvePoint> pubs = recipient_keys(state.range(0));
+    vector<string> plains{string(1024, 'a')};
+    ECIES enc;
+    enc.set_curve_type(CurveType::SECP256K1);
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    for (auto _ : state) {
+        vector<string> cyphers;
+        enc.EncryptPackMany(pubs, plains, cyphers, &pool);
+        benchmark::DoNotOptimize(cyphers);
+    }
+}
+BENCHMARK(BM_ECIES_EncryptPackMany)->ECIES_ARGS->UseRealTime();
@@ -0,0 +1,87 @@
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-hash/sha1.h"
+#include "crypto-suites/crypto-hash/sha256.h"
+#include "crypto-suites/crypto-hash/sha512.h"
+#include "crypto-suites/crypto-hash/ripemd160.h"
+#include "crypto-suites/crypto-hash/keccak256.h"
+#include "crypto-suites/crypto-hash/hash160.h"
+#include "crypto-suites/crypto-hash/hash256.h"
+#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-hash/hmac_sha256.h"
+
+using namespace safeheron::hash;
+
+/**
+ * Hash state.range(0) bytes per iteration with a fresh hasher.
+ */
+template <typename Hasher>
+static void BM_Hash(benchmark::State &state) {
+    std::vector<unsigned char> msg(state.range(0));
+    safeheron::rand::RandomBytes(msg.data(), msg.size());
+    unsigned char digest[Hasher::OUTPUT_SIZE];
+    for (auto _ : state) {
+        Hasher().Write(msg.data(), msg.size()).Finalize(digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+#define BENCHMARK_HASH(Hasher) BENCHMARK_TEMPLATE(BM_Hash, Hasher)->Arg(32)->Arg(64)->Arg(1024)->Arg(16 * 1024)->Arg(1024 * 1024)
+
+BENCHMARK_HASH(CSHA1);
+BENCHMARK_HASH(CSHA256);
+BENCHMARK_HASH(CSHA512);
+BENCHMARK_HASH(CRIPEMD160);
+BENCHMARK_HASH(CKeccak256);
+BENCHMARK_HASH(CHash160);
+BENCHMARK_HASH(CHash256);
+BENCHMARK_HASH(CSafeHash256);
+
+static void BM_HMAC_SHA256(benchmark::State &state) {
+    unsigned char key[32];
+    safeheron::rand::RandomBytes(key, sizeof(key));
+    std::vector<unsigned char> msg(state.range(0));
+    safeheron::rand::RandomBytes(msg.data(), msg.size());
+    unsigned char digest[CHMAC_SHA256::OUTPUT_SIZE];
+    for (auto _ : state) {
+        CHMAC_SHA256(key, sizeof(key)).Write(msg.data(), msg.size()).Finalize(digest);
+        benchmark::DoNotOptimize(digest);
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HMAC_SHA256)->Arg(32)->Arg(64)->Arg(1024)->Arg(16 * 1024)->Arg(1024 * 1024);
+
+/**
+ * Keccak-256 of state.range(0) messages of 64 bytes, the size of the public keys hashed into Ethereum addresses,
+ * one by one and with Keccak256Many.
+ */
+static std::vector<std::string> random_messages(size_t n, size_t len) {
+    std::vector<std::string> msgs(n, std::string(len, '\0'));
+    for (auto &msg : msgs) safeheron::rand::RandomBytes((unsigned char *)&msg[0], len);
+    return msgs;
+}
+
+static void BM_Keccak256_Loop(benchmark::State &state) {
+    std::vector<std::string> msgs = random_messages(state.range(0), 64);
+    unsigned char digest[CKeccak256::OUTPUT_SIZE];
+    for (auto _ : state) {
+        for (const auto &msg : msgs) {
+            CKeccak256().Write((const unsigned char *)msg.data(), msg.size()).Finalize(digest);
+            benchmark::DoNotOptimize(digest);
+        }
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Keccak256_Loop)->Arg(1024);
+
+static void BM_Keccak256Many(benchmark::State &state) {
+    std::vector<std::string> msgs = random_messages(state.range(0), 64);
+    for (auto _ : state) {
+        std::vector<std::string> digests = Keccak256Many(msgs);
+        benchmark::DoNotOptimize(digests);
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_Keccak256Many)->Arg(1024);
@@ -0,0 +1,51 @@
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
+#include "bench_fixtures.h"
+
+using safeheron::bignum::BN;
+using safeheron::pail::PailPrivKey;
+using safeheron::pail::PailPubKey;
+using safeheron::bench::GetPailKeyPair;
+
+static void BM_Pail_CreateKeyPair(benchmark::State &state) {
+    for (auto _ : state) {
+        PailPrivKey priv;
+        PailPubKey pub;
+        safeheron::pail::CreateKeyPair(priv, pub, state.range(0));
+        benchmark::DoNotOptimize(pub);
+    }
+}
+// Prime generation dominates and varies a lot from one key to another, so a few iterations are enough.
+BENCHMARK(BM_Pail_CreateKeyPair)->Arg(2048)->Arg(3072)->Arg(4096)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+static void BM_Pail_Encrypt(benchmark::State &state) {
+    const PailPubKey &pub = GetPailKeyPair(state.range(0)).pub;
+    BN m = safeheron::rand::RandomBNLt(pub.n());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pub.Encrypt(m));
+    }
+}
+BENCHMARK(BM_Pail_Encrypt)->Arg(2048)->Arg(3072)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_Pail_Decrypt(benchmark::State &state) {
+    const PailPrivKey &priv = GetPailKeyPair(state.range(0)).priv;
+    const PailPubKey &pub = GetPailKeyPair(state.range(0)).pub;
+    BN c = pub.Encrypt(safeheron::rand::RandomBNLt(pub.n()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(priv.Decrypt(c));
+    }
+}
+BENCHMARK(BM_Pail_Decrypt)->Arg(2048)->Arg(3072)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_Pail_DecryptParallel(benchmark::State &state) {
+    const PailPrivKey &priv = GetPailKeyPair(state.range(0)).priv;
+    const PailPubKey &pub = GetPailKeyPair(state.range(0)).pub;
+    BN c = pub.Encrypt(safeheron::rand::RandomBNLt(pub.n()));
+    safeheron::concurrency::ThreadPoolExecutor pool(2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(priv.Decrypt(c, &pool));
+    }
+}
+BENCHMARK(BM_Pail_DecryptParallel)->Arg(2048)->Arg(3072)->Arg(4096)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,94 @@
+#include <vector>
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-sss/vsss_secp256k1.h"
+#include "crypto-suites/common/executor.h"
+
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+using safeheron::sss::Point;
+namespace vsss_secp256k1 = safeheron::sss::vsss_secp256k1;
+
+// Arguments: threshold, number of shares.
+#define SSS_ARGS Args({2, 3})->Args({5, 10})->Args({17, 50})->Args({33, 100})
+
+static vector<BN> share_indexes(int num) {
+    vector<BN> indexes;
+    for (int i = 1; i <= num; ++i) indexes.emplace_back(i);
+    return indexes;
+}
+
+static void BM_VSSS_MakeSharesWithCommits(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN secret = safeheron::rand::RandomBNLt(curv->n);
+    vector<BN> indexes = share_indexes(state.range(1));
+    for (auto _ : state) {
+        vector<Point> shares;
+        vector<CurvePoint> commits;
+        vsss_secp256k1::MakeSharesWithCommits(shares, commits, secret, state.range(0), indexes);
+        benchmark::DoNotOptimize(commits);
+    }
+}
+BENCHMARK(BM_VSSS_MakeSharesWithCommits)->SSS_ARGS;
+
+static void BM_VSSS_MakeSharesWithCommitsParallel(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN secret = safeheron::rand::RandomBNLt(curv->n);
+    vector<BN> indexes = share_indexes(state.range(1));
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    for (auto _ : state) {
+        vector<Point> shares;
+        vector<CurvePoint> commits;
+        vsss_secp256k1::MakeSharesWithCommits(shares, commits, secret, state.range(0), indexes, &pool);
+        benchmark::DoNotOptimize(commits);
+    }
+}
+BENCHMARK(BM_VSSS_MakeSharesWithCommitsParallel)->SSS_ARGS->UseRealTime();
+
+static void BM_VSSS_VerifyShare(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN secret = safeheron::rand::RandomBNLt(curv->n);
+    vector<Point> shares;
+    vector<CurvePoint> commits;
+    vsss_secp256k1::MakeSharesWithCommits(shares, commits, secret, state.range(0), share_indexes(state.range(1)));
+    for (auto _ : state) {
+        if (!vsss_secp256k1::VerifyShare(commits, state.range(0), shares.back().x, shares.back().y)) {
+            state.SkipWithError("Invalid share");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_VSSS_VerifyShare)->SSS_ARGS;
+
+static void BM_VSSS_VerifySharesBatch(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN secret = safeheron::rand::RandomBNLt(curv->n);
+    vector<Point> shares;
+    vector<CurvePoint> commits;
+    vsss_secp256k1::MakeSharesWithCommits(shares, commits, secret, state.range(0), share_indexes(state.range(1)));
+    for (auto _ : state) {
+        if (!vsss_secp256k1::VerifySharesBatch(commits, state.range(0), shares)) {
+            state.SkipWithError("Invalid share");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_VSSS_VerifySharesBatch)->SSS_ARGS;
+
+static void BM_VSSS_RecoverSecret(benchmark::State &state) {
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN secret = safeheron::rand::RandomBNLt(curv->n);
+    vector<Point> shares;
+    vsss_secp256k1::MakeShares(shares, secret, state.range(0), share_indexes(state.range(1)));
+    shares.erase(shares.begin() + state.range(0), shares.end());
+    for (auto _ : state) {
+        BN recovered;
+        vsss_secp256k1::RecoverSecret(recovered, shares);
+        benchmark::DoNotOptimize(recovered);
+    }
+}
+BENCHMARK(BM_VSSS_RecoverSecret)->SSS_ARGS;
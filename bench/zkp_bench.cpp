@@ -0,0 +1,564 @@
+#include <memory>
+#include "benchmark/benchmark.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-zkp/zkp.h"
+#include "bench_fixtures.h"
+
+using std::unique_ptr;
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+using safeheron::pail::PailPrivKey;
+using safeheron::pail::PailPubKey;
+using safeheron::rand::RandomBNLt;
+using safeheron::rand::RandomBNLtGcd;
+using safeheron::rand::RandomBNLtCoPrime;
+using safeheron::bench::GetPailKeyPair;
+using safeheron::bench::GetRingPedersenSetup;
+using safeheron::bench::RingPedersenSetup;
+using namespace safeheron::zkp;
+
+/**
+ * Every proof has a case holding its statement and witness, built once on first use, with
+ *     typedef ... Proof;
+ *     void Prove(Proof &proof) const;
+ *     bool Verify(const Proof &proof) const;
+ * The statements follow the ones of test/crypto-zkp, with secp256k1, a 2048-bit Paillier key and a 2048-bit
+ * ring-Pedersen modulus.
+ */
+template <typename Case>
+static const Case &get_case() {
+    static const Case c;
+    return c;
+}
+
+template <typename Case>
+static void BM_Prove(benchmark::State &state) {
+    const Case &c = get_case<Case>();
+    for (auto _ : state) {
+        typename Case::Proof proof;
+        c.Prove(proof);
+        benchmark::DoNotOptimize(proof);
+    }
+}
+
+template <typename Case>
+static void BM_Verify(benchmark::State &state) {
+    const Case &c = get_case<Case>();
+    typename Case::Proof proof;
+    c.Prove(proof);
+    for (auto _ : state) {
+        if (!c.Verify(proof)) {
+            state.SkipWithError("Invalid proof");
+            break;
+        }
+    }
+}
+
+#define BENCHMARK_PROOF(Case, unit)                             \
+    BENCHMARK_TEMPLATE(BM_Prove, Case)->Unit(benchmark::unit);  \
+    BENCHMARK_TEMPLATE(BM_Verify, Case)->Unit(benchmark::unit)
+
+static const Curve *secp256k1() {
+    return GetCurveParam(CurveType::SECP256K1);
+}
+
+/* Proofs over the curve */
+
+struct DLogProofCase {
+    typedef dlog::DLogProof Proof;
+    BN sk = RandomBNLt(secp256k1()->n);
+    void Prove(Proof &proof) const { proof.ProveEx(sk, CurveType::SECP256K1); }
+    bool Verify(const Proof &proof) const { return proof.Verify(); }
+};
+BENCHMARK_PROOF(DLogProofCase, kMicrosecond);
+
+struct DLogProofV2Case {
+    typedef dlog::DLogProof_V2 Proof;
+    BN x = RandomBNLt(secp256k1()->n);
+    CurvePoint X = secp256k1()->g * x;
+    void Prove(Proof &proof) const { proof.ProveEx(x, CurveType::SECP256K1); }
+    bool Verify(const Proof &proof) const { return proof.Verify(X); }
+};
+BENCHMARK_PROOF(DLogProofV2Case, kMicrosecond);
+
+struct DLogProofV3Case {
+    typedef dlog::DLogProof_V3 Proof;
+    BN x = RandomBNLt(secp256k1()->n);
+    CurvePoint G = secp256k1()->g * RandomBNLt(secp256k1()->n);
+    CurvePoint X = G * x;
+    void Prove(Proof &proof) const { proof.Prove(x, G, secp256k1()->n); }
+    bool Verify(const Proof &proof) const { return proof.Verify(X, G, secp256k1()->n); }
+};
+BENCHMARK_PROOF(DLogProofV3Case, kMicrosecond);
+
+struct DlogEqualityProofCase {
+    typedef dlog_equality::DlogEqualityProof Proof;
+    BN x;
+    unique_ptr<dlog_equality::DlogEqualityStatement> statement;
+    DlogEqualityProofCase() {
+        const Curve *curv = secp256k1();
+        x = RandomBNLt(curv->n);
+        CurvePoint h = curv->g * RandomBNLt(curv->n);
+        statement.reset(new dlog_equality::DlogEqualityStatement(curv->g, h, curv->g * x, h * x, curv->n));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, x); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(DlogEqualityProofCase, kMicrosecond);
+
+struct DlogElGamalComProofCase {
+    typedef dlog_elgamal_com::DlogElGamalComProof Proof;
+    unique_ptr<dlog_elgamal_com::DlogElGamalComStatement> statement;
+    unique_ptr<dlog_elgamal_com::DlogElGamalComWitness> witness;
+    DlogElGamalComProofCase() {
+        const Curve *curv = secp256k1();
+        BN x = RandomBNLt(curv->n);
+        BN y = RandomBNLt(curv->n);
+        BN lambda = RandomBNLt(curv->n);
+        CurvePoint h = curv->g * RandomBNLt(curv->n);
+        CurvePoint X = curv->g * x;
+        CurvePoint L = curv->g * lambda;
+        CurvePoint M = curv->g * y + X * lambda;
+        CurvePoint Y = h * y;
+        statement.reset(new dlog_elgamal_com::DlogElGamalComStatement(curv->g, L, M, X, Y, h, curv->n));
+        witness.reset(new dlog_elgamal_com::DlogElGamalComWitness(y, lambda));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(DlogElGamalComProofCase, kMicrosecond);
+
+struct HegProofCase {
+    typedef heg::HegProof Proof;
+    unique_ptr<heg::HomoElGamalStatement> statement;
+    unique_ptr<heg::HomoElGamalWitness> witness;
+    HegProofCase() {
+        const Curve *curv = secp256k1();
+        BN r = RandomBNLt(curv->n);
+        BN x = RandomBNLt(curv->n);
+        CurvePoint H = curv->g * RandomBNLt(curv->n);
+        CurvePoint Y = curv->g * RandomBNLt(curv->n);
+        statement.reset(new heg::HomoElGamalStatement(curv->g, H, Y, H * x + Y * r, curv->g * r));
+        witness.reset(new heg::HomoElGamalWitness(r, x));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(HegProofCase, kMicrosecond);
+
+struct HEGProofV2Case {
+    typedef heg::HEGProof_V2 Proof;
+    unique_ptr<heg::HEGStatement_V2> statement;
+    unique_ptr<heg::HEGWitness_V2> witness;
+    HEGProofV2Case() {
+        const Curve *curv = secp256k1();
+        BN s = RandomBNLt(curv->n);
+        BN l = RandomBNLt(curv->n);
+        CurvePoint R = curv->g * RandomBNLt(curv->n);
+        CurvePoint A = curv->g * RandomBNLt(curv->n);
+        statement.reset(new heg::HEGStatement_V2(curv->g, R * s + curv->g * l, R, A, A * l, curv->n));
+        witness.reset(new heg::HEGWitness_V2(s, l));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(HEGProofV2Case, kMicrosecond);
+
+struct HEGProofV3Case {
+    typedef heg::HEGProof_V3 Proof;
+    unique_ptr<heg::HEGStatement_V3> statement;
+    unique_ptr<heg::HEGWitness_V3> witness;
+    HEGProofV3Case() {
+        const Curve *curv = secp256k1();
+        BN sigma = RandomBNLt(curv->n);
+        BN l = RandomBNLt(curv->n);
+        CurvePoint H = curv->g * RandomBNLt(curv->n);
+        CurvePoint R = curv->g * RandomBNLt(curv->n);
+        statement.reset(new heg::HEGStatement_V3(curv->g * sigma + H * l, curv->g, H, R * sigma, R, curv->n));
+        witness.reset(new heg::HEGWitness_V3(sigma, l));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(HEGProofV3Case, kMicrosecond);
+
+struct LinearCombinationProofCase {
+    typedef linear_combination::LinearCombinationProof Proof;
+    unique_ptr<linear_combination::LinearCombinationStatement> statement;
+    unique_ptr<linear_combination::LinearCombinationWitness> witness;
+    LinearCombinationProofCase() {
+        const Curve *curv = secp256k1();
+        BN s = RandomBNLt(curv->n);
+        BN l = RandomBNLt(curv->n);
+        CurvePoint R = curv->g * RandomBNLt(curv->n);
+        statement.reset(new linear_combination::LinearCombinationStatement(R * s + curv->g * l, R, curv->g, curv->n));
+        witness.reset(new linear_combination::LinearCombinationWitness(s, l));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(LinearCombinationProofCase, kMicrosecond);
+
+struct PedersenProofCase {
+    typedef pedersen_proof::PedersenProof Proof;
+    unique_ptr<pedersen_proof::PedersenStatement> statement;
+    unique_ptr<pedersen_proof::PedersenWitness> witness;
+    PedersenProofCase() {
+        const Curve *curv = secp256k1();
+        BN sigma = RandomBNLt(curv->n);
+        BN l = RandomBNLt(curv->n);
+        CurvePoint H = curv->g * RandomBNLt(curv->n);
+        statement.reset(new pedersen_proof::PedersenStatement(curv->g, H, curv->g * sigma + H * l));
+        witness.reset(new pedersen_proof::PedersenWitness(sigma, l));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(PedersenProofCase, kMicrosecond);
+
+/* Proofs over a ring-Pedersen modulus */
+
+struct DLNProofCase {
+    typedef dln_proof::DLNProof Proof;
+    const RingPedersenSetup &rp = GetRingPedersenSetup();
+    void Prove(Proof &proof) const { proof.Prove(rp.N_tilde, rp.h1, rp.h2, rp.p, rp.q, rp.alpha); }
+    bool Verify(const Proof &proof) const { return proof.Verify(rp.N_tilde, rp.h1, rp.h2); }
+};
+BENCHMARK_PROOF(DLNProofCase, kMillisecond);
+
+struct TwoDLNProofCase {
+    typedef dln_proof::TwoDLNProof Proof;
+    const RingPedersenSetup &rp = GetRingPedersenSetup();
+    void Prove(Proof &proof) const { proof.Prove(rp.N_tilde, rp.h1, rp.h2, rp.p, rp.q, rp.alpha, rp.beta); }
+    bool Verify(const Proof &proof) const { return proof.Verify(rp.N_tilde, rp.h1, rp.h2); }
+};
+BENCHMARK_PROOF(TwoDLNProofCase, kMillisecond);
+
+/* Proofs about a Paillier key */
+
+struct PailNProofCase {
+    typedef pail::PailNProof Proof;
+    const PailPrivKey &priv = GetPailKeyPair(2048).priv;
+    const PailPubKey &pub = GetPailKeyPair(2048).pub;
+    void Prove(Proof &proof) const { proof.Prove(priv); }
+    bool Verify(const Proof &proof) const { return proof.Verify(pub); }
+};
+BENCHMARK_PROOF(PailNProofCase, kMillisecond);
+
+struct PailProofCase {
+    typedef pail::PailProof Proof;
+    const PailPrivKey &priv = GetPailKeyPair(2048).priv;
+    const PailPubKey &pub = GetPailKeyPair(2048).pub;
+    BN index = RandomBNLtGcd(secp256k1()->n);
+    CurvePoint point = secp256k1()->g * RandomBNLt(secp256k1()->n);
+    void Prove(Proof &proof) const { proof.Prove(priv, index, point.x(), point.y()); }
+    bool Verify(const Proof &proof) const { return proof.Verify(pub, index, point.x(), point.y()); }
+};
+BENCHMARK_PROOF(PailProofCase, kMillisecond);
+
+struct PailBlumModulusProofCase {
+    typedef pail::PailBlumModulusProof Proof;
+    const PailPrivKey &priv = GetPailKeyPair(2048).priv;
+    const PailPubKey &pub = GetPailKeyPair(2048).pub;
+    void Prove(Proof &proof) const { proof.Prove(pub.n(), priv.p(), priv.q()); }
+    bool Verify(const Proof &proof) const { return proof.Verify(pub.n()); }
+};
+BENCHMARK_PROOF(PailBlumModulusProofCase, kMillisecond);
+
+struct NoSmallFactorProofCase {
+    typedef no_small_factor_proof::NoSmallFactorProof Proof;
+    const RingPedersenSetup &rp = GetRingPedersenSetup();
+    const PailPrivKey &priv = GetPailKeyPair(2048).priv;
+    no_small_factor_proof::NoSmallFactorSetUp setup{rp.N_tilde, rp.h1, rp.h2};
+    no_small_factor_proof::NoSmallFactorStatement statement{priv.p() * priv.q(), 256, 512};
+    no_small_factor_proof::NoSmallFactorWitness witness{priv.p(), priv.q()};
+    void Prove(Proof &proof) const { proof.Prove(setup, statement, witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(setup, statement); }
+};
+BENCHMARK_PROOF(NoSmallFactorProofCase, kMillisecond);
+
+/* Proofs about Paillier ciphertexts */
+
+struct AliceRangeProofCase {
+    typedef range_proof::AliceRangeProof Proof;
+    const RingPedersenSetup &rp = GetRingPedersenSetup();
+    const PailPubKey &pub = GetPailKeyPair(2048).pub;
+    BN m = RandomBNLt(secp256k1()->n);
+    BN r = RandomBNLtGcd(pub.n());
+    BN c = pub.EncryptWithR(m, r);
+    void Prove(Proof &proof) const { proof.Prove(secp256k1()->n, pub.n(), pub.g(), rp.N_tilde, rp.h1, rp.h2, c, m, r); }
+    bool Verify(const Proof &proof) const { return proof.Verify(secp256k1()->n, pub.n(), pub.g(), rp.N_tilde, rp.h1, rp.h2, c); }
+};
+BENCHMARK_PROOF(AliceRangeProofCase, kMillisecond);
+
+struct PailEncRangeProofV1Case {
+    typedef pail::PailEncRangeProof_V1 Proof;
+    unique_ptr<pail::PailEncRangeSetUp_V1> setup;
+    unique_ptr<pail::PailEncRangeStatement_V1> statement;
+    unique_ptr<pail::PailEncRangeWitness_V1> witness;
+    PailEncRangeProofV1Case() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        BN x = RandomBNLt(secp256k1()->n);
+        BN r = RandomBNLtGcd(pub.n());
+        setup.reset(new pail::PailEncRangeSetUp_V1(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailEncRangeStatement_V1(pub.EncryptWithR(x, r), pub.n(), pub.n_sqr(), secp256k1()->n));
+        witness.reset(new pail::PailEncRangeWitness_V1(x, r));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailEncRangeProofV1Case, kMillisecond);
+
+struct PailEncRangeProofV2Case {
+    typedef pail::PailEncRangeProof_V2 Proof;
+    unique_ptr<pail::PailEncRangeSetUp_V2> setup;
+    unique_ptr<pail::PailEncRangeStatement_V2> statement;
+    unique_ptr<pail::PailEncRangeWitness_V2> witness;
+    PailEncRangeProofV2Case() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        BN x = RandomBNLt(secp256k1()->n);
+        BN r = RandomBNLtGcd(pub.n());
+        setup.reset(new pail::PailEncRangeSetUp_V2(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailEncRangeStatement_V2(pub.EncryptWithR(x, r), pub.n(), pub.n_sqr(), secp256k1()->n, 256, 512));
+        witness.reset(new pail::PailEncRangeWitness_V2(x, r));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailEncRangeProofV2Case, kMillisecond);
+
+struct PailEncRangeProofV3Case {
+    typedef pail::PailEncRangeProof_V3 Proof;
+    unique_ptr<pail::PailEncRangeStatement_V3> statement;
+    unique_ptr<pail::PailEncRangeWitness_V3> witness;
+    PailEncRangeProofV3Case() {
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        BN l = secp256k1()->n / 3;
+        BN x = RandomBNLt(l);
+        BN r = RandomBNLtCoPrime(pub.n());
+        statement.reset(new pail::PailEncRangeStatement_V3(pub.EncryptWithR(x, r), pub, l));
+        witness.reset(new pail::PailEncRangeWitness_V3(x, r));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(PailEncRangeProofV3Case, kMillisecond);
+
+struct PailEncMulProofCase {
+    typedef pail::PailEncMulProof Proof;
+    unique_ptr<pail::PailEncMulStatement> statement;
+    unique_ptr<pail::PailEncMulWitness> witness;
+    PailEncMulProofCase() {
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        BN x = RandomBNLt(secp256k1()->n);
+        BN rho_x = RandomBNLtGcd(pub.n());
+        BN rho = RandomBNLtGcd(pub.n());
+        BN X = pub.EncryptWithR(x, rho_x);
+        BN Y = RandomBNLtCoPrime(pub.n_sqr());
+        BN C = (Y.PowM(x, pub.n_sqr()) * rho.PowM(pub.n(), pub.n_sqr())) % pub.n_sqr();
+        statement.reset(new pail::PailEncMulStatement(pub.n(), pub.n_sqr(), X, Y, C, secp256k1()->n));
+        witness.reset(new pail::PailEncMulWitness(x, rho, rho_x));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*statement); }
+};
+BENCHMARK_PROOF(PailEncMulProofCase, kMillisecond);
+
+struct PailDecModuloProofCase {
+    typedef pail::PailDecModuloProof Proof;
+    unique_ptr<pail::PailDecModuloSetUp> setup;
+    unique_ptr<pail::PailDecModuloStatement> statement;
+    unique_ptr<pail::PailDecModuloWitness> witness;
+    PailDecModuloProofCase() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        BN y = RandomBNLtCoPrime(pub.n());
+        BN rho = RandomBNLtGcd(pub.n());
+        setup.reset(new pail::PailDecModuloSetUp(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailDecModuloStatement(secp256k1()->n, pub.n(), pub.n_sqr(), pub.EncryptWithR(y, rho),
+                                                          y % secp256k1()->n, 256, 512));
+        witness.reset(new pail::PailDecModuloWitness(y, rho));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailDecModuloProofCase, kMillisecond);
+
+struct PailAffRangeProofCase {
+    typedef pail::PailAffRangeProof Proof;
+    unique_ptr<pail::PailAffRangeSetUp> setup;
+    unique_ptr<pail::PailAffRangeStatement> statement;
+    unique_ptr<pail::PailAffRangeWitness> witness;
+    PailAffRangeProofCase() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        const BN &q = secp256k1()->n;
+        BN q5 = q * q * q * q * q;
+        BN x = RandomBNLt(q);
+        BN y = RandomBNLt(q5);
+        BN r = RandomBNLtGcd(pub.n());
+        BN c1 = pub.EncryptWithR(RandomBNLt(q), RandomBNLtGcd(pub.n()));
+        BN c2 = (c1.PowM(x, pub.n_sqr()) * pub.g().PowM(y, pub.n_sqr()) * r.PowM(pub.n(), pub.n_sqr())) % pub.n_sqr();
+        setup.reset(new pail::PailAffRangeSetUp(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailAffRangeStatement(c1, c2, pub, q));
+        witness.reset(new pail::PailAffRangeWitness(x, y, r));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailAffRangeProofCase, kMillisecond);
+
+struct PailAffGroupEleRangeProofV1Case {
+    typedef pail::PailAffGroupEleRangeProof_V1 Proof;
+    unique_ptr<pail::PailAffGroupEleRangeSetUp_V1> setup;
+    unique_ptr<pail::PailAffGroupEleRangeStatement_V1> statement;
+    unique_ptr<pail::PailAffGroupEleRangeWitness_V1> witness;
+    PailAffGroupEleRangeProofV1Case() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        const BN &q = secp256k1()->n;
+        BN q5 = q * q * q * q * q;
+        BN x = RandomBNLt(q);
+        BN y = RandomBNLt(q5);
+        BN r = RandomBNLtGcd(pub.n());
+        BN c1 = pub.EncryptWithR(RandomBNLt(q), RandomBNLtGcd(pub.n()));
+        BN c2 = (c1.PowM(x, pub.n_sqr()) * pub.g().PowM(y, pub.n_sqr()) * r.PowM(pub.n(), pub.n_sqr())) % pub.n_sqr();
+        setup.reset(new pail::PailAffGroupEleRangeSetUp_V1(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailAffGroupEleRangeStatement_V1(c1, c2, pub, secp256k1()->g * x, q));
+        witness.reset(new pail::PailAffGroupEleRangeWitness_V1(x, y, r));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailAffGroupEleRangeProofV1Case, kMillisecond);
+
+struct PailAffGroupEleRangeProofV2Case {
+    typedef pail::PailAffGroupEleRangeProof_V2 Proof;
+    unique_ptr<pail::PailAffGroupEleRangeSetUp_V2> setup;
+    unique_ptr<pail::PailAffGroupEleRangeStatement_V2> statement;
+    unique_ptr<pail::PailAffGroupEleRangeWitness_V2> witness;
+    PailAffGroupEleRangeProofV2Case() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        // The verifier's key encrypts C and D, the prover's key Y.
+        const PailPubKey &pub0 = GetPailKeyPair(2048).pub;
+        const PailPubKey &pub1 = GetPailKeyPair(3072).pub;
+        const uint32_t l = 256;
+        const uint32_t l_prime = 1280;
+        const uint32_t varepsilon = 512;
+        BN x = safeheron::rand::RandomNegBNInSymInterval(BN::ONE << l);
+        BN y = safeheron::rand::RandomNegBNInSymInterval(BN::ONE << l_prime);
+        BN rho = RandomBNLtCoPrime(pub0.n());
+        BN rho_y = RandomBNLtCoPrime(pub1.n());
+        BN C = pub0.EncryptNegWithR(RandomBNLt(secp256k1()->n), RandomBNLtCoPrime(pub0.n()));
+        BN Y = pub1.EncryptNegWithR(y, rho_y);
+        BN D = (C.PowM(x, pub0.n_sqr()) * pub0.EncryptNegWithR(y, rho)) % pub0.n_sqr();
+        setup.reset(new pail::PailAffGroupEleRangeSetUp_V2(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailAffGroupEleRangeStatement_V2(pub0.n(), pub0.n_sqr(), pub1.n(), pub1.n_sqr(), C, D, Y,
+                                                                    secp256k1()->g * x, secp256k1()->n, l, l_prime, varepsilon));
+        witness.reset(new pail::PailAffGroupEleRangeWitness_V2(x, y, rho, rho_y));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailAffGroupEleRangeProofV2Case, kMillisecond);
+
+struct PailEncElGamalComRangeProofCase {
+    typedef pail::PailEncElGamalComRangeProof Proof;
+    unique_ptr<pail::PailEncElGamalComRangeSetUp> setup;
+    unique_ptr<pail::PailEncElGamalComRangeStatement> statement;
+    unique_ptr<pail::PailEncElGamalComRangeWitness> witness;
+    PailEncElGamalComRangeProofCase() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        const Curve *curv = secp256k1();
+        BN x = RandomBNLt(curv->n);
+        BN rho = RandomBNLtGcd(pub.n());
+        BN a = RandomBNLt(curv->n);
+        BN b = RandomBNLt(curv->n);
+        CurvePoint A = curv->g * a;
+        CurvePoint B = curv->g * b;
+        CurvePoint X = A * b + curv->g * x;
+        setup.reset(new pail::PailEncElGamalComRangeSetUp(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailEncElGamalComRangeStatement(pub.n(), pub.n_sqr(), pub.EncryptWithR(x, rho), A, B, X,
+                                                                  curv->n, 256, 512));
+        witness.reset(new pail::PailEncElGamalComRangeWitness(x, rho, a, b));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailEncElGamalComRangeProofCase, kMillisecond);
+
+struct PailEncGroupEleRangeProofCase {
+    typedef pail::PailEncGroupEleRangeProof Proof;
+    unique_ptr<pail::PailEncGroupEleRangeSetUp> setup;
+    unique_ptr<pail::PailEncGroupEleRangeStatement> statement;
+    unique_ptr<pail::PailEncGroupEleRangeWitness> witness;
+    PailEncGroupEleRangeProofCase() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        const Curve *curv = secp256k1();
+        BN x = RandomBNLt(curv->n);
+        BN r = RandomBNLtGcd(pub.n());
+        setup.reset(new pail::PailEncGroupEleRangeSetUp(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailEncGroupEleRangeStatement(pub.EncryptWithR(x, r), pub.n(), pub.n_sqr(), curv->n,
+                                                                curv->g * x, curv->g, 256, 512));
+        witness.reset(new pail::PailEncGroupEleRangeWitness(x, r));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailEncGroupEleRangeProofCase, kMillisecond);
+
+struct PailMulGroupEleRangeProofCase {
+    typedef pail::PailMulGroupEleRangeProof Proof;
+    unique_ptr<pail::PailMulGroupEleRangeSetUp> setup;
+    unique_ptr<pail::PailMulGroupEleRangeStatement> statement;
+    unique_ptr<pail::PailMulGroupEleRangeWitness> witness;
+    PailMulGroupEleRangeProofCase() {
+        const RingPedersenSetup &rp = GetRingPedersenSetup();
+        const PailPubKey &pub = GetPailKeyPair(2048).pub;
+        const Curve *curv = secp256k1();
+        BN x = RandomBNLt(curv->n);
+        BN rho = RandomBNLtGcd(pub.n());
+        BN c = pub.EncryptWithR(RandomBNLt(curv->n), RandomBNLtGcd(pub.n()));
+        BN d = (c.PowM(x, pub.n_sqr()) * rho.PowM(pub.n(), pub.n_sqr())) % pub.n_sqr();
+        setup.reset(new pail::PailMulGroupEleRangeSetUp(rp.N_tilde, rp.h1, rp.h2));
+        statement.reset(new pail::PailMulGroupEleRangeStatement(pub.n(), pub.n_sqr(), c, d, curv->g * x, curv->g, curv->n,
+                                                                256, 512));
+        witness.reset(new pail::PailMulGroupEleRangeWitness(x, rho));
+    }
+    void Prove(Proof &proof) const { proof.Prove(*setup, *statement, *witness); }
+    bool Verify(const Proof &proof) const { return proof.Verify(*setup, *statement); }
+};
+BENCHMARK_PROOF(PailMulGroupEleRangeProofCase, kMillisecond);
+
+/* PDL is interactive, the benchmark runs the whole protocol. */
+
+static void BM_PDLProtocol(benchmark::State &state) {
+    const PailPrivKey &priv = GetPailKeyPair(2048).priv;
+    const PailPubKey &pub = GetPailKeyPair(2048).pub;
+    BN x = RandomBNLt(secp256k1()->n);
+    CurvePoint Q = secp256k1()->g * x;
+    BN c = pub.Encrypt(x);
+    for (auto _ : state) {
+        BN c1, c2, commit_Q, a, b, blind_a_b, blind_Q_hat;
+        CurvePoint Q_hat;
+        pdl::PDLProver prover(c, Q, pub, priv, x);
+        pdl::PDLVerifier verifier(c, Q, pub);
+        bool ok = verifier.Step1(c1, c2) &&
+                  prover.Step1(c1, c2, commit_Q) &&
+                  verifier.Step2(commit_Q, a, b, blind_a_b) &&
+                  prover.Step2(a, b, blind_a_b, Q_hat, blind_Q_hat) &&
+                  verifier.Accept(Q_hat, blind_Q_hat);
+        if (!ok) {
+            state.SkipWithError("PDL protocol failed");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_PDLProtocol)->Unit(benchmark::kMillisecond);
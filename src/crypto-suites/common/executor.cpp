@@ -0,0 +1,164 @@
+#include "crypto-suites/common/executor.h"
+
+#include <algorithm>
+#include <exception>
+
+#ifndef SAFEHERON_SGX_SDK
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif //SAFEHERON_SGX_SDK
+
+namespace safeheron{
+namespace concurrency{
+
+void SequentialExecutor::ParallelFor(size_t n, const std::function<void(size_t)> &task) {
+    for (size_t i = 0; i < n; ++i) {
+        task(i);
+    }
+}
+
+void ParallelFor(Executor *executor, size_t n, const std::function<void(size_t)> &task) {
+    if (executor == nullptr || n <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            task(i);
+        }
+        return;
+    }
+    executor->ParallelFor(n, task);
+}
+
+void ParallelInvoke(Executor *executor, const std::vector<std::function<void()>> &tasks) {
+    ParallelFor(executor, tasks.size(), [&tasks](size_t i) {
+        tasks[i]();
+    });
+}
+
+size_t Concurrency(const Executor *executor) {
+    return executor ? std::max<size_t>(executor->Concurrency(), 1) : 1;
+}
+
+#ifndef SAFEHERON_SGX_SDK
+
+namespace {
+
+struct Batch {
+    Batch(size_t _n, const std::function<void(size_t)> &_task) : n(_n), task(_task), next(0), finished(0) {}
+
+    const size_t n;
+    const std::function<void(size_t)> &task;
+    std::atomic<size_t> next;
+    std::atomic<size_t> finished;
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    std::exception_ptr error;
+
+    // Run tasks of the batch until there are none left to start.
+    void Run() {
+        for (;;) {
+            size_t i = next.fetch_add(1);
+            if (i >= n) return;
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+            if (finished.fetch_add(1) + 1 == n) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done_cv.notify_all();
+            }
+        }
+    }
+
+    bool Exhausted() const { return next.load() >= n; }
+};
+
+}
+
+struct ThreadPoolExecutor::Impl {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::deque<std::shared_ptr<Batch>> queue;
+    bool stop = false;
+
+    void WorkerLoop() {
+        for (;;) {
+            std::shared_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_cv.wait(lock, [this] { return stop || !queue.empty(); });
+                if (stop) return;
+                batch = queue.front();
+                if (batch->Exhausted()) {
+                    queue.pop_front();
+                    continue;
+                }
+            }
+            batch->Run();
+        }
+    }
+};
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t threads) : impl_(new Impl()) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    // The calling thread is one of the workers.
+    for (size_t i = 1; i < threads; ++i) {
+        impl_->workers.emplace_back(&Impl::WorkerLoop, impl_.get());
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->stop = true;
+    }
+    impl_->work_cv.notify_all();
+    for (auto &worker : impl_->workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPoolExecutor::Concurrency() const {
+    return impl_->workers.size() + 1;
+}
+
+void ThreadPoolExecutor::ParallelFor(size_t n, const std::function<void(size_t)> &task) {
+    if (n == 0) return;
+    if (n == 1 || impl_->workers.empty()) {
+        for (size_t i = 0; i < n; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>(n, task);
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        impl_->queue.push_back(batch);
+    }
+    impl_->work_cv.notify_all();
+
+    batch->Run();
+
+    {
+        std::lock_guard<std::mutex> lock(impl_->mutex);
+        auto it = std::find(impl_->queue.begin(), impl_->queue.end(), batch);
+        if (it != impl_->queue.end()) impl_->queue.erase(it);
+    }
+    {
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->done_cv.wait(lock, [&batch] { return batch->finished.load() == batch->n; });
+    }
+    if (batch->error) std::rethrow_exception(batch->error);
+}
+
+#endif //SAFEHERON_SGX_SDK
+
+};
+};
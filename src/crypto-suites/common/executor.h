@@ -0,0 +1,99 @@
+#ifndef SAFEHERONCRYPTOSUITES_EXECUTOR_H
+#define SAFEHERONCRYPTOSUITES_EXECUTOR_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace safeheron{
+namespace concurrency{
+
+/**
+ * Runs independent tasks of a batch API.
+ *
+ * The functions that accept an executor take a raw pointer which may be null, null meaning that every task
+ * runs sequentially in the calling thread. The result of a batch function never depends on the executor.
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * Call task(0), task(1), ..., task(n - 1), possibly in parallel, and return once all of them are done.
+     * If some tasks throw, the first exception is rethrown in the calling thread after all the tasks are finished.
+     *
+     * @param n number of tasks
+     * @param task the task, called with its index
+     */
+    virtual void ParallelFor(size_t n, const std::function<void(size_t)> &task) = 0;
+
+    /**
+     * @return the maximum number of tasks running at the same time.
+     */
+    virtual size_t Concurrency() const = 0;
+};
+
+/**
+ * Run every task in the calling thread, one after the other.
+ */
+class SequentialExecutor : public Executor {
+public:
+    void ParallelFor(size_t n, const std::function<void(size_t)> &task) override;
+
+    size_t Concurrency() const override { return 1; }
+};
+
+/**
+ * Call task(0), ..., task(n - 1) on "executor", or sequentially if "executor" is null.
+ */
+void ParallelFor(Executor *executor, size_t n, const std::function<void(size_t)> &task);
+
+/**
+ * Run a fixed set of independent tasks on "executor", or one after the other in the calling thread if "executor"
+ * is null. Each task writes its own result, so the results are the same whatever the order of execution.
+ */
+void ParallelInvoke(Executor *executor, const std::vector<std::function<void()>> &tasks);
+
+/**
+ * @return the concurrency of "executor", 1 if "executor" is null.
+ */
+size_t Concurrency(const Executor *executor);
+
+#ifndef SAFEHERON_SGX_SDK
+
+/**
+ * A fixed pool of worker threads. The threads are created once and reused by every call of ParallelFor.
+ * The calling thread takes part in the work, so nested calls of ParallelFor on the same pool do not deadlock.
+ * An instance can be shared between threads.
+ */
+class ThreadPoolExecutor : public Executor {
+public:
+    /**
+     * Constructor
+     * @param threads number of threads working on a batch, including the calling thread.
+     *        0 means std::thread::hardware_concurrency().
+     */
+    explicit ThreadPoolExecutor(size_t threads = 0);
+
+    ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+
+    ThreadPoolExecutor &operator=(const ThreadPoolExecutor &) = delete;
+
+    ~ThreadPoolExecutor() override;
+
+    void ParallelFor(size_t n, const std::function<void(size_t)> &task) override;
+
+    size_t Concurrency() const override;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+#endif //SAFEHERON_SGX_SDK
+
+};
+};
+
+#endif //SAFEHERONCRYPTOSUITES_EXECUTOR_H
@@ -0,0 +1,184 @@
+#include "crypto-suites/common/instrumentation.h"
+
+#if ENABLE_INSTRUMENTATION
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+namespace safeheron{
+namespace instrumentation{
+
+static thread_local Counters thread_counters;
+
+uint64_t Counters::PowMTotal() const {
+    uint64_t total = 0;
+    for (const auto &item : powm) total += item.second;
+    return total;
+}
+
+uint64_t Counters::CurveMulTotal() const {
+    uint64_t total = 0;
+    for (const auto &item : curve_mul) total += item.second;
+    return total;
+}
+
+const Counters &ThreadCounters() {
+    return thread_counters;
+}
+
+void ResetThreadCounters() {
+    thread_counters = Counters();
+}
+
+void CountPowM(size_t modulus_bits, uint64_t n) {
+    thread_counters.powm[(modulus_bits + 63) / 64 * 64] += n;
+}
+
+void CountInvM() {
+    ++thread_counters.invm;
+}
+
+void CountCurveMul(uint32_t curve_type) {
+    ++thread_counters.curve_mul[curve_type];
+}
+
+void CountHashBytes(uint64_t len) {
+    thread_counters.hash_bytes += len;
+}
+
+void CountRandomBytes(uint64_t len) {
+    thread_counters.random_bytes += len;
+}
+
+// The sink is replaced under the mutex and read through a copy of the shared pointer, so a scope closing while
+// the sink is being replaced reports to either the old or the new one.
+static std::mutex sink_mutex;
+static std::shared_ptr<TraceSink> sink;
+static std::atomic<bool> sink_installed(false);
+
+void SetTraceSink(TraceSink new_sink) {
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    if (new_sink) {
+        sink = std::make_shared<TraceSink>(std::move(new_sink));
+    } else {
+        sink.reset();
+    }
+    sink_installed.store(sink != nullptr, std::memory_order_release);
+}
+
+static std::shared_ptr<TraceSink> current_sink() {
+    std::lock_guard<std::mutex> lock(sink_mutex);
+    return sink;
+}
+
+static uint64_t now_ns() {
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+static uint32_t thread_id() {
+    static std::atomic<uint32_t> next_id(1);
+    static thread_local uint32_t id = next_id.fetch_add(1);
+    return id;
+}
+
+ScopedTimer::ScopedTimer(const char *name)
+        : name_(name), active_(sink_installed.load(std::memory_order_acquire)), start_ns_(0),
+          powm_(0), invm_(0), curve_mul_(0), hash_bytes_(0), random_bytes_(0) {
+    if (!active_) return;
+    const Counters &c = thread_counters;
+    powm_ = c.PowMTotal();
+    invm_ = c.invm;
+    curve_mul_ = c.CurveMulTotal();
+    hash_bytes_ = c.hash_bytes;
+    random_bytes_ = c.random_bytes;
+    start_ns_ = now_ns();
+}
+
+ScopedTimer::~ScopedTimer() {
+    if (!active_) return;
+    uint64_t end_ns = now_ns();
+    std::shared_ptr<TraceSink> s = current_sink();
+    if (!s) return;
+    const Counters &c = thread_counters;
+    TraceEvent event;
+    event.name = name_;
+    event.thread_id = thread_id();
+    event.start_ns = start_ns_;
+    event.duration_ns = end_ns - start_ns_;
+    event.powm = c.PowMTotal() - powm_;
+    event.invm = c.invm - invm_;
+    event.curve_mul = c.CurveMulTotal() - curve_mul_;
+    event.hash_bytes = c.hash_bytes - hash_bytes_;
+    event.random_bytes = c.random_bytes - random_bytes_;
+    // A destructor must not throw: an exception of the sink is dropped with the event.
+    try {
+        (*s)(event);
+    } catch (...) {
+    }
+}
+
+ChromeTraceWriter::ChromeTraceWriter(std::ostream &out) : out_(out), first_(true), closed_(false) {
+    out_ << "{\"traceEvents\":[";
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() {
+    Close();
+}
+
+static void write_json_string(std::ostream &out, const char *s) {
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for (; s && *s; ++s) {
+        unsigned char ch = static_cast<unsigned char>(*s);
+        if (ch == '"' || ch == '\\') {
+            out << '\\' << ch;
+        } else if (ch < 0x20) {
+            out << "\\u00" << hex[ch >> 4] << hex[ch & 0xf];
+        } else {
+            out << ch;
+        }
+    }
+    out << '"';
+}
+
+// Chrome traces count in microseconds.
+static void write_us(std::ostream &out, uint64_t ns) {
+    out << ns / 1000 << '.' << (char)('0' + ns / 100 % 10) << (char)('0' + ns / 10 % 10) << (char)('0' + ns % 10);
+}
+
+void ChromeTraceWriter::Write(const TraceEvent &event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) return;
+    out_ << (first_ ? "\n" : ",\n");
+    first_ = false;
+    out_ << "{\"name\":";
+    write_json_string(out_, event.name);
+    out_ << ",\"cat\":\"safeheron\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread_id << ",\"ts\":";
+    write_us(out_, event.start_ns);
+    out_ << ",\"dur\":";
+    write_us(out_, event.duration_ns);
+    out_ << ",\"args\":{\"powm\":" << event.powm
+         << ",\"invm\":" << event.invm
+         << ",\"curve_mul\":" << event.curve_mul
+         << ",\"hash_bytes\":" << event.hash_bytes
+         << ",\"random_bytes\":" << event.random_bytes << "}}";
+}
+
+void ChromeTraceWriter::Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) return;
+    closed_ = true;
+    out_ << "\n]}\n";
+    out_.flush();
+}
+
+TraceSink ChromeTraceWriter::Sink() {
+    return [this](const TraceEvent &event) { Write(event); };
+}
+
+}
+}
+
+#endif //ENABLE_INSTRUMENTATION
@@ -0,0 +1,180 @@
+#ifndef SAFEHERONCRYPTOSUITES_INSTRUMENTATION_H
+#define SAFEHERONCRYPTOSUITES_INSTRUMENTATION_H
+
+/**
+ * Opt-in instrumentation, built with -DENABLE_INSTRUMENTATION=ON.
+ *
+ * The library counts, per thread, the expensive primitives it runs, and times the Prove and Verify functions
+ * of the zero-knowledge proofs. Without ENABLE_INSTRUMENTATION the SAFEHERON_COUNT_* and SAFEHERON_TRACE_SCOPE
+ * macros expand to nothing, their arguments are not evaluated, and nothing below is declared.
+ */
+
+#if ENABLE_INSTRUMENTATION
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+namespace safeheron{
+namespace instrumentation{
+
+/**
+ * Operation counters of one thread.
+ */
+struct Counters {
+    /** BN::PowM calls by bit length of the modulus, rounded up to a multiple of 64. MultiPowM counts one per base. */
+    std::map<size_t, uint64_t> powm;
+    /** BN::InvM calls */
+    uint64_t invm = 0;
+    /** Scalar multiplications of a CurvePoint, by curve type */
+    std::map<uint32_t, uint64_t> curve_mul;
+    /**
+     * Message bytes hashed by SHA-1, SHA-256, SHA-512, RIPEMD-160 and Keccak-256, including those hashed on behalf
+     * of Hash160, HMAC, etc. The SHA and RIPEMD digests count them when finalized, Keccak-256 when written.
+     */
+    uint64_t hash_bytes = 0;
+    /** Bytes drawn from safeheron::rand::RandomBytes */
+    uint64_t random_bytes = 0;
+
+    uint64_t PowMTotal() const;
+    uint64_t CurveMulTotal() const;
+};
+
+/**
+ * @return the counters of the calling thread since it started or since its last call of ResetThreadCounters().
+ */
+const Counters &ThreadCounters();
+
+void ResetThreadCounters();
+
+void CountPowM(size_t modulus_bits, uint64_t n);
+void CountInvM();
+void CountCurveMul(uint32_t curve_type);
+void CountHashBytes(uint64_t len);
+void CountRandomBytes(uint64_t len);
+
+/**
+ * A finished scope, with the work done by its thread while it was open.
+ */
+struct TraceEvent {
+    const char *name;
+    /** Small integer identifying the thread, 1 for the first thread that reported an event. */
+    uint32_t thread_id;
+    /** Start time in nanoseconds, on a monotonic clock whose origin is the first use of the instrumentation. */
+    uint64_t start_ns;
+    uint64_t duration_ns;
+    uint64_t powm;
+    uint64_t invm;
+    uint64_t curve_mul;
+    uint64_t hash_bytes;
+    uint64_t random_bytes;
+};
+
+typedef std::function<void(const TraceEvent &)> TraceSink;
+
+/**
+ * Install the sink receiving the events of every thread, or remove it with an empty sink.
+ * The sink may be called by several threads at the same time. While no sink is installed a scope only costs
+ * an atomic load.
+ */
+void SetTraceSink(TraceSink sink);
+
+/**
+ * Report the time spent between its construction and its destruction to the trace sink.
+ * Use it through SAFEHERON_TRACE_SCOPE.
+ */
+class ScopedTimer {
+public:
+    /**
+     * @param name string literal, or any string outliving the sink's use of the event.
+     */
+    explicit ScopedTimer(const char *name);
+
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+    const char *name_;
+    bool active_;
+    uint64_t start_ns_;
+    uint64_t powm_;
+    uint64_t invm_;
+    uint64_t curve_mul_;
+    uint64_t hash_bytes_;
+    uint64_t random_bytes_;
+};
+
+/**
+ * Write the events as a Chrome trace (the JSON format read by chrome://tracing and Perfetto), one complete
+ * event per scope with the counters as arguments.
+ *
+ *     std::ofstream file("trace.json");
+ *     ChromeTraceWriter writer(file);
+ *     SetTraceSink(writer.Sink());
+ *     ...
+ *     SetTraceSink(nullptr);
+ *     writer.Close();
+ */
+class ChromeTraceWriter {
+public:
+    explicit ChromeTraceWriter(std::ostream &out);
+
+    /**
+     * Close the trace if it is still open.
+     */
+    ~ChromeTraceWriter();
+
+    ChromeTraceWriter(const ChromeTraceWriter &) = delete;
+
+    ChromeTraceWriter &operator=(const ChromeTraceWriter &) = delete;
+
+    void Write(const TraceEvent &event);
+
+    /**
+     * Finish the JSON document. Later events are dropped.
+     */
+    void Close();
+
+    /**
+     * @return a sink writing to this writer, which must outlive the sink's installation.
+     */
+    TraceSink Sink();
+
+private:
+    std::mutex mutex_;
+    std::ostream &out_;
+    bool first_;
+    bool closed_;
+};
+
+}
+}
+
+#define SAFEHERON_COUNT_POWM(modulus_bits, n) safeheron::instrumentation::CountPowM(modulus_bits, n)
+#define SAFEHERON_COUNT_INVM() safeheron::instrumentation::CountInvM()
+#define SAFEHERON_COUNT_CURVE_MUL(curve_type) safeheron::instrumentation::CountCurveMul(static_cast<uint32_t>(curve_type))
+#define SAFEHERON_COUNT_HASH_BYTES(len) safeheron::instrumentation::CountHashBytes(len)
+#define SAFEHERON_COUNT_RANDOM_BYTES(len) safeheron::instrumentation::CountRandomBytes(len)
+#define SAFEHERON_TRACE_CONCAT_INNER(a, b) a##b
+#define SAFEHERON_TRACE_CONCAT(a, b) SAFEHERON_TRACE_CONCAT_INNER(a, b)
+#define SAFEHERON_TRACE_SCOPE(name) \
+    safeheron::instrumentation::ScopedTimer SAFEHERON_TRACE_CONCAT(safeheron_trace_scope_, __LINE__)(name)
+
+#else
+
+#define SAFEHERON_COUNT_POWM(modulus_bits, n) ((void)0)
+#define SAFEHERON_COUNT_INVM() ((void)0)
+#define SAFEHERON_COUNT_CURVE_MUL(curve_type) ((void)0)
+#define SAFEHERON_COUNT_HASH_BYTES(len) ((void)0)
+#define SAFEHERON_COUNT_RANDOM_BYTES(len) ((void)0)
+#define SAFEHERON_TRACE_SCOPE(name) ((void)0)
+
+#endif //ENABLE_INSTRUMENTATION
+
+#endif //SAFEHERONCRYPTOSUITES_INSTRUMENTATION_H
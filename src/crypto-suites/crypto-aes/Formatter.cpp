@@ -123,3 +123,48 @@ bool Formatter::ConstructAESGCMCypher(const uint8_t * p_encrypted_data,
 
     return true;
 }
+
+uint32_t Formatter::AESGCMCypherLength(uint32_t encrypted_data_len,
+                                       uint32_t mac_len,
+                                       uint32_t iv_len){
+    return 1 + 3 * 4 + encrypted_data_len + mac_len + iv_len;
+}
+
+bool Formatter::LayoutAESGCMCypher(uint8_t *p_cypher,
+                                   uint32_t cypher_len,
+                                   uint32_t encrypted_data_len,
+                                   uint32_t mac_len,
+                                   uint32_t iv_len,
+                                   uint8_t * &p_encrypted_data,
+                                   uint8_t * &p_mac,
+                                   uint8_t * &p_iv){
+    bool ok = false;
+    if(!p_cypher || cypher_len != AESGCMCypherLength(encrypted_data_len, mac_len, iv_len)) return false;
+
+    uint8_t *p_cur = p_cypher;
+
+    // 0x01 + Len0
+    safeheron::memory::MemoryWriter head_writer(p_cur, 1 + 4);
+    ok = head_writer.write_byte(0x01) && head_writer.write_uint32(encrypted_data_len);
+    if(!ok) return false;
+    p_cur += 1 + 4;
+    p_encrypted_data = p_cur;
+    p_cur += encrypted_data_len;
+
+    // Len1
+    safeheron::memory::MemoryWriter mac_writer(p_cur, 4);
+    ok = mac_writer.write_uint32(mac_len);
+    if(!ok) return false;
+    p_cur += 4;
+    p_mac = p_cur;
+    p_cur += mac_len;
+
+    // Len2
+    safeheron::memory::MemoryWriter iv_writer(p_cur, 4);
+    ok = iv_writer.write_uint32(iv_len);
+    if(!ok) return false;
+    p_cur += 4;
+    p_iv = p_cur;
+
+    return true;
+}
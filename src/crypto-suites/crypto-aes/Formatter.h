@@ -89,6 +89,44 @@ public:
                                const uint8_t * p_iv,
                                uint32_t iv_len,
                                std::string &cypher);
+
+    /**
+     * Length of the Crypher Bytes of AES-GCM (Version 1)
+     * 01 + Len0(4 bytes) + Segment0 + Len1(4 bytes) + Segment1 + Len2(4 bytes) + Segment2
+     *
+     * @param encrypted_data_len [in]
+     * @param mac_len [in]
+     * @param iv_len [in]
+     * @return
+     */
+    static uint32_t AESGCMCypherLength(uint32_t encrypted_data_len,
+                                       uint32_t mac_len,
+                                       uint32_t iv_len);
+
+    /**
+     * Write the type and length fields of the Crypher Bytes of AES-GCM (Version 1) into p_cypher,
+     * and return the positions of the segments so that they can be filled in place.
+     * 01 + Len0(4 bytes) + Segment0 + Len1(4 bytes) + Segment1 + Len2(4 bytes) + Segment2
+     * 01 + cypher + mac + iv
+     *
+     * @param p_cypher [in] buffer of AESGCMCypherLength() bytes
+     * @param cypher_len [in]
+     * @param encrypted_data_len [in]
+     * @param mac_len [in]
+     * @param iv_len [in]
+     * @param p_encrypted_data [out]
+     * @param p_mac [out]
+     * @param p_iv [out]
+     * @return
+     */
+    bool LayoutAESGCMCypher(uint8_t *p_cypher,
+                            uint32_t cypher_len,
+                            uint32_t encrypted_data_len,
+                            uint32_t mac_len,
+                            uint32_t iv_len,
+                            uint8_t * &p_encrypted_data,
+                            uint8_t * &p_mac,
+                            uint8_t * &p_iv);
 };
 
 
@@ -20,36 +20,144 @@ using safeheron::exception::LocatedException;
 namespace safeheron{
 namespace aes{
 
+const int GCM::TAG_SIZE;
+const int GCM::IV_SIZE;
+
 GCM::GCM(uint8_t *p_key, int key_len)
+        : enc_ctx_(nullptr), dec_ctx_(nullptr)
 {
     ASSERT_THROW(p_key);
     ASSERT_THROW(key_len == 16 || key_len == 24 || key_len == 32);
     key_.resize(key_len);
     memcpy(key_.data(), p_key, key_len);
+    InitContexts();
 }
 
 GCM::GCM(const std::string &key)
+        : enc_ctx_(nullptr), dec_ctx_(nullptr)
 {
     ASSERT_THROW(key.length() == 16 || key.length() == 24 || key.length() == 32);
     key_.resize(key.length());
     memcpy(key_.data(), key.c_str(), key.length());
+    InitContexts();
+}
+
+GCM::GCM(const GCM &gcm)
+        : key_(gcm.key_), enc_ctx_(nullptr), dec_ctx_(nullptr)
+{
+    InitContexts();
+}
+
+GCM &GCM::operator=(const GCM &gcm)
+{
+    if (this == &gcm) return *this;
+    FreeContexts();
+    crypto_memzero(key_.data(), key_.size());
+    key_ = gcm.key_;
+    error_msg_ = "";
+    InitContexts();
+    return *this;
 }
 
 GCM::~GCM() 
 {
+    FreeContexts();
     // fill the buffer with 0 before release
     crypto_memzero(key_.data(), key_.size());
 }
 
+void GCM::InitContexts()
+{
+    const EVP_CIPHER *cipher = nullptr;
+
+    // support AES-GCM with 128/192/256 bytes key
+    switch (key_.size()) {
+        case 16:
+            cipher = EVP_aes_128_gcm();
+            break;
+        case 24:
+            cipher = EVP_aes_192_gcm();
+            break;
+        case 32:
+            cipher = EVP_aes_256_gcm();
+            break;
+        default:
+            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "AES-GCM Key length is wrong.");
+    }
+
+    // The key schedule is done once here, every message only resets the iv.
+    enc_ctx_ = EVP_CIPHER_CTX_new();
+    dec_ctx_ = EVP_CIPHER_CTX_new();
+    if (!enc_ctx_ || !dec_ctx_) {
+        FreeContexts();
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "EVP_CIPHER_CTX_new() failed!");
+    }
+    if ((1 != EVP_EncryptInit_ex(enc_ctx_, cipher, nullptr, nullptr, nullptr)) ||
+        (1 != EVP_CIPHER_CTX_ctrl(enc_ctx_, EVP_CTRL_GCM_SET_IVLEN, GCM_IV_LEN, nullptr)) ||
+        (1 != EVP_EncryptInit_ex(enc_ctx_, nullptr, nullptr, key_.data(), nullptr)) ||
+        (1 != EVP_DecryptInit_ex(dec_ctx_, cipher, nullptr, nullptr, nullptr)) ||
+        (1 != EVP_CIPHER_CTX_ctrl(dec_ctx_, EVP_CTRL_GCM_SET_IVLEN, GCM_IV_LEN, nullptr)) ||
+        (1 != EVP_DecryptInit_ex(dec_ctx_, nullptr, nullptr, key_.data(), nullptr))) {
+        FreeContexts();
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, -1, "Create and initialize cipher context failed.");
+    }
+}
+
+void GCM::FreeContexts()
+{
+    if (enc_ctx_) {
+        EVP_CIPHER_CTX_free(enc_ctx_);
+        enc_ctx_ = nullptr;
+    }
+    if (dec_ctx_) {
+        EVP_CIPHER_CTX_free(dec_ctx_);
+        dec_ctx_ = nullptr;
+    }
+}
+
 bool GCM::Encrypt(const uint8_t* p_in_plaindata, int in_plaindata_len,
                  const uint8_t* p_in_iv, int in_iv_len,
                 const uint8_t* p_in_associatedData, int in_associated_data_len,
                 uint8_t* &p_out_tag, int &out_tag_len,
                 uint8_t* &p_out_cipherdata, int &out_cipherdata_len)
+{
+    uint8_t* p_tag = nullptr;
+    uint8_t* p_cipher = nullptr;
+
+    error_msg_ = "";
+
+    if (!p_in_plaindata || in_plaindata_len <= 0) {
+        error_msg_ = "Parameter p_in_plaindata cannot be null or empty.";
+        return false;
+    }
+
+    // encrypt plain data
+    p_tag = new uint8_t[GCM_TAG_LEN];
+    p_cipher = new uint8_t[in_plaindata_len];
+    if (!Encrypt(p_in_plaindata, in_plaindata_len, p_in_iv, in_iv_len,
+                 p_in_associatedData, in_associated_data_len, p_tag, p_cipher)) {
+        delete []p_tag;
+        delete []p_cipher;
+        return false;
+    }
+
+    // return ciphertext data length
+    p_out_tag = p_tag;
+    out_tag_len = GCM_TAG_LEN;
+    p_out_cipherdata = p_cipher;
+    out_cipherdata_len = in_plaindata_len;
+
+    return true;
+}
+
+bool GCM::Encrypt(const uint8_t* p_in_plaindata, int in_plaindata_len,
+                 const uint8_t* p_in_iv, int in_iv_len,
+                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                 uint8_t* p_out_tag,
+                 uint8_t* p_out_cipherdata)
 {
     int len = 0;
-    const EVP_CIPHER *cipher = nullptr;
-    EVP_CIPHER_CTX *ctx = nullptr;
+    int out_len = 0;
 
     error_msg_ = "";
 
@@ -69,63 +177,34 @@ bool GCM::Encrypt(const uint8_t* p_in_plaindata, int in_plaindata_len,
         error_msg_ = "Parameter in_associated_data_len cannot be 0 or less 0 when p_in_associatedData is not null.";
         return false;
     }
-
-    // support AES-GCM with 128/192/256 bytes key
-    switch (key_.size()) {
-        case 16:
-            cipher = EVP_aes_128_gcm();
-            break;
-        case 24:
-            cipher = EVP_aes_192_gcm();
-            break;
-        case 32:
-            cipher = EVP_aes_256_gcm();
-            break;
-        default:
-            error_msg_ = "AES-GCM Key length is wrong.";
-            return false;
+    if (!p_out_tag || !p_out_cipherdata) {
+        error_msg_ = "Parameter p_out_tag and p_out_cipherdata cannot be null.";
+        return false;
     }
 
-    // create and initialize cipher context
-    if (!(ctx = EVP_CIPHER_CTX_new()) ||
-        (1 != EVP_EncryptInit_ex(ctx, cipher, nullptr, nullptr, nullptr)) ||
-        (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, GCM_IV_LEN, nullptr)) ||
-        (1 != EVP_EncryptInit_ex(ctx, nullptr, nullptr, key_.data(), p_in_iv))) {
-        EVP_CIPHER_CTX_free(ctx);
-        error_msg_ = "Create and initialize cipher context failed.";
+    // reset the iv, the key schedule is kept in the context
+    if (1 != EVP_EncryptInit_ex(enc_ctx_, nullptr, nullptr, nullptr, p_in_iv)) {
+        error_msg_ = "Initialize cipher context failed.";
         return false;
     }
 
     // add AAD data
     if (p_in_associatedData && in_associated_data_len > 0) {
-        if (1 != EVP_EncryptUpdate(ctx, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
-            EVP_CIPHER_CTX_free(ctx);
+        if (1 != EVP_EncryptUpdate(enc_ctx_, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
             error_msg_ = "Try to add AAD data failed.";
             return false;
         }
     }
 
-    // encrypt plain data
-    out_cipherdata_len = 0;
-    out_tag_len = GCM_TAG_LEN;
-    p_out_tag = new uint8_t[GCM_TAG_LEN];
-    p_out_cipherdata = new uint8_t[in_plaindata_len + EVP_MAX_BLOCK_LENGTH];
-    if ((1 != EVP_EncryptUpdate(ctx, p_out_cipherdata, &out_cipherdata_len, p_in_plaindata, in_plaindata_len)) ||
-        (1 != EVP_EncryptFinal_ex(ctx, p_out_cipherdata + out_cipherdata_len, &len)) ||
-        (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, GCM_TAG_LEN, p_out_tag)) ) {
-        delete []p_out_tag;
-        delete []p_out_cipherdata;
-        p_out_tag = nullptr;
-        p_out_cipherdata = nullptr;
-        EVP_CIPHER_CTX_free(ctx);
+    // encrypt plain data, GCM is a stream mode so the cipher is as long as the plain data
+    if ((1 != EVP_EncryptUpdate(enc_ctx_, p_out_cipherdata, &out_len, p_in_plaindata, in_plaindata_len)) ||
+        (1 != EVP_EncryptFinal_ex(enc_ctx_, p_out_cipherdata + out_len, &len)) ||
+        (out_len + len != in_plaindata_len) ||
+        (1 != EVP_CIPHER_CTX_ctrl(enc_ctx_, EVP_CTRL_GCM_GET_TAG, GCM_TAG_LEN, p_out_tag)) ) {
         error_msg_ = "Encrypt data failed.";
         return false;
     }
 
-    // return ciphertext data length
-    out_cipherdata_len += len;
-    EVP_CIPHER_CTX_free(ctx);
-
     return true;
 }
 
@@ -134,10 +213,39 @@ bool GCM::Decrypt(const uint8_t* p_in_cipherdata, int in_cipherdata_len,
                 const uint8_t* p_in_associatedData, int in_associated_data_len,
                 const uint8_t* p_in_tag, int in_tag_len,
                 uint8_t* &p_out_plaindata, int &out_plaindata_len)
+{
+    uint8_t* p_plain = nullptr;
+
+    error_msg_ = "";
+
+    if (!p_in_cipherdata || in_cipherdata_len <= 0) {
+        error_msg_ = "Parameter p_in_cipherdata cannot be null or empty.";
+        return false;
+    }
+
+    // decrypt ciphertext data
+    p_plain = new uint8_t[in_cipherdata_len];
+    if (!Decrypt(p_in_cipherdata, in_cipherdata_len, p_in_iv, in_iv_len,
+                 p_in_associatedData, in_associated_data_len, p_in_tag, in_tag_len, p_plain)) {
+        delete []p_plain;
+        return false;
+    }
+
+    // return decrypted data length
+    p_out_plaindata = p_plain;
+    out_plaindata_len = in_cipherdata_len;
+
+    return true;
+}
+
+bool GCM::Decrypt(const uint8_t* p_in_cipherdata, int in_cipherdata_len,
+                 const uint8_t* p_in_iv, int in_iv_len,
+                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                 const uint8_t* p_in_tag, int in_tag_len,
+                 uint8_t* p_out_plaindata)
 {
     int len = 0;
-    const EVP_CIPHER *cipher = nullptr;
-    EVP_CIPHER_CTX *ctx = nullptr;
+    int out_len = 0;
 
     error_msg_ = "";
 
@@ -161,59 +269,36 @@ bool GCM::Decrypt(const uint8_t* p_in_cipherdata, int in_cipherdata_len,
         error_msg_ = "Parameter in_associated_data_len cannot be 0 or less 0 when p_in_associatedData is not null.";
         return false;
     }
-
-    // support AES-GCM with 128/192/256 bytes key
-    switch (key_.size()) {
-        case 16:
-            cipher = EVP_aes_128_gcm();
-            break;
-        case 24:
-            cipher = EVP_aes_192_gcm();
-            break;
-        case 32:
-            cipher = EVP_aes_256_gcm();
-            break;
-        default:
-            error_msg_ = "AES-GCM Key length is wrong!";
-            return false;
+    if (!p_out_plaindata) {
+        error_msg_ = "Parameter p_out_plaindata cannot be null.";
+        return false;
     }
 
-    // create and initialize cipher context
-    if (!(ctx = EVP_CIPHER_CTX_new()) ||
-        (1 != EVP_DecryptInit_ex(ctx, cipher, nullptr, nullptr, nullptr)) ||
-        (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, in_iv_len, nullptr)) ||
-        (1 != EVP_DecryptInit_ex(ctx, nullptr, nullptr, key_.data(), p_in_iv))) {
-        EVP_CIPHER_CTX_free(ctx);
-        error_msg_ = "Create and initialize cipher context failed.";
+    // reset the iv, the key schedule is kept in the context
+    if (1 != EVP_DecryptInit_ex(dec_ctx_, nullptr, nullptr, nullptr, p_in_iv)) {
+        error_msg_ = "Initialize cipher context failed.";
         return false;
     }
 
     // add AAD data
     if (p_in_associatedData && in_associated_data_len > 0) {
-        if (1 != EVP_DecryptUpdate(ctx, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
-            EVP_CIPHER_CTX_free(ctx);
+        if (1 != EVP_DecryptUpdate(dec_ctx_, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
             error_msg_ = "Try to add AAD data failed.";
             return false;
         }
     }
     
     // decrypt ciphertext data
-    out_plaindata_len = 0;
-    p_out_plaindata = new uint8_t[in_cipherdata_len];
-    if ((1 != EVP_DecryptUpdate(ctx, p_out_plaindata, &out_plaindata_len, p_in_cipherdata, in_cipherdata_len)) ||
-        (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, in_tag_len, (void*)p_in_tag)) ||
-        (1 != EVP_DecryptFinal_ex(ctx, p_out_plaindata + out_plaindata_len, &len)) ) {
-        delete []p_out_plaindata;
-        p_out_plaindata = nullptr;
-        EVP_CIPHER_CTX_free(ctx);
+    if ((1 != EVP_DecryptUpdate(dec_ctx_, p_out_plaindata, &out_len, p_in_cipherdata, in_cipherdata_len)) ||
+        (1 != EVP_CIPHER_CTX_ctrl(dec_ctx_, EVP_CTRL_GCM_SET_TAG, in_tag_len, (void*)p_in_tag)) ||
+        (1 != EVP_DecryptFinal_ex(dec_ctx_, p_out_plaindata + out_len, &len)) ||
+        (out_len + len != in_cipherdata_len) ) {
+        // do not leave unauthenticated plain data to the caller
+        crypto_memzero(p_out_plaindata, in_cipherdata_len);
         error_msg_ = "Decrypt data failed.";
         return false;
     }
 
-    // return decrypted data length
-    out_plaindata_len += len;
-    EVP_CIPHER_CTX_free(ctx);
-
     return true;
 }
 
@@ -221,42 +306,47 @@ bool GCM::EncryptPack(const uint8_t* p_in_plaindata, int in_plaindata_len,
                  const uint8_t* p_in_associatedData, int in_associated_data_len,
                  uint8_t* &p_out_cipherpack, int &out_cipherpack_len)
 {
-    int tag_len = 0;
-    int cipher_len = 0;
+    uint8_t* p_pack = nullptr;
+    uint32_t pack_len = 0;
     uint8_t* p_tag = nullptr;
     uint8_t* p_cipher = nullptr;
-    uint8_t iv[GCM_IV_LEN] = {0};
-    std::string out_cypher;
+    uint8_t* p_iv = nullptr;
     Formatter fm;
 
     error_msg_ = "";
 
-    // use a random number as the iv
-    RAND_bytes(iv, GCM_IV_LEN);
-
-    // encrypt plain data
-    if (!Encrypt(p_in_plaindata, in_plaindata_len, iv, GCM_IV_LEN, p_in_associatedData, 
-            in_associated_data_len, p_tag, tag_len, p_cipher, cipher_len)) {
+    if (!p_in_plaindata || in_plaindata_len <= 0) {
+        error_msg_ = "Parameter p_in_plaindata cannot be null or empty.";
         return false;
     }
 
-    // construct GCM cypher
-    if (!fm.ConstructAESGCMCypher(p_cipher, cipher_len, p_tag, tag_len, iv, GCM_IV_LEN, out_cypher)) {
-        delete []p_tag;
-        delete []p_cipher;
+    // construct GCM cypher in place: cipher, tag and iv are written straight into the pack
+    pack_len = Formatter::AESGCMCypherLength(in_plaindata_len, GCM_TAG_LEN, GCM_IV_LEN);
+    p_pack = new uint8_t[pack_len];
+    if (!fm.LayoutAESGCMCypher(p_pack, pack_len, in_plaindata_len, GCM_TAG_LEN, GCM_IV_LEN,
+                               p_cipher, p_tag, p_iv)) {
+        delete []p_pack;
         error_msg_ = "Construct ciphertext data package failed.";
         return false;
     }
 
+    // use a random number as the iv
+    if (1 != RAND_bytes(p_iv, GCM_IV_LEN)) {
+        delete []p_pack;
+        error_msg_ = "Generate random iv failed.";
+        return false;
+    }
+
+    // encrypt plain data
+    if (!Encrypt(p_in_plaindata, in_plaindata_len, p_iv, GCM_IV_LEN, p_in_associatedData,
+            in_associated_data_len, p_tag, p_cipher)) {
+        delete []p_pack;
+        return false;
+    }
+
     // return result
-    p_out_cipherpack = new uint8_t[out_cypher.length()];
-    memcpy(p_out_cipherpack, out_cypher.c_str(), out_cypher.length());
-    out_cipherpack_len = out_cypher.length();
-
-    delete []p_tag;
-    delete []p_cipher;
-    p_tag = nullptr;
-    p_cipher = nullptr;
+    p_out_cipherpack = p_pack;
+    out_cipherpack_len = pack_len;
     return true;
 }
 
@@ -264,8 +354,6 @@ bool GCM::DecryptPack(const uint8_t* p_in_cipherpack, int in_cipherpack_len,
                  const uint8_t* p_in_associatedData, int in_associated_data_len,
                  uint8_t* &p_out_plaindata, int &out_plaindata_len)
 {
-    int len = 0;
-    int out_len = 0;
     const uint8_t *p_encrypted_data = nullptr;
     uint32_t encrypted_data_len = -1;
     const uint8_t *p_tag = nullptr;
@@ -299,20 +387,43 @@ bool GCM::EncryptPack(const std::string &in_plaindata,
                     const std::string &in_associatedData,
                     std::string &out_cipherpack)
 {
-    int out_cipherpack_len = 0;
-    uint8_t* p_out_cipherpack = nullptr;
+    uint32_t pack_len = 0;
+    uint8_t* p_tag = nullptr;
+    uint8_t* p_cipher = nullptr;
+    uint8_t* p_iv = nullptr;
+    Formatter fm;
 
     error_msg_ = "";
 
-    if (!EncryptPack((uint8_t*)in_plaindata.c_str(), in_plaindata.length(),
-                (uint8_t*)in_associatedData.c_str(), in_associatedData.length(),
-                p_out_cipherpack, out_cipherpack_len)) {
+    if (in_plaindata.empty()) {
+        error_msg_ = "Parameter p_in_plaindata cannot be null or empty.";
+        return false;
+    }
+
+    // construct GCM cypher in place of the output string
+    pack_len = Formatter::AESGCMCypherLength(in_plaindata.length(), GCM_TAG_LEN, GCM_IV_LEN);
+    out_cipherpack.resize(pack_len);
+    if (!fm.LayoutAESGCMCypher((uint8_t*)&out_cipherpack[0], pack_len, in_plaindata.length(), GCM_TAG_LEN, GCM_IV_LEN,
+                               p_cipher, p_tag, p_iv)) {
+        out_cipherpack.clear();
+        error_msg_ = "Construct ciphertext data package failed.";
+        return false;
+    }
+
+    // use a random number as the iv
+    if (1 != RAND_bytes(p_iv, GCM_IV_LEN)) {
+        out_cipherpack.clear();
+        error_msg_ = "Generate random iv failed.";
+        return false;
+    }
+
+    // encrypt plain data
+    if (!Encrypt((const uint8_t*)in_plaindata.c_str(), in_plaindata.length(), p_iv, GCM_IV_LEN,
+                 (const uint8_t*)in_associatedData.c_str(), in_associatedData.length(), p_tag, p_cipher)) {
+        out_cipherpack.clear();
         return false;
     }
 
-    out_cipherpack.assign((char*)p_out_cipherpack, out_cipherpack_len);
-    delete []p_out_cipherpack;
-    p_out_cipherpack = nullptr;
     return true;
 }
 
@@ -320,20 +431,43 @@ bool GCM::DecryptPack(const std::string &in_cipherpack,
                      const std::string &in_associatedData,
                      std::string &out_plaindata)
 {
-    int out_plaindata_len = 0;
-    uint8_t* p_out_plaindata = nullptr;
+    const uint8_t *p_encrypted_data = nullptr;
+    uint32_t encrypted_data_len = -1;
+    const uint8_t *p_tag = nullptr;
+    uint32_t tag_len = -1;
+    const uint8_t *p_iv = nullptr;
+    uint32_t iv_len = -1;
+    Formatter fm;
 
     error_msg_ = "";
 
-    if (!DecryptPack((uint8_t*)in_cipherpack.c_str(), in_cipherpack.length(),
-                (uint8_t*)in_associatedData.c_str(), in_associatedData.length(),
-                p_out_plaindata, out_plaindata_len)) {
+    if (in_cipherpack.empty()) {
+        error_msg_ = "Parameter p_in_cipherpack cannot be null or empty.";
+        return false;
+    }
+
+    // parser GCM cypher
+    if (!fm.ParseAESGCMCypher(in_cipherpack,
+                              p_encrypted_data, encrypted_data_len,
+                              p_tag, tag_len,
+                              p_iv, iv_len)) {
+        error_msg_ = "Parameter p_in_cipherpack in not valid.";
+        return false;
+    }
+    if (encrypted_data_len == 0) {
+        error_msg_ = "Parameter p_in_cipherdata cannot be null or empty.";
+        return false;
+    }
+
+    // decrypt straight into the output string
+    out_plaindata.resize(encrypted_data_len);
+    if (!Decrypt(p_encrypted_data, encrypted_data_len, p_iv, iv_len,
+                 (const uint8_t*)in_associatedData.c_str(), in_associatedData.length(),
+                 p_tag, tag_len, (uint8_t*)&out_plaindata[0])) {
+        out_plaindata.clear();
         return false;
     }
 
-    out_plaindata.assign((char*)p_out_plaindata, out_plaindata_len);
-    delete []p_out_plaindata;
-    p_out_plaindata = nullptr;
     return true;
 }
 
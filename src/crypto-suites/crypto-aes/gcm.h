@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <openssl/evp.h>
 
 namespace safeheron{
 namespace aes{
@@ -30,6 +31,10 @@ public:
      */
     GCM(const std::string &key);
 
+    GCM(const GCM &gcm);
+
+    GCM &operator=(const GCM &gcm);
+
     /**
      * Destructor
      * 
@@ -87,6 +92,58 @@ public:
                  const uint8_t* p_in_tag, int in_tag_len,
                  uint8_t* &p_out_plaindata, int &out_plaindata_len);
 
+    /**
+     * Encrypt into caller-supplied buffers. The key schedule and cipher context of this instance are reused,
+     * only the IV is reset for each message.
+     *
+     * - plaindata: The content to encrypt.
+     * - iv: The iv data, must be 12 bytes length.
+     * - associatedData: Extra data associated with this message, which must also be provided during decryption.
+     * - tag: The generated authentication tag, the buffer must hold TAG_SIZE bytes.
+     * - cipherdata: The encrypted contents, the buffer must hold in_plaindata_len bytes.
+     *
+     * @param p_in_plaindata
+     * @param in_plaindata_len
+     * @param p_in_iv
+     * @param in_iv_len
+     * @param p_in_associatedData
+     * @param in_associated_data_len
+     * @param p_out_tag
+     * @param p_out_cipherdata
+     */
+    bool Encrypt(const uint8_t* p_in_plaindata, int in_plaindata_len,
+                 const uint8_t* p_in_iv, int in_iv_len,
+                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                 uint8_t* p_out_tag,
+                 uint8_t* p_out_cipherdata);
+
+    /**
+     * Decrypt into a caller-supplied buffer. The key schedule and cipher context of this instance are reused,
+     * only the IV is reset for each message.
+     *
+     * - cipherdata: The encrypted contents.
+     * - iv: The iv data, must be 12 bytes length.
+     * - associatedData: Extra data associated with this message, which must also be provided during decryption.
+     * - tag: The authentication tag, must be TAG_SIZE bytes length.
+     * - plaindata: The decrypted contents, the buffer must hold in_cipherdata_len bytes.
+     *
+     * @param p_in_cipherdata
+     * @param in_cipherdata_len
+     * @param p_in_iv
+     * @param in_iv_len
+     * @param p_in_associatedData
+     * @param in_associated_data_len
+     * @param p_in_tag
+     * @param in_tag_len
+     * @param p_out_plaindata
+     * @return
+     */
+    bool Decrypt(const uint8_t* p_in_cipherdata, int in_cipherdata_len,
+                 const uint8_t* p_in_iv, int in_iv_len,
+                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                 const uint8_t* p_in_tag, int in_tag_len,
+                 uint8_t* p_out_plaindata);
+
     /**
      * EncryptPack. IV will be generated randomly in this function.
      * 
@@ -161,9 +218,22 @@ public:
      */
     std::string GetErrorMessage() const { return error_msg_; }
 
+    // The length of the authentication tag, in bytes.
+    static const int TAG_SIZE = 16;
+
+    // The length of the iv, in bytes.
+    static const int IV_SIZE = 12;
+
 private:
+    // Create the cipher contexts and run the key schedule once for this instance.
+    void InitContexts();
+
+    void FreeContexts();
+
     std::vector<uint8_t> key_;
     std::string error_msg_;
+    EVP_CIPHER_CTX *enc_ctx_;
+    EVP_CIPHER_CTX *dec_ctx_;
 };
 
 
@@ -0,0 +1,958 @@
+#include "gcm_stream.h"
+#include "Formatter.h"
+#include "crypto-suites/exception/safeheron_exceptions.h"
+#include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/custom_memzero.h"
+#include "crypto-suites/common/MemoryWalker.h"
+#include "crypto-suites/common/MemoryWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <openssl/rand.h>
+#include <openssl/evp.h>
+#ifndef SAFEHERON_SGX_SDK
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using safeheron::exception::OpensslException;
+using safeheron::exception::BadAllocException;
+using safeheron::exception::LocatedException;
+using safeheron::memory::MemoryWalker;
+using safeheron::memory::MemoryWriter;
+
+// Length of the nonce prefix in the segmented format, the last 4 bytes of the iv are the segment index.
+#define GCM_NONCE_PREFIX_LEN    8
+
+// Length of the length fields which surround the cypher in the pack format.
+#define GCM_PACK_HEAD_LEN       (1 + 4)
+#define GCM_PACK_TAIL_LEN       (4 + GCMStream::TAG_SIZE + 4 + GCMStream::IV_SIZE)
+
+namespace safeheron{
+namespace aes{
+
+const int GCMStream::TAG_SIZE;
+const int GCMStream::IV_SIZE;
+const int GCMStream::SEGMENTED_HEADER_SIZE;
+const uint32_t GCMStream::DEFAULT_SEGMENT_SIZE;
+
+static uint64_t SegmentCount(uint64_t plain_len, uint32_t segment_size)
+{
+    return (plain_len + segment_size - 1) / segment_size;
+}
+
+static uint64_t SegmentedLength(uint64_t plain_len, uint32_t segment_size)
+{
+    return GCMStream::SEGMENTED_HEADER_SIZE + plain_len + SegmentCount(plain_len, segment_size) * GCMStream::TAG_SIZE;
+}
+
+static bool CheckAssociatedData(const uint8_t* p_in_associatedData, int in_associated_data_len, std::string &error_msg)
+{
+    if (!p_in_associatedData && in_associated_data_len > 0) {
+        error_msg = "Parameter p_in_associatedData cannot be null when in_associated_data_len > 0.";
+        return false;
+    }
+    if (in_associated_data_len < 0) {
+        error_msg = "Parameter in_associated_data_len cannot be less 0.";
+        return false;
+    }
+    return true;
+}
+
+GCMStream::GCMStream(const uint8_t *p_key, int key_len, uint32_t segment_size)
+        : segment_size_(segment_size), enc_ctx_(nullptr), dec_ctx_(nullptr), state_(State::Idle)
+{
+    ASSERT_THROW(p_key);
+    ASSERT_THROW(key_len == 16 || key_len == 24 || key_len == 32);
+    ASSERT_THROW(segment_size > 0 && segment_size <= (1u << 30));
+    key_.assign(p_key, p_key + key_len);
+    InitContexts();
+}
+
+GCMStream::GCMStream(const std::string &key, uint32_t segment_size)
+        : segment_size_(segment_size), enc_ctx_(nullptr), dec_ctx_(nullptr), state_(State::Idle)
+{
+    ASSERT_THROW(key.length() == 16 || key.length() == 24 || key.length() == 32);
+    ASSERT_THROW(segment_size > 0 && segment_size <= (1u << 30));
+    key_.assign(key.begin(), key.end());
+    InitContexts();
+}
+
+GCMStream::~GCMStream()
+{
+    FreeContexts();
+    // fill the buffer with 0 before release
+    crypto_memzero(key_.data(), key_.size());
+}
+
+void GCMStream::InitContexts()
+{
+    const EVP_CIPHER *cipher = nullptr;
+
+    // support AES-GCM with 128/192/256 bytes key
+    switch (key_.size()) {
+        case 16:
+            cipher = EVP_aes_128_gcm();
+            break;
+        case 24:
+            cipher = EVP_aes_192_gcm();
+            break;
+        case 32:
+            cipher = EVP_aes_256_gcm();
+            break;
+        default:
+            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "AES-GCM Key length is wrong.");
+    }
+
+    enc_ctx_ = EVP_CIPHER_CTX_new();
+    dec_ctx_ = EVP_CIPHER_CTX_new();
+    if (!enc_ctx_ || !dec_ctx_) {
+        FreeContexts();
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "EVP_CIPHER_CTX_new() failed!");
+    }
+    if ((1 != EVP_EncryptInit_ex(enc_ctx_, cipher, nullptr, nullptr, nullptr)) ||
+        (1 != EVP_CIPHER_CTX_ctrl(enc_ctx_, EVP_CTRL_GCM_SET_IVLEN, IV_SIZE, nullptr)) ||
+        (1 != EVP_EncryptInit_ex(enc_ctx_, nullptr, nullptr, key_.data(), nullptr)) ||
+        (1 != EVP_DecryptInit_ex(dec_ctx_, cipher, nullptr, nullptr, nullptr)) ||
+        (1 != EVP_CIPHER_CTX_ctrl(dec_ctx_, EVP_CTRL_GCM_SET_IVLEN, IV_SIZE, nullptr)) ||
+        (1 != EVP_DecryptInit_ex(dec_ctx_, nullptr, nullptr, key_.data(), nullptr))) {
+        FreeContexts();
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, -1, "Create and initialize cipher context failed.");
+    }
+}
+
+void GCMStream::FreeContexts()
+{
+    if (enc_ctx_) {
+        EVP_CIPHER_CTX_free(enc_ctx_);
+        enc_ctx_ = nullptr;
+    }
+    if (dec_ctx_) {
+        EVP_CIPHER_CTX_free(dec_ctx_);
+        dec_ctx_ = nullptr;
+    }
+}
+
+bool GCMStream::EncryptInit(const uint8_t* p_in_iv, int in_iv_len,
+                            const uint8_t* p_in_associatedData, int in_associated_data_len)
+{
+    int len = 0;
+
+    error_msg_ = "";
+    state_ = State::Idle;
+
+    if (!p_in_iv || in_iv_len != IV_SIZE) {
+        error_msg_ = "Parameter p_in_iv cannot be null and length must be 12 bytes.";
+        return false;
+    }
+    if (!CheckAssociatedData(p_in_associatedData, in_associated_data_len, error_msg_)) {
+        return false;
+    }
+
+    // reset the iv, the key schedule is kept in the context
+    if (1 != EVP_EncryptInit_ex(enc_ctx_, nullptr, nullptr, nullptr, p_in_iv)) {
+        error_msg_ = "Initialize cipher context failed.";
+        return false;
+    }
+
+    // add AAD data
+    if (p_in_associatedData && in_associated_data_len > 0) {
+        if (1 != EVP_EncryptUpdate(enc_ctx_, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
+            error_msg_ = "Try to add AAD data failed.";
+            return false;
+        }
+    }
+
+    state_ = State::Encrypting;
+    return true;
+}
+
+bool GCMStream::EncryptUpdate(const uint8_t* p_in_plaindata, int in_plaindata_len,
+                              uint8_t* p_out_cipherdata)
+{
+    int out_len = 0;
+
+    if (state_ != State::Encrypting) {
+        error_msg_ = "EncryptInit() must be called first.";
+        return false;
+    }
+    if (!p_in_plaindata || in_plaindata_len <= 0 || !p_out_cipherdata) {
+        error_msg_ = "Parameter p_in_plaindata and p_out_cipherdata cannot be null or empty.";
+        return false;
+    }
+
+    // GCM is a stream mode, the cipher is exactly as long as the plain data
+    if ((1 != EVP_EncryptUpdate(enc_ctx_, p_out_cipherdata, &out_len, p_in_plaindata, in_plaindata_len)) ||
+        (out_len != in_plaindata_len)) {
+        state_ = State::Idle;
+        error_msg_ = "Encrypt data failed.";
+        return false;
+    }
+
+    return true;
+}
+
+bool GCMStream::EncryptFinal(uint8_t* p_out_tag)
+{
+    int len = 0;
+    uint8_t dummy[EVP_MAX_BLOCK_LENGTH];
+
+    if (state_ != State::Encrypting) {
+        error_msg_ = "EncryptInit() must be called first.";
+        return false;
+    }
+    state_ = State::Idle;
+    if (!p_out_tag) {
+        error_msg_ = "Parameter p_out_tag cannot be null.";
+        return false;
+    }
+
+    if ((1 != EVP_EncryptFinal_ex(enc_ctx_, dummy, &len)) ||
+        (len != 0) ||
+        (1 != EVP_CIPHER_CTX_ctrl(enc_ctx_, EVP_CTRL_GCM_GET_TAG, TAG_SIZE, p_out_tag))) {
+        error_msg_ = "Encrypt data failed.";
+        return false;
+    }
+
+    return true;
+}
+
+bool GCMStream::DecryptInit(const uint8_t* p_in_iv, int in_iv_len,
+                            const uint8_t* p_in_associatedData, int in_associated_data_len)
+{
+    int len = 0;
+
+    error_msg_ = "";
+    state_ = State::Idle;
+
+    if (!p_in_iv || in_iv_len != IV_SIZE) {
+        error_msg_ = "Parameter p_in_iv cannot be null and length must be 12 bytes.";
+        return false;
+    }
+    if (!CheckAssociatedData(p_in_associatedData, in_associated_data_len, error_msg_)) {
+        return false;
+    }
+
+    // reset the iv, the key schedule is kept in the context
+    if (1 != EVP_DecryptInit_ex(dec_ctx_, nullptr, nullptr, nullptr, p_in_iv)) {
+        error_msg_ = "Initialize cipher context failed.";
+        return false;
+    }
+
+    // add AAD data
+    if (p_in_associatedData && in_associated_data_len > 0) {
+        if (1 != EVP_DecryptUpdate(dec_ctx_, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
+            error_msg_ = "Try to add AAD data failed.";
+            return false;
+        }
+    }
+
+    state_ = State::Decrypting;
+    return true;
+}
+
+bool GCMStream::DecryptUpdate(const uint8_t* p_in_cipherdata, int in_cipherdata_len,
+                              uint8_t* p_out_plaindata)
+{
+    int out_len = 0;
+
+    if (state_ != State::Decrypting) {
+        error_msg_ = "DecryptInit() must be called first.";
+        return false;
+    }
+    if (!p_in_cipherdata || in_cipherdata_len <= 0 || !p_out_plaindata) {
+        error_msg_ = "Parameter p_in_cipherdata and p_out_plaindata cannot be null or empty.";
+        return false;
+    }
+
+    if ((1 != EVP_DecryptUpdate(dec_ctx_, p_out_plaindata, &out_len, p_in_cipherdata, in_cipherdata_len)) ||
+        (out_len != in_cipherdata_len)) {
+        state_ = State::Idle;
+        error_msg_ = "Decrypt data failed.";
+        return false;
+    }
+
+    return true;
+}
+
+bool GCMStream::DecryptFinal(const uint8_t* p_in_tag, int in_tag_len)
+{
+    int len = 0;
+    uint8_t dummy[EVP_MAX_BLOCK_LENGTH];
+
+    if (state_ != State::Decrypting) {
+        error_msg_ = "DecryptInit() must be called first.";
+        return false;
+    }
+    state_ = State::Idle;
+    if (!p_in_tag || in_tag_len != TAG_SIZE) {
+        error_msg_ = "Parameter p_in_tag cannot be null or empty.";
+        return false;
+    }
+
+    if ((1 != EVP_CIPHER_CTX_ctrl(dec_ctx_, EVP_CTRL_GCM_SET_TAG, in_tag_len, (void*)p_in_tag)) ||
+        (1 != EVP_DecryptFinal_ex(dec_ctx_, dummy, &len)) ||
+        (len != 0)) {
+        error_msg_ = "Decrypt data failed.";
+        return false;
+    }
+
+    return true;
+}
+
+uint64_t GCMStream::CipherLength(Format format, uint64_t in_plaindata_len) const
+{
+    if (format == Format::Pack) {
+        return GCM_PACK_HEAD_LEN + in_plaindata_len + GCM_PACK_TAIL_LEN;
+    }
+    return SegmentedLength(in_plaindata_len, segment_size_);
+}
+
+bool GCMStream::ParseSegmentedHeader(const uint8_t* p_header,
+                                     uint32_t &segment_size, uint64_t &plain_len, const uint8_t* &p_nonce_prefix)
+{
+    uint8_t type = 0;
+    uint32_t plain_len_hi = 0;
+    uint32_t plain_len_lo = 0;
+    MemoryWalker walker(p_header, SEGMENTED_HEADER_SIZE);
+
+    if (!walker.move_byte(type) || type != (uint8_t)Format::Segmented ||
+        !walker.move_uint32(segment_size) ||
+        !walker.move_uint32(plain_len_hi) ||
+        !walker.move_uint32(plain_len_lo) ||
+        !walker.move_buf(p_nonce_prefix, GCM_NONCE_PREFIX_LEN)) {
+        error_msg_ = "Segmented stream header is not valid.";
+        return false;
+    }
+    plain_len = ((uint64_t)plain_len_hi << 32) | plain_len_lo;
+    if (segment_size == 0 || plain_len == 0 || SegmentCount(plain_len, segment_size) > 0xFFFFFFFFULL) {
+        error_msg_ = "Segmented stream header is not valid.";
+        return false;
+    }
+    return true;
+}
+
+bool GCMStream::SegmentIV(const uint8_t* p_nonce_prefix, uint64_t index, uint8_t* p_iv)
+{
+    // iv = nonce_prefix || I2OSP(index, 4)
+    if (index > 0xFFFFFFFFULL) {
+        error_msg_ = "Too many segments.";
+        return false;
+    }
+    memcpy(p_iv, p_nonce_prefix, GCM_NONCE_PREFIX_LEN);
+    MemoryWriter writer(p_iv + GCM_NONCE_PREFIX_LEN, 4);
+    return writer.write_uint32((uint32_t)index);
+}
+
+bool GCMStream::EncryptSegment(const uint8_t* p_header, const uint8_t* p_nonce_prefix, uint64_t index,
+                               const uint8_t* p_in_associatedData, int in_associated_data_len,
+                               const uint8_t* p_in, uint32_t in_len, uint8_t* p_out, uint8_t* p_out_tag)
+{
+    int len = 0;
+    uint8_t iv[IV_SIZE];
+
+    if (!SegmentIV(p_nonce_prefix, index, iv)) return false;
+    if (!EncryptInit(iv, IV_SIZE, p_header, SEGMENTED_HEADER_SIZE)) return false;
+    if (p_in_associatedData && in_associated_data_len > 0) {
+        if (1 != EVP_EncryptUpdate(enc_ctx_, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
+            state_ = State::Idle;
+            error_msg_ = "Try to add AAD data failed.";
+            return false;
+        }
+    }
+    return EncryptUpdate(p_in, in_len, p_out) && EncryptFinal(p_out_tag);
+}
+
+bool GCMStream::DecryptSegmentData(const uint8_t* p_header, const uint8_t* p_nonce_prefix, uint64_t index,
+                                   const uint8_t* p_in_associatedData, int in_associated_data_len,
+                                   const uint8_t* p_in, uint32_t in_len, const uint8_t* p_in_tag, uint8_t* p_out)
+{
+    int len = 0;
+    uint8_t iv[IV_SIZE];
+
+    if (!SegmentIV(p_nonce_prefix, index, iv)) return false;
+    if (!DecryptInit(iv, IV_SIZE, p_header, SEGMENTED_HEADER_SIZE)) return false;
+    if (p_in_associatedData && in_associated_data_len > 0) {
+        if (1 != EVP_DecryptUpdate(dec_ctx_, nullptr, &len, p_in_associatedData, in_associated_data_len)) {
+            state_ = State::Idle;
+            error_msg_ = "Try to add AAD data failed.";
+            return false;
+        }
+    }
+    if (!DecryptUpdate(p_in, in_len, p_out) || !DecryptFinal(p_in_tag, TAG_SIZE)) {
+        // do not leave unauthenticated plain data to the caller
+        crypto_memzero(p_out, in_len);
+        return false;
+    }
+    return true;
+}
+
+bool GCMStream::Encrypt(Format format,
+                        const uint8_t* p_in_plaindata, uint64_t in_plaindata_len,
+                        const uint8_t* p_in_associatedData, int in_associated_data_len,
+                        uint8_t* p_out_cipher, uint64_t out_cipher_len)
+{
+    error_msg_ = "";
+
+    if (!p_in_plaindata || in_plaindata_len == 0) {
+        error_msg_ = "Parameter p_in_plaindata cannot be null or empty.";
+        return false;
+    }
+    if (!p_out_cipher || out_cipher_len != CipherLength(format, in_plaindata_len)) {
+        error_msg_ = "Parameter p_out_cipher cannot be null and its length must be CipherLength().";
+        return false;
+    }
+
+    if (format == Format::Pack) {
+        uint8_t* p_cipher = nullptr;
+        uint8_t* p_tag = nullptr;
+        uint8_t* p_iv = nullptr;
+        Formatter fm;
+
+        if (out_cipher_len > 0xFFFFFFFFULL) {
+            error_msg_ = "Plain data is too long for the pack format.";
+            return false;
+        }
+        if (!fm.LayoutAESGCMCypher(p_out_cipher, (uint32_t)out_cipher_len, (uint32_t)in_plaindata_len, TAG_SIZE, IV_SIZE,
+                                   p_cipher, p_tag, p_iv)) {
+            error_msg_ = "Construct ciphertext data package failed.";
+            return false;
+        }
+        if (1 != RAND_bytes(p_iv, IV_SIZE)) {
+            error_msg_ = "Generate random iv failed.";
+            return false;
+        }
+        if (!EncryptInit(p_iv, IV_SIZE, p_in_associatedData, in_associated_data_len)) {
+            return false;
+        }
+        for (uint64_t offset = 0; offset < in_plaindata_len; offset += segment_size_) {
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size_, in_plaindata_len - offset);
+            if (!EncryptUpdate(p_in_plaindata + offset, chunk_len, p_cipher + offset)) {
+                return false;
+            }
+        }
+        return EncryptFinal(p_tag);
+    }
+
+    if (format == Format::Segmented) {
+        uint8_t* p_header = p_out_cipher;
+        uint8_t* p_nonce_prefix = p_header + SEGMENTED_HEADER_SIZE - GCM_NONCE_PREFIX_LEN;
+        uint64_t segment_count = SegmentCount(in_plaindata_len, segment_size_);
+        MemoryWriter writer(p_header, SEGMENTED_HEADER_SIZE);
+
+        if (segment_count > 0xFFFFFFFFULL) {
+            error_msg_ = "Too many segments.";
+            return false;
+        }
+        if (!writer.write_byte((uint8_t)Format::Segmented) ||
+            !writer.write_uint32(segment_size_) ||
+            !writer.write_uint32((uint32_t)(in_plaindata_len >> 32)) ||
+            !writer.write_uint32((uint32_t)in_plaindata_len)) {
+            error_msg_ = "Construct ciphertext header failed.";
+            return false;
+        }
+        if (1 != RAND_bytes(p_nonce_prefix, GCM_NONCE_PREFIX_LEN)) {
+            error_msg_ = "Generate random iv failed.";
+            return false;
+        }
+        uint8_t* p_out = p_out_cipher + SEGMENTED_HEADER_SIZE;
+        for (uint64_t i = 0; i < segment_count; i++) {
+            uint64_t offset = i * segment_size_;
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size_, in_plaindata_len - offset);
+            if (!EncryptSegment(p_header, p_nonce_prefix, i, p_in_associatedData, in_associated_data_len,
+                                p_in_plaindata + offset, chunk_len, p_out, p_out + chunk_len)) {
+                return false;
+            }
+            p_out += chunk_len + TAG_SIZE;
+        }
+        return true;
+    }
+
+    error_msg_ = "Unknown format.";
+    return false;
+}
+
+bool GCMStream::PlainLength(const uint8_t* p_in_cipher, uint64_t in_cipher_len, uint64_t &out_plaindata_len)
+{
+    error_msg_ = "";
+
+    if (!p_in_cipher || in_cipher_len == 0) {
+        error_msg_ = "Parameter p_in_cipher cannot be null or empty.";
+        return false;
+    }
+    if (p_in_cipher[0] == (uint8_t)Format::Pack) {
+        uint8_t type = 0;
+        uint32_t len = 0;
+        MemoryWalker walker(p_in_cipher, in_cipher_len < GCM_PACK_HEAD_LEN ? in_cipher_len : GCM_PACK_HEAD_LEN);
+        if (!walker.move_byte(type) || !walker.move_uint32(len)) {
+            error_msg_ = "Parameter p_in_cipher in not valid.";
+            return false;
+        }
+        out_plaindata_len = len;
+        return true;
+    }
+    if (p_in_cipher[0] == (uint8_t)Format::Segmented) {
+        uint32_t segment_size = 0;
+        const uint8_t* p_nonce_prefix = nullptr;
+        if (in_cipher_len < (uint64_t)SEGMENTED_HEADER_SIZE) {
+            error_msg_ = "Parameter p_in_cipher in not valid.";
+            return false;
+        }
+        return ParseSegmentedHeader(p_in_cipher, segment_size, out_plaindata_len, p_nonce_prefix);
+    }
+
+    error_msg_ = "Unknown format.";
+    return false;
+}
+
+bool GCMStream::Decrypt(const uint8_t* p_in_cipher, uint64_t in_cipher_len,
+                        const uint8_t* p_in_associatedData, int in_associated_data_len,
+                        uint8_t* p_out_plaindata, uint64_t &out_plaindata_len)
+{
+    uint64_t plain_len = 0;
+
+    if (!PlainLength(p_in_cipher, in_cipher_len, plain_len)) {
+        return false;
+    }
+    if (!p_out_plaindata || out_plaindata_len < plain_len) {
+        error_msg_ = "Parameter p_out_plaindata cannot be null and must hold the plain data.";
+        return false;
+    }
+
+    if (p_in_cipher[0] == (uint8_t)Format::Pack) {
+        const uint8_t *p_encrypted_data = nullptr;
+        uint32_t encrypted_data_len = 0;
+        const uint8_t *p_tag = nullptr;
+        uint32_t tag_len = 0;
+        const uint8_t *p_iv = nullptr;
+        uint32_t iv_len = 0;
+        Formatter fm;
+
+        if (in_cipher_len > 0xFFFFFFFFULL ||
+            !fm.ParseAESGCMCypher(p_in_cipher, (uint32_t)in_cipher_len,
+                                  p_encrypted_data, encrypted_data_len,
+                                  p_tag, tag_len,
+                                  p_iv, iv_len) ||
+            encrypted_data_len == 0) {
+            error_msg_ = "Parameter p_in_cipher in not valid.";
+            return false;
+        }
+        if (!DecryptInit(p_iv, iv_len, p_in_associatedData, in_associated_data_len)) {
+            return false;
+        }
+        bool ok = true;
+        for (uint64_t offset = 0; ok && offset < encrypted_data_len; offset += segment_size_) {
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size_, encrypted_data_len - offset);
+            ok = DecryptUpdate(p_encrypted_data + offset, chunk_len, p_out_plaindata + offset);
+        }
+        if (!ok || !DecryptFinal(p_tag, tag_len)) {
+            // do not leave unauthenticated plain data to the caller
+            crypto_memzero(p_out_plaindata, encrypted_data_len);
+            return false;
+        }
+        out_plaindata_len = encrypted_data_len;
+        return true;
+    }
+
+    // Segmented
+    uint32_t segment_size = 0;
+    const uint8_t* p_nonce_prefix = nullptr;
+    if (!ParseSegmentedHeader(p_in_cipher, segment_size, plain_len, p_nonce_prefix)) {
+        return false;
+    }
+    if (in_cipher_len != SegmentedLength(plain_len, segment_size)) {
+        error_msg_ = "Parameter p_in_cipher in not valid.";
+        return false;
+    }
+    const uint8_t* p_in = p_in_cipher + SEGMENTED_HEADER_SIZE;
+    uint64_t segment_count = SegmentCount(plain_len, segment_size);
+    for (uint64_t i = 0; i < segment_count; i++) {
+        uint64_t offset = i * segment_size;
+        uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size, plain_len - offset);
+        if (!DecryptSegmentData(p_in_cipher, p_nonce_prefix, i, p_in_associatedData, in_associated_data_len,
+                                p_in, chunk_len, p_in + chunk_len, p_out_plaindata + offset)) {
+            crypto_memzero(p_out_plaindata, offset);
+            return false;
+        }
+        p_in += chunk_len + TAG_SIZE;
+    }
+    out_plaindata_len = plain_len;
+    return true;
+}
+
+bool GCMStream::DecryptSegment(const uint8_t* p_in_cipher, uint64_t in_cipher_len,
+                               const uint8_t* p_in_associatedData, int in_associated_data_len,
+                               uint64_t index,
+                               uint8_t* p_out_plaindata, uint32_t &out_plaindata_len)
+{
+    uint32_t segment_size = 0;
+    uint64_t plain_len = 0;
+    const uint8_t* p_nonce_prefix = nullptr;
+
+    error_msg_ = "";
+
+    if (!p_in_cipher || in_cipher_len < (uint64_t)SEGMENTED_HEADER_SIZE || !p_out_plaindata) {
+        error_msg_ = "Parameter p_in_cipher and p_out_plaindata cannot be null or empty.";
+        return false;
+    }
+    if (!ParseSegmentedHeader(p_in_cipher, segment_size, plain_len, p_nonce_prefix)) {
+        return false;
+    }
+    if (in_cipher_len != SegmentedLength(plain_len, segment_size)) {
+        error_msg_ = "Parameter p_in_cipher in not valid.";
+        return false;
+    }
+    if (index >= SegmentCount(plain_len, segment_size)) {
+        error_msg_ = "Segment index is out of range.";
+        return false;
+    }
+
+    uint64_t offset = index * segment_size;
+    uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size, plain_len - offset);
+    // segment_size comes from the untrusted header, the segment must fit in the caller's buffer.
+    if (chunk_len > out_plaindata_len) {
+        error_msg_ = "Parameter out_plaindata_len is too small.";
+        return false;
+    }
+    const uint8_t* p_in = p_in_cipher + SEGMENTED_HEADER_SIZE + index * ((uint64_t)segment_size + TAG_SIZE);
+    if (!DecryptSegmentData(p_in_cipher, p_nonce_prefix, index, p_in_associatedData, in_associated_data_len,
+                            p_in, chunk_len, p_in + chunk_len, p_out_plaindata)) {
+        return false;
+    }
+    out_plaindata_len = chunk_len;
+    return true;
+}
+
+#ifndef SAFEHERON_SGX_SDK
+
+static bool ReadFull(int fd, uint8_t* p_buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t n = read(fd, p_buf, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p_buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool PReadFull(int fd, uint8_t* p_buf, size_t len, uint64_t offset)
+{
+    while (len > 0) {
+        ssize_t n = pread(fd, p_buf, len, (off_t)offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p_buf += n;
+        len -= n;
+        offset += n;
+    }
+    return true;
+}
+
+static bool WriteFull(int fd, const uint8_t* p_buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t n = write(fd, p_buf, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p_buf += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool FdSize(int fd, uint64_t &size)
+{
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0) return false;
+    size = (uint64_t)st.st_size;
+    return true;
+}
+
+bool GCMStream::EncryptFd(Format format, int in_fd, uint64_t in_plaindata_len,
+                          const uint8_t* p_in_associatedData, int in_associated_data_len,
+                          int out_fd)
+{
+    bool ok = true;
+    std::vector<uint8_t> plain(segment_size_);
+    std::vector<uint8_t> cipher(segment_size_ + TAG_SIZE);
+
+    error_msg_ = "";
+
+    if (in_fd < 0 || out_fd < 0 || in_plaindata_len == 0) {
+        error_msg_ = "Parameter in_fd and out_fd must be valid and in_plaindata_len cannot be 0.";
+        return false;
+    }
+
+    if (format == Format::Pack) {
+        uint8_t head[GCM_PACK_HEAD_LEN];
+        uint8_t tail[GCM_PACK_TAIL_LEN];
+        uint8_t tag[TAG_SIZE];
+        uint8_t iv[IV_SIZE];
+        MemoryWriter head_writer(head, sizeof(head));
+        MemoryWriter tail_writer(tail, sizeof(tail));
+
+        if (CipherLength(format, in_plaindata_len) > 0xFFFFFFFFULL) {
+            error_msg_ = "Plain data is too long for the pack format.";
+            return false;
+        }
+        // 01 + Len0 + cypher + Len1 + tag + Len2 + iv, the iv is written at the end but used from the beginning
+        if (1 != RAND_bytes(iv, IV_SIZE)) {
+            error_msg_ = "Generate random iv failed.";
+            return false;
+        }
+        ok = head_writer.write_byte((uint8_t)Format::Pack) && head_writer.write_uint32((uint32_t)in_plaindata_len);
+        if (!ok || !WriteFull(out_fd, head, sizeof(head))) {
+            error_msg_ = "Write to out_fd failed.";
+            return false;
+        }
+        if (!EncryptInit(iv, IV_SIZE, p_in_associatedData, in_associated_data_len)) {
+            return false;
+        }
+        for (uint64_t offset = 0; ok && offset < in_plaindata_len; offset += segment_size_) {
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size_, in_plaindata_len - offset);
+            if (!ReadFull(in_fd, plain.data(), chunk_len)) {
+                state_ = State::Idle;
+                error_msg_ = "Read from in_fd failed.";
+                ok = false;
+                break;
+            }
+            ok = EncryptUpdate(plain.data(), chunk_len, cipher.data());
+            if (ok && !WriteFull(out_fd, cipher.data(), chunk_len)) {
+                state_ = State::Idle;
+                error_msg_ = "Write to out_fd failed.";
+                ok = false;
+            }
+        }
+        ok = ok && EncryptFinal(tag);
+        if (ok) {
+            ok = tail_writer.write_uint32(TAG_SIZE) && tail_writer.write_buf(tag, TAG_SIZE) &&
+                 tail_writer.write_uint32(IV_SIZE) && tail_writer.write_buf(iv, IV_SIZE);
+            if (!ok || !WriteFull(out_fd, tail, sizeof(tail))) {
+                error_msg_ = "Write to out_fd failed.";
+                ok = false;
+            }
+        }
+        crypto_memzero(plain.data(), plain.size());
+        return ok;
+    }
+
+    if (format == Format::Segmented) {
+        uint8_t header[SEGMENTED_HEADER_SIZE];
+        uint8_t* p_nonce_prefix = header + SEGMENTED_HEADER_SIZE - GCM_NONCE_PREFIX_LEN;
+        uint64_t segment_count = SegmentCount(in_plaindata_len, segment_size_);
+        MemoryWriter writer(header, SEGMENTED_HEADER_SIZE);
+
+        if (segment_count > 0xFFFFFFFFULL) {
+            error_msg_ = "Too many segments.";
+            return false;
+        }
+        ok = writer.write_byte((uint8_t)Format::Segmented) &&
+             writer.write_uint32(segment_size_) &&
+             writer.write_uint32((uint32_t)(in_plaindata_len >> 32)) &&
+             writer.write_uint32((uint32_t)in_plaindata_len);
+        if (!ok || 1 != RAND_bytes(p_nonce_prefix, GCM_NONCE_PREFIX_LEN)) {
+            error_msg_ = "Construct ciphertext header failed.";
+            return false;
+        }
+        if (!WriteFull(out_fd, header, sizeof(header))) {
+            error_msg_ = "Write to out_fd failed.";
+            return false;
+        }
+        for (uint64_t i = 0; ok && i < segment_count; i++) {
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size_, in_plaindata_len - i * segment_size_);
+            if (!ReadFull(in_fd, plain.data(), chunk_len)) {
+                error_msg_ = "Read from in_fd failed.";
+                ok = false;
+                break;
+            }
+            ok = EncryptSegment(header, p_nonce_prefix, i, p_in_associatedData, in_associated_data_len,
+                                plain.data(), chunk_len, cipher.data(), cipher.data() + chunk_len);
+            if (ok && !WriteFull(out_fd, cipher.data(), chunk_len + TAG_SIZE)) {
+                error_msg_ = "Write to out_fd failed.";
+                ok = false;
+            }
+        }
+        crypto_memzero(plain.data(), plain.size());
+        return ok;
+    }
+
+    error_msg_ = "Unknown format.";
+    return false;
+}
+
+bool GCMStream::DecryptFd(int in_fd,
+                          const uint8_t* p_in_associatedData, int in_associated_data_len,
+                          int out_fd)
+{
+    bool ok = true;
+    uint64_t file_size = 0;
+    uint8_t type = 0;
+
+    error_msg_ = "";
+
+    if (in_fd < 0 || out_fd < 0) {
+        error_msg_ = "Parameter in_fd and out_fd must be valid.";
+        return false;
+    }
+    if (!FdSize(in_fd, file_size) || file_size == 0 || !PReadFull(in_fd, &type, 1, 0)) {
+        error_msg_ = "Read from in_fd failed.";
+        return false;
+    }
+
+    if (type == (uint8_t)Format::Pack) {
+        uint8_t head[GCM_PACK_HEAD_LEN];
+        uint8_t tail[GCM_PACK_TAIL_LEN];
+        uint32_t encrypted_data_len = 0;
+        uint32_t tag_len = 0;
+        uint32_t iv_len = 0;
+        const uint8_t* p_tag = nullptr;
+        const uint8_t* p_iv = nullptr;
+
+        if (file_size < GCM_PACK_HEAD_LEN + GCM_PACK_TAIL_LEN || !PReadFull(in_fd, head, sizeof(head), 0)) {
+            error_msg_ = "Parameter in_fd in not valid.";
+            return false;
+        }
+        MemoryWalker head_walker(head, sizeof(head));
+        ok = head_walker.move_byte(type) && head_walker.move_uint32(encrypted_data_len) &&
+             encrypted_data_len > 0 &&
+             file_size == CipherLength(Format::Pack, encrypted_data_len) &&
+             PReadFull(in_fd, tail, sizeof(tail), GCM_PACK_HEAD_LEN + (uint64_t)encrypted_data_len);
+        MemoryWalker tail_walker(tail, sizeof(tail));
+        ok = ok && tail_walker.move_uint32(tag_len) && tail_walker.move_buf(p_tag, tag_len) &&
+             tail_walker.move_uint32(iv_len) && tail_walker.move_buf(p_iv, iv_len);
+        if (!ok) {
+            error_msg_ = "Parameter in_fd in not valid.";
+            return false;
+        }
+        if (!DecryptInit(p_iv, iv_len, p_in_associatedData, in_associated_data_len)) {
+            return false;
+        }
+
+        std::vector<uint8_t> cipher(segment_size_);
+        std::vector<uint8_t> plain(segment_size_);
+        for (uint64_t offset = 0; ok && offset < encrypted_data_len; offset += segment_size_) {
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size_, encrypted_data_len - offset);
+            if (!PReadFull(in_fd, cipher.data(), chunk_len, GCM_PACK_HEAD_LEN + offset)) {
+                state_ = State::Idle;
+                error_msg_ = "Read from in_fd failed.";
+                ok = false;
+                break;
+            }
+            ok = DecryptUpdate(cipher.data(), chunk_len, plain.data());
+            if (ok && !WriteFull(out_fd, plain.data(), chunk_len)) {
+                state_ = State::Idle;
+                error_msg_ = "Write to out_fd failed.";
+                ok = false;
+            }
+        }
+        ok = ok && DecryptFinal(p_tag, tag_len);
+        crypto_memzero(plain.data(), plain.size());
+        return ok;
+    }
+
+    if (type == (uint8_t)Format::Segmented) {
+        uint8_t header[SEGMENTED_HEADER_SIZE];
+        uint32_t segment_size = 0;
+        uint64_t plain_len = 0;
+        const uint8_t* p_nonce_prefix = nullptr;
+
+        if (file_size < (uint64_t)SEGMENTED_HEADER_SIZE || !PReadFull(in_fd, header, sizeof(header), 0)) {
+            error_msg_ = "Parameter in_fd in not valid.";
+            return false;
+        }
+        if (!ParseSegmentedHeader(header, segment_size, plain_len, p_nonce_prefix)) {
+            return false;
+        }
+        if (file_size != SegmentedLength(plain_len, segment_size) || segment_size > (1u << 30)) {
+            error_msg_ = "Parameter in_fd in not valid.";
+            return false;
+        }
+
+        std::vector<uint8_t> cipher((size_t)segment_size + TAG_SIZE);
+        std::vector<uint8_t> plain(segment_size);
+        uint64_t segment_count = SegmentCount(plain_len, segment_size);
+        uint64_t in_offset = SEGMENTED_HEADER_SIZE;
+        for (uint64_t i = 0; ok && i < segment_count; i++) {
+            uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size, plain_len - i * segment_size);
+            if (!PReadFull(in_fd, cipher.data(), chunk_len + TAG_SIZE, in_offset)) {
+                error_msg_ = "Read from in_fd failed.";
+                ok = false;
+                break;
+            }
+            // only authenticated segments reach out_fd
+            ok = DecryptSegmentData(header, p_nonce_prefix, i, p_in_associatedData, in_associated_data_len,
+                                    cipher.data(), chunk_len, cipher.data() + chunk_len, plain.data());
+            if (ok && !WriteFull(out_fd, plain.data(), chunk_len)) {
+                error_msg_ = "Write to out_fd failed.";
+                ok = false;
+            }
+            in_offset += chunk_len + TAG_SIZE;
+        }
+        crypto_memzero(plain.data(), plain.size());
+        return ok;
+    }
+
+    error_msg_ = "Unknown format.";
+    return false;
+}
+
+bool GCMStream::DecryptSegmentFd(int in_fd,
+                                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                                 uint64_t index,
+                                 uint8_t* p_out_plaindata, uint32_t &out_plaindata_len)
+{
+    uint64_t file_size = 0;
+    uint8_t header[SEGMENTED_HEADER_SIZE];
+    uint32_t segment_size = 0;
+    uint64_t plain_len = 0;
+    const uint8_t* p_nonce_prefix = nullptr;
+
+    error_msg_ = "";
+
+    if (in_fd < 0 || !p_out_plaindata) {
+        error_msg_ = "Parameter in_fd and p_out_plaindata must be valid.";
+        return false;
+    }
+    if (!FdSize(in_fd, file_size) || file_size < (uint64_t)SEGMENTED_HEADER_SIZE ||
+        !PReadFull(in_fd, header, sizeof(header), 0)) {
+        error_msg_ = "Read from in_fd failed.";
+        return false;
+    }
+    if (!ParseSegmentedHeader(header, segment_size, plain_len, p_nonce_prefix)) {
+        return false;
+    }
+    if (file_size != SegmentedLength(plain_len, segment_size) || segment_size > (1u << 30)) {
+        error_msg_ = "Parameter in_fd in not valid.";
+        return false;
+    }
+    if (index >= SegmentCount(plain_len, segment_size)) {
+        error_msg_ = "Segment index is out of range.";
+        return false;
+    }
+
+    uint32_t chunk_len = (uint32_t)std::min<uint64_t>(segment_size, plain_len - index * segment_size);
+    if (chunk_len > out_plaindata_len) {
+        error_msg_ = "Parameter out_plaindata_len is too small.";
+        return false;
+    }
+    uint64_t in_offset = SEGMENTED_HEADER_SIZE + index * ((uint64_t)segment_size + TAG_SIZE);
+    std::vector<uint8_t> cipher((size_t)chunk_len + TAG_SIZE);
+    if (!PReadFull(in_fd, cipher.data(), cipher.size(), in_offset)) {
+        error_msg_ = "Read from in_fd failed.";
+        return false;
+    }
+    if (!DecryptSegmentData(header, p_nonce_prefix, index, p_in_associatedData, in_associated_data_len,
+                            cipher.data(), chunk_len, cipher.data() + chunk_len, p_out_plaindata)) {
+        return false;
+    }
+    out_plaindata_len = chunk_len;
+    return true;
+}
+
+#endif
+
+}   //aes
+}   //safeheron
@@ -0,0 +1,245 @@
+#ifndef SAFEHERON_CRYPTO_GCM_STREAM_H
+#define SAFEHERON_CRYPTO_GCM_STREAM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <openssl/evp.h>
+
+namespace safeheron{
+namespace aes{
+
+/**
+ * Incremental AES-GCM for payloads too large to hold in memory.
+ *
+ * Two output formats are supported:
+ * - Pack: the same format as GCM::EncryptPack, one GCM message over the whole payload:
+ *     01 + Len(4 bytes) + cypher + Len(4 bytes) + tag + Len(4 bytes) + iv
+ * - Segmented: the payload is cut into fixed-size segments, each one is an independent GCM message,
+ *   so that any segment can be decrypted and authenticated on its own:
+ *     03 + SegmentSize(4 bytes) + PlainLen(8 bytes) + NoncePrefix(8 bytes)
+ *        + cypher_0 + tag_0 + cypher_1 + tag_1 + ... + cypher_{n-1} + tag_{n-1}
+ *   The iv of segment i is NoncePrefix + i (4 bytes, big endian), and the associated data of every segment
+ *   is the header followed by the associated data of the caller, so that segments can not be reordered,
+ *   truncated or moved to another stream.
+ *
+ * The memory footprint of every function is bounded by one segment, whatever the payload size. The memory
+ * interfaces work on any buffers, including memory-mapped files.
+ */
+class GCMStream{
+public:
+    enum class Format : uint8_t {
+        Pack = 0x01,
+        Segmented = 0x03
+    };
+
+    // The length of the authentication tag, in bytes.
+    static const int TAG_SIZE = 16;
+
+    // The length of the iv, in bytes.
+    static const int IV_SIZE = 12;
+
+    // The length of the header of the segmented format, in bytes.
+    static const int SEGMENTED_HEADER_SIZE = 1 + 4 + 8 + 8;
+
+    // The default segment (chunk) size, in bytes.
+    static const uint32_t DEFAULT_SEGMENT_SIZE = 64 * 1024;
+
+    /**
+     * Constructor
+     * @param p_key: pointer to the secret key to use for this instance.
+     * @param key_len: length of the secret key, only 16, 24, or 32 bytes (128, 192, or 256 bits)
+     * @param segment_size: size of the chunks processed at once, and the segment size of the segmented format.
+     */
+    GCMStream(const uint8_t *p_key, int key_len, uint32_t segment_size = DEFAULT_SEGMENT_SIZE);
+
+    /**
+     * Constructor
+     * @param key: The secret key to use for this instance, length of which should only be 16, 24, or 32 bytes (128, 192, or 256 bits)
+     * @param segment_size: size of the chunks processed at once, and the segment size of the segmented format.
+     */
+    GCMStream(const std::string &key, uint32_t segment_size = DEFAULT_SEGMENT_SIZE);
+
+    GCMStream(const GCMStream &) = delete;
+
+    GCMStream &operator=(const GCMStream &) = delete;
+
+    ~GCMStream();
+
+    /**
+     * Start encrypting one GCM message.
+     *
+     * @param p_in_iv: The iv data, must be 12 bytes length.
+     * @param in_iv_len
+     * @param p_in_associatedData: Extra data associated with this message, can be null.
+     * @param in_associated_data_len
+     */
+    bool EncryptInit(const uint8_t* p_in_iv, int in_iv_len,
+                     const uint8_t* p_in_associatedData, int in_associated_data_len);
+
+    /**
+     * Encrypt the next chunk of the message. p_out_cipherdata must hold in_plaindata_len bytes.
+     */
+    bool EncryptUpdate(const uint8_t* p_in_plaindata, int in_plaindata_len,
+                       uint8_t* p_out_cipherdata);
+
+    /**
+     * Finish the message and output the authentication tag, p_out_tag must hold TAG_SIZE bytes.
+     */
+    bool EncryptFinal(uint8_t* p_out_tag);
+
+    /**
+     * Start decrypting one GCM message.
+     */
+    bool DecryptInit(const uint8_t* p_in_iv, int in_iv_len,
+                     const uint8_t* p_in_associatedData, int in_associated_data_len);
+
+    /**
+     * Decrypt the next chunk of the message. p_out_plaindata must hold in_cipherdata_len bytes.
+     * Note that the output is not authenticated until DecryptFinal() returns true.
+     */
+    bool DecryptUpdate(const uint8_t* p_in_cipherdata, int in_cipherdata_len,
+                       uint8_t* p_out_plaindata);
+
+    /**
+     * Finish the message and check the authentication tag.
+     * If false is returned, all the output of DecryptUpdate() must be discarded.
+     */
+    bool DecryptFinal(const uint8_t* p_in_tag, int in_tag_len);
+
+    /**
+     * The length of the encrypted data for a payload of in_plaindata_len bytes, in the given format.
+     */
+    uint64_t CipherLength(Format format, uint64_t in_plaindata_len) const;
+
+    /**
+     * Encrypt a whole payload from memory to memory, chunk by chunk. The iv (or nonce prefix) is generated randomly.
+     *
+     * @param format: Pack or Segmented.
+     * @param p_in_plaindata
+     * @param in_plaindata_len
+     * @param p_in_associatedData
+     * @param in_associated_data_len
+     * @param p_out_cipher: buffer of CipherLength(format, in_plaindata_len) bytes.
+     * @param out_cipher_len: size of p_out_cipher.
+     */
+    bool Encrypt(Format format,
+                 const uint8_t* p_in_plaindata, uint64_t in_plaindata_len,
+                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                 uint8_t* p_out_cipher, uint64_t out_cipher_len);
+
+    /**
+     * Decrypt a whole payload of either format from memory to memory.
+     * In the pack format the output is only authenticated once the function returns true.
+     *
+     * @param p_in_cipher
+     * @param in_cipher_len
+     * @param p_in_associatedData
+     * @param in_associated_data_len
+     * @param p_out_plaindata: buffer of at least PlainLength() bytes.
+     * @param out_plaindata_len: [in] size of p_out_plaindata, [out] length of the decrypted data.
+     */
+    bool Decrypt(const uint8_t* p_in_cipher, uint64_t in_cipher_len,
+                 const uint8_t* p_in_associatedData, int in_associated_data_len,
+                 uint8_t* p_out_plaindata, uint64_t &out_plaindata_len);
+
+    /**
+     * Decrypt and authenticate a single segment of the segmented format (random access).
+     *
+     * @param p_in_cipher: the whole encrypted stream.
+     * @param in_cipher_len
+     * @param p_in_associatedData
+     * @param in_associated_data_len
+     * @param index: index of the segment.
+     * @param p_out_plaindata: buffer receiving the segment, of GetSegmentSize() bytes for the streams of this instance.
+     * @param out_plaindata_len: [in] size of p_out_plaindata, [out] length of the decrypted segment.
+     *        A segment longer than the buffer, e.g. of a stream with a larger segment size, is rejected.
+     */
+    bool DecryptSegment(const uint8_t* p_in_cipher, uint64_t in_cipher_len,
+                        const uint8_t* p_in_associatedData, int in_associated_data_len,
+                        uint64_t index,
+                        uint8_t* p_out_plaindata, uint32_t &out_plaindata_len);
+
+    /**
+     * Length of the plain data in an encrypted stream of either format, from its header.
+     */
+    bool PlainLength(const uint8_t* p_in_cipher, uint64_t in_cipher_len, uint64_t &out_plaindata_len);
+
+#ifndef SAFEHERON_SGX_SDK
+    /**
+     * Encrypt in_plaindata_len bytes read from in_fd, and write the result to out_fd.
+     * in_fd and out_fd are read and written sequentially, so pipes and sockets are supported.
+     */
+    bool EncryptFd(Format format, int in_fd, uint64_t in_plaindata_len,
+                   const uint8_t* p_in_associatedData, int in_associated_data_len,
+                   int out_fd);
+
+    /**
+     * Decrypt the stream of either format stored in in_fd, and write the result to out_fd.
+     * in_fd must be seekable, out_fd is written sequentially.
+     * In the pack format, if false is returned the data written to out_fd must be discarded. In the segmented
+     * format only authenticated segments are written.
+     */
+    bool DecryptFd(int in_fd,
+                   const uint8_t* p_in_associatedData, int in_associated_data_len,
+                   int out_fd);
+
+    /**
+     * Decrypt and authenticate a single segment of the segmented stream stored in in_fd (random access).
+     * in_fd must be seekable.
+     * out_plaindata_len is [in] the size of p_out_plaindata and [out] the length of the decrypted segment, as in
+     * DecryptSegment.
+     */
+    bool DecryptSegmentFd(int in_fd,
+                          const uint8_t* p_in_associatedData, int in_associated_data_len,
+                          uint64_t index,
+                          uint8_t* p_out_plaindata, uint32_t &out_plaindata_len);
+#endif
+
+    uint32_t GetSegmentSize() const { return segment_size_; }
+
+    /**
+     * @brief Get the Error Message
+     *     Use this function to return a detailed error message when an encryption or decryption function fails.
+     *
+     * @return std::string
+     */
+    std::string GetErrorMessage() const { return error_msg_; }
+
+private:
+    enum class State {
+        Idle,
+        Encrypting,
+        Decrypting
+    };
+
+    void InitContexts();
+
+    void FreeContexts();
+
+    bool ParseSegmentedHeader(const uint8_t* p_header,
+                              uint32_t &segment_size, uint64_t &plain_len, const uint8_t* &p_nonce_prefix);
+
+    bool SegmentIV(const uint8_t* p_nonce_prefix, uint64_t index, uint8_t* p_iv);
+
+    // Encrypt or decrypt one segment of the segmented format, with aad = header || associatedData.
+    bool EncryptSegment(const uint8_t* p_header, const uint8_t* p_nonce_prefix, uint64_t index,
+                        const uint8_t* p_in_associatedData, int in_associated_data_len,
+                        const uint8_t* p_in, uint32_t in_len, uint8_t* p_out, uint8_t* p_out_tag);
+
+    bool DecryptSegmentData(const uint8_t* p_header, const uint8_t* p_nonce_prefix, uint64_t index,
+                            const uint8_t* p_in_associatedData, int in_associated_data_len,
+                            const uint8_t* p_in, uint32_t in_len, const uint8_t* p_in_tag, uint8_t* p_out);
+
+    std::vector<uint8_t> key_;
+    uint32_t segment_size_;
+    std::string error_msg_;
+    EVP_CIPHER_CTX *enc_ctx_;
+    EVP_CIPHER_CTX *dec_ctx_;
+    State state_;
+};
+
+};
+};
+
+#endif //SAFEHERON_CRYPTO_GCM_STREAM_H
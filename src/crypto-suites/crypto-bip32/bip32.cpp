@@ -532,6 +532,80 @@ bool HDKey::PublicCKDPath(HDKey &child_key, const std::string &path) const {
 }
 
 
+bool HDKey::PublicCKDRange(uint32_t start, uint32_t count, std::vector<HDKey> &children,
+                           safeheron::concurrency::Executor *executor) const {
+    std::vector<BN> deltas;
+    return PublicCKDRange(start, count, children, deltas, executor);
+}
+
+bool HDKey::PublicCKDRange(uint32_t start, uint32_t count, std::vector<HDKey> &children,
+                           std::vector<BN> &deltas,
+                           safeheron::concurrency::Executor *executor) const {
+    const bool is_edwards = (curve_type_ == CurveType::ED25519);
+    if (!is_edwards && curve_type_ != CurveType::SECP256K1 && curve_type_ != CurveType::P256) return false;
+
+    CurvePoint parent_pubkey;
+    GetPublicKey(parent_pubkey);
+    uint32_t fingerprint = is_edwards ? _ed25519::hdnode_fingerprint(&hd_node_) : _ecdsa::hdnode_fingerprint(&hd_node_);
+
+    std::vector<CurvePoint> points;
+    std::vector<uint8_t> chain_codes((size_t)count * 32);
+    int ret = is_edwards ?
+              _ed25519::hdnode_public_ckd_range_cp_ex(parent_pubkey, hd_node_.chain_code_, start, count,
+                                                      points, chain_codes.data(), deltas, executor) :
+              _ecdsa::hdnode_public_ckd_range_cp_ex(parent_pubkey, hd_node_.chain_code_, start, count,
+                                                    points, chain_codes.data(), deltas, executor);
+    if (ret != 1) return false;
+
+    HDKey child_key(*this);
+    crypto_bip32_memzero(child_key.hd_node_.private_key_, 32);
+    child_key.hd_node_.depth_ = hd_node_.depth_ + 1;
+    child_key.fingerprint_ = fingerprint;
+    children.assign(count, child_key);
+    for (uint32_t k = 0; k < count; ++k) {
+        HDNode &node = children[k].hd_node_;
+        node.child_num_ = start + k;
+        memcpy(node.chain_code_, chain_codes.data() + 32 * (size_t)k, 32);
+        if (is_edwards) {
+            node.public_key_[0] = 0x0;
+            points[k].EncodeEdwardsPoint(node.public_key_ + 1);
+        } else {
+            points[k].EncodeCompressed(node.public_key_);
+        }
+    }
+    crypto_bip32_memzero(chain_codes.data(), chain_codes.size());
+    return true;
+}
+
+bool HDKey::PublicCKDRange(const std::string &path_template, uint32_t start, uint32_t count,
+                           std::vector<HDKey> &children,
+                           safeheron::concurrency::Executor *executor) const {
+    const std::string suffix = "/*";
+    if (path_template.length() <= suffix.length() ||
+        path_template.compare(path_template.length() - suffix.length(), suffix.length(), suffix) != 0) {
+        return false;
+    }
+    std::vector<uint32_t> prefix;
+    if (!HDPath::ParseHDPath(path_template.substr(0, path_template.length() - suffix.length()), prefix)) return false;
+
+    bool hardened = false;
+    for (uint32_t index : prefix) {
+        hardened = hardened || (index & 0x80000000);
+    }
+    HDKey parent(*this);
+    if (hardened) {
+        if (!HasPrivateKey()) return false;
+        for (uint32_t index : prefix) {
+            parent = parent.PrivateCKD(index);
+        }
+    } else {
+        for (uint32_t index : prefix) {
+            if (!parent.PublicCKD(parent, index)) return false;
+        }
+    }
+    return parent.PublicCKDRange(start, count, children, executor);
+}
+
 bool HDKey::FromExtendedPublicKey(const char *xpub, CurveType c_type) {
     switch (c_type) {
         case CurveType::SECP256K1:
@@ -6,6 +6,7 @@
 #include <vector>
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-bip32/common.h"
+#include "crypto-suites/common/executor.h"
 
 namespace safeheron {
 namespace bip32{
@@ -19,6 +20,8 @@ class HDKey {
     HDNode hd_node_;
     uint32_t fingerprint_;
 
+    friend class HDKeyCache;
+
 public:
     /**
      * Constructor
@@ -270,6 +273,46 @@ public:
     bool PublicCKDPath(HDKey &child_key, const std::string &path) const;
 
 
+    /**
+     * Public child key derivation of the children [start, start + count) of this HDKey.
+     * The result is the same as calling PublicCKD(start + k) for every k, with the parent public key, fingerprint
+     * and HMAC key state computed once, and the children split into one chunk per thread of "executor".
+     * @param[in] start index of the first child, must not be hardened.
+     * @param[in] count number of children
+     * @param[out] children
+     * @param[in] executor null to derive in the calling thread.
+     * @return true on success, false on error
+     */
+    bool PublicCKDRange(uint32_t start, uint32_t count, std::vector<HDKey> &children,
+                        safeheron::concurrency::Executor *executor = nullptr) const;
+
+    /**
+     * Public child key derivation of the children [start, start + count) of this HDKey.
+     * @param[in] start index of the first child, must not be hardened.
+     * @param[in] count number of children
+     * @param[out] children
+     * @param[out] deltas deltas[k] = (children[k] - parent) mod order
+     * @param[in] executor null to derive in the calling thread.
+     * @return true on success, false on error
+     */
+    bool PublicCKDRange(uint32_t start, uint32_t count, std::vector<HDKey> &children,
+                        std::vector<safeheron::bignum::BN> &deltas,
+                        safeheron::concurrency::Executor *executor = nullptr) const;
+
+    /**
+     * Public child key derivation of a range of keys according to a path template like "m/44'/0'/0'/0/&#42;".
+     * The prefix of the template is derived once, with private derivation if it contains hardened indexes
+     * (this HDKey must have a private key then), and "*" is replaced with start, ..., start + count - 1.
+     * @param[in] path_template path whose last index is "*"
+     * @param[in] start
+     * @param[in] count
+     * @param[out] children
+     * @param[in] executor null to derive in the calling thread.
+     * @return true on success, false on error
+     */
+    bool PublicCKDRange(const std::string &path_template, uint32_t start, uint32_t count, std::vector<HDKey> &children,
+                        safeheron::concurrency::Executor *executor = nullptr) const;
+
     /**
      * Deserialize the extended public key and set this HDKey.
      * @param[in] xpub
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
 #include "crypto-suites/crypto-hash/hmac_sha512.h"
 #include "crypto-suites/crypto-hash/sha256.h"
 #include "crypto-suites/crypto-hash/ripemd160.h"
@@ -16,6 +18,8 @@ using safeheron::bignum::BN;
 using safeheron::curve::Curve;
 using safeheron::curve::CurveType;
 using safeheron::curve::CurvePoint;
+using safeheron::curve::FixedBaseTable;
+using safeheron::curve::FixedBaseMul;
 using safeheron::bip32::HDPath;
 using safeheron::bip32::HDKey;
 using safeheron::bip32::Bip32Version;
@@ -145,9 +149,18 @@ int hdnode_private_ckd(HDNode *inout, uint32_t i) {
         data[0] = 0;
         memcpy(data + 1, inout->private_key_, 32);
     } else {  // public derivation, normal(no hardened) derivation
-        BN x = BN::FromBytesBE(inout->private_key_, 32);
-        CurvePoint point = curv->g * x;
-        point.EncodeCompressed(data);
+        // Use the public key if it has been filled, instead of computing it again.
+        uint32_t has_pub = 0;
+        for(int k = 0; k < 33; k++){
+            has_pub = has_pub | inout->public_key_[k];
+        }
+        if (has_pub != 0) {
+            memcpy(data, inout->public_key_, 33);
+        } else {
+            BN x = BN::FromBytesBE(inout->private_key_, 32);
+            CurvePoint point = curv->g * x;
+            point.EncodeCompressed(data);
+        }
     }
     write_be(data + 33, i);
 
@@ -233,6 +246,97 @@ int hdnode_public_ckd_cp_ex(const CurvePoint &parent,
     }
 }
 
+/**
+ * Table of the generator, built on first use and shared by all the threads for the life of the process.
+ * IL is derived from the extended public key, so it is public and may go through the table.
+ */
+static const FixedBaseTable *generator_table(CurveType curve_type) {
+    switch (curve_type) {
+        case CurveType::SECP256K1: {
+            static const FixedBaseTable *table = new FixedBaseTable(curve::GetCurveParam(CurveType::SECP256K1)->g);
+            return table;
+        }
+        case CurveType::P256: {
+            static const FixedBaseTable *table = new FixedBaseTable(curve::GetCurveParam(CurveType::P256)->g);
+            return table;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+int hdnode_public_ckd_range_cp_ex(const CurvePoint &parent,
+                                  const uint8_t *parent_chain_code, uint32_t start, uint32_t count,
+                                  std::vector<CurvePoint> &children, uint8_t *child_chain_codes,
+                                  std::vector<BN> &deltas,
+                                  safeheron::concurrency::Executor *executor) {
+    if (count == 0) {
+        children.clear();
+        deltas.clear();
+        return 1;
+    }
+    const uint32_t last = start + count - 1;
+    if ((start & 0x80000000) || (last & 0x80000000) || last < start) {  // private derivation
+        return 0;
+    }
+    const Curve *curv = GetCurveParam(parent.GetCurveType());
+    const FixedBaseTable *g_table = generator_table(parent.GetCurveType());
+    uint8_t data[(1 + 32) + 4] = {0};
+    parent.EncodeCompressed(data);
+    // The inner and outer states of the HMAC only depend on the parent chain code.
+    const CHMAC_SHA512 hmac_base(parent_chain_code, 32);
+
+    children.assign(count, CurvePoint());
+    deltas.assign(count, BN());
+    const size_t chunks = std::min<size_t>(count, safeheron::concurrency::Concurrency(executor));
+    std::vector<char> chunk_ok(chunks, 0);
+    safeheron::concurrency::ParallelFor(executor, chunks, [&](size_t c) {
+        const size_t begin = count * c / chunks;
+        const size_t end = count * (c + 1) / chunks;
+        uint8_t msg[(1 + 32) + 4];
+        uint8_t I[32 + 32];
+        std::vector<CurvePoint> points;
+        points.reserve(end - begin);
+        memcpy(msg, data, 33);
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t i = start + (uint32_t)k;
+            write_be(msg + 33, i);
+            CHMAC_SHA512 hmac = hmac_base;
+            hmac.Write(msg, sizeof(msg)).Finalize(I);
+
+            BN il = BN::FromBytesBE(I, 32);
+            CurvePoint child;
+            bool valid = false;
+            if (il < curv->n) {
+                child = parent + FixedBaseMul(curv->g, g_table, il);
+                valid = !child.IsInfinity();
+            }
+            if (valid) {
+                memcpy(child_chain_codes + 32 * k, I + 32, 32);
+                deltas[k] = il;
+            } else if (!hdnode_public_ckd_cp_ex(parent, parent_chain_code, i, child, child_chain_codes + 32 * k, deltas[k])) {
+                // Invalid IL, of negligible probability: the single derivation moves on to the next index.
+                memzero(I, sizeof(I));
+                return;
+            }
+            points.push_back(child);
+        }
+        // One shared field inversion for the whole chunk instead of one per encoding.
+        CurvePoint::NormalizeBatch(points);
+        for (size_t k = begin; k < end; ++k) {
+            children[k] = points[k - begin];
+        }
+        memzero(I, sizeof(I));
+        chunk_ok[c] = 1;
+    });
+
+    memzero(data, sizeof(data));
+    for (size_t c = 0; c < chunks; ++c) {
+        if (!chunk_ok[c]) return 0;
+    }
+    return 1;
+}
+
 int hdnode_public_ckd_ex(HDNode *inout, uint32_t i, BN &delta, CurveType curve_type,
                          bool hd_node_has_private_key) {
     assert(is_valid_curve_type(static_cast<CurveType>(inout->curve_type_)));
@@ -2,8 +2,10 @@
 #define SAFEHERON_CRYPTO_BIP32_EDDSA_H
 
 #include <string>
+#include <vector>
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-bip32/common.h"
+#include "crypto-suites/common/executor.h"
 
 namespace safeheron {
 namespace bip32 {
@@ -81,6 +83,26 @@ int hdnode_public_ckd_cp_ex(const curve::CurvePoint &parent,
                                     const uint8_t *parent_chain_code, uint32_t i,
                                     curve::CurvePoint &child, uint8_t *child_chain_code, safeheron::bignum::BN &delta);
 
+/**
+ * Public child key derivation of the children [start, start + count) of one parent.
+ * The HMAC key state of the parent chain code is computed once, and the children are split into one chunk
+ * per thread of "executor".
+ * @param[in] parent
+ * @param[in] parent_chain_code
+ * @param[in] start index of the first child, must not be hardened.
+ * @param[in] count number of children, start + count - 1 must not be hardened.
+ * @param[out] children
+ * @param[out] child_chain_codes buffer of count * 32 bytes
+ * @param[out] deltas
+ * @param[in] executor null to derive in the calling thread.
+ * @return 1 on success
+ */
+int hdnode_public_ckd_range_cp_ex(const curve::CurvePoint &parent,
+                                  const uint8_t *parent_chain_code, uint32_t start, uint32_t count,
+                                  std::vector<curve::CurvePoint> &children, uint8_t *child_chain_codes,
+                                  std::vector<safeheron::bignum::BN> &deltas,
+                                  safeheron::concurrency::Executor *executor);
+
 /**
  * Public child key derivation.
  * @param[in,out] inout
@@ -0,0 +1,254 @@
+#include "crypto-suites/crypto-bip32/hd_key_cache.h"
+#include "crypto-suites/crypto-hash/sha256.h"
+#include "crypto-suites/crypto-bip32/hd_path.h"
+#include "crypto-suites/crypto-bip32/bip32_ecdsa.h"
+#include "crypto-suites/crypto-bip32/bip32_ed25519.h"
+#include "crypto-suites/crypto-bip32/util.h"
+#include "crypto-suites/crypto-bip32/memzero.h"
+
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurveType;
+using safeheron::curve::CurvePoint;
+using safeheron::hash::CSHA256;
+
+namespace safeheron {
+namespace bip32 {
+
+HDKeyCache::HDKeyCache(size_t capacity)
+        : capacity_(capacity), hits_(0), misses_(0), ckd_steps_(0) {
+}
+
+HDKeyCache::~HDKeyCache() {
+    Clear();
+}
+
+bool HDKeyCache::PrivateCKDPath(const HDKey &root, const std::string &path, HDKey &child_key) {
+    std::vector<uint32_t> hd_path;
+    if (!HDPath::ParseHDPath(path, hd_path)) return false;
+    return PrivateCKDPath(root, hd_path, child_key);
+}
+
+bool HDKeyCache::PrivateCKDPath(const HDKey &root, const std::vector<uint32_t> &path, HDKey &child_key) {
+    if (!root.HasPrivateKey()) return false;
+    BN delta;
+    return Derive(root, path, true, child_key, delta);
+}
+
+bool HDKeyCache::PublicCKDPath(const HDKey &root, const std::string &path, HDKey &child_key, BN &delta) {
+    std::vector<uint32_t> hd_path;
+    if (!HDPath::ParseHDPath(path, hd_path)) return false;
+    return PublicCKDPath(root, hd_path, child_key, delta);
+}
+
+bool HDKeyCache::PublicCKDPath(const HDKey &root, const std::string &path, HDKey &child_key) {
+    BN delta;
+    return PublicCKDPath(root, path, child_key, delta);
+}
+
+bool HDKeyCache::PublicCKDPath(const HDKey &root, const std::vector<uint32_t> &path, HDKey &child_key, BN &delta) {
+    return Derive(root, path, false, child_key, delta);
+}
+
+void HDKeyCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // HDKey wipes its node when destroyed.
+    index_.clear();
+    lru_.clear();
+}
+
+size_t HDKeyCache::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+uint64_t HDKeyCache::Hits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+}
+
+uint64_t HDKeyCache::Misses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return misses_;
+}
+
+uint64_t HDKeyCache::CKDSteps() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ckd_steps_;
+}
+
+/**
+ * Cache key: SHA256(root node) || derivation mode || path prefix.
+ */
+static std::string root_identity(const HDKey &root, const HDNode &node, uint32_t fingerprint, bool is_private) {
+    uint8_t buf[4 * 4];
+    uint8_t digest[CSHA256::OUTPUT_SIZE];
+    write_be(buf, node.curve_type_);
+    write_be(buf + 4, node.depth_);
+    write_be(buf + 8, node.child_num_);
+    write_be(buf + 12, fingerprint);
+    CSHA256 sha256;
+    sha256.Write(buf, sizeof(buf));
+    sha256.Write(node.chain_code_, sizeof(node.chain_code_));
+    if (root.HasPrivateKey()) {
+        sha256.Write(node.private_key_, sizeof(node.private_key_));
+    } else {
+        sha256.Write(node.public_key_, sizeof(node.public_key_));
+    }
+    sha256.Finalize(digest);
+
+    std::string id((const char *)digest, sizeof(digest));
+    id.push_back(is_private ? 'v' : 'b');
+    crypto_bip32_memzero(digest, sizeof(digest));
+    return id;
+}
+
+static void append_index(std::string &key, uint32_t i) {
+    uint8_t buf[4];
+    write_be(buf, i);
+    key.append((const char *)buf, sizeof(buf));
+}
+
+bool HDKeyCache::MakeNode(const HDKey &key, const BN &delta, Node &node) {
+    node.key = key;
+    node.delta = delta;
+    switch (key.curve_type_) {
+        case CurveType::SECP256K1:
+        case CurveType::P256:
+            _ecdsa::hdnode_fill_public_key(&node.key.hd_node_);
+            if (!node.point.DecodeCompressed(node.key.hd_node_.public_key_, key.curve_type_)) return false;
+            node.fingerprint = _ecdsa::hdnode_fingerprint(&node.key.hd_node_);
+            return true;
+        case CurveType::ED25519:
+            _ed25519::hdnode_fill_public_key(&node.key.hd_node_);
+            if (!node.point.DecodeEdwardsPoint(node.key.hd_node_.public_key_ + 1, key.curve_type_)) return false;
+            node.fingerprint = _ed25519::hdnode_fingerprint(&node.key.hd_node_);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool HDKeyCache::CKDStep(const Node &parent, uint32_t i, bool is_private, HDKey &child_key, BN &delta) {
+    const CurveType c_type = parent.key.curve_type_;
+    const bool is_edwards = (c_type == CurveType::ED25519);
+    if (!is_edwards && c_type != CurveType::SECP256K1 && c_type != CurveType::P256) return false;
+
+    HDNode hd_node = parent.key.hd_node_;
+    if (is_private) {
+        // The public key of the parent is filled, it is not computed again for a normal derivation.
+        int ret = is_edwards ? _ed25519::hdnode_private_ckd(&hd_node, i) : _ecdsa::hdnode_private_ckd(&hd_node, i);
+        if (ret != 1) {
+            crypto_bip32_memzero(&hd_node, sizeof(HDNode));
+            return false;
+        }
+    } else {
+        const Curve *curv = curve::GetCurveParam(c_type);
+        CurvePoint child_point;
+        uint8_t child_chain_code[32];
+        BN d;
+        int ret = is_edwards ?
+                  _ed25519::hdnode_public_ckd_cp_ex(parent.point, hd_node.chain_code_, i, child_point, child_chain_code, d) :
+                  _ecdsa::hdnode_public_ckd_cp_ex(parent.point, hd_node.chain_code_, i, child_point, child_chain_code, d);
+        if (ret != 1) return false;
+        crypto_bip32_memzero(hd_node.private_key_, 32);
+        memcpy(hd_node.chain_code_, child_chain_code, 32);
+        hd_node.depth_++;
+        hd_node.child_num_ = i;
+        if (is_edwards) {
+            hd_node.public_key_[0] = 0x0;
+            child_point.EncodeEdwardsPoint(hd_node.public_key_ + 1);
+        } else {
+            child_point.EncodeCompressed(hd_node.public_key_);
+        }
+        delta = (parent.delta + d) % curv->n;
+        crypto_bip32_memzero(child_chain_code, 32);
+    }
+
+    child_key = parent.key;
+    child_key.hd_node_ = hd_node;
+    child_key.fingerprint_ = parent.fingerprint;
+    crypto_bip32_memzero(&hd_node, sizeof(HDNode));
+    return true;
+}
+
+void HDKeyCache::Insert(const std::string &cache_key, const Node &node) {
+    if (capacity_ == 0) return;
+    auto it = index_.find(cache_key);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+    lru_.emplace_front(cache_key, node);
+    index_[cache_key] = lru_.begin();
+    while (lru_.size() > capacity_) {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+bool HDKeyCache::Derive(const HDKey &root, const std::vector<uint32_t> &path, bool is_private,
+                        HDKey &child_key, BN &delta) {
+    if (path.empty()) {
+        child_key = root;
+        delta = BN(0);
+        return true;
+    }
+
+    // Keys of all the prefixes of the path, prefix_keys[k] for path[0, k).
+    std::vector<std::string> prefix_keys(path.size());
+    prefix_keys[0] = root_identity(root, root.hd_node_, root.fingerprint_, is_private);
+    for (size_t k = 1; k < path.size(); ++k) {
+        prefix_keys[k] = prefix_keys[k - 1];
+        append_index(prefix_keys[k], path[k - 1]);
+    }
+
+    // Look for the longest cached prefix, the leaf itself is never cached.
+    Node node;
+    size_t start = 0;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t k = path.size() - 1; k > 0; --k) {
+            auto it = index_.find(prefix_keys[k]);
+            if (it != index_.end()) {
+                lru_.splice(lru_.begin(), lru_, it->second);
+                node = it->second->second;
+                start = k;
+                found = true;
+                break;
+            }
+        }
+        if (found) hits_++; else misses_++;
+    }
+
+    if (!found && !MakeNode(root, BN(0), node)) return false;
+
+    std::vector<std::pair<size_t, Node>> new_nodes;
+    uint64_t steps = 0;
+    for (size_t k = start; k < path.size(); ++k) {
+        HDKey key;
+        BN d;
+        if (!CKDStep(node, path[k], is_private, key, d)) return false;
+        steps++;
+        if (k + 1 == path.size()) {
+            child_key = key;
+            delta = is_private ? BN(0) : d;
+            break;
+        }
+        Node next;
+        if (!MakeNode(key, d, next)) return false;
+        node = next;
+        new_nodes.emplace_back(k + 1, next);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ckd_steps_ += steps;
+    for (const auto &item : new_nodes) {
+        Insert(prefix_keys[item.first], item.second);
+    }
+    return true;
+}
+
+};
+};
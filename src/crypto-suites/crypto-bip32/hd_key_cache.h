@@ -0,0 +1,130 @@
+#ifndef SAFEHERON_CRYPTO_BIP32_HD_KEY_CACHE_H
+#define SAFEHERON_CRYPTO_BIP32_HD_KEY_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "crypto-suites/crypto-bip32/bip32.h"
+
+namespace safeheron {
+namespace bip32 {
+
+/**
+ * LRU cache of the intermediate nodes of a BIP32 derivation tree.
+ *
+ * HDKey::PrivateCKDPath and HDKey::PublicCKDPath derive from the root at every call. The cache keeps the
+ * intermediate nodes (for "m/44'/60'/0'/0/i": m/44', m/44'/60', m/44'/60'/0' and m/44'/60'/0'/0), together with
+ * their decoded public point and their fingerprint, which is the parent fingerprint of their children.
+ * Deriving a child of a cached node, such as a sibling of a previously derived key, costs exactly one CKD step.
+ *
+ * Nodes are keyed by (root identity, private or public derivation, path prefix). The root identity is a SHA256
+ * digest of the whole root node, so two different roots never share entries even if their 4-byte fingerprints
+ * collide. The leaves are not cached. Cached private nodes are wiped when they are evicted or cleared.
+ *
+ * The results are the same as those of HDKey::PrivateCKDPath and HDKey::PublicCKDPath. An instance can be shared
+ * between threads.
+ */
+class HDKeyCache {
+public:
+    /**
+     * Constructor
+     * @param[in] capacity maximum number of cached nodes.
+     */
+    explicit HDKeyCache(size_t capacity = 1024);
+
+    HDKeyCache(const HDKeyCache &) = delete;
+
+    HDKeyCache &operator=(const HDKeyCache &) = delete;
+
+    ~HDKeyCache();
+
+    /**
+     * Private child key derivation according to specified path, from "root".
+     * @param[in] root
+     * @param[in] path like "m/44'/60'/0'/0/1"
+     * @param[out] child_key the derived HDKey object
+     * @return true on success, false on error
+     */
+    bool PrivateCKDPath(const HDKey &root, const std::string &path, HDKey &child_key);
+
+    /**
+     * Private child key derivation according to a parsed path, from "root".
+     */
+    bool PrivateCKDPath(const HDKey &root, const std::vector<uint32_t> &path, HDKey &child_key);
+
+    /**
+     * Public child key derivation according to specified path, from "root".
+     * @param[in] root
+     * @param[in] path like "m/44/60/0/0/1"
+     * @param[out] child_key the derived HDKey object
+     * @param[out] delta delta = (child - root) mod order
+     * @return true on success, false on error
+     */
+    bool PublicCKDPath(const HDKey &root, const std::string &path, HDKey &child_key, safeheron::bignum::BN &delta);
+
+    bool PublicCKDPath(const HDKey &root, const std::string &path, HDKey &child_key);
+
+    /**
+     * Public child key derivation according to a parsed path, from "root".
+     */
+    bool PublicCKDPath(const HDKey &root, const std::vector<uint32_t> &path, HDKey &child_key, safeheron::bignum::BN &delta);
+
+    /**
+     * Remove all cached nodes.
+     */
+    void Clear();
+
+    size_t Size() const;
+
+    size_t Capacity() const { return capacity_; }
+
+    /**
+     * Number of lookups which found a cached prefix of the path.
+     */
+    uint64_t Hits() const;
+
+    /**
+     * Number of lookups which had to start from the root.
+     */
+    uint64_t Misses() const;
+
+    /**
+     * Number of CKD steps performed since the construction of this cache.
+     */
+    uint64_t CKDSteps() const;
+
+private:
+    struct Node {
+        HDKey key;                             // the public key of the node is always filled
+        safeheron::curve::CurvePoint point;    // decoded public key
+        uint32_t fingerprint;                  // fingerprint of this node, parent fingerprint of its children
+        safeheron::bignum::BN delta;           // (node - root) mod order, public derivation only
+    };
+
+    typedef std::list<std::pair<std::string, Node>> LruList;
+
+    bool Derive(const HDKey &root, const std::vector<uint32_t> &path, bool is_private,
+                HDKey &child_key, safeheron::bignum::BN &delta);
+
+    static bool MakeNode(const HDKey &key, const safeheron::bignum::BN &delta, Node &node);
+
+    static bool CKDStep(const Node &parent, uint32_t i, bool is_private, HDKey &child_key, safeheron::bignum::BN &delta);
+
+    void Insert(const std::string &cache_key, const Node &node);
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    LruList lru_;
+    std::unordered_map<std::string, LruList::iterator> index_;
+    uint64_t hits_;
+    uint64_t misses_;
+    uint64_t ckd_steps_;
+};
+
+};
+};
+
+#endif //SAFEHERON_CRYPTO_BIP32_HD_KEY_CACHE_H
@@ -2,15 +2,20 @@
 // Created by Sword03 on 2022/7/17.
 //
 
+#include <algorithm>
 #include <cstring>
 #include "crypto-suites/crypto-bip39/bip39.h"
 #include "crypto-suites/crypto-bip39/wally_bip39.h"
 #include "crypto-suites/crypto-bip39/wordlist.h"
 #include "crypto-suites/crypto-bip39/internal.h"
+#include "crypto-suites/crypto-hash/pbkdf2_hmac_sha512.h"
 
 /* Maximum length including up to 2 bytes for checksum */
 #define BIP39_ENTROPY_LEN_MAX (BIP39_ENTROPY_LEN_320 + sizeof(unsigned char) * 2)
 
+#define BIP39_SEED_LEN 64
+#define BIP39_PBKDF2_ROUNDS 2048
+
 namespace safeheron {
 namespace bip39 {
 
@@ -167,6 +172,58 @@ bool BytesToMnemonic(std::string &mnemonic, const uint8_t *bytes, size_t len, La
     clear_and_free(mnemonic_ptr, strlen(mnemonic_ptr));
     return true;
 }
+bool MnemonicToSeed(std::string &seed, const std::string &mnemonic, const std::string &passphrase, Language lang) {
+    std::string bytes;
+    if (!MnemonicToBytes(bytes, mnemonic, lang)) {
+        return false;
+    }
+    wally_clear((uint8_t *)bytes.c_str(), bytes.length());
+
+    std::string trim_mnemonic;
+    Trim(mnemonic, trim_mnemonic);
+    std::string salt("mnemonic");
+    salt.append(passphrase);
+
+    uint8_t seed_out[BIP39_SEED_LEN];
+    safeheron::hash::PBKDF2_HMAC_SHA512((const uint8_t *) trim_mnemonic.c_str(), trim_mnemonic.length(),
+                                        (const uint8_t *) salt.c_str(), salt.length(),
+                                        BIP39_PBKDF2_ROUNDS, seed_out, sizeof(seed_out));
+    seed.assign((const char *) seed_out, sizeof(seed_out));
+    wally_clear(seed_out, sizeof(seed_out));
+    wally_clear((uint8_t *)trim_mnemonic.c_str(), trim_mnemonic.length());
+    wally_clear((uint8_t *)salt.c_str(), salt.length());
+    return true;
+}
+
+bool MnemonicToSeedMany(std::vector<std::string> &seeds, const std::vector<std::string> &mnemonics,
+                        const std::vector<std::string> &passphrases, Language lang,
+                        safeheron::concurrency::Executor *executor) {
+    const size_t n = mnemonics.size();
+    if (passphrases.size() != n && passphrases.size() != 1) {
+        return false;
+    }
+    seeds.assign(n, std::string());
+    if (n == 0) {
+        return true;
+    }
+
+    // One contiguous chunk of mnemonics per thread.
+    const size_t chunks = std::min(n, safeheron::concurrency::Concurrency(executor));
+    std::vector<char> chunk_ok(chunks, 1);
+    safeheron::concurrency::ParallelFor(executor, chunks, [&](size_t c) {
+        const size_t begin = n * c / chunks;
+        const size_t end = n * (c + 1) / chunks;
+        for (size_t i = begin; i < end; ++i) {
+            const std::string &passphrase = passphrases.size() == 1 ? passphrases[0] : passphrases[i];
+            if (!MnemonicToSeed(seeds[i], mnemonics[i], passphrase, lang)) {
+                seeds[i].clear();
+                chunk_ok[c] = 0;
+            }
+        }
+    });
+
+    return std::find(chunk_ok.begin(), chunk_ok.end(), 0) == chunk_ok.end();
+}
 
 }
 }
@@ -8,6 +8,7 @@
 #include<string>
 #include<vector>
 #include "crypto-suites/crypto-bip39/language.h"
+#include "crypto-suites/common/executor.h"
 
 namespace safeheron {
 namespace bip39 {
@@ -48,6 +49,36 @@ bool BytesToMnemonic(std::string &mnemonic, const uint8_t *bytes, size_t len, La
  */
 bool MnemonicToWords(std::vector<std::string>& words, const std::string &mnemonic, Language lang);
 
+/**
+ * Convert mnemonic to a 64-byte seed, as defined in BIP39:
+ *     seed = PBKDF2-HMAC-SHA512(password = mnemonic, salt = "mnemonic" + passphrase, 2048 iterations)
+ *
+ * The mnemonic must be valid in "lang" (words and checksum), extra spaces are removed. The passphrase is used as is,
+ * it should already be in NFKD form if it is not ASCII.
+ *
+ * @param seed 64 bytes
+ * @param mnemonic
+ * @param passphrase
+ * @param lang
+ * @return true on success, false if the mnemonic is invalid.
+ */
+bool MnemonicToSeed(std::string &seed, const std::string &mnemonic, const std::string &passphrase, Language lang);
+
+/**
+ * Convert many mnemonics to seeds, e.g. to recover or check a set of wallets. The mnemonics are spread over the
+ * threads of "executor". The seeds are the same as those of MnemonicToSeed.
+ *
+ * @param seeds seeds[i] is the seed of mnemonics[i], or is empty if mnemonics[i] is invalid.
+ * @param mnemonics
+ * @param passphrases one passphrase per mnemonic, or a single passphrase for all of them.
+ * @param lang
+ * @param executor null to run in the calling thread.
+ * @return true if every mnemonic is valid.
+ */
+bool MnemonicToSeedMany(std::vector<std::string> &seeds, const std::vector<std::string> &mnemonics,
+                        const std::vector<std::string> &passphrases, Language lang,
+                        safeheron::concurrency::Executor *executor = nullptr);
+
 }
 }
 
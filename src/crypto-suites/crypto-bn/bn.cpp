@@ -5,6 +5,7 @@
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/exception/safeheron_exceptions.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using safeheron::exception::LocatedException;
 using safeheron::exception::OpensslException;
@@ -62,6 +63,45 @@ static std::string bin2hex(const std::string &s) {
 }
 
 
+/**
+ * A spare BN_CTX per thread. OpenSSL keeps the temporaries of a context in a pool, so passing the same
+ * context to successive operations saves the BN_CTX_new() and the pool allocations of each of them.
+ * A nested acquisition finds the slot empty and gets a context of its own.
+ */
+#if !defined(SAFEHERON_SGX_SDK)
+struct ThreadCtxSlot {
+    BN_CTX *ctx = nullptr;
+
+    ~ThreadCtxSlot() {
+        if (ctx) BN_CTX_free(ctx);
+    }
+};
+
+static thread_local ThreadCtxSlot ctx_slot;
+#endif
+
+static BN_CTX *acquire_ctx() {
+#if !defined(SAFEHERON_SGX_SDK)
+    if (ctx_slot.ctx) {
+        BN_CTX *ctx = ctx_slot.ctx;
+        ctx_slot.ctx = nullptr;
+        return ctx;
+    }
+#endif
+    return BN_CTX_new();
+}
+
+static void release_ctx(BN_CTX *ctx) {
+    if (!ctx) return;
+#if !defined(SAFEHERON_SGX_SDK)
+    if (!ctx_slot.ctx) {
+        ctx_slot.ctx = ctx;
+        return;
+    }
+#endif
+    BN_CTX_free(ctx);
+}
+
 /**
  * const variables definition
 */
@@ -277,15 +317,15 @@ BN BN::operator*(const BN &num) const
 
     ASSERT_THROW(bn_ && n.bn_ && num.bn_);
 
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_mul(n.bn_, bn_, num.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mul(n.bn_, bn_, num.bn_, ctx)) != 1");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return n;
 }
@@ -303,15 +343,15 @@ BN BN::operator/(const BN &num) const
 
     ASSERT_THROW(bn_ && n.bn_ && num.bn_);
 
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_div(n.bn_, nullptr, bn_, num.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_div(n.bn_, nullptr, bn_, num.bn_, ctx)) != 1");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return n;
 }
@@ -358,15 +398,15 @@ BN &BN::operator*=(const BN &num)
 
     ASSERT_THROW(bn_ && num.bn_);
 
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_mul(bn_, bn_, num.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mul(bn_, bn_, num.bn_, ctx)) != 1");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return *this;
 }
@@ -383,15 +423,15 @@ BN &BN::operator/=(const BN &num)
 
     ASSERT_THROW(bn_ && num.bn_);
 
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_div(bn_, nullptr, bn_, num.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_div(bn_, nullptr, bn_, num.bn_, ctx)) != 1");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return *this;
 }
@@ -599,15 +639,15 @@ BN BN::operator%(const BN &num) const
 
     ASSERT_THROW(bn_ && n.bn_ && num.bn_);
 
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_nnmod(n.bn_, n.bn_, num.bn_, ctx)) != 1){
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_nnmod(n.bn_, n.bn_, num.bn_, ctx)) != 1");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return n;
 }
@@ -622,6 +662,31 @@ BN BN::operator%(unsigned long ui) const
     return *this % BN(ui);
 }
 
+/**
+ * Self-modulo operation.
+ * @param[in] num
+ * @return (*this) mod num
+ */
+BN &BN::operator%=(const BN &num)
+{
+    int ret = 0;
+    BN_CTX* ctx = nullptr;
+
+    ASSERT_THROW(bn_ && num.bn_);
+
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
+    }
+    if ((ret = BN_nnmod(bn_, bn_, num.bn_, ctx)) != 1){
+        release_ctx(ctx);
+        ctx = nullptr;
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_nnmod(bn_, bn_, num.bn_, ctx)) != 1");
+    }
+    release_ctx(ctx);
+    ctx = nullptr;
+    return *this;
+}
+
 /**
  * Bitwise left shift.
  * @param[in] n
@@ -849,15 +914,15 @@ void BN::Div(const BN &d, BN &q, BN &r)
     ASSERT_THROW(bn_ && d.bn_ && q.bn_ && r.bn_);
     int ret = 0;
     BN_CTX* ctx = nullptr;
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_div(q.bn_, r.bn_, bn_, d.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_div(q.bn_, r.bn_, bn_, d.bn_, ctx)");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
 }
 
@@ -869,17 +934,18 @@ void BN::Div(const BN &d, BN &q, BN &r)
  */
 BN BN::InvM(const BN &m) const
 {
+    SAFEHERON_COUNT_INVM();
     BN r;
     BN_CTX* ctx = nullptr;
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if (!BN_mod_inverse(r.bn_, bn_, m.bn_, ctx)) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, 0, "!BN_mod_inverse(r.bn_, bn_, m.bn_, ctx)");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return r;
 }
@@ -894,15 +960,15 @@ BN BN::Gcd(const BN &n) const
     BN r;
     BN_CTX* ctx = nullptr;
     int ret = 0;
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_gcd(r.bn_, bn_, n.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_gcd(r.bn_, bn_, n.bn_, ctx)) != 1");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return r;
 }
@@ -920,6 +986,87 @@ BN BN::Lcm(const BN &n) const
     return r;
 }
 
+/**
+ * Modular addition.
+ * @param[in] num
+ * @param[in] m a positive modulus
+ * @return ((*this) + num) mod m, in [0, m)
+ */
+BN BN::AddMod(const BN &num, const BN &m) const
+{
+    BN r;
+    BN_CTX* ctx = nullptr;
+    int ret = 0;
+
+    ASSERT_THROW(bn_ && num.bn_ && m.bn_);
+
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
+    }
+    if ((ret = BN_mod_add(r.bn_, bn_, num.bn_, m.bn_, ctx)) != 1) {
+        release_ctx(ctx);
+        ctx = nullptr;
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_add(r.bn_, bn_, num.bn_, m.bn_, ctx)) != 1");
+    }
+    release_ctx(ctx);
+    ctx = nullptr;
+    return r;
+}
+
+/**
+ * Modular subtraction.
+ * @param[in] num
+ * @param[in] m a positive modulus
+ * @return ((*this) - num) mod m, in [0, m)
+ */
+BN BN::SubMod(const BN &num, const BN &m) const
+{
+    BN r;
+    BN_CTX* ctx = nullptr;
+    int ret = 0;
+
+    ASSERT_THROW(bn_ && num.bn_ && m.bn_);
+
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
+    }
+    if ((ret = BN_mod_sub(r.bn_, bn_, num.bn_, m.bn_, ctx)) != 1) {
+        release_ctx(ctx);
+        ctx = nullptr;
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_sub(r.bn_, bn_, num.bn_, m.bn_, ctx)) != 1");
+    }
+    release_ctx(ctx);
+    ctx = nullptr;
+    return r;
+}
+
+/**
+ * Modular multiplication.
+ * @param[in] num
+ * @param[in] m a positive modulus
+ * @return ((*this) * num) mod m, in [0, m)
+ */
+BN BN::MulMod(const BN &num, const BN &m) const
+{
+    BN r;
+    BN_CTX* ctx = nullptr;
+    int ret = 0;
+
+    ASSERT_THROW(bn_ && num.bn_ && m.bn_);
+
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
+    }
+    if ((ret = BN_mod_mul(r.bn_, bn_, num.bn_, m.bn_, ctx)) != 1) {
+        release_ctx(ctx);
+        ctx = nullptr;
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_mul(r.bn_, bn_, num.bn_, m.bn_, ctx)) != 1");
+    }
+    release_ctx(ctx);
+    ctx = nullptr;
+    return r;
+}
+
 /**
  * Calculate the y-th power of this and modulo m
  *      r = (this ^ y) % m
@@ -930,24 +1077,213 @@ BN BN::Lcm(const BN &n) const
 BN BN::PowM(const BN &y, const BN &m) const
 {
     ASSERT_THROW(bn_ && y.bn_ && m.bn_);
+    SAFEHERON_COUNT_POWM(m.BitLength(), 1);
     BN r;
     BN t_y = y.IsNeg()? y.Neg() : y;
     BN_CTX* ctx = nullptr;
     int ret = 0;
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if ((ret = BN_mod_exp(r.bn_, bn_, t_y.bn_, m.bn_, ctx)) != 1) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_exp(r.bn_, bn_, t_y.bn_, m.bn_, ctx)) != 1");
 
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return y.IsNeg()? r.InvM(m): r;
 }
 
+namespace {
+
+/**
+ * Context of a Montgomery multi-exponentiation, freed when it goes out of scope.
+ */
+struct MultiPowContext {
+    BN_CTX *ctx = nullptr;
+    BN_MONT_CTX *mont = nullptr;
+
+    ~MultiPowContext() {
+        if (mont) BN_MONT_CTX_free(mont);
+        if (ctx) release_ctx(ctx);
+    }
+};
+
+// Same window sizes as OpenSSL's BN_mod_exp_mont.
+int window_bits_for_exponent_size(int bits) {
+    return bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : 1;
+}
+
+}
+
+MontContext::MontContext(const BN &m)
+        : m_(m), mont_(nullptr)
+{
+    BN_CTX* ctx = nullptr;
+    int ret = 0;
+
+    ASSERT_THROW(m > 1 && m.IsOdd());
+
+    if (!(mont_ = BN_MONT_CTX_new())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(mont_ = BN_MONT_CTX_new())");
+    }
+    if (!(ctx = acquire_ctx())) {
+        BN_MONT_CTX_free(mont_);
+        mont_ = nullptr;
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
+    }
+    if ((ret = BN_MONT_CTX_set(mont_, m_.bn_, ctx)) != 1) {
+        release_ctx(ctx);
+        ctx = nullptr;
+        BN_MONT_CTX_free(mont_);
+        mont_ = nullptr;
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_MONT_CTX_set(mont_, m_.bn_, ctx)) != 1");
+    }
+    release_ctx(ctx);
+    ctx = nullptr;
+}
+
+MontContext::~MontContext()
+{
+    if (mont_) BN_MONT_CTX_free(mont_);
+}
+
+BN MontContext::PowM(const BN &x, const BN &y) const
+{
+    ASSERT_THROW(x.bn_ && y.bn_);
+    SAFEHERON_COUNT_POWM(m_.BitLength(), 1);
+    BN r;
+    BN t_y = y.IsNeg()? y.Neg() : y;
+    BN_CTX* ctx = nullptr;
+    int ret = 0;
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
+    }
+    if ((ret = BN_mod_exp_mont(r.bn_, x.bn_, t_y.bn_, m_.bn_, ctx, mont_)) != 1) {
+        release_ctx(ctx);
+        ctx = nullptr;
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_exp_mont(r.bn_, x.bn_, t_y.bn_, m_.bn_, ctx, mont_)) != 1");
+    }
+    release_ctx(ctx);
+    ctx = nullptr;
+    return y.IsNeg()? r.InvM(m_): r;
+}
+
+BN BN::MultiPowM(const std::vector<BN> &bases, const std::vector<BN> &exponents, const BN &m)
+{
+    ASSERT_THROW(bases.size() == exponents.size());
+    ASSERT_THROW(m.bn_ && m > 0);
+
+    if (m == 1) return BN(0);
+
+    // Montgomery arithmetic needs an odd modulus.
+    if (!BN_is_odd(m.bn_)) {
+        BN r(1);
+        for (size_t i = 0; i < bases.size(); ++i) {
+            r = (r * bases[i].PowM(exponents[i], m)) % m;
+        }
+        return r;
+    }
+
+    // The even case above counts through PowM.
+    SAFEHERON_COUNT_POWM(m.BitLength(), bases.size());
+
+    MultiPowContext mc;
+    if (!(mc.ctx = acquire_ctx()) || !(mc.mont = BN_MONT_CTX_new())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx()) || !(mont = BN_MONT_CTX_new())");
+    }
+    int ret = 0;
+    if ((ret = BN_MONT_CTX_set(mc.mont, m.bn_, mc.ctx)) != 1) {
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_MONT_CTX_set(mont, m.bn_, ctx)) != 1");
+    }
+
+    // For each power: the odd powers b, b^3, ..., b^(2^w - 1) of its base in Montgomery form, and the window digits
+    // of its exponent, digits[pos] being the odd digit which ends at bit pos, or 0.
+    struct Power {
+        std::vector<BN> table;
+        std::vector<uint8_t> digits;
+    };
+    std::vector<Power> powers;
+    powers.reserve(bases.size());
+    int max_bits = 0;
+    for (size_t i = 0; i < bases.size(); ++i) {
+        const BN &y = exponents[i];
+        if (y.IsZero()) continue;
+        BN b = y.IsNeg() ? (bases[i] % m).InvM(m) : bases[i] % m;
+        BN e = y.IsNeg() ? y.Neg() : y;
+
+        const int bits = e.BitLength();
+        const int w = window_bits_for_exponent_size(bits);
+        powers.emplace_back();
+        Power &power = powers.back();
+
+        power.table.resize((size_t)1 << (w - 1));
+        if ((ret = BN_to_montgomery(power.table[0].bn_, b.bn_, mc.mont, mc.ctx)) != 1) {
+            throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_to_montgomery(...)) != 1");
+        }
+        if (power.table.size() > 1) {
+            BN b2;
+            if ((ret = BN_mod_mul_montgomery(b2.bn_, power.table[0].bn_, power.table[0].bn_, mc.mont, mc.ctx)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_mul_montgomery(...)) != 1");
+            }
+            for (size_t k = 1; k < power.table.size(); ++k) {
+                if ((ret = BN_mod_mul_montgomery(power.table[k].bn_, power.table[k - 1].bn_, b2.bn_, mc.mont, mc.ctx)) != 1) {
+                    throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_mul_montgomery(...)) != 1");
+                }
+            }
+        }
+
+        // Sliding windows from the most significant bit.
+        power.digits.assign(bits, 0);
+        for (int pos = bits - 1; pos >= 0; ) {
+            if (!BN_is_bit_set(e.bn_, pos)) {
+                pos--;
+                continue;
+            }
+            int low = pos - w + 1 > 0 ? pos - w + 1 : 0;
+            while (!BN_is_bit_set(e.bn_, low)) low++;
+            uint8_t digit = 0;
+            for (int k = pos; k >= low; --k) {
+                digit = (uint8_t)((digit << 1) | (BN_is_bit_set(e.bn_, k) ? 1 : 0));
+            }
+            power.digits[low] = digit;
+            pos = low - 1;
+        }
+        if (bits > max_bits) max_bits = bits;
+    }
+
+    if (powers.empty()) return BN(1);
+
+    // One shared chain of squarings for all the powers.
+    BN acc;
+    bool started = false;
+    for (int pos = max_bits - 1; pos >= 0; --pos) {
+        if (started) {
+            if ((ret = BN_mod_mul_montgomery(acc.bn_, acc.bn_, acc.bn_, mc.mont, mc.ctx)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_mul_montgomery(...)) != 1");
+            }
+        }
+        for (const Power &power : powers) {
+            if (pos >= (int)power.digits.size() || power.digits[pos] == 0) continue;
+            const BN &t = power.table[power.digits[pos] >> 1];
+            if (!started) {
+                acc = t;
+                started = true;
+            } else if ((ret = BN_mod_mul_montgomery(acc.bn_, acc.bn_, t.bn_, mc.mont, mc.ctx)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_mod_mul_montgomery(...)) != 1");
+            }
+        }
+    }
+
+    BN r;
+    if ((ret = BN_from_montgomery(r.bn_, acc.bn_, mc.mont, mc.ctx)) != 1) {
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = BN_from_montgomery(...)) != 1");
+    }
+    return r;
+}
+
 /**
  * Calculate square root 'r' on modulo m where
  *      r^2 == this (mod p),
@@ -965,15 +1301,15 @@ BN BN::SqrtM(const BN &p) const
 {
     BN r;
     BN_CTX* ctx = nullptr;
-    if (!(ctx = BN_CTX_new())) {
-        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = BN_CTX_new())");
+    if (!(ctx = acquire_ctx())) {
+        throw BadAllocException(__FILE__, __LINE__, __FUNCTION__, -1, "!(ctx = acquire_ctx())");
     }
     if (!(BN_mod_sqrt(r.bn_, bn_, p.bn_, ctx))) {
-        BN_CTX_free(ctx);
+        release_ctx(ctx);
         ctx = nullptr;
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, 0, "!(BN_mod_sqrt(r.bn_, bn_, p.bn_, ctx))");
     }
-    BN_CTX_free(ctx);
+    release_ctx(ctx);
     ctx = nullptr;
     return r;
 }
@@ -3,16 +3,22 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 struct bignum_st;
+struct bn_mont_ctx_st;
 
 namespace safeheron {
 namespace bignum {
 
+class MontContext;
+
 /**
  * A big number class.
  */
 class BN {
+    friend class MontContext;
+
 public:
     /**
      * Construct a BN object and initialized it with 0
@@ -189,6 +195,13 @@ public:
      */
     BN operator%(unsigned long n) const;
 
+    /**
+     * Self-modulo operation.
+     * @param[in] num
+     * @return (*this) mod num
+     */
+    BN &operator%=(const BN &num);
+
     /**
      * Bitwise left shift.
      * @param[in] n
@@ -314,6 +327,30 @@ public:
      */
     void Div(const BN &d, BN &q, BN &r);
 
+    /**
+     * Modular addition, with no intermediate BN for the sum.
+     * @param[in] num
+     * @param[in] m a positive modulus
+     * @return ((*this) + num) mod m, in [0, m)
+     */
+    BN AddMod(const BN &num, const BN &m) const;
+
+    /**
+     * Modular subtraction, with no intermediate BN for the difference.
+     * @param[in] num
+     * @param[in] m a positive modulus
+     * @return ((*this) - num) mod m, in [0, m)
+     */
+    BN SubMod(const BN &num, const BN &m) const;
+
+    /**
+     * Modular multiplication, with no intermediate BN for the product.
+     * @param[in] num
+     * @param[in] m a positive modulus
+     * @return ((*this) * num) mod m, in [0, m)
+     */
+    BN MulMod(const BN &num, const BN &m) const;
+
     /**
      * Calculate the inverse modulo m.
      * @param[in] m
@@ -346,6 +383,21 @@ public:
      */
     BN PowM(const BN &y, const BN &m) const;
 
+    /**
+     * Calculate the product of bases[i]^exponents[i] modulo m
+     *      r = (bases[0]^exponents[0] * bases[1]^exponents[1] * ... ) % m
+     *
+     * The powers share their squarings (interleaved sliding windows), so the cost is close to that of the single
+     * largest exponentiation instead of their sum. A negative exponent uses the inverse of its base, as PowM does.
+     *
+     * @warning Not constant time, only for public values such as the terms of a verifier equation.
+     * @param[in] bases
+     * @param[in] exponents as many as bases
+     * @param[in] m a positive modulus
+     * @return the product of the powers
+     */
+    static BN MultiPowM(const std::vector<BN> &bases, const std::vector<BN> &exponents, const BN &m);
+
     /**
      * Calculate square root 'r' on modulo m where
      *      r^2 == this (mod p),
@@ -629,6 +681,44 @@ private:
     struct bignum_st* bn_;      /**< a pointer to BIGNUM object */
 };
 
+/**
+ * Montgomery context of an odd modulus, for repeated exponentiations modulo the same number.
+ *
+ * BN::PowM sets up a new context on each call. Keeping one for a fixed modulus saves that setup.
+ * A context is immutable once constructed and can be shared between threads.
+ */
+class MontContext {
+public:
+    /**
+     * Constructor
+     * @param[in] m an odd modulus greater than 1
+     */
+    explicit MontContext(const BN &m);
+
+    MontContext(const MontContext &) = delete;
+
+    MontContext &operator=(const MontContext &) = delete;
+
+    ~MontContext();
+
+    /**
+     * @return the modulus
+     */
+    const BN &Modulus() const { return m_; }
+
+    /**
+     * Calculate the y-th power of x modulo the modulus, same as x.PowM(y, Modulus()).
+     * @param[in] x
+     * @param[in] y
+     * @return x^y mod m
+     */
+    BN PowM(const BN &x, const BN &y) const;
+
+private:
+    BN m_;
+    bn_mont_ctx_st *mont_;
+};
+
 };
 };
 
@@ -1,8 +1,17 @@
 #include <openssl/bn.h>
+#include <openssl/crypto.h>
 #include <openssl/rand.h>
 #include <memory>
 #include <cassert>
+#include <cstring>
+#if !defined(SAFEHERON_SGX_SDK)
+#include <atomic>
+#include <mutex>
+#include <pthread.h>
+#endif
 #include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/common/instrumentation.h"
+#include "crypto-suites/crypto-hash/chacha20.h"
 #include "crypto-suites/exception/safeheron_exceptions.h"
 #include "crypto-suites/common/custom_assert.h"
 
@@ -16,6 +25,108 @@ using safeheron::exception::RandomSourceException;
 namespace safeheron{
 namespace rand{
 
+#if !defined(SAFEHERON_SGX_SDK)
+
+/**
+ * Bumped by Reseed() and in the child of a fork, so that every thread generator reseeds before its next output.
+ */
+static std::atomic<uint64_t> seed_epoch(0);
+
+static void on_fork_child() {
+    seed_epoch.fetch_add(1);
+}
+
+/**
+ * A ChaCha20 keystream generator per thread, keyed with 32 bytes of RAND_bytes.
+ *
+ * The keystream is produced a buffer at a time. The first 32 bytes of each buffer become the next key and are
+ * erased, so a leaked state does not reveal earlier output. The key is replaced by fresh RAND_bytes after
+ * RESEED_INTERVAL bytes of output, on Reseed(), and in the child process after a fork.
+ */
+class ThreadRandom {
+public:
+    ThreadRandom() : pos_(BUF_SIZE), output_since_seed_(0), epoch_(0), seeded_(false) {
+        memset(buf_, 0, sizeof(buf_));
+    }
+
+    ~ThreadRandom() {
+        OPENSSL_cleanse(buf_, sizeof(buf_));
+        OPENSSL_cleanse(&cipher_, sizeof(cipher_));
+    }
+
+    void Generate(unsigned char *out, size_t size) {
+        uint64_t epoch = seed_epoch.load();
+        if (!seeded_ || epoch != epoch_ || output_since_seed_ >= RESEED_INTERVAL) {
+            Seed(epoch);
+        }
+        output_since_seed_ += size;
+        while (size > 0) {
+            if (pos_ == BUF_SIZE) Refill();
+            size_t n = (size < BUF_SIZE - pos_) ? size : BUF_SIZE - pos_;
+            memcpy(out, buf_ + pos_, n);
+            OPENSSL_cleanse(buf_ + pos_, n);
+            pos_ += n;
+            out += n;
+            size -= n;
+        }
+    }
+
+private:
+    static const size_t KEY_SIZE = 32;
+    static const size_t BUF_SIZE = 1024;
+    static const uint64_t RESEED_INTERVAL = 1024 * 1024;
+
+    void Seed(uint64_t epoch) {
+        int ret = 0;
+        unsigned char key[KEY_SIZE];
+        if ((ret = RAND_bytes(key, sizeof(key))) <= 0) {
+            throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = RAND_bytes(key, sizeof(key))) <= 0");
+        }
+        cipher_.SetKey(key, sizeof(key));
+        OPENSSL_cleanse(key, sizeof(key));
+        OPENSSL_cleanse(buf_, sizeof(buf_));
+        pos_ = BUF_SIZE;
+        output_since_seed_ = 0;
+        epoch_ = epoch;
+        seeded_ = true;
+    }
+
+    void Refill() {
+        cipher_.Keystream(buf_, BUF_SIZE);
+        cipher_.SetKey(buf_, KEY_SIZE);
+        OPENSSL_cleanse(buf_, KEY_SIZE);
+        pos_ = KEY_SIZE;
+    }
+
+    safeheron::hash::ChaCha20 cipher_;
+    unsigned char buf_[BUF_SIZE];
+    size_t pos_;
+    uint64_t output_since_seed_;
+    uint64_t epoch_;
+    bool seeded_;
+};
+
+static ThreadRandom &thread_random() {
+    static std::once_flag fork_handler_flag;
+    std::call_once(fork_handler_flag, []() { pthread_atfork(nullptr, nullptr, on_fork_child); });
+    static thread_local ThreadRandom rng;
+    return rng;
+}
+
+void RandomBytes(unsigned char *buf, size_t size) {
+    if (!buf) {
+        throw RandomSourceException(__FILE__, __LINE__, __FUNCTION__, -1, "!buf");
+    }
+    SAFEHERON_COUNT_RANDOM_BYTES(size);
+    thread_random().Generate(buf, size);
+}
+
+void Reseed() {
+    seed_epoch.fetch_add(1);
+}
+
+#else
+
 void RandomBytes(unsigned char *buf, size_t size) {
     int ret = 0;
     if (!buf) {
@@ -24,8 +135,15 @@ void RandomBytes(unsigned char *buf, size_t size) {
     if ((ret = RAND_bytes(buf, size)) <= 0) {
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = RAND_bytes(buf, size)) <= 0");
     }
+    SAFEHERON_COUNT_RANDOM_BYTES(size);
 }
 
+void Reseed() {
+    // RandomBytes() reads RAND_bytes directly, which has no state here to reseed.
+}
+
+#endif //SAFEHERON_SGX_SDK
+
 BN RandomBN(size_t bits) {
     BN n;
     size_t bytes = (bits + 7) / 8;
@@ -140,6 +258,82 @@ BN RandomBNLtCoPrime(const BN &max) {
     return n;
 }
 
+/**
+ * Append to "offenders" the positions in [begin, end) of the candidates which are not co-prime to "max",
+ * given the product of the candidates of the range modulo "max".
+ */
+static void find_not_coprime(const std::vector<BN> &candidates, size_t begin, size_t end, const BN &product,
+                             const BN &max, std::vector<size_t> &offenders) {
+    if (product.Gcd(max) == 1) return;
+    if (end - begin == 1) {
+        offenders.push_back(begin);
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    BN left(1);
+    for (size_t i = begin; i < mid; ++i) left = left.MulMod(candidates[i], max);
+    BN right(1);
+    for (size_t i = mid; i < end; ++i) right = right.MulMod(candidates[i], max);
+    find_not_coprime(candidates, begin, mid, left, max, offenders);
+    find_not_coprime(candidates, mid, end, right, max, offenders);
+}
+
+std::vector<BN> RandomBNsLtCoPrime(const BN &max, size_t count, bool skipGcd) {
+    static const unsigned long SMALL_PRIMES[] = {
+            2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97,
+            101, 103, 107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173, 179, 181, 191, 193, 197, 199,
+            211, 223, 227, 229, 233, 239, 241, 251
+    };
+    ASSERT_THROW(max > 1);
+
+    std::vector<BN> result;
+    result.reserve(count);
+    if (skipGcd) {
+        while (result.size() < count) {
+            result.push_back(RandomBNLt(max));
+        }
+        return result;
+    }
+
+    // The small primes dividing "max" reject a candidate before any gcd.
+    std::vector<BN> small_factors;
+    for (unsigned long p : SMALL_PRIMES) {
+        BN bn_p(static_cast<long>(p));
+        if (max % bn_p == 0) small_factors.push_back(bn_p);
+    }
+
+    std::vector<BN> candidates;
+    while (result.size() < count) {
+        candidates.clear();
+        while (candidates.size() < count - result.size()) {
+            BN n = RandomBNLt(max);
+            bool divisible = false;
+            for (const BN &p : small_factors) {
+                if (n % p == 0) {
+                    divisible = true;
+                    break;
+                }
+            }
+            if (!divisible) candidates.push_back(std::move(n));
+        }
+
+        BN product(1);
+        for (const BN &n : candidates) product = product.MulMod(n, max);
+        std::vector<size_t> offenders;
+        find_not_coprime(candidates, 0, candidates.size(), product, max, offenders);
+
+        size_t k = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (k < offenders.size() && offenders[k] == i) {
+                ++k;
+                continue;
+            }
+            result.push_back(std::move(candidates[i]));
+        }
+    }
+    return result;
+}
+
 BN RandomBNInRange(const safeheron::bignum::BN &min, const safeheron::bignum::BN &max){
     ASSERT_THROW(max > min);
     BN range = max - min;
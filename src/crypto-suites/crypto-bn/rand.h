@@ -1,6 +1,7 @@
 #ifndef SAFEHERON_RANDOM_H
 #define SAFEHERON_RANDOM_H
 
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 
 namespace safeheron {
@@ -13,6 +14,15 @@ namespace rand {
  */
 void RandomBytes(unsigned char * buf, size_t size);
 
+/**
+ * Make the random generator of every thread take a fresh seed from OpenSSL RAND_bytes before its next output.
+ *
+ * The functions of this file draw from a ChaCha20 generator per thread, which is seeded from RAND_bytes, reseeded
+ * after every 1 MiB of output and after a fork. Call this after an event that calls for fresh randomness, such as
+ * restoring a snapshot of the process or reseeding the OpenSSL DRBG.
+ */
+void Reseed();
+
 /**
  * Sample random BN.
  * @param bits
@@ -77,6 +87,22 @@ safeheron::bignum::BN RandomBNLtGcd(const safeheron::bignum::BN &max);
  */
 safeheron::bignum::BN RandomBNLtCoPrime(const safeheron::bignum::BN &max);
 
+/**
+ * Sample "count" random BNs which are less than and co-prime to "max".
+ *
+ * Candidates are first screened against the small prime factors of "max", then checked all at once with a single
+ * gcd of their product modulo "max". Only when that gcd is not 1 are the offending candidates located, by descending
+ * a tree of partial products, and replaced.
+ *
+ * @param max
+ * @param count
+ * @param skipGcd Opt-in: skip the co-primality check. Only for a "max" whose prime factors are all large, such as
+ *                a Paillier modulus N = pq or N^2, where a random BN shares a factor with "max" with negligible
+ *                probability.
+ * @return "count" random BNs
+ */
+std::vector<safeheron::bignum::BN> RandomBNsLtCoPrime(const safeheron::bignum::BN &max, size_t count, bool skipGcd = false);
+
  /**
   * Sample random BN in range [min, max)
   * @param min
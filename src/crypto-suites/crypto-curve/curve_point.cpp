@@ -1,14 +1,17 @@
 #include <cassert>
+#include <cstring>
+#include <utility>
 #include <openssl/ec.h>
 #include <google/protobuf/util/json_util.h>
 #include "crypto-suites/exception/safeheron_exceptions.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/crypto-curve/curve_point.h"
 #include "crypto-suites/crypto-curve/openssl_curve_wrapper.h"
+#include "crypto-suites/crypto-curve/secp256k1_native.h"
 #include "crypto-suites/crypto-curve/ed25519_ex.h"
 #include "crypto-suites/crypto-curve/curve.h"
-#include "crypto-suites/common/ByteArrayDeleter.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using google::protobuf::util::Status;
@@ -19,7 +22,6 @@ using google::protobuf::util::JsonParseOptions;
 using safeheron::exception::OpensslException;
 using safeheron::exception::LocatedException;
 using safeheron::bignum::BN;
-using safeheron::common::ByteArrayDeleter;
 
 namespace safeheron{
 namespace curve {
@@ -59,7 +61,66 @@ static uint32_t get_category(CurveType curveType){
     return category;
 }
 
+/**
+ * States of the cached affine coordinates
+ */
+static const uint8_t AFFINE_EMPTY = 0;
+static const uint8_t AFFINE_FILLING = 1;
+static const uint8_t AFFINE_READY = 2;
+
+/**
+ * Coordinate y of an encoded point on an edwards curve.
+ */
+static BN edwards_y(const uint8_t *edwards_point) {
+    // Get y coordinate, Reverse copy
+    uint8_t point_y[32];
+    memcpy(point_y, edwards_point, 32);
+    point_y[31] &= 0x7f;
+    return BN::FromBytesLE(point_y, 32);
+}
+
+/**
+ * Coordinate x of an encoded point on an edwards curve, which costs a square root.
+ */
+static BN edwards_x(const uint8_t *edwards_point, CurveType c_type) {
+    // For Ecdsa, not only Ed25519
+    bool x_is_odd = (edwards_point[31] & 0x80) != 0;
+    BN y = edwards_y(edwards_point);
+
+    // Get x
+    const safeheron::curve::Curve *curv = safeheron::curve::GetCurveParam(c_type);
+    // x^2 = (y^2 - c^2) / (c^2 d y^2 - a)
+    BN y_sqr = (y * y) % curv->p;
+    BN c_sqr = (curv->c * curv->c) % curv->p;
+    // u = (y^2 - c^2)
+    BN u = (y_sqr - c_sqr) % curv->p;
+    // v = (c^2 d y^2 - a)
+    BN v = (c_sqr * curv->d * y_sqr - curv->a) % curv->p;
+    BN x_sqr = (u * v.InvM(curv->p)) % curv->p;
+
+    BN x = x_sqr.SqrtM(curv->p);
+    if ((x.IsOdd() && !x_is_odd) || (!x.IsOdd() && x_is_odd)) {
+        x = curv->p - x;
+    }
+    return x;
+}
+
+#if ENABLE_SECP256K1_NATIVE
+/**
+ * rxy = k * xy on secp256k1 with the native backend, both in affine coordinates x || y, 0 < k < n.
+ * @return false if the result is the point at infinity.
+ */
+static bool secp256k1_native_mul(uint8_t rxy[64], const uint8_t xy[64], const BN &k) {
+    uint8_t k32[32];
+    k.ToBytes32BE(k32);
+    bool ok = safeheron::_secp256k1_native::point_mul(rxy, rxy + 32, xy, xy + 32, k32) != 0;
+    memset(k32, 0, sizeof(k32));
+    return ok;
+}
+#endif //ENABLE_SECP256K1_NATIVE
+
 void CurvePoint::Reset() {
+    ClearAffineCache();
     if (curve_type_ == CurveType::INVALID_CURVE) {
         return;
     }
@@ -70,11 +131,65 @@ void CurvePoint::Reset() {
         short_point_ = nullptr;
     }
     memset(edwards_point_, 0, sizeof(edwards_point_));
+    memset(affine_xy_, 0, sizeof(affine_xy_));
     
     curve_type_ = CurveType::INVALID_CURVE;
     curve_grp_ = nullptr;
 }
 
+void CurvePoint::ClearAffineCache() {
+    affine_state_.store(AFFINE_EMPTY, std::memory_order_relaxed);
+}
+
+void CurvePoint::CopyAffineCache(const CurvePoint &point) {
+    if (point.affine_state_.load(std::memory_order_acquire) == AFFINE_READY) {
+        memcpy(affine_xy_, point.affine_xy_, sizeof(affine_xy_));
+        affine_state_.store(AFFINE_READY, std::memory_order_release);
+    } else {
+        ClearAffineCache();
+    }
+}
+
+void CurvePoint::LoadAffine(uint8_t xy64[64]) const {
+    if (affine_state_.load(std::memory_order_acquire) == AFFINE_READY) {
+        memcpy(xy64, affine_xy_, sizeof(affine_xy_));
+        return;
+    }
+
+    uint32_t category = get_category(curve_type_);
+    switch (category) {
+        case 0: // Short curve
+        {
+            // 04 + x + y
+            uint8_t pub65[65];
+            int ret = 0;
+            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub65, 65, false)) != 0) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub65, 65, false)) != 0");
+            }
+            memcpy(xy64, pub65 + 1, 64);
+            break;
+        }
+        case 1: // Edwards curve
+        {
+            // For Ed25519
+            edwards_x(edwards_point_, curve_type_).ToBytes32BE(xy64);
+            edwards_y(edwards_point_).ToBytes32BE(xy64 + 32);
+            break;
+        }
+        default:
+            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "Invalid curve type!");
+    }
+    StoreAffine(xy64);
+}
+
+void CurvePoint::StoreAffine(const uint8_t xy64[64]) const {
+    uint8_t expected = AFFINE_EMPTY;
+    if (affine_state_.compare_exchange_strong(expected, AFFINE_FILLING, std::memory_order_acquire)) {
+        memcpy(affine_xy_, xy64, sizeof(affine_xy_));
+        affine_state_.store(AFFINE_READY, std::memory_order_release);
+    }
+}
+
 CurveType CurvePoint::GetCurveType() const {
     return curve_type_;
 }
@@ -83,13 +198,13 @@ const ec_group_st* CurvePoint::GetEcdsaCurveGrp() const {
     return curve_grp_;
 }
 
-CurvePoint::CurvePoint() {
+CurvePoint::CurvePoint(): affine_state_(AFFINE_EMPTY) {
     curve_type_ = CurveType::INVALID_CURVE;
     memset(edwards_point_, 0, sizeof(edwards_point_));
     curve_grp_ = nullptr;
 }
 
-CurvePoint::CurvePoint(CurveType c_type) {
+CurvePoint::CurvePoint(CurveType c_type): affine_state_(AFFINE_EMPTY) {
     ASSERT_THROW(c_type != CurveType::INVALID_CURVE);
 
     curve_type_ = c_type;
@@ -123,7 +238,7 @@ CurvePoint::CurvePoint(CurveType c_type) {
     }
 }
 
-CurvePoint::CurvePoint(const CurvePoint &point) {
+CurvePoint::CurvePoint(const CurvePoint &point): affine_state_(AFFINE_EMPTY) {
     memset(&edwards_point_, 0, sizeof(edwards_point_));
 
     curve_type_ = point.curve_type_;
@@ -148,9 +263,10 @@ CurvePoint::CurvePoint(const CurvePoint &point) {
         default:
             break;
     }
+    CopyAffineCache(point);
 }
 
-CurvePoint::CurvePoint(const safeheron::bignum::BN &x, const safeheron::bignum::BN &y, CurveType c_type)
+CurvePoint::CurvePoint(const safeheron::bignum::BN &x, const safeheron::bignum::BN &y, CurveType c_type): affine_state_(AFFINE_EMPTY)
 {
     memset(&edwards_point_, 0, sizeof(edwards_point_));
 
@@ -220,6 +336,37 @@ CurvePoint &CurvePoint::operator=(const CurvePoint &point) {
         default:
             break;
     }
+    CopyAffineCache(point);
+    return *this;
+}
+
+CurvePoint::CurvePoint(CurvePoint &&point) noexcept: affine_state_(AFFINE_EMPTY) {
+    // The pointer to the EC_POINT or the encoded Ed25519 point is taken over.
+    curve_type_ = point.curve_type_;
+    curve_grp_ = point.curve_grp_;
+    memcpy(&edwards_point_, &point.edwards_point_, sizeof(edwards_point_));
+    CopyAffineCache(point);
+
+    point.curve_type_ = CurveType::INVALID_CURVE;
+    point.curve_grp_ = nullptr;
+    memset(&point.edwards_point_, 0, sizeof(point.edwards_point_));
+    point.ClearAffineCache();
+}
+
+CurvePoint &CurvePoint::operator=(CurvePoint &&point) noexcept {
+    // hand self-assignment
+    if(this == &point) return *this;
+
+    Reset();
+    curve_type_ = point.curve_type_;
+    curve_grp_ = point.curve_grp_;
+    memcpy(&edwards_point_, &point.edwards_point_, sizeof(edwards_point_));
+    CopyAffineCache(point);
+
+    point.curve_type_ = CurveType::INVALID_CURVE;
+    point.curve_grp_ = nullptr;
+    memset(&point.edwards_point_, 0, sizeof(point.edwards_point_));
+    point.ClearAffineCache();
     return *this;
 }
 
@@ -409,27 +556,11 @@ void CurvePoint::EncodeCompressed(uint8_t* pub33) const {
     if(IsInfinity()) {
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, -1, "Failed in CurvePoint::EncodeCompressed(uint8_t* pub33): IsInfinity");
     }
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int ret = 0;
-            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub33, 33, true)) != 0) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub33, true)) != 0");
-            }
-            break;
-        }
-        case 1: // Edwards curve
-        {
-            // For Ed25519
-            char y_is_odd = edwards_point_[0] & 0x1 ;
-            pub33[0] = 0x02 + y_is_odd; // 0x02 or 0x03
-            x().ToBytes32BE(pub33 + 1);
-            break;
-        }
-        default:
-            break;
-    }
+    // 02/03 + x, where 03 means an odd y
+    uint8_t xy[64];
+    LoadAffine(xy);
+    pub33[0] = 0x02 + (xy[63] & 0x01);
+    memcpy(pub33 + 1, xy, 32);
 }
 
 bool CurvePoint::DecodeCompressed(const uint8_t* pub33, CurveType c_type) {
@@ -450,28 +581,9 @@ void CurvePoint::EncodeFull(uint8_t* pub65) const {
     if(IsInfinity()) {
         throw OpensslException(__FILE__, __LINE__, __FUNCTION__, -1, "Failed in CurvePoint::EncodeFull(uint8_t* pub65): IsInfinity");
     }
-    // Full public key
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int ret = 0;
-            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub65, 65, false)) != 0) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub65, false)) != 0");
-            }
-            break;
-        }
-        case 1: // Edwards curve
-        {
-            // For Ed25519
-            pub65[0] = 0x04;
-            x().ToBytes32BE(pub65 + 1);
-            y().ToBytes32BE(pub65 + 33);
-            break;
-        }
-        default:
-            break;
-    }
+    // 04 + x + y
+    pub65[0] = 0x04;
+    LoadAffine(pub65 + 1);
 }
 
 bool CurvePoint::DecodeFull(const uint8_t* pub65, CurveType c_type) {
@@ -535,38 +647,10 @@ void CurvePoint::EncodeCompressed(std::string & bytes) const{
         return;
     }
 
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int coord_len = CoordinateLength(curve_type_);
-            if(coord_len < 0){
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, coord_len, "invalid CoordinateLength");
-            }
-            // 02/03 + X
-            int pub_bytes_len = coord_len + 1;
-            std::unique_ptr<uint8_t[], ByteArrayDeleter> pub_bytes(new uint8_t[pub_bytes_len], ByteArrayDeleter(pub_bytes_len));
-            int ret = 0;
-            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub_bytes.get(), pub_bytes_len, true)) != 0) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub33, true)) != 0");
-            }
-            bytes.assign((char *)pub_bytes.get(), pub_bytes_len);
-            break;
-        }
-        case 1: // Edwards curve
-        {
-            // For Ed25519
-            uint8_t pub33[33];
-            char y_is_odd = edwards_point_[0] & 0x1 ;
-            pub33[0] = 0x02 + y_is_odd; // 0x02 or 0x03
-            x().ToBytes32BE(pub33 + 1);
-            bytes.assign((char *)pub33, 33);
-            memset(pub33, 0, sizeof pub33);
-            break;
-        }
-        default:
-            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "Invalid Curve Type!");
-    }
+    uint8_t pub33[33];
+    EncodeCompressed(pub33);
+    bytes.assign((char *)pub33, 33);
+    memset(pub33, 0, sizeof pub33);
 }
 
 bool CurvePoint::DecodeCompressed(const std::string &bytes, CurveType c_type){
@@ -611,38 +695,10 @@ void CurvePoint::EncodeFull(std::string &bytes) const{
     }
 
     // Full public key
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int coord_len = CoordinateLength(curve_type_);
-            if(coord_len < 0){
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, coord_len, "invalid CoordinateLength");
-            }
-            // 02/03 + X + Y
-            int pub_bytes_len = coord_len * 2 + 1;
-            std::unique_ptr<uint8_t[], ByteArrayDeleter> pub_bytes(new uint8_t[pub_bytes_len], ByteArrayDeleter(pub_bytes_len));
-            int ret = 0;
-            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub_bytes.get(), pub_bytes_len, false)) != 0) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub_bytes.get(), pub_bytes_len, false) != 0");
-            }
-            bytes.assign((char *)pub_bytes.get(), pub_bytes_len);
-            break;
-        }
-        case 1: // Edwards curve
-        {
-            // For Ed25519
-            uint8_t pub65[65];
-            pub65[0] = 0x04;
-            x().ToBytes32BE(pub65 + 1);
-            y().ToBytes32BE(pub65 + 33);
-            bytes.assign((const char *)pub65, 65);
-            memset(pub65, 0, 65);
-            break;
-        }
-        default:
-            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "Invalid curve type!");
-    }
+    uint8_t pub65[65];
+    EncodeFull(pub65);
+    bytes.assign((const char *)pub65, 65);
+    memset(pub65, 0, 65);
 }
 
 bool CurvePoint::DecodeFull(const std::string &bytes, CurveType c_type){
@@ -726,101 +782,114 @@ bool CurvePoint::DecodeEdwardsPoint(const std::string &bytes, CurveType c_type){
 }
 
 
-CurvePoint CurvePoint::operator+(const CurvePoint &point) const {
+CurvePoint CurvePoint::operator+(const CurvePoint &point) const & {
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
     ASSERT_THROW(curve_type_ == point.curve_type_);
     CurvePoint res(*this);
-
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int ret = 0;
-            if ((ret = EC_POINT_add(curve_grp_, res.short_point_, point.short_point_, res.short_point_, nullptr)) != 1) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_add(curve_grp_, res.short_point_, point.short_point_, res.short_point_, nullptr)) != 1");
-            }
-            break;
-        }
-        case 1: // Edwards curve
-        {
-            // For Ed25519
-            ed25519_cosi_combine_two_publickeys(res.edwards_point_, edwards_point_, point.edwards_point_);
-            break;
-        }
-        default:
-            break;
-    }
+    res += point;
     return res;
 }
 
-CurvePoint CurvePoint::operator-(const CurvePoint &point) const {
+CurvePoint CurvePoint::operator+(const CurvePoint &point) && {
+    *this += point;
+    return std::move(*this);
+}
+
+CurvePoint CurvePoint::operator-(const CurvePoint &point) const & {
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
     ASSERT_THROW(curve_type_ == point.curve_type_);
-    CurvePoint res = *this + point.Neg();
+    CurvePoint res(*this);
+    res -= point;
     return res;
 }
 
-CurvePoint CurvePoint::operator*(const safeheron::bignum::BN &bn) const {
+CurvePoint CurvePoint::operator-(const CurvePoint &point) && {
+    *this -= point;
+    return std::move(*this);
+}
+
+CurvePoint CurvePoint::operator*(const safeheron::bignum::BN &bn) const & {
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
     CurvePoint res(*this);
-    const safeheron::curve::Curve *curv = safeheron::curve::GetCurveParam(curve_type_);
+    res *= bn;
+    return res;
+}
+
+CurvePoint CurvePoint::operator*(const safeheron::bignum::BN &bn) && {
+    *this *= bn;
+    return std::move(*this);
+}
+
+CurvePoint CurvePoint::operator*(long n) const & {
+    BN bn(n);
+    return *this * bn;
+}
+
+CurvePoint CurvePoint::operator*(long n) && {
+    BN bn(n);
+    *this *= bn;
+    return std::move(*this);
+}
+
+CurvePoint &CurvePoint::operator+=(const CurvePoint &point){
+    ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
+    ASSERT_THROW(curve_type_ == point.curve_type_);
+    ClearAffineCache();
     uint32_t category = get_category(curve_type_);
     switch (category) {
         case 0: // Short curve
         {
             int ret = 0;
-            BN k = bn % curv->n;
-            if ((ret = EC_POINT_mul(curve_grp_, res.short_point_, nullptr, res.short_point_, k.GetBIGNUM(), nullptr)) != 1) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_mul(curve_grp_, res.short_point_, nullptr, res.short_point_, k.GetBIGNUM(), nullptr)) != 1");
+            if ((ret = EC_POINT_add(curve_grp_, short_point_, point.short_point_, short_point_, nullptr)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_add(curve_grp_, short_point_, point.short_point_, short_point_, nullptr)) != 1");
             }
             break;
         }
         case 1: // Edwards curve
         {
             // For Ed25519
-            ed25519_secret_key sk;
-            if(bn.ByteLength() > 32){
-                BN t_bn = bn % curv->n;
-                t_bn.ToBytes32LE(sk);
-            } else{
-                bn.ToBytes32LE(sk);
-            }
-            if(*this == curv->g){
-                // Fast multiply
-                ed25519_publickey_pure(sk, res.edwards_point_);
-            }else{
-                ed25519_scalarmult_pure(res.edwards_point_, sk, edwards_point_);
-            }
+            ed25519_cosi_combine_two_publickeys(edwards_point_, edwards_point_, point.edwards_point_);
             break;
         }
         default:
             break;
     }
-    return res;
-}
-
-CurvePoint CurvePoint::operator*(long n) const {
-    BN bn(n);
-    return *this * bn;
+    return *this;
 }
 
-CurvePoint &CurvePoint::operator+=(const CurvePoint &point){
+CurvePoint &CurvePoint::operator-=(const CurvePoint &point){
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
     ASSERT_THROW(curve_type_ == point.curve_type_);
+    ClearAffineCache();
     uint32_t category = get_category(curve_type_);
     switch (category) {
         case 0: // Short curve
         {
             int ret = 0;
+            if (this == &point) {
+                if ((ret = EC_POINT_set_to_infinity(curve_grp_, short_point_)) != 1) {
+                    throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_set_to_infinity(curve_grp_, short_point_)) != 1");
+                }
+                break;
+            }
+            // this - point = -(-this + point), without a copy of "point"
+            if ((ret = EC_POINT_invert(curve_grp_, short_point_, nullptr)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_invert(curve_grp_, short_point_, nullptr)) != 1");
+            }
             if ((ret = EC_POINT_add(curve_grp_, short_point_, point.short_point_, short_point_, nullptr)) != 1) {
                 throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_add(curve_grp_, short_point_, point.short_point_, short_point_, nullptr)) != 1");
             }
+            if ((ret = EC_POINT_invert(curve_grp_, short_point_, nullptr)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_invert(curve_grp_, short_point_, nullptr)) != 1");
+            }
             break;
         }
         case 1: // Edwards curve
         {
             // For Ed25519
-            ed25519_cosi_combine_two_publickeys(edwards_point_, edwards_point_, point.edwards_point_);
+            ed25519_public_key neg_point;
+            ed25519_publickey_neg(neg_point, point.edwards_point_);
+            ed25519_cosi_combine_two_publickeys(edwards_point_, edwards_point_, neg_point);
             break;
         }
         default:
@@ -829,15 +898,9 @@ CurvePoint &CurvePoint::operator+=(const CurvePoint &point){
     return *this;
 }
 
-CurvePoint &CurvePoint::operator-=(const CurvePoint &point){
-    ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
-    ASSERT_THROW(curve_type_ == point.curve_type_);
-    *this = *this + point.Neg();
-    return *this;
-}
-
 CurvePoint &CurvePoint::operator*=(const safeheron::bignum::BN &bn){
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
+    SAFEHERON_COUNT_CURVE_MUL(curve_type_);
     const safeheron::curve::Curve *curv = safeheron::curve::GetCurveParam(curve_type_);
     uint32_t category = get_category(curve_type_);
     switch (category) {
@@ -845,6 +908,33 @@ CurvePoint &CurvePoint::operator*=(const safeheron::bignum::BN &bn){
         {
             int ret = 0;
             BN k = bn % curv->n;
+#if ENABLE_SECP256K1_NATIVE
+            if (curve_type_ == CurveType::SECP256K1) {
+                // The native backend works in affine coordinates, so the result is cached as it is.
+                uint8_t xy[64];
+                uint8_t rxy[64];
+                bool is_infinity = k.IsZero() || IsInfinity();
+                if (!is_infinity) {
+                    LoadAffine(xy);
+                    is_infinity = !secp256k1_native_mul(rxy, xy, k);
+                }
+                ClearAffineCache();
+                if (is_infinity) {
+                    if ((ret = EC_POINT_set_to_infinity(curve_grp_, short_point_)) != 1) {
+                        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_set_to_infinity(curve_grp_, short_point_)) != 1");
+                    }
+                } else {
+                    BN x = BN::FromBytesBE(rxy, 32);
+                    BN y = BN::FromBytesBE(rxy + 32, 32);
+                    if ((ret = EC_POINT_set_affine_coordinates(curve_grp_, short_point_, x.GetBIGNUM(), y.GetBIGNUM(), nullptr)) != 1) {
+                        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_set_affine_coordinates(curve_grp_, short_point_, x.GetBIGNUM(), y.GetBIGNUM(), nullptr)) != 1");
+                    }
+                    StoreAffine(rxy);
+                }
+                break;
+            }
+#endif //ENABLE_SECP256K1_NATIVE
+            ClearAffineCache();
             if ((ret = EC_POINT_mul(curve_grp_, short_point_, nullptr, short_point_, k.GetBIGNUM(), nullptr)) != 1) {
                 throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_mul(curve_grp_, short_point_, nullptr, short_point_, k.GetBIGNUM(), nullptr)) != 1");
             }
@@ -860,7 +950,14 @@ CurvePoint &CurvePoint::operator*=(const safeheron::bignum::BN &bn){
             } else{
                 bn.ToBytes32LE(sk);
             }
-            ed25519_scalarmult_pure(edwards_point_, sk, edwards_point_);
+            bool is_generator = (*this == curv->g);
+            ClearAffineCache();
+            if(is_generator){
+                // Fast multiply
+                ed25519_publickey_pure(sk, edwards_point_);
+            }else{
+                ed25519_scalarmult_pure(edwards_point_, sk, edwards_point_);
+            }
             break;
         }
         default:
@@ -875,10 +972,15 @@ CurvePoint &CurvePoint::operator*=(long n){
     return *this;
 }
 
-CurvePoint CurvePoint::Neg() const {
+CurvePoint CurvePoint::Neg() const & {
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
-
     CurvePoint res(*this);
+    return std::move(res).Neg();
+}
+
+CurvePoint CurvePoint::Neg() && {
+    ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
+    ClearAffineCache();
 
     uint32_t category = get_category(curve_type_);
     switch (category) {
@@ -886,21 +988,46 @@ CurvePoint CurvePoint::Neg() const {
         {
             int ret = 0;
             // (x, y) => (x, -y)
-            if ((ret = EC_POINT_invert(curve_grp_, res.short_point_, nullptr)) != 1) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_invert(curve_grp_, res.short_point_, nullptr)) != 1");
+            if ((ret = EC_POINT_invert(curve_grp_, short_point_, nullptr)) != 1) {
+                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = EC_POINT_invert(curve_grp_, short_point_, nullptr)) != 1");
             }
             break;
         }
         case 1: // Edwards curve
         {
             // For Ed25519
-            ed25519_publickey_neg(res.edwards_point_, (unsigned char *)edwards_point_);
+            ed25519_publickey_neg(edwards_point_, edwards_point_);
             break;
         }
         default:
             break;
     }
-    return res;
+    return std::move(*this);
+}
+
+void CurvePoint::NormalizeBatch(std::vector<CurvePoint> &points) {
+    if (points.empty()) return;
+    CurveType c_type = points[0].curve_type_;
+    if (c_type == CurveType::INVALID_CURVE || get_category(c_type) != 0) return;
+
+    std::vector<ec_point_st *> short_points;
+    short_points.reserve(points.size());
+    for (CurvePoint &point : points) {
+        ASSERT_THROW(point.curve_type_ == c_type);
+        if (!point.IsInfinity()) short_points.push_back(point.short_point_);
+    }
+    if (short_points.empty()) return;
+
+    int ret = 0;
+    if ((ret = safeheron::_openssl_curve_wrapper::make_affine(points[0].curve_grp_, short_points.size(), short_points.data())) != 0) {
+        throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::make_affine(points[0].curve_grp_, short_points.size(), short_points.data())) != 0");
+    }
+
+    // Z = 1 now, so filling the caches is a plain copy of the coordinates.
+    uint8_t xy[64];
+    for (CurvePoint &point : points) {
+        if (!point.IsInfinity()) point.LoadAffine(xy);
+    }
 }
 
 bool CurvePoint::operator==(const CurvePoint &point) const {
@@ -911,7 +1038,12 @@ bool CurvePoint::operator==(const CurvePoint &point) const {
     switch (category) {
         case 0: // Short curve
         {
-            if (EC_POINT_cmp(curve_grp_, short_point_, point.short_point_, nullptr) == 0) {
+            if (same_type &&
+                affine_state_.load(std::memory_order_acquire) == AFFINE_READY &&
+                point.affine_state_.load(std::memory_order_acquire) == AFFINE_READY) {
+                // Both are known in affine coordinates
+                same_mem = (memcmp(affine_xy_, point.affine_xy_, sizeof(affine_xy_)) == 0);
+            } else if (EC_POINT_cmp(curve_grp_, short_point_, point.short_point_, nullptr) == 0) {
                 same_mem = true;
             }
             break;
@@ -935,86 +1067,20 @@ bool CurvePoint::operator!=(const CurvePoint &point) const {
 
 safeheron::bignum::BN CurvePoint::x() const {
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int coord_len = CoordinateLength(curve_type_);
-            if(coord_len < 0){
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, coord_len, "invalid CoordinateLength");
-            }
-            // 02/03 + x + y
-            int pub_bytes_len = coord_len * 2 + 1;
-            std::unique_ptr<uint8_t[], ByteArrayDeleter> pub_bytes(new uint8_t[pub_bytes_len], ByteArrayDeleter(pub_bytes_len));
-            int ret = 0;
-            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub_bytes.get(), pub_bytes_len, false)) != 0) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, xy, false)) != 0");
-            }
-            // return x
-            return safeheron::bignum::BN::FromBytesBE(pub_bytes.get() + 1, coord_len);
-        }
-        case 1: // Edwards curve
-        {
-            // For Ecdsa, not only Ed25519
-            // Get y coordinate, Reverse copy
-            bool x_is_odd = (edwards_point_[31] & 0x80) != 0;
-            BN y = this->y();
-
-            // Get x
-            const safeheron::curve::Curve *curv = safeheron::curve::GetCurveParam(curve_type_);
-            // x^2 = (y^2 - c^2) / (c^2 d y^2 - a)
-            BN y_sqr = (y * y) % curv->p;
-            BN c_sqr = (curv->c * curv->c) % curv->p;
-            // u = (y^2 - c^2)
-            BN u = (y_sqr - c_sqr) % curv->p;
-            // v = (c^2 d y^2 - a)
-            BN v = (c_sqr * curv->d * y_sqr - curv->a) % curv->p;
-            BN x_sqr = (u * v.InvM(curv->p)) % curv->p;
-
-            BN x = x_sqr.SqrtM(curv->p);
-            if ((x.IsOdd() && !x_is_odd) || (!x.IsOdd() && x_is_odd)) {
-                x = curv->p - x;
-            }
-            return x;
-        }
-        default:
-            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "Unexpected exception in CurvePoint::x()");
-    }
+    uint8_t xy[64];
+    LoadAffine(xy);
+    return BN::FromBytesBE(xy, 32);
 }
 
 safeheron::bignum::BN CurvePoint::y() const {
     ASSERT_THROW(curve_type_ != CurveType::INVALID_CURVE);
-    BN y;
-    uint32_t category = get_category(curve_type_);
-    switch (category) {
-        case 0: // Short curve
-        {
-            int coord_len = CoordinateLength(curve_type_);
-            if(coord_len < 0){
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, coord_len, "invalid CoordinateLength");
-            }
-            // 02/03 + x + y
-            int pub_bytes_len = coord_len * 2 + 1;
-            std::unique_ptr<uint8_t[], ByteArrayDeleter> pub_bytes(new uint8_t[pub_bytes_len], ByteArrayDeleter(pub_bytes_len));
-            int ret = 0;
-            if ((ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, pub_bytes.get(), pub_bytes_len, false)) != 0) {
-                throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "(ret = safeheron::_openssl_curve_wrapper::encode_ec_point(curve_grp_, short_point_, xy, false)) != 0");
-            }
-            // return Y
-            return safeheron::bignum::BN::FromBytesBE(pub_bytes.get() + coord_len + 1, coord_len);
-        }
-        case 1: // Edwards curve
-        {
-            // For Ed25519
-            // Get y coordinate, Reverse copy
-            uint8_t point_y[32];
-            memcpy(point_y, edwards_point_, 32);
-            point_y[31] &= 0x7f;
-            return BN::FromBytesLE(point_y, 32);
-        }
-        default:
-            throw LocatedException(__FILE__, __LINE__, __FUNCTION__, -1, "Unexpected exception in CurvePoint::y()");
+    if (get_category(curve_type_) == 1) {
+        // y is stored in the encoding of an edwards point, while x would cost a square root.
+        return edwards_y(edwards_point_);
     }
+    uint8_t xy[64];
+    LoadAffine(xy);
+    return BN::FromBytesBE(xy + 32, 32);
 }
 
 bool CurvePoint::ToProtoObject(safeheron::proto::CurvePoint &point) const {
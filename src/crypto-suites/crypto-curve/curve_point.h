@@ -1,6 +1,8 @@
 #ifndef SAFEHERON_CURVE_POINT_H
 #define SAFEHERON_CURVE_POINT_H
 
+#include <atomic>
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/proto_gen/curve_point.pb.switch.h"
 #include "crypto-suites/crypto-curve/curve_type.h"
@@ -26,6 +28,8 @@ class CurvePoint {
         ec_point_st* short_point_;  /**< a pointer to a struct "ec_point_st" */
         ed25519_public_key_byte32 edwards_point_;  /**< a memory to store the point on curve ed25519. */
     };
+    mutable std::atomic<uint8_t> affine_state_;  /**< state of affine_xy_: empty, being filled or ready. */
+    mutable uint8_t affine_xy_[64];  /**< cached affine coordinates x || y, 32 bytes each in big endian. */
 
 public:
     /**
@@ -82,8 +86,19 @@ public:
      * @return A CurvePoint object.
      */
     CurvePoint &operator=(const CurvePoint &point);
-    //CurvePoint(CurvePoint &&num) noexcept;           // move constructor
-    //CurvePoint &operator=(CurvePoint &&point) noexcept;// move assignment
+
+    /**
+     * Move constructor.
+     * @param[in,out] point a blank CurvePoint afterwards.
+     */
+    CurvePoint(CurvePoint &&point) noexcept;
+
+    /**
+     * Move assignment operator.
+     * @param[in,out] point a blank CurvePoint afterwards.
+     * @return A CurvePoint object.
+     */
+    CurvePoint &operator=(CurvePoint &&point) noexcept;
 
     /**
      * Destructor.
@@ -274,7 +289,18 @@ public:
      * @param[in] point
      * @return Res = *this + point
      */
-    CurvePoint operator+(const CurvePoint &point) const;
+    CurvePoint operator+(const CurvePoint &point) const &;
+
+    /**
+     * Addition on curve, the temporary on the left side being reused for the result.
+     * \code{.cpp}
+     *      CurvePoint p2 = g * a + h * b;  // g * a is added in place
+     * \endcode
+     * @param[in] point
+     * @return Res = *this + point
+     */
+    CurvePoint operator+(const CurvePoint &point) &&;
+
 
     /**
      * Subtraction on curve.
@@ -287,7 +313,15 @@ public:
      * @param[in] point
      * @return Res = *this - point
      */
-    CurvePoint operator-(const CurvePoint &point) const;
+    CurvePoint operator-(const CurvePoint &point) const &;
+
+    /**
+     * Subtraction on curve, the temporary on the left side being reused for the result.
+     * @param[in] point
+     * @return Res = *this - point
+     */
+    CurvePoint operator-(const CurvePoint &point) &&;
+
 
     /**
      * Multiplication on curve.
@@ -300,7 +334,18 @@ public:
      * @param[in] point
      * @return Res = (*this) * bn
      */
-    CurvePoint operator*(const safeheron::bignum::BN &bn) const;
+    CurvePoint operator*(const safeheron::bignum::BN &bn) const &;
+
+    /**
+     * Multiplication on curve, the temporary on the left side being reused for the result.
+     * \code{.cpp}
+     *      CurvePoint p2 = (p0 + p1) * n;  // p0 + p1 is multiplied in place
+     * \endcode
+     * @param[in] bn
+     * @return Res = (*this) * bn
+     */
+    CurvePoint operator*(const safeheron::bignum::BN &bn) &&;
+
 
     /**
      * Multiplication on curve.
@@ -313,7 +358,15 @@ public:
      * @param[in] point
      * @return Res = (*this) * n
      */
-    CurvePoint operator*(long n) const;
+    CurvePoint operator*(long n) const &;
+
+    /**
+     * Multiplication on curve, the temporary on the left side being reused for the result.
+     * @param[in] n
+     * @return Res = (*this) * n
+     */
+    CurvePoint operator*(long n) &&;
+
 
     /**
      * Self-Addition on curve.
@@ -377,7 +430,24 @@ public:
      * \endcode
      * @return A CurvePoint object.
      */
-    CurvePoint Neg() const;
+    CurvePoint Neg() const &;
+
+    /**
+     * Get negative of a temporary CurvePoint, which is negated in place.
+     * @return A CurvePoint object.
+     */
+    CurvePoint Neg() &&;
+
+
+    /**
+     * Convert the points to affine coordinates, sharing one field inversion among all of them.
+     * The values of the points do not change, and their affine coordinates are cached,
+     * so that x(), y(), the encodings and comparisons afterwards need no inversion.
+     *
+     * It's a no-op for Ed25519 points, which are always stored encoded.
+     * @param[in,out] points points of the same curve, infinity points are allowed.
+     */
+    static void NormalizeBatch(std::vector<CurvePoint> &points);
 
     /**
      * Comparison between two points.
@@ -407,6 +477,7 @@ public:
 
     /**
      * Get coordinate x of the point
+     * @note The affine coordinates are computed once, and cached until the point changes.
      * @return coordinate x
      * @warning throw exception if the point is infinity and the curve is not Ed25519
      */
@@ -479,6 +550,31 @@ private:
      */
     void Reset();
 
+    /**
+     * Drop the cached affine coordinates, must be called whenever the point changes.
+     */
+    void ClearAffineCache();
+
+    /**
+     * Copy the cached affine coordinates of "point", if any.
+     * @param[in] point
+     */
+    void CopyAffineCache(const CurvePoint &point);
+
+    /**
+     * Get the affine coordinates x || y of the point, which are computed only once and cached afterwards.
+     * @param[out] xy64 x || y, 32 bytes each in big endian.
+     * @warning Throw an exception for the infinity point of short curves.
+     */
+    void LoadAffine(uint8_t xy64[64]) const;
+
+    /**
+     * Publish the affine coordinates of the point into the cache.
+     * It's safe to be called concurrently on a shared const point, the first caller wins.
+     * @param[in] xy64 x || y, 32 bytes each in big endian.
+     */
+    void StoreAffine(const uint8_t xy64[64]) const;
+
 };
 
 };
@@ -0,0 +1,77 @@
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
+
+using safeheron::bignum::BN;
+
+namespace safeheron{
+namespace curve{
+
+/**
+ * The w bits of the little endian buffer starting at bit 'bit'.
+ */
+static uint32_t window_digit(const uint8_t *le, size_t bit, int w) {
+    uint32_t v = (uint32_t)le[bit / 8] | ((uint32_t)le[bit / 8 + 1] << 8);
+    return (v >> (bit % 8)) & ((1u << w) - 1);
+}
+
+FixedBaseTable::FixedBaseTable(const CurvePoint &base, int window_bits)
+        : base_(base), window_bits_(window_bits), windows_(0) {
+    ASSERT_THROW(base.GetCurveType() != CurveType::INVALID_CURVE);
+    ASSERT_THROW(window_bits >= 1 && window_bits <= 8);
+
+    const Curve *curv = GetCurveParam(base.GetCurveType());
+    ASSERT_THROW(curv != nullptr);
+    // ed25519-donna multiplies the generator with a table of its own already.
+    bool ed25519_generator = (base.GetCurveType() == CurveType::ED25519 && base == curv->g);
+    if (ed25519_generator || base.IsInfinity()) return;
+
+    order_ = curv->n;
+    size_t bits = order_.BitLength();
+    ASSERT_THROW(bits <= 256);
+    windows_ = (bits + window_bits - 1) / window_bits;
+    size_t digits = (1u << window_bits) - 1;
+
+    // Row i is 1 * B, 2 * B, ... (2^w - 1) * B where B = 2^(w*i) * base, and the next B is (2^w - 1) * B + B.
+    table_.reserve(windows_ * digits);
+    CurvePoint row_base = base;
+    for (size_t i = 0; i < windows_; ++i) {
+        table_.push_back(row_base);
+        for (size_t d = 2; d <= digits; ++d) {
+            table_.push_back(table_.back() + row_base);
+        }
+        if (i + 1 < windows_) row_base = table_.back() + row_base;
+    }
+    // Entries in affine coordinates make the additions of Mul cheaper.
+    CurvePoint::NormalizeBatch(table_);
+}
+
+CurvePoint FixedBaseTable::Mul(const BN &k) const {
+    if (table_.empty() || k.IsNeg()) return base_ * k;
+
+    SAFEHERON_COUNT_CURVE_MUL(base_.GetCurveType());
+
+    uint8_t le[34] = {0};
+    if (k >= order_) {
+        (k % order_).ToBytes32LE(le);
+    } else {
+        k.ToBytes32LE(le);
+    }
+    size_t digits = (1u << window_bits_) - 1;
+    CurvePoint r(base_.GetCurveType());
+    for (size_t i = 0; i < windows_; ++i) {
+        uint32_t d = window_digit(le, i * window_bits_, window_bits_);
+        if (d != 0) r += table_[i * digits + d - 1];
+    }
+    return r;
+}
+
+CurvePoint FixedBaseMul(const CurvePoint &P, const FixedBaseTable *table, const BN &k) {
+    if (table == nullptr) return P * k;
+    ASSERT_THROW(&table->Base() == &P || table->Base() == P);
+    return table->Mul(k);
+}
+
+}
+}
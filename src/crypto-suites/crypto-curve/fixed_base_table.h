@@ -0,0 +1,78 @@
+#ifndef SAFEHERON_CURVE_FIXED_BASE_TABLE_H
+#define SAFEHERON_CURVE_FIXED_BASE_TABLE_H
+
+#include <vector>
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/crypto-curve/curve_point.h"
+
+namespace safeheron{
+namespace curve{
+
+/**
+ * Precomputed multiples of a point which is used as the base of many multiplications,
+ * such as the generators of a Pedersen commitment or an ElGamal public key.
+ *
+ * The table holds d * 2^(w*i) * P for every window i and every digit 1 <= d < 2^w,
+ * so that P * k costs one point addition per non-zero window of k and no doubling at all.
+ * The table of a 256-bits curve with the default w = 4 has 960 points.
+ *
+ * The table is read-only once built and can be shared by several threads.
+ * \code{.cpp}
+ *      FixedBaseTable table(H);
+ *      CurvePoint P = table.Mul(k);   // P == H * k
+ * \endcode
+ *
+ * Mul is not constant time: it skips the zero digits of k and its loads depend on the digits. Use it only for
+ * public scalars, such as those of a verification, never for a secret key or the nonce of a prover.
+ */
+class FixedBaseTable {
+public:
+    /**
+     * Default width of a window in bits.
+     */
+    static const int DEFAULT_WINDOW_BITS = 4;
+
+    /**
+     * Build the table of the point.
+     * @param[in] base a valid point, it may be the point at infinity.
+     * @param[in] window_bits width of a window in bits, from 1 to 8.
+     */
+    explicit FixedBaseTable(const CurvePoint &base, int window_bits = DEFAULT_WINDOW_BITS);
+
+    /**
+     * @return the base point.
+     */
+    const CurvePoint &Base() const { return base_; }
+
+    /**
+     * Compute Base() * k, the same point as operator*, that is (k mod n) * Base() where n is the order of the curve.
+     * k must be public, see above.
+     *
+     * Non-negative scalars are computed with the table, negative ones fall back to Base() * k.
+     * So does the generator of Ed25519, which has a table of its own.
+     * @param[in] k
+     * @return Base() * k
+     */
+    CurvePoint Mul(const safeheron::bignum::BN &k) const;
+
+private:
+    CurvePoint base_;
+    int window_bits_;
+    size_t windows_;
+    safeheron::bignum::BN order_;  /**< order of the curve */
+    std::vector<CurvePoint> table_;  /**< table_[i * (2^w - 1) + d - 1] = d * 2^(w*i) * base_ */
+};
+
+/**
+ * Compute P * k, through the table of P if there is one. k must be public unless table is nullptr.
+ * @param[in] P
+ * @param[in] table nullptr or a table whose base is P.
+ * @param[in] k
+ * @return P * k
+ */
+CurvePoint FixedBaseMul(const CurvePoint &P, const FixedBaseTable *table, const safeheron::bignum::BN &k);
+
+}
+}
+
+#endif //SAFEHERON_CURVE_FIXED_BASE_TABLE_H
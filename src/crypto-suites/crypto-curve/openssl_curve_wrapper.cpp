@@ -1,3 +1,6 @@
+// EC_POINTs_make_affine is deprecated since OpenSSL 3.0 without a replacement. This file is the only caller,
+// so the deprecation warnings are silenced here and nowhere else.
+#define OPENSSL_SUPPRESS_DEPRECATED
 #include <cassert>
 #include <openssl/ec.h>
 #include <cstring>
@@ -107,5 +110,44 @@ err:
     return ret;
 }
 
+int make_affine(const ec_group_st* grp, size_t num, ec_point_st* points[])
+{
+#ifndef OPENSSL_NO_DEPRECATED_3_0
+    // A single field inversion for all the points
+    if (EC_POINTs_make_affine(grp, num, points, nullptr) != 1) return -1;
+    return 0;
+#else
+    // One field inversion per point
+    int ret = 0;
+    BIGNUM* bn_x = nullptr;
+    BIGNUM* bn_y = nullptr;
+
+    if (!(bn_x = BN_new()) ||
+        !(bn_y = BN_new())) {
+        ret = -1;
+        goto err;
+    }
+
+    for (size_t i = 0; i < num; ++i) {
+        if (EC_POINT_get_affine_coordinates(grp, points[i], bn_x, bn_y, nullptr) != 1 ||
+            EC_POINT_set_affine_coordinates(grp, points[i], bn_x, bn_y, nullptr) != 1) {
+            ret = -2;
+            goto err;
+        }
+    }
+
+err:
+    if (bn_x) {
+        BN_clear_free(bn_x);
+        bn_x = nullptr;
+    }
+    if (bn_y) {
+        BN_clear_free(bn_y);
+        bn_y = nullptr;
+    }
+    return ret;
+#endif //OPENSSL_NO_DEPRECATED_3_0
+}
+
 }
 }
@@ -25,6 +25,18 @@ namespace _openssl_curve_wrapper
      * @warning Failed while the point is infinity.
      */
     int encode_ec_point(const ec_group_st* grp, const ec_point_st *pub, uint8_t* pub_bytes, int pub_bytes_len, bool compress);
+
+    /**
+     * Convert the points to affine coordinates, with a single field inversion for all of them unless OpenSSL is built
+     * without its deprecated functions.
+     * @param[in] grp the pointer to the elliptic curve group information.
+     * @param[in] num number of points.
+     * @param[in,out] points elliptic points, none of them at infinity.
+     * @return
+     *      @retval 0  success;
+     *      @retval <0 failure;
+     */
+    int make_affine(const ec_group_st* grp, size_t num, ec_point_st* points[]);
 };
 };
 
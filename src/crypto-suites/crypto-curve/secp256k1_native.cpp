@@ -0,0 +1,675 @@
+#include "crypto-suites/crypto-curve/secp256k1_native.h"
+
+#if ENABLE_SECP256K1_NATIVE
+
+#include <cstring>
+
+namespace safeheron{
+namespace _secp256k1_native
+{
+
+typedef unsigned __int128 uint128_t;
+
+static const uint64_t M52 = 0xFFFFFFFFFFFFFULL;
+static const uint64_t M48 = 0x0FFFFFFFFFFFFULL;
+// 2^256 mod p
+static const uint64_t R256 = 0x1000003D1ULL;
+// 2^260 mod p
+static const uint64_t R260 = 0x1000003D10ULL;
+
+/**
+ * Field element: n[0] + n[1] * 2^52 + ... + n[4] * 2^208, not necessarily less than p.
+ *
+ * After fe_mul, fe_sqr and fe_normalize_weak every limb is at most about 2^52, which is "magnitude 1". The sum of m
+ * such elements has magnitude m. fe_mul and fe_sqr accept inputs of magnitude up to 256, fe_negate up to 3.
+ */
+struct fe {
+    uint64_t n[5];
+};
+
+// 64 * p, used to negate without underflow.
+static const uint64_t P64[5] = {
+        0xFFFFEFFFFFC2FULL << 6, M52 << 6, M52 << 6, M52 << 6, M48 << 6
+};
+
+static const fe FE_ONE = {{1, 0, 0, 0, 0}};
+
+// beta^3 = 1 mod p, (beta * x, y) = lambda * (x, y)
+static const fe FE_BETA = {{0x96C28719501EEULL, 0x7512F58995C13ULL, 0xC3434E99CF049ULL, 0x07106E64479EAULL, 0x07AE96A2B657CULL}};
+
+static void fe_set_b32(fe &r, const uint8_t *a) {
+    uint64_t w[4];
+    for (int i = 0; i < 4; ++i) {
+        w[i] = 0;
+        for (int j = 0; j < 8; ++j) {
+            w[i] = (w[i] << 8) | a[(3 - i) * 8 + j];
+        }
+    }
+    r.n[0] = w[0] & M52;
+    r.n[1] = ((w[0] >> 52) | (w[1] << 12)) & M52;
+    r.n[2] = ((w[1] >> 40) | (w[2] << 24)) & M52;
+    r.n[3] = ((w[2] >> 28) | (w[3] << 36)) & M52;
+    r.n[4] = w[3] >> 16;
+}
+
+// "a" is fully normalized
+static void fe_get_b32(uint8_t *r, const fe &a) {
+    uint64_t w[4];
+    w[0] = a.n[0] | (a.n[1] << 52);
+    w[1] = (a.n[1] >> 12) | (a.n[2] << 40);
+    w[2] = (a.n[2] >> 24) | (a.n[3] << 28);
+    w[3] = (a.n[3] >> 36) | (a.n[4] << 16);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            r[(3 - i) * 8 + j] = (uint8_t)(w[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+// Magnitude 1: the limbs are carried, what is above 2^260 is folded back.
+static void fe_normalize_weak(fe &r) {
+    uint64_t t0 = r.n[0], t1 = r.n[1], t2 = r.n[2], t3 = r.n[3], t4 = r.n[4];
+    t1 += t0 >> 52; t0 &= M52;
+    t2 += t1 >> 52; t1 &= M52;
+    t3 += t2 >> 52; t2 &= M52;
+    t4 += t3 >> 52; t3 &= M52;
+    t0 += (t4 >> 52) * R260; t4 &= M52;
+    t1 += t0 >> 52; t0 &= M52;
+    r.n[0] = t0; r.n[1] = t1; r.n[2] = t2; r.n[3] = t3; r.n[4] = t4;
+}
+
+// The unique representation less than p.
+static void fe_normalize(fe &r) {
+    fe_normalize_weak(r);
+    uint64_t t0 = r.n[0], t1 = r.n[1], t2 = r.n[2], t3 = r.n[3], t4 = r.n[4];
+    // Fold what is above 2^256, twice as the carry of the first fold may reach 2^256 again.
+    for (int i = 0; i < 2; ++i) {
+        t0 += (t4 >> 48) * R256; t4 &= M48;
+        t1 += t0 >> 52; t0 &= M52;
+        t2 += t1 >> 52; t1 &= M52;
+        t3 += t2 >> 52; t2 &= M52;
+        t4 += t3 >> 52; t3 &= M52;
+    }
+    // t < 2^256, t >= p if and only if t + 2^256 - p >= 2^256
+    uint64_t u0 = t0 + R256;
+    uint64_t u1 = t1 + (u0 >> 52); u0 &= M52;
+    uint64_t u2 = t2 + (u1 >> 52); u1 &= M52;
+    uint64_t u3 = t3 + (u2 >> 52); u2 &= M52;
+    uint64_t u4 = t4 + (u3 >> 52); u3 &= M52;
+    uint64_t mask = 0 - (u4 >> 48);
+    u4 &= M48;
+    r.n[0] = (u0 & mask) | (t0 & ~mask);
+    r.n[1] = (u1 & mask) | (t1 & ~mask);
+    r.n[2] = (u2 & mask) | (t2 & ~mask);
+    r.n[3] = (u3 & mask) | (t3 & ~mask);
+    r.n[4] = (u4 & mask) | (t4 & ~mask);
+}
+
+static int fe_is_zero(const fe &a) {
+    fe t = a;
+    fe_normalize(t);
+    uint64_t z = t.n[0] | t.n[1] | t.n[2] | t.n[3] | t.n[4];
+    return (int)(((z | (0 - z)) >> 63) ^ 1);
+}
+
+static void fe_cmov(fe &r, const fe &a, int flag) {
+    uint64_t mask = 0 - (uint64_t)flag;
+    for (int i = 0; i < 5; ++i) {
+        r.n[i] = (r.n[i] & ~mask) | (a.n[i] & mask);
+    }
+}
+
+static void fe_add(fe &r, const fe &a) {
+    for (int i = 0; i < 5; ++i) r.n[i] += a.n[i];
+}
+
+static void fe_mul_int(fe &r, uint64_t k) {
+    for (int i = 0; i < 5; ++i) r.n[i] *= k;
+}
+
+// r = -a, "a" of magnitude up to 3, r of magnitude up to 64.
+static void fe_negate(fe &r, const fe &a) {
+    for (int i = 0; i < 5; ++i) r.n[i] = P64[i] - a.n[i];
+}
+
+// r = r / 2
+static void fe_half(fe &r) {
+    uint64_t mask = 0 - (r.n[0] & 1);
+    r.n[0] += 0xFFFFEFFFFFC2FULL & mask;
+    r.n[1] += M52 & mask;
+    r.n[2] += M52 & mask;
+    r.n[3] += M52 & mask;
+    r.n[4] += M48 & mask;
+    r.n[0] = (r.n[0] >> 1) + ((r.n[1] & 1) << 51);
+    r.n[1] = (r.n[1] >> 1) + ((r.n[2] & 1) << 51);
+    r.n[2] = (r.n[2] >> 1) + ((r.n[3] & 1) << 51);
+    r.n[3] = (r.n[3] >> 1) + ((r.n[4] & 1) << 51);
+    r.n[4] = r.n[4] >> 1;
+}
+
+// Reduce the 10 columns of a product: 2^260 = 0x1000003D10 mod p.
+static void fe_reduce_product(fe &r, const uint128_t c[10]) {
+    uint64_t t[9];
+    uint128_t acc = 0;
+    for (int k = 0; k < 9; ++k) {
+        acc += c[k];
+        t[k] = (uint64_t)acc & M52;
+        acc >>= 52;
+    }
+    uint128_t t9 = acc + c[9];
+
+    uint128_t d = (uint128_t)t[0] + (uint128_t)t[5] * R260;
+    r.n[0] = (uint64_t)d & M52; d >>= 52;
+    d += (uint128_t)t[1] + (uint128_t)t[6] * R260;
+    r.n[1] = (uint64_t)d & M52; d >>= 52;
+    d += (uint128_t)t[2] + (uint128_t)t[7] * R260;
+    r.n[2] = (uint64_t)d & M52; d >>= 52;
+    d += (uint128_t)t[3] + (uint128_t)t[8] * R260;
+    r.n[3] = (uint64_t)d & M52; d >>= 52;
+    d += (uint128_t)t[4] + t9 * R260;
+    r.n[4] = (uint64_t)d & M52; d >>= 52;
+
+    d = d * R260 + r.n[0];
+    r.n[0] = (uint64_t)d & M52; d >>= 52;
+    d += r.n[1];
+    r.n[1] = (uint64_t)d & M52; d >>= 52;
+    r.n[2] += (uint64_t)d;
+}
+
+static void fe_mul(fe &r, const fe &a, const fe &b) {
+    uint128_t c[10] = {0};
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            c[i + j] += (uint128_t)a.n[i] * b.n[j];
+        }
+    }
+    fe_reduce_product(r, c);
+}
+
+static void fe_sqr(fe &r, const fe &a) {
+    uint128_t c[10] = {0};
+    for (int i = 0; i < 5; ++i) {
+        c[2 * i] += (uint128_t)a.n[i] * a.n[i];
+        uint64_t a2 = a.n[i] * 2;
+        for (int j = i + 1; j < 5; ++j) {
+            c[i + j] += (uint128_t)a2 * a.n[j];
+        }
+    }
+    fe_reduce_product(r, c);
+}
+
+static void fe_sqr_n(fe &r, const fe &a, int n) {
+    fe_sqr(r, a);
+    for (int i = 1; i < n; ++i) fe_sqr(r, r);
+}
+
+/**
+ * r = a^(p - 2), with p - 2 = [223 ones] 0 [22 ones] 0000 1 0 11 0 1
+ * and x_k = a^(2^k - 1).
+ */
+static void fe_inv(fe &r, const fe &a) {
+    fe x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+    fe_sqr(x2, a); fe_mul(x2, x2, a);
+    fe_sqr(x3, x2); fe_mul(x3, x3, a);
+    fe_sqr_n(x6, x3, 3); fe_mul(x6, x6, x3);
+    fe_sqr_n(x9, x6, 3); fe_mul(x9, x9, x3);
+    fe_sqr_n(x11, x9, 2); fe_mul(x11, x11, x2);
+    fe_sqr_n(x22, x11, 11); fe_mul(x22, x22, x11);
+    fe_sqr_n(x44, x22, 22); fe_mul(x44, x44, x22);
+    fe_sqr_n(x88, x44, 44); fe_mul(x88, x88, x44);
+    fe_sqr_n(x176, x88, 88); fe_mul(x176, x176, x88);
+    fe_sqr_n(x220, x176, 44); fe_mul(x220, x220, x44);
+    fe_sqr_n(x223, x220, 3); fe_mul(x223, x223, x3);
+
+    fe_sqr_n(t, x223, 23); fe_mul(t, t, x22);
+    fe_sqr_n(t, t, 5); fe_mul(t, t, a);
+    fe_sqr_n(t, t, 3); fe_mul(t, t, x2);
+    fe_sqr_n(t, t, 2); fe_mul(r, t, a);
+}
+
+/**
+ * Affine point, never the point at infinity, coordinates of magnitude 1.
+ */
+struct ge {
+    fe x;
+    fe y;
+};
+
+/**
+ * Jacobian point (x / z^2, y / z^3), coordinates of magnitude 1.
+ */
+struct gej {
+    fe x;
+    fe y;
+    fe z;
+    int infinity;
+};
+
+static void gej_set_ge(gej &r, const ge &a) {
+    r.x = a.x;
+    r.y = a.y;
+    r.z = FE_ONE;
+    r.infinity = 0;
+}
+
+static void ge_neg(ge &r, const ge &a) {
+    r.x = a.x;
+    fe_negate(r.y, a.y);
+    fe_normalize_weak(r.y);
+}
+
+/**
+ * r = 2 * a, scaled by 1/2 to save multiplications:
+ *     L = 3/2 * X^2, S = Y^2, T = -X * S
+ *     X3 = L^2 + 2 * T
+ *     Y3 = -(L * (X3 + T) + S^2)
+ *     Z3 = Y * Z
+ * There is no point of order 2, Y is never zero.
+ */
+static void gej_double(gej &r, const gej &a) {
+    fe l, s, t;
+    r.infinity = a.infinity;
+    fe_mul(r.z, a.z, a.y);
+    fe_sqr(s, a.y);
+    fe_sqr(l, a.x);
+    fe_mul_int(l, 3);
+    fe_half(l);
+    fe_negate(t, s);
+    fe_mul(t, t, a.x);
+    fe_sqr(r.x, l);
+    fe_add(r.x, t);
+    fe_add(r.x, t);
+    fe_sqr(s, s);
+    fe_add(t, r.x);
+    fe_mul(r.y, t, l);
+    fe_add(r.y, s);
+    fe_negate(r.y, r.y);
+    fe_normalize_weak(r.x);
+    fe_normalize_weak(r.y);
+}
+
+/**
+ * r = a + b, a and b being distinct points and not opposite, neither of them at infinity.
+ */
+static void gej_add_distinct(gej &r, const gej &a, const gej &b) {
+    fe z1z1, z2z2, u1, u2, s1, s2, h, rr, h2, h3, t;
+    fe_sqr(z1z1, a.z);
+    fe_sqr(z2z2, b.z);
+    fe_mul(u1, a.x, z2z2);
+    fe_mul(u2, b.x, z1z1);
+    fe_mul(s1, a.y, b.z); fe_mul(s1, s1, z2z2);
+    fe_mul(s2, b.y, a.z); fe_mul(s2, s2, z1z1);
+    fe_negate(h, u1); fe_add(h, u2);
+    fe_negate(rr, s1); fe_add(rr, s2);
+    fe_sqr(h2, h);
+    fe_mul(h3, h, h2);
+    fe_mul(u1, u1, h2);
+    fe_mul(r.z, a.z, b.z); fe_mul(r.z, r.z, h);
+    // X3 = R^2 - H^3 - 2 * U1 * H^2
+    fe_sqr(r.x, rr);
+    fe_negate(t, h3); fe_add(r.x, t);
+    fe_negate(t, u1); fe_add(r.x, t); fe_add(r.x, t);
+    fe_normalize_weak(r.x);
+    // Y3 = R * (U1 * H^2 - X3) - S1 * H^3
+    fe_negate(t, r.x); fe_add(t, u1);
+    fe_mul(r.y, t, rr);
+    fe_mul(s1, s1, h3);
+    fe_negate(t, s1); fe_add(r.y, t);
+    fe_normalize_weak(r.y);
+    r.infinity = 0;
+}
+
+/**
+ * r = a + b for any a, b being finite, in constant time.
+ *
+ * The unified formula of Brier and Joye, with a = 0 for secp256k1:
+ *     lambda = (x1^2 + x1 * x2 + x2^2) / (y1 + y2)
+ *     x3 = lambda^2 - (x1 + x2)
+ *     2 * y3 = lambda * (x1 + x2 - 2 * x3) - (y1 + y2)
+ * works for doubling as well. In Jacobian coordinates with Z2 = 1:
+ *     U1 = X1, U2 = x2 * Z1^2, S1 = Y1, S2 = y2 * Z1^3
+ *     T = U1 + U2, M = S1 + S2, R = T^2 - U1 * U2, Q = -T * M^2
+ *     X3 = R^2 + Q
+ *     Y3 = -(R * (2 * X3 + Q) + M^4) / 2
+ *     Z3 = M * Z1
+ * It fails if y1 = -y2. Then either a = -b and Z3 = M * Z1 = 0 is the point at infinity, or x1 != x2 (secp256k1 has
+ * three points for every y) and lambda = (y1 - y2) / (x1 - x2) is used instead, that is R = 2 * S1, M = U1 - U2 and
+ * no M^4 term.
+ */
+static void gej_add_ge(gej &r, const gej &a, const ge &b) {
+    fe zz, u1, u2, s1, s2, t, tt, m, n, q, rr, m_alt, rr_alt;
+    fe_sqr(zz, a.z);
+    u1 = a.x;
+    fe_mul(u2, b.x, zz);
+    s1 = a.y;
+    fe_mul(s2, b.y, zz);
+    fe_mul(s2, s2, a.z);
+    t = u1; fe_add(t, u2);
+    m = s1; fe_add(m, s2);
+    fe_sqr(rr, t);
+    fe_negate(m_alt, u2);
+    fe_mul(tt, u1, m_alt);
+    fe_add(rr, tt);
+    int degenerate = fe_is_zero(m);
+    rr_alt = s1; fe_add(rr_alt, s1);
+    fe_add(m_alt, u1);
+    fe_cmov(rr_alt, rr, !degenerate);
+    fe_cmov(m_alt, m, !degenerate);
+    fe_sqr(n, m_alt);
+    fe_negate(q, t);
+    fe_mul(q, q, n);
+    fe_sqr(n, n);
+    fe_cmov(n, m, degenerate);
+    fe_sqr(t, rr_alt);
+    fe_mul(r.z, a.z, m_alt);
+    fe_add(t, q);
+    r.x = t;
+    fe_add(t, t);
+    fe_add(t, q);
+    fe_mul(t, t, rr_alt);
+    fe_add(t, n);
+    fe_negate(r.y, t);
+    fe_half(r.y);
+    fe_normalize_weak(r.x);
+    fe_normalize_weak(r.y);
+
+    fe_cmov(r.x, b.x, a.infinity);
+    fe_cmov(r.y, b.y, a.infinity);
+    fe_cmov(r.z, FE_ONE, a.infinity);
+    r.infinity = fe_is_zero(r.z);
+}
+
+/**
+ * Convert "n" Jacobian points, none of them at infinity, with a single inversion.
+ */
+static void ge_set_all_gej(ge *r, const gej *a, int n) {
+    fe prod[8];
+    prod[0] = a[0].z;
+    for (int i = 1; i < n; ++i) fe_mul(prod[i], prod[i - 1], a[i].z);
+    fe inv;
+    fe_inv(inv, prod[n - 1]);
+    for (int i = n - 1; i >= 0; --i) {
+        fe zi, zi2;
+        if (i > 0) {
+            fe_mul(zi, inv, prod[i - 1]);
+            fe_mul(inv, inv, a[i].z);
+        } else {
+            zi = inv;
+        }
+        fe_sqr(zi2, zi);
+        fe_mul(r[i].x, a[i].x, zi2);
+        fe_mul(zi2, zi2, zi);
+        fe_mul(r[i].y, a[i].y, zi2);
+    }
+}
+
+/**
+ * Scalars modulo the order n, 4 limbs of 64 bits.
+ */
+static const uint64_t N[4] = {0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL};
+// (n - 1) / 2
+static const uint64_t N_HALF[4] = {0xDFE92F46681B20A0ULL, 0x5D576E7357A4501DULL, 0xFFFFFFFFFFFFFFFFULL, 0x7FFFFFFFFFFFFFFFULL};
+// 2^256 - n
+static const uint64_t N_C[3] = {0x402DA1732FC9BEBFULL, 0x4551231950B75FC4ULL, 1};
+
+// Lattice basis of the GLV decomposition (a1, b1), (a2, b2) with b2 = a1
+static const uint64_t MINUS_B1[4] = {0x6F547FA90ABFE4C3ULL, 0xE4437ED6010E8828ULL, 0, 0};
+static const uint64_t MINUS_B2[4] = {0xD765CDA83DB1562CULL, 0x8A280AC50774346DULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL};
+// round(2^384 * b2 / n), round(2^384 * -b1 / n)
+static const uint64_t G1[4] = {0xE893209A45DBB031ULL, 0x3DAA8A1471E8CA7FULL, 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL};
+static const uint64_t G2[4] = {0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL, 0x6F547FA90ABFE4C4ULL, 0xE4437ED6010E8828ULL};
+static const uint64_t MINUS_LAMBDA[4] = {0xE0CFC810B51283CFULL, 0xA880B9FC8EC739C2ULL, 0x5AD9E3FD77ED9BA4ULL, 0xAC9C52B33FA3CF1FULL};
+
+static void scalar_set_b32(uint64_t r[4], const uint8_t *a) {
+    for (int i = 0; i < 4; ++i) {
+        r[i] = 0;
+        for (int j = 0; j < 8; ++j) {
+            r[i] = (r[i] << 8) | a[(3 - i) * 8 + j];
+        }
+    }
+}
+
+static void scalar_mul_512(uint64_t l[8], const uint64_t a[4], const uint64_t b[4]) {
+    memset(l, 0, 8 * sizeof(uint64_t));
+    for (int i = 0; i < 4; ++i) {
+        uint128_t carry = 0;
+        for (int j = 0; j < 4; ++j) {
+            carry += (uint128_t)a[i] * b[j] + l[i + j];
+            l[i + j] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        l[i + 4] = (uint64_t)carry;
+    }
+}
+
+// out = lo + hi * (2^256 - n), "out_len" limbs
+static void scalar_fold(uint64_t *out, int out_len, const uint64_t lo[4], const uint64_t *hi, int hi_len) {
+    for (int i = 0; i < out_len; ++i) out[i] = (i < 4) ? lo[i] : 0;
+    for (int i = 0; i < hi_len; ++i) {
+        uint128_t carry = 0;
+        for (int j = 0; j < 3; ++j) {
+            carry += (uint128_t)hi[i] * N_C[j] + out[i + j];
+            out[i + j] = (uint64_t)carry;
+            carry >>= 64;
+        }
+        for (int k = i + 3; k < out_len; ++k) {
+            carry += out[k];
+            out[k] = (uint64_t)carry;
+            carry >>= 64;
+        }
+    }
+}
+
+// r = a - n if a >= n, for a < 2^256 + 2^256 - n given as a[0..3] and the carry "overflow".
+static void scalar_reduce_once(uint64_t r[4], const uint64_t a[4], uint64_t overflow) {
+    uint64_t t[4];
+    uint128_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        carry += (uint128_t)a[i] + (i < 3 ? N_C[i] : 0);
+        t[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    uint64_t mask = 0 - (((uint64_t)carry | overflow) & 1);
+    for (int i = 0; i < 4; ++i) r[i] = (t[i] & mask) | (a[i] & ~mask);
+}
+
+static void scalar_mul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t l[8], m[7], p[5], q[5], s[5];
+    scalar_mul_512(l, a, b);
+    scalar_fold(m, 7, l, l + 4, 4);   // < 2^386
+    scalar_fold(p, 5, m, m + 4, 3);   // < 2^260
+    scalar_fold(q, 5, p, p + 4, 1);   // < 2^256 + 2^133
+    scalar_fold(s, 5, q, q + 4, 1);   // < 2^256
+    scalar_reduce_once(r, s, 0);
+}
+
+static void scalar_add(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+    uint64_t t[4];
+    uint128_t carry = 0;
+    for (int i = 0; i < 4; ++i) {
+        carry += (uint128_t)a[i] + b[i];
+        t[i] = (uint64_t)carry;
+        carry >>= 64;
+    }
+    scalar_reduce_once(r, t, (uint64_t)carry);
+}
+
+// r = round(a * g / 2^384)
+static void scalar_mul_shift_384(uint64_t r[4], const uint64_t a[4], const uint64_t g[4]) {
+    uint64_t l[8];
+    scalar_mul_512(l, a, g);
+    uint128_t t = (uint128_t)l[6] + (l[5] >> 63);
+    r[0] = (uint64_t)t;
+    t = (t >> 64) + l[7];
+    r[1] = (uint64_t)t;
+    r[2] = (uint64_t)(t >> 64);
+    r[3] = 0;
+}
+
+// 1 if a > (n - 1) / 2
+static int scalar_is_high(const uint64_t a[4]) {
+    uint128_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        borrow = (uint128_t)N_HALF[i] - a[i] - (uint64_t)borrow;
+        borrow = (borrow >> 64) & 1;
+    }
+    return (int)borrow;
+}
+
+// r = n - a if "flag" is set, a != 0
+static void scalar_cond_negate(uint64_t r[4], int flag) {
+    uint64_t t[4];
+    uint128_t borrow = 0;
+    for (int i = 0; i < 4; ++i) {
+        uint128_t d = (uint128_t)N[i] - r[i] - (uint64_t)borrow;
+        t[i] = (uint64_t)d;
+        borrow = (d >> 64) & 1;
+    }
+    uint64_t mask = 0 - (uint64_t)flag;
+    for (int i = 0; i < 4; ++i) r[i] = (t[i] & mask) | (r[i] & ~mask);
+}
+
+/**
+ * k = r1 + r2 * lambda mod n, with r1 and r2 in (-2^128, 2^128) once taken as signed values.
+ */
+static void scalar_split_lambda(uint64_t r1[4], uint64_t r2[4], const uint64_t k[4]) {
+    uint64_t c1[4], c2[4];
+    scalar_mul_shift_384(c1, k, G1);
+    scalar_mul_shift_384(c2, k, G2);
+    scalar_mul(c1, c1, MINUS_B1);
+    scalar_mul(c2, c2, MINUS_B2);
+    scalar_add(r2, c1, c2);
+    scalar_mul(r1, r2, MINUS_LAMBDA);
+    scalar_add(r1, r1, k);
+}
+
+static const int WINDOW = 4;
+static const int TABLE_SIZE = 1 << (WINDOW - 1);
+// ceil(129 / WINDOW)
+static const int DIGITS = 33;
+
+/**
+ * Signed digits s = d[0] + d[1] * 2^4 + ... + d[32] * 2^128, every digit odd in [-15, 15], for an odd s < 2^128.
+ *     d = (s mod 32) - 16, s = (s - d) / 16
+ */
+static void recode(int d[DIGITS], uint128_t s) {
+    for (int i = 0; i < DIGITS - 1; ++i) {
+        d[i] = (int)(s & 31) - 16;
+        s = (s >> WINDOW) + ((~s >> WINDOW) & 1);
+    }
+    d[DIGITS - 1] = (int)s;
+}
+
+// r = d * P from the odd multiples P, 3P, ..., 15P, in constant time.
+static void table_get(ge &r, const ge pre[TABLE_SIZE], int d) {
+    int sign = (int)((unsigned int)d >> 31);
+    int abs_d = (d ^ -sign) + sign;
+    int index = (abs_d - 1) >> 1;
+    r = pre[0];
+    for (int i = 1; i < TABLE_SIZE; ++i) {
+        int hit = (int)(((unsigned int)(i ^ index) - 1) >> 31);
+        fe_cmov(r.x, pre[i].x, hit);
+        fe_cmov(r.y, pre[i].y, hit);
+    }
+    fe neg_y;
+    fe_negate(neg_y, r.y);
+    fe_normalize_weak(neg_y);
+    fe_cmov(r.y, neg_y, sign);
+}
+
+static void table_cond_negate(ge pre[TABLE_SIZE], int flag) {
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        fe neg_y;
+        fe_negate(neg_y, pre[i].y);
+        fe_normalize_weak(neg_y);
+        fe_cmov(pre[i].y, neg_y, flag);
+    }
+}
+
+int point_mul(uint8_t rx[32], uint8_t ry[32], const uint8_t x[32], const uint8_t y[32], const uint8_t k[32]) {
+    ge p;
+    fe_set_b32(p.x, x);
+    fe_set_b32(p.y, y);
+
+    // Odd multiples of P, then of lambda * P.
+    gej pre_j[TABLE_SIZE];
+    gej p2;
+    gej_set_ge(pre_j[0], p);
+    gej_double(p2, pre_j[0]);
+    for (int i = 1; i < TABLE_SIZE; ++i) gej_add_distinct(pre_j[i], pre_j[i - 1], p2);
+    ge pre1[TABLE_SIZE], pre2[TABLE_SIZE];
+    ge_set_all_gej(pre1, pre_j, TABLE_SIZE);
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        fe_mul(pre2[i].x, pre1[i].x, FE_BETA);
+        pre2[i].y = pre1[i].y;
+    }
+
+    // k = s1 * (+-P) + s2 * (+-lambda * P), with 0 <= s1, s2 < 2^128
+    uint64_t sk[4], r1[4], r2[4];
+    scalar_set_b32(sk, k);
+    scalar_split_lambda(r1, r2, sk);
+    int neg1 = scalar_is_high(r1);
+    int neg2 = scalar_is_high(r2);
+    scalar_cond_negate(r1, neg1);
+    scalar_cond_negate(r2, neg2);
+    table_cond_negate(pre1, neg1);
+    table_cond_negate(pre2, neg2);
+
+    // Odd digits only: an even s is replaced with s + 1, P is subtracted at the end.
+    uint128_t s1 = ((uint128_t)r1[1] << 64) | r1[0];
+    uint128_t s2 = ((uint128_t)r2[1] << 64) | r2[0];
+    int even1 = (int)(~r1[0] & 1);
+    int even2 = (int)(~r2[0] & 1);
+    s1 += (uint64_t)even1;
+    s2 += (uint64_t)even2;
+    int d1[DIGITS], d2[DIGITS];
+    recode(d1, s1);
+    recode(d2, s2);
+
+    gej acc;
+    ge t;
+    table_get(t, pre1, d1[DIGITS - 1]);
+    gej_set_ge(acc, t);
+    table_get(t, pre2, d2[DIGITS - 1]);
+    gej_add_ge(acc, acc, t);
+    for (int i = DIGITS - 2; i >= 0; --i) {
+        for (int j = 0; j < WINDOW; ++j) gej_double(acc, acc);
+        table_get(t, pre1, d1[i]);
+        gej_add_ge(acc, acc, t);
+        table_get(t, pre2, d2[i]);
+        gej_add_ge(acc, acc, t);
+    }
+
+    gej fixed;
+    ge_neg(t, pre1[0]);
+    gej_add_ge(fixed, acc, t);
+    fe_cmov(acc.x, fixed.x, even1);
+    fe_cmov(acc.y, fixed.y, even1);
+    fe_cmov(acc.z, fixed.z, even1);
+    acc.infinity = (acc.infinity & ~even1) | (fixed.infinity & even1);
+    ge_neg(t, pre2[0]);
+    gej_add_ge(fixed, acc, t);
+    fe_cmov(acc.x, fixed.x, even2);
+    fe_cmov(acc.y, fixed.y, even2);
+    fe_cmov(acc.z, fixed.z, even2);
+    acc.infinity = (acc.infinity & ~even2) | (fixed.infinity & even2);
+
+    if (acc.infinity) return 0;
+
+    fe zi, zi2, ax, ay;
+    fe_inv(zi, acc.z);
+    fe_sqr(zi2, zi);
+    fe_mul(ax, acc.x, zi2);
+    fe_mul(zi2, zi2, zi);
+    fe_mul(ay, acc.y, zi2);
+    fe_normalize(ax);
+    fe_normalize(ay);
+    fe_get_b32(rx, ax);
+    fe_get_b32(ry, ay);
+    return 1;
+}
+
+};
+};
+
+#endif //ENABLE_SECP256K1_NATIVE
@@ -0,0 +1,31 @@
+#ifndef SAFEHERON_SECP256K1_NATIVE_H_
+#define SAFEHERON_SECP256K1_NATIVE_H_
+
+#include <cstdint>
+
+namespace safeheron{
+namespace _secp256k1_native
+{
+    /**
+     * Native scalar multiplication on secp256k1, used instead of EC_POINT_mul if ENABLE_SECP256K1_NATIVE is on.
+     *
+     * Field elements are held in 5 limbs of 52 bits and reduced with 2^256 = 2^32 + 977 mod p. The scalar is split
+     * into two halves of 128 bits with the GLV endomorphism (x, y) => (beta * x, y), equal to lambda * (x, y), and
+     * both halves are processed together in Jacobian coordinates: 128 doublings instead of 256.
+     * The running time does not depend on the value of the scalar, nor on the point.
+     *
+     * @param[out] rx coordinate x of k * (x, y), 32 bytes in big-endian.
+     * @param[out] ry coordinate y of k * (x, y), 32 bytes in big-endian.
+     * @param[in] x coordinate x of a point on the curve, 32 bytes in big-endian.
+     * @param[in] y coordinate y of a point on the curve, 32 bytes in big-endian.
+     * @param[in] k scalar less than the order of the curve, 32 bytes in big-endian.
+     * @return
+     *      @retval 1 k * (x, y) is a finite point;
+     *      @retval 0 k * (x, y) is the point at infinity, rx and ry are not set.
+     * @warning (x, y) must be on the curve.
+     */
+    int point_mul(uint8_t rx[32], uint8_t ry[32], const uint8_t x[32], const uint8_t y[32], const uint8_t k[32]);
+};
+};
+
+#endif //SAFEHERON_SECP256K1_NATIVE_H_
@@ -1,4 +1,6 @@
 #include <assert.h>
+#include <algorithm>
+#include <memory>
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-ecies/ecies.h"
@@ -6,6 +8,7 @@
 #include "crypto-suites/crypto-ecies/symm.h"
 #include "crypto-suites/crypto-ecies/hmac.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/executor.h"
 
 using namespace safeheron::bignum;
 using namespace safeheron::curve;
@@ -330,24 +333,25 @@ bool ECIES::Decrypt(const BN &privkey,
                    (const unsigned char *) in_iv.c_str(), in_iv.length(), out_plain);
 }
 
-//
-bool ECIES::EncryptWithIV(const CurvePoint &pubkey,
-                          const unsigned char *in_plain, size_t in_plain_len,
-                          const unsigned char *in_iv, size_t in_iv_len,
-                          std::string &out_cypher) {
+// Encrypt with the given KDF, symmetric and HMAC objects, so that several threads can encrypt at the same time
+// with objects of their own.
+static bool encrypt_with_iv(const Curve *curv, IKDF *kdf, ISYMM *symm, IHMAC *hmac,
+                            const CurvePoint &pubkey,
+                            const unsigned char *in_plain, size_t in_plain_len,
+                            const unsigned char *in_iv, size_t in_iv_len,
+                            std::string &out_cypher) {
     int symm_key_size = 0;
     int mac_key_size = 0;
     uint8_t xy[65] = {0};
     uint8_t share[33] = {0};
-    const Curve *curv = GetCurveParam(curve_type_);
     if (curv == nullptr) return false;
 
     // checking status
-    ASSERT_THROW(kdf_);
-    ASSERT_THROW(symm_);
-    ASSERT_THROW(hmac_);
-    symm_key_size = (symm_->getKeySize() + 7) / 8;
-    mac_key_size = (hmac_->getBlockSize() + 7) / 8;
+    ASSERT_THROW(kdf);
+    ASSERT_THROW(symm);
+    ASSERT_THROW(hmac);
+    symm_key_size = (symm->getKeySize() + 7) / 8;
+    mac_key_size = (hmac->getBlockSize() + 7) / 8;
     if (symm_key_size <= 0 || mac_key_size <= 0) {
         return false;
     }
@@ -385,36 +389,44 @@ bool ECIES::EncryptWithIV(const CurvePoint &pubkey,
     std::string seed;
     seed.append((const char *) xy, 65);
     seed.append((const char *) (share + 1), 32);
-    if (!kdf_->generateBytes(seed, symm_key_size + mac_key_size, k1k2)) {
+    if (!kdf->generateBytes(seed, symm_key_size + mac_key_size, k1k2)) {
         return false;
     }
 
-    // encrypt in_plain with symmetic algorithm
-    std::string cbc_iv;
+    // encrypt in_plain with symmetic algorithm, K1 = k1k2[0, symm_key_size)
     std::string cypher;
-    std::string k1 = k1k2.substr(0, symm_key_size);
-    cbc_iv.assign((const char *) in_iv, in_iv_len);
-    if (!symm_->initKey_CBC(k1, cbc_iv)) {
+    const unsigned char *k1 = (const unsigned char *) k1k2.c_str();
+    if (!symm->initKey_CBC(k1, symm_key_size, in_iv, in_iv_len)) {
         return false;
     }
-    if (!symm_->encrypt(in_plain, in_plain_len, cypher)) {
+    if (!symm->encrypt(in_plain, in_plain_len, cypher)) {
         return false;
     }
 
-    // calc HMAC for cypher
+    // calc HMAC for cypher, K2 = k1k2[symm_key_size, symm_key_size + mac_key_size)
     std::string mac;
-    std::string k2 = k1k2.substr(symm_key_size, mac_key_size);
-    if (!hmac_->calcMAC(k2, cypher, mac)) {
+    const unsigned char *k2 = (const unsigned char *) k1k2.c_str() + symm_key_size;
+    if (!hmac->calcMAC(k2, mac_key_size, (const unsigned char *) cypher.c_str(), cypher.length(), mac)) {
         return false;
     }
 
     // return result
+    out_cypher.reserve(out_cypher.length() + 65 + cypher.length() + mac.length() + MAX_CBC_IV_LEN);
     out_cypher.append((const char *) xy, 65);
     out_cypher.append(cypher);
     out_cypher.append(mac);
     return true;
 }
 
+//
+bool ECIES::EncryptWithIV(const CurvePoint &pubkey,
+                          const unsigned char *in_plain, size_t in_plain_len,
+                          const unsigned char *in_iv, size_t in_iv_len,
+                          std::string &out_cypher) {
+    return encrypt_with_iv(GetCurveParam(curve_type_), kdf_, symm_, hmac_, pubkey,
+                           in_plain, in_plain_len, in_iv, in_iv_len, out_cypher);
+}
+
 bool ECIES::Encrypt(const CurvePoint &pubkey,
                     const unsigned char *in_plain, size_t in_plain_len,
                     std::string &out_iv,
@@ -484,31 +496,29 @@ bool ECIES::Decrypt(const BN &privkey,
         return false;
     }
 
-    // calc HMAC for cypher
+    // calc HMAC for cypher, K2 = k1k2[symm_key_size, symm_key_size + mac_key_size)
     std::string mac;
-    std::string symm_cypher;
-    std::string k2 = k1k2.substr(symm_key_size, mac_key_size);
+    const unsigned char *k2 = (const unsigned char *) k1k2.c_str() + symm_key_size;
+    const unsigned char *symm_cypher = in_cypher + 65;
     int symm_cypher_len = in_cypher_len - (65 + hmac_->getOutSize() / 8);
-    symm_cypher.assign((const char *) (in_cypher + 65), symm_cypher_len);
-    if (!hmac_->calcMAC(k2, symm_cypher, mac)) {
+    if (symm_cypher_len <= 0) {
+        return false;
+    }
+    if (!hmac_->calcMAC(k2, mac_key_size, symm_cypher, symm_cypher_len, mac)) {
         return false;
     }
 
     // checking HMAC
-    std::string in_mac;
-    in_mac.assign((const char *) (in_cypher + 65 + symm_cypher_len), hmac_->getOutSize() / 8);
-    if (memcmp(in_mac.c_str(), mac.c_str(), mac.length()) != 0) {
+    if (memcmp(in_cypher + 65 + symm_cypher_len, mac.c_str(), mac.length()) != 0) {
         return false;
     }
 
-    // decrypt cypher use symmetic algorithm
-    std::string cbc_iv;
-    std::string k1 = k1k2.substr(0, symm_key_size);
-    cbc_iv.assign((const char *) in_iv, in_iv_len);
-    if (!symm_->initKey_CBC(k1, cbc_iv)) {
+    // decrypt cypher use symmetic algorithm, K1 = k1k2[0, symm_key_size)
+    const unsigned char *k1 = (const unsigned char *) k1k2.c_str();
+    if (!symm_->initKey_CBC(k1, symm_key_size, in_iv, in_iv_len)) {
         return false;
     }
-    if (!symm_->decrypt(symm_cypher, out_plain)) {
+    if (!symm_->decrypt(symm_cypher, symm_cypher_len, out_plain)) {
         return false;
     }
 
@@ -584,5 +594,73 @@ bool ECIES::DecryptPack(const BN &privkey,
 }
 
 
+
+bool ECIES::EncryptPackMany(const std::vector<CurvePoint> &pubkeys,
+                            const std::vector<std::string> &in_plains,
+                            std::vector<std::string> &out_cyphers,
+                            safeheron::concurrency::Executor *executor) {
+    ASSERT_THROW(kdf_);
+    ASSERT_THROW(symm_);
+    ASSERT_THROW(hmac_);
+
+    const size_t n = pubkeys.size();
+    if (n == 0) return false;
+    if (in_plains.size() != n && in_plains.size() != 1) return false;
+    const Curve *curv = GetCurveParam(curve_type_);
+    if (curv == nullptr) return false;
+
+    int iv_len = (symm_->getIVSize() + 7) / 8;
+    if (iv_len > MAX_CBC_IV_LEN) {
+        return false;
+    }
+
+    out_cyphers.assign(n, std::string());
+
+    // Recipients are cut into one contiguous chunk per thread. Every chunk reuses its KDF, symmetric and HMAC
+    // contexts for all of its recipients.
+    const size_t chunks = std::min(n, safeheron::concurrency::Concurrency(executor));
+    std::vector<char> chunk_ok(chunks, 0);
+    safeheron::concurrency::ParallelFor(executor, chunks, [&](size_t c) {
+        std::unique_ptr<IKDF> kdf;
+        std::unique_ptr<ISYMM> symm;
+        std::unique_ptr<IHMAC> hmac;
+        IKDF *p_kdf = kdf_;
+        ISYMM *p_symm = symm_;
+        IHMAC *p_hmac = hmac_;
+        if (chunks > 1) {
+            kdf.reset(kdf_->clone());
+            symm.reset(symm_->clone());
+            hmac.reset(hmac_->clone());
+            p_kdf = kdf.get();
+            p_symm = symm.get();
+            p_hmac = hmac.get();
+        }
+
+        const size_t begin = n * c / chunks;
+        const size_t end = n * (c + 1) / chunks;
+        uint8_t iv[MAX_CBC_IV_LEN] = {0};
+        for (size_t i = begin; i < end; ++i) {
+            const std::string &plain = in_plains.size() == 1 ? in_plains[0] : in_plains[i];
+            safeheron::rand::RandomBytes(iv, iv_len);
+            if (!encrypt_with_iv(curv, p_kdf, p_symm, p_hmac, pubkeys[i],
+                                 (const unsigned char *) plain.c_str(), plain.length(),
+                                 iv, iv_len, out_cyphers[i])) {
+                return;
+            }
+            // packing iv in the end of ecies cypher
+            out_cyphers[i].append((const char *) iv, iv_len);
+        }
+        chunk_ok[c] = 1;
+    });
+
+    for (size_t c = 0; c < chunks; ++c) {
+        if (!chunk_ok[c]) {
+            out_cyphers.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
 }
 }
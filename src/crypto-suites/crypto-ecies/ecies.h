@@ -2,6 +2,7 @@
 #define SAFEHERON_CRYPTO_ECIES_H
 
 #include <string>
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve_point.h"
 
@@ -12,6 +13,9 @@
 #define MAX_HMAC_LEN        64  //in Bytes
 
 namespace safeheron {
+namespace concurrency {
+class Executor;
+}
 namespace ecies {
 
 class IKDF;
@@ -159,6 +163,16 @@ public:
     bool EncryptPack(const safeheron::curve::CurvePoint &pubkey, const unsigned char *in_plain, size_t in_plain_len, std::string &out_cypher);
 
     bool DecryptPack(const safeheron::bignum::BN &privkey, const unsigned char *in_cypher, size_t in_cypher_len, std::string &out_plain);
+
+    // Encrypt pack for many recipients at once.
+    // Every cypher is in the EncryptPack format, with its own ephemeral key and IV, and can be decrypted with DecryptPack.
+    //
+    // pubkeys: public keys of the recipients.
+    // in_plains: one plain text per recipient, or a single plain text sent to every recipient.
+    // out_cyphers: out_cyphers[i] is the cypher for pubkeys[i].
+    // executor: runs the recipients in parallel, null to encrypt sequentially in the calling thread.
+    bool EncryptPackMany(const std::vector<safeheron::curve::CurvePoint> &pubkeys, const std::vector<std::string> &in_plains,
+                         std::vector<std::string> &out_cyphers, safeheron::concurrency::Executor *executor = nullptr);
 };
 
 }
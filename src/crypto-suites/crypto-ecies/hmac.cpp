@@ -1,19 +1,25 @@
+#include <string.h>
 #include <openssl/hmac.h>
 #include "crypto-suites/crypto-ecies/hmac.h"
 
 namespace safeheron {
 namespace ecies {
 
+IHMAC::~IHMAC() {
+    if (ctx_) {
+        HMAC_CTX_free(ctx_);
+        ctx_ = nullptr;
+    }
+}
+
 bool IHMAC::calcMAC(const unsigned char *key,
                     size_t key_size,
                     const unsigned char *input,
                     size_t in_size,
                     std::string &out) {
-    bool ret = false;
     unsigned int mdlen = 0;
     unsigned char md[EVP_MAX_MD_SIZE] = {0};
-    HMAC_CTX *ctx = nullptr;
-    std::string iv_len_tag;
+    uint8_t iv_len_tag[8] = {0};
 
     if (!key || key_size <= 0) {
         return false;
@@ -22,42 +28,37 @@ bool IHMAC::calcMAC(const unsigned char *key,
         return false;
     }
 
-    iv_len_tag = getLengthTag(iv_);
+    getLengthTag(iv_, iv_len_tag);
 
-    if (!(ctx = HMAC_CTX_new())) {
+    // the context is created once and re-keyed for every message
+    if (!ctx_ && !(ctx_ = HMAC_CTX_new())) {
         return false;
     }
 
     // hamc key
-    if (!HMAC_Init_ex(ctx, key, key_size, md_, nullptr))
-        goto err;
+    if (!HMAC_Init_ex(ctx_, key, key_size, md_, nullptr))
+        return false;
 
     // shared in ecies
-    if (!HMAC_Update(ctx, input, in_size))
-        goto err;
+    if (!HMAC_Update(ctx_, input, in_size))
+        return false;
     
     // encoding iv
     if (iv_.length() > 0) {
-        if (!HMAC_Update(ctx, (const uint8_t*)iv_.c_str(), iv_.length()))
-            goto err;
+        if (!HMAC_Update(ctx_, (const uint8_t*)iv_.c_str(), iv_.length()))
+            return false;
     }
 
     // encoding iv length tag
-    if (!HMAC_Update(ctx, (const uint8_t*)iv_len_tag.c_str(), iv_len_tag.length()))
-        goto err;
+    if (!HMAC_Update(ctx_, iv_len_tag, sizeof(iv_len_tag)))
+        return false;
 
     // get the hmac
-    if (!HMAC_Final(ctx, md, &mdlen))
-        goto err;
+    if (!HMAC_Final(ctx_, md, &mdlen))
+        return false;
     
     out.assign((char*)md, mdlen);
-    ret = true;
-err:
-    if (ctx) {
-        HMAC_CTX_free(ctx);
-        ctx = nullptr;
-    }
-    return ret;
+    return true;
 }
 
 bool IHMAC::calcMAC(const std::string &key,
@@ -68,11 +69,9 @@ bool IHMAC::calcMAC(const std::string &key,
 }
 
 // as described in Shroup's paper and P1363a
-std::string IHMAC::getLengthTag(const std::string & str)
+void IHMAC::getLengthTag(const std::string & str, uint8_t tag[8])
 {
-    uint8_t tag[8] = { 0 };
     uint64_t len = 8 * str.length();    //in bits
-    std::string res;
 
     if (len > 0) {
         tag[7] = len & 0xFF;
@@ -83,9 +82,9 @@ std::string IHMAC::getLengthTag(const std::string & str)
         tag[2] = (len >> 40) & 0xFF;
         tag[1] = (len >> 48) & 0xFF;
         tag[0] = (len >> 56) & 0xFF;
+    } else {
+        memset(tag, 0, 8);
     }
-    res.assign((char*)tag, sizeof(tag));
-    return res;
 }
 
 }
@@ -3,15 +3,24 @@
 
 #include <string>
 #include <openssl/evp.h>
+#include <openssl/hmac.h>
 
 namespace safeheron {
 namespace ecies {
 
 class IHMAC {
 public:
-    IHMAC() { md_ = nullptr; };
+    IHMAC() { md_ = nullptr; ctx_ = nullptr; };
 
-    virtual ~IHMAC() {};
+    // The HMAC context is owned by this object and reused across messages.
+    IHMAC(const IHMAC &) = delete;
+
+    IHMAC &operator=(const IHMAC &) = delete;
+
+    virtual ~IHMAC();
+
+    // Create a new object of the same algorithm with the same IV, it does not share any context with this one.
+    virtual IHMAC *clone() const = 0;
 
     virtual int getOutSize() { return 8 * EVP_MD_size(md_); };
 
@@ -27,10 +36,11 @@ public:
     virtual bool calcMAC(const std::string &key, const std::string &input, std::string &out);
 
 protected:
-    std::string getLengthTag(const std::string & str);
+    static void getLengthTag(const std::string & str, uint8_t tag[8]);
 
 protected:
     const EVP_MD *md_;
+    HMAC_CTX *ctx_;
     std::string iv_;
 };
 
@@ -39,6 +49,8 @@ public:
     HMAC_sha1() { md_ = EVP_sha1(); };
 
     virtual ~HMAC_sha1() {};
+
+    IHMAC *clone() const { HMAC_sha1 *mac = new HMAC_sha1(); mac->setIV(iv_); return mac; };
 };
 
 class HMAC_sha224 : public IHMAC {
@@ -46,6 +58,8 @@ public:
     HMAC_sha224() { md_ = EVP_sha224(); };
 
     virtual ~HMAC_sha224() {};
+
+    IHMAC *clone() const { HMAC_sha224 *mac = new HMAC_sha224(); mac->setIV(iv_); return mac; };
 };
 
 class HMAC_sha256 : public IHMAC {
@@ -53,6 +67,8 @@ public:
     HMAC_sha256() { md_ = EVP_sha256(); };
 
     virtual ~HMAC_sha256() {};
+
+    IHMAC *clone() const { HMAC_sha256 *mac = new HMAC_sha256(); mac->setIV(iv_); return mac; };
 };
 
 class HMAC_sha384 : public IHMAC {
@@ -60,6 +76,8 @@ public:
     HMAC_sha384() { md_ = EVP_sha384(); };
 
     virtual ~HMAC_sha384() {};
+
+    IHMAC *clone() const { HMAC_sha384 *mac = new HMAC_sha384(); mac->setIV(iv_); return mac; };
 };
 
 class HMAC_sha512 : public IHMAC {
@@ -67,6 +85,8 @@ public:
     HMAC_sha512() { md_ = EVP_sha512(); };
 
     virtual ~HMAC_sha512() {};
+
+    IHMAC *clone() const { HMAC_sha512 *mac = new HMAC_sha512(); mac->setIV(iv_); return mac; };
 };
 
 }
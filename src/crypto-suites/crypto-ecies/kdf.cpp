@@ -7,8 +7,16 @@
 namespace safeheron {
 namespace ecies {
 
+IKDF::~IKDF() {
+    if (ctx_) {
+        EVP_MD_CTX_free(ctx_);
+        ctx_ = nullptr;
+    }
+}
+
 /**
- * @brief Use a hash function to derivate data from input data
+ * @brief Use a hash function to derivate data from input data.
+ *        The digest context of this object is reused across calls.
  * 
  * @param hash_nid: openssl EVP_MD nid
  * @param iter_from: The start index of I2OSP, 0 for KDF1_18033, and 1 for X9_63 and KDF2_18033  
@@ -30,7 +38,6 @@ bool IKDF::baseKDF(int hash_nid, int iter_from,
     bool ret = false;
     unsigned char ctr[4] = {0};
     unsigned char buff[EVP_MAX_MD_SIZE] = {0};
-    EVP_MD_CTX *ctx = nullptr;
     const EVP_MD *md = nullptr;
 
     if (!input || in_size <= 0) {
@@ -56,8 +63,9 @@ bool IKDF::baseKDF(int hash_nid, int iter_from,
     }
     mdlen = EVP_MD_size(md);
 
-    if (!(ctx = EVP_MD_CTX_new()))
+    if (!ctx_ && !(ctx_ = EVP_MD_CTX_new()))
         return false;
+    out.reserve(out.length() + out_size);
 
     // loop until leftlen = 0
     leftlen = out_size;
@@ -69,19 +77,18 @@ bool IKDF::baseKDF(int hash_nid, int iter_from,
         ctr[0] = (i >> 24) & 0xFF;
 
         // calc md of input||ctr||iv_
-        memset(buff, 0, EVP_MAX_MD_SIZE);
-        if (!EVP_DigestInit_ex(ctx, md, nullptr))
-            goto err;
-        if (!EVP_DigestUpdate(ctx, input, in_size))
-            goto err;
-        if (!EVP_DigestUpdate(ctx, ctr, sizeof(ctr)))
-            goto err;
+        if (!EVP_DigestInit_ex(ctx_, md, nullptr))
+            break;
+        if (!EVP_DigestUpdate(ctx_, input, in_size))
+            break;
+        if (!EVP_DigestUpdate(ctx_, ctr, sizeof(ctr)))
+            break;
         if (salt && salt_size > 0) {
-            if (!EVP_DigestUpdate(ctx, salt, salt_size))
-                goto err;
+            if (!EVP_DigestUpdate(ctx_, salt, salt_size))
+                break;
         }
-        if (!EVP_DigestFinal(ctx, buff, nullptr))
-            goto err;
+        if (!EVP_DigestFinal_ex(ctx_, buff, nullptr))
+            break;
 
         // append this md to out string
         if (leftlen > mdlen) {
@@ -94,12 +101,6 @@ bool IKDF::baseKDF(int hash_nid, int iter_from,
         }
     }
 
-    err:
-    if (ctx) {
-        EVP_MD_CTX_free(ctx);
-        ctx = nullptr;
-    }
-
     return ret;
 }
 
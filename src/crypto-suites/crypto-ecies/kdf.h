@@ -2,6 +2,7 @@
 #define SAFEHERON_CRYPTO_ECIES_KDF_H
 
 #include <string>
+#include <openssl/evp.h>
 
 namespace safeheron {
 namespace ecies {
@@ -17,14 +18,24 @@ public:
     IKDF() {
         hash_nid_ = 0;
         iv_ = "";
+        ctx_ = nullptr;
     };
 
     IKDF(int hash_nid) {
         hash_nid_ = hash_nid;
         iv_ = "";
+        ctx_ = nullptr;
     };
 
-    virtual ~IKDF() {};
+    // The digest context is owned by this object and reused across messages.
+    IKDF(const IKDF &) = delete;
+
+    IKDF &operator=(const IKDF &) = delete;
+
+    virtual ~IKDF();
+
+    // Create a new object of the same KDF type with the same IV, it does not share any context with this one.
+    virtual IKDF *clone() const = 0;
 
     virtual int getHashNid() { return hash_nid_; };
 
@@ -37,13 +48,14 @@ public:
     virtual bool generateBytes(const std::string &input, size_t out_size, std::string &out) = 0;
 
 protected:
-    static bool
+    bool
     baseKDF(int hash_nid, int iter_from, const unsigned char *input, size_t in_size, const unsigned char *salt,
             size_t salt_size, size_t out_size, std::string &out);
 
 protected:
     int hash_nid_;
     std::string iv_;
+    EVP_MD_CTX *ctx_;
 };
 
 //  Key derivation function from X9.63/SECG 
@@ -68,6 +80,8 @@ public:
 
     virtual ~KDF_X9_63() {};
 public:
+    IKDF *clone() const { return new KDF_X9_63(hash_nid_, iv_); };
+
     bool generateBytes(const unsigned char *input, size_t in_size, size_t out_size, std::string &out);
 
     bool generateBytes(const std::string &input, size_t out_size, std::string &out);
@@ -90,6 +104,8 @@ public:
 
     virtual ~KDF1_18033() {};
 public:
+    IKDF *clone() const { KDF1_18033 *kdf = new KDF1_18033(hash_nid_); kdf->setIV(iv_); return kdf; };
+
     bool generateBytes(const unsigned char *input, size_t in_size, size_t out_size, std::string &out);
 
     bool generateBytes(const std::string &input, size_t out_size, std::string &out);
@@ -112,6 +128,8 @@ public:
 
     virtual ~KDF2_18033() {};
 public:
+    IKDF *clone() const { KDF2_18033 *kdf = new KDF2_18033(hash_nid_); kdf->setIV(iv_); return kdf; };
+
     bool generateBytes(const unsigned char *input, size_t in_size, size_t out_size, std::string &out);
 
     bool generateBytes(const std::string &input, size_t out_size, std::string &out);
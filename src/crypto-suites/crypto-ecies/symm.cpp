@@ -4,14 +4,23 @@
 namespace safeheron {
 namespace ecies {
 
-// The base symmetic process functions for openssl EVP Cipher
-bool ISYMM::encrypt(const unsigned char *in_plain,
-                    size_t in_plain_len,
-                    std::string &out_cypher) {
-    bool ret = false;
-    int out_len = 0;
+ISYMM::~ISYMM() {
+    if (ctx_) {
+        EVP_CIPHER_CTX_free(ctx_);
+        ctx_ = nullptr;
+    }
+}
+
+// The base symmetic process function for openssl EVP Cipher.
+// The cipher context is created once and reset for every message, and the output
+// is written straight into out, which is resized to the exact length at the end.
+bool ISYMM::process(const unsigned char *in,
+                    size_t in_len,
+                    int enc,
+                    std::string &out) {
+    int update_len = 0;
+    int final_len = 0;
     unsigned char *out_buff = nullptr;
-    EVP_CIPHER_CTX *ctx = nullptr;
 
     if (!cipher_) {
         return false;
@@ -19,45 +28,36 @@ bool ISYMM::encrypt(const unsigned char *in_plain,
     if (key_.length() <= 0 || cbc_iv_.length() <= 0) {
         return false;
     }
-    if (!in_plain || in_plain_len <= 0) {
+    if (!in || in_len <= 0) {
         return false;
     }
-    out_cypher.clear();
-
-    out_len = in_plain_len + EVP_MAX_BLOCK_LENGTH;
-    out_buff = (unsigned char *) OPENSSL_malloc(out_len);
-    memset(out_buff, 0, out_len);
+    out.clear();
 
-    if (!(ctx = EVP_CIPHER_CTX_new())) {
+    if (!ctx_ && !(ctx_ = EVP_CIPHER_CTX_new())) {
         return false;
     }
-    if (!EVP_CipherInit_ex(ctx, cipher_, nullptr,
+    if (!EVP_CipherInit_ex(ctx_, cipher_, nullptr,
                            (const unsigned char *) key_.c_str(),
-                           (const unsigned char *) cbc_iv_.c_str(), 1)) {
-        goto err;
-    }
-    if (!EVP_CipherUpdate(ctx, out_buff, &out_len, in_plain, in_plain_len)) {
-        goto err;
+                           (const unsigned char *) cbc_iv_.c_str(), enc)) {
+        return false;
     }
-    out_cypher.append((char *) out_buff, out_len);
-    out_len = in_plain_len + EVP_MAX_BLOCK_LENGTH;
-    if (!EVP_CipherFinal_ex(ctx, out_buff, &out_len)) {
-        goto err;
+
+    out.resize(in_len + EVP_MAX_BLOCK_LENGTH);
+    out_buff = (unsigned char *) &out[0];
+    if (!EVP_CipherUpdate(ctx_, out_buff, &update_len, in, in_len) ||
+        !EVP_CipherFinal_ex(ctx_, out_buff + update_len, &final_len)) {
+        out.clear();
+        return false;
     }
-    out_cypher.append((char *) out_buff, out_len);
+    out.resize(update_len + final_len);
 
-    ret = true;
+    return true;
+}
 
-    err:
-    if (out_buff) {
-        OPENSSL_free(out_buff);
-        out_buff = nullptr;
-    }
-    if (ctx) {
-        EVP_CIPHER_CTX_free(ctx);
-        ctx = nullptr;
-    }
-    return ret;
+bool ISYMM::encrypt(const unsigned char *in_plain,
+                    size_t in_plain_len,
+                    std::string &out_cypher) {
+    return process(in_plain, in_plain_len, 1, out_cypher);
 }
 
 bool ISYMM::encrypt(const std::string &in_plain,
@@ -68,56 +68,7 @@ bool ISYMM::encrypt(const std::string &in_plain,
 bool ISYMM::decrypt(const unsigned char *in_cypher,
                     size_t in_cypher_len,
                     std::string &out_plain) {
-    bool ret = false;
-    int out_len = 0;
-    unsigned char *out_buff = nullptr;
-    EVP_CIPHER_CTX *ctx = nullptr;
-
-    if (!cipher_) {
-        return false;
-    }
-    if (key_.length() <= 0 || cbc_iv_.length() <= 0) {
-        return false;
-    }
-    if (!in_cypher || in_cypher_len <= 0) {
-        return false;
-    }
-    out_plain.clear();
-
-    out_len = in_cypher_len;
-    out_buff = (unsigned char *) OPENSSL_malloc(out_len);
-    memset(out_buff, 0, out_len);
-
-    if (!(ctx = EVP_CIPHER_CTX_new())) {
-        return false;
-    }
-    if (!EVP_CipherInit_ex(ctx, cipher_, nullptr,
-                           (const unsigned char *) key_.c_str(),
-                           (const unsigned char *) cbc_iv_.c_str(), 0)) {
-        goto err;
-    }
-    if (!EVP_CipherUpdate(ctx, out_buff, &out_len, in_cypher, in_cypher_len)) {
-        goto err;
-    }
-    out_plain.append((char *) out_buff, out_len);
-    out_len = in_cypher_len;
-    if (!EVP_CipherFinal_ex(ctx, out_buff, &out_len)) {
-        goto err;
-    }
-    out_plain.append((char *) out_buff, out_len);
-
-    ret = true;
-
-    err:
-    if (out_buff) {
-        OPENSSL_free(out_buff);
-        out_buff = nullptr;
-    }
-    if (ctx) {
-        EVP_CIPHER_CTX_free(ctx);
-        ctx = nullptr;
-    }
-    return ret;
+    return process(in_cypher, in_cypher_len, 0, out_plain);
 }
 
 bool ISYMM::decrypt(const std::string &in_cypher,
@@ -11,10 +11,19 @@ class ISYMM {
 public:
     ISYMM() {
         cipher_ = nullptr;
+        ctx_ = nullptr;
         key_size_ = 0;
     };
 
-    virtual ~ISYMM() {};
+    // The cipher context is owned by this object and reused across messages.
+    ISYMM(const ISYMM &) = delete;
+
+    ISYMM &operator=(const ISYMM &) = delete;
+
+    virtual ~ISYMM();
+
+    // Create a new object of the same algorithm, it does not share any context with this one.
+    virtual ISYMM *clone() const = 0;
 
     virtual int getKeySize() { return key_size_; };
 
@@ -32,8 +41,12 @@ public:
 
     virtual bool decrypt(const std::string &in_cypher, std::string &out_plain);
 
+protected:
+    bool process(const unsigned char *in, size_t in_len, int enc, std::string &out);
+
 protected:
     const EVP_CIPHER *cipher_;
+    EVP_CIPHER_CTX *ctx_;
     size_t key_size_;       // in bits
     size_t block_size_;     // in bits
     std::string key_;
@@ -43,13 +56,14 @@ protected:
 class AES : public ISYMM {
 public:
     AES(size_t key_size) {
-        cipher_ = nullptr;
         key_size_ = key_size;
         block_size_ = 16 * 8;
     };
 
     virtual ~AES() {};
 public:
+    ISYMM *clone() const { return new AES(key_size_); };
+
     bool initKey_CBC(const unsigned char *key, size_t key_size, const unsigned char *iv, size_t iv_size);
 
     bool initKey_CBC(const std::string &key, const std::string &iv);
@@ -5,6 +5,7 @@
 #include "crypto-suites/crypto-hash/keccak256.h"
 #include "crypto-suites/common/custom_memzero.h"
 #include "crypto-suites/crypto-hash/sha3_imp.h"
+#include "crypto-suites/common/instrumentation.h"
 
 namespace safeheron{
 namespace hash{
@@ -25,6 +26,7 @@ void CKeccak256::Finalize(unsigned char hash[OUTPUT_SIZE]) {
 }
 
 CKeccak256& CKeccak256::Write(const unsigned char *data, size_t len) {
+    SAFEHERON_COUNT_HASH_BYTES(len);
     keccak_Update(ptr_ctx, data, len);
     return *this;
 }
@@ -34,6 +36,41 @@ CKeccak256& CKeccak256::Reset() {
     return *this;
 }
 
+std::vector<std::string> Keccak256Many(const std::vector<std::string> &inputs, safeheron::concurrency::Executor *executor) {
+    // Split the inputs into runs of four messages of the same length, hashed by keccak_256_x4, and single messages.
+    std::vector<size_t> starts;
+    uint64_t total_len = 0;
+    for (size_t i = 0; i < inputs.size(); ) {
+        starts.push_back(i);
+        size_t len = inputs[i].size();
+        bool run = i + 4 <= inputs.size()
+                   && inputs[i + 1].size() == len && inputs[i + 2].size() == len && inputs[i + 3].size() == len;
+        size_t n = run ? 4 : 1;
+        for (size_t j = i; j < i + n; ++j) total_len += inputs[j].size();
+        i += n;
+    }
+    SAFEHERON_COUNT_HASH_BYTES(total_len);
+
+    std::vector<std::string> digests(inputs.size(), std::string(CKeccak256::OUTPUT_SIZE, '\0'));
+    safeheron::concurrency::ParallelFor(executor, starts.size(), [&](size_t k) {
+        size_t i = starts[k];
+        size_t end = k + 1 < starts.size() ? starts[k + 1] : inputs.size();
+        if (end - i == 4) {
+            const unsigned char *data[4];
+            unsigned char *digest[4];
+            for (size_t j = 0; j < 4; ++j) {
+                data[j] = reinterpret_cast<const unsigned char *>(inputs[i + j].data());
+                digest[j] = reinterpret_cast<unsigned char *>(&digests[i + j][0]);
+            }
+            keccak_256_x4(data, inputs[i].size(), digest);
+        } else {
+            keccak_256(reinterpret_cast<const unsigned char *>(inputs[i].data()), inputs[i].size(),
+                       reinterpret_cast<unsigned char *>(&digests[i][0]));
+        }
+    });
+    return digests;
+}
+
 
 }
 }
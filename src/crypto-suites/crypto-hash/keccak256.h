@@ -6,6 +6,9 @@
 #define CRYPTOHASH_Keccak256_H
 
 #include <cstddef>
+#include <string>
+#include <vector>
+#include "crypto-suites/common/executor.h"
 
 struct SHA3_CTX;
 
@@ -28,6 +31,17 @@ public:
     CKeccak256& Reset();
 };
 
+/**
+ * Keccak-256 digests of a batch of messages, e.g. of the public keys whose Ethereum addresses are derived.
+ * Runs of four messages of the same length are hashed together with AVX2 when the CPU supports it.
+ *
+ * @param[in] inputs the messages
+ * @param[in] executor optional executor hashing the runs in parallel
+ * @return the 32-byte digests, digests[i] being the one of inputs[i]
+ */
+std::vector<std::string> Keccak256Many(const std::vector<std::string> &inputs,
+                                       safeheron::concurrency::Executor *executor = nullptr);
+
 
 }
 }
@@ -0,0 +1,43 @@
+#include <string.h>
+#include "crypto-suites/crypto-hash/pbkdf2_hmac_sha512.h"
+#include "crypto-suites/crypto-hash/hmac_sha512.h"
+
+namespace safeheron {
+namespace hash {
+
+void PBKDF2_HMAC_SHA512(const unsigned char *password, size_t password_len,
+                        const unsigned char *salt, size_t salt_len,
+                        uint32_t iterations,
+                        unsigned char *out, size_t out_len) {
+    // Keyed once: copies of "prf" start from the precomputed inner and outer states.
+    const CHMAC_SHA512 prf(password, password_len);
+    unsigned char u[CHMAC_SHA512::OUTPUT_SIZE];
+    unsigned char t[CHMAC_SHA512::OUTPUT_SIZE];
+
+    for (uint32_t block = 1; out_len > 0; block++) {
+        unsigned char block_be[4] = {(unsigned char) (block >> 24), (unsigned char) (block >> 16),
+                                     (unsigned char) (block >> 8), (unsigned char) block};
+        CHMAC_SHA512 h = prf;
+        h.Write(salt, salt_len).Write(block_be, sizeof(block_be)).Finalize(u);
+        memcpy(t, u, sizeof(t));
+
+        for (uint32_t i = 1; i < iterations; i++) {
+            h = prf;
+            h.Write(u, sizeof(u)).Finalize(u);
+            for (size_t k = 0; k < sizeof(t); k++) {
+                t[k] ^= u[k];
+            }
+        }
+
+        size_t len = out_len < sizeof(t) ? out_len : sizeof(t);
+        memcpy(out, t, len);
+        out += len;
+        out_len -= len;
+    }
+
+    memset(u, 0, sizeof(u));
+    memset(t, 0, sizeof(t));
+}
+
+}
+}
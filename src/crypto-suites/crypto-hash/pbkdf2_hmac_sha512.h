@@ -0,0 +1,32 @@
+#ifndef SAFEHERON_CRYPTO_PBKDF2_HMAC_SHA512_H
+#define SAFEHERON_CRYPTO_PBKDF2_HMAC_SHA512_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace safeheron{
+namespace hash{
+
+/**
+ * PBKDF2 with HMAC-SHA-512 as pseudorandom function (RFC 8018).
+ *
+ * The inner and outer HMAC states of the password are computed once and copied at each iteration, so an
+ * iteration costs two SHA-512 compressions instead of four.
+ *
+ * @param[in] password
+ * @param[in] password_len
+ * @param[in] salt
+ * @param[in] salt_len
+ * @param[in] iterations iteration count, at least 1
+ * @param[out] out derived key
+ * @param[in] out_len length of the derived key
+ */
+void PBKDF2_HMAC_SHA512(const unsigned char *password, size_t password_len,
+                        const unsigned char *salt, size_t salt_len,
+                        uint32_t iterations,
+                        unsigned char *out, size_t out_len);
+
+};
+};
+
+#endif // SAFEHERON_CRYPTO_PBKDF2_HMAC_SHA512_H
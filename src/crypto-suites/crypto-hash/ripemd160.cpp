@@ -6,6 +6,7 @@
 #include <string.h>
 #include "crypto-suites/crypto-hash/common.h"
 #include "crypto-suites/crypto-hash/ripemd160.h"
+#include "crypto-suites/common/instrumentation.h"
 
 namespace safeheron {
 namespace hash {
@@ -297,6 +298,7 @@ CRIPEMD160 &CRIPEMD160::Write(const unsigned char *data, size_t len) {
 }
 
 void CRIPEMD160::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    SAFEHERON_COUNT_HASH_BYTES(bytes);
     static const unsigned char pad[64] = {0x80};
     unsigned char sizedesc[8];
     WriteLE64(sizedesc, bytes << 3);
@@ -1,6 +1,7 @@
 #include <string.h>
 #include "crypto-suites/crypto-hash/common.h"
 #include "crypto-suites/crypto-hash/sha1.h"
+#include "crypto-suites/common/instrumentation.h"
 
 namespace safeheron {
 namespace hash {
@@ -166,6 +167,7 @@ CSHA1 &CSHA1::Write(const unsigned char *data, size_t len) {
 }
 
 void CSHA1::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    SAFEHERON_COUNT_HASH_BYTES(bytes);
     static const unsigned char pad[64] = {0x80};
     unsigned char sizedesc[8];
     WriteBE64(sizedesc, bytes << 3);
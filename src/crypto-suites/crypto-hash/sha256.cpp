@@ -6,6 +6,7 @@
 #include <assert.h>
 #include <string.h>
 #include "crypto-suites/crypto-hash/sha256.h"
+#include "crypto-suites/common/instrumentation.h"
 #include "crypto-suites/crypto-hash/common.h"
 
 namespace safeheron {
@@ -550,6 +551,7 @@ CSHA256 &CSHA256::Write(const unsigned char *data, size_t len) {
 }
 
 void CSHA256::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    SAFEHERON_COUNT_HASH_BYTES(bytes);
     static const unsigned char pad[64] = {0x80};
     unsigned char sizedesc[8];
     WriteBE64(sizedesc, bytes << 3);
@@ -24,6 +24,14 @@
 #include "crypto-suites/common/custom_memzero.h"
 #include "crypto-suites/crypto-hash/byte_order.h"
 
+/* The 4-way permutation of keccak_256_x4, selected at run time. Not in SGX enclaves, which cannot query the CPU. */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(SAFEHERON_SGX_SDK)
+#define SHA3_HAVE_AVX2 1
+#include <immintrin.h>
+#else
+#define SHA3_HAVE_AVX2 0
+#endif
+
 #define I64(x) x##LL
 #define ROTL64(qword, n) ((qword) << (n) ^ ((qword) >> (64 - (n))))
 #define le2me_64(x) (x)
@@ -94,78 +102,98 @@ void sha3_512_Init(SHA3_CTX *ctx)
 	keccak_Init(ctx, 512);
 }
 
-/* Keccak theta() transformation */
-static void keccak_theta(uint64_t *A)
-{
-	unsigned int x = 0;
-	uint64_t C[5] = {0}, D[5] = {0};
-
-	for (x = 0; x < 5; x++) {
-		C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
-	}
-	D[0] = ROTL64(C[1], 1) ^ C[4];
-	D[1] = ROTL64(C[2], 1) ^ C[0];
-	D[2] = ROTL64(C[3], 1) ^ C[1];
-	D[3] = ROTL64(C[4], 1) ^ C[2];
-	D[4] = ROTL64(C[0], 1) ^ C[3];
-
-	for (x = 0; x < 5; x++) {
-		A[x]      ^= D[x];
-		A[x + 5]  ^= D[x];
-		A[x + 10] ^= D[x];
-		A[x + 15] ^= D[x];
-		A[x + 20] ^= D[x];
-	}
-}
-
-/* Keccak pi() transformation */
-static void keccak_pi(uint64_t *A)
+/*
+ * One round of Keccak-f[1600] on the lanes A[x + 5 * y], written to R.
+ *
+ * theta, rho and pi are merged: each row of R is computed from the five lanes which pi moves into it, and chi
+ * is applied to the row at once. The lanes 1, 2, 8, 12, 17 and 20 are kept complemented between the rounds
+ * (the lane complementing transform of the Keccak implementation overview, section 2.2), which replaces most of
+ * the NOT operations of chi by a change between AND and OR.
+ */
+static inline void keccak_round(uint64_t R[25], const uint64_t A[25], uint64_t rc)
 {
-	uint64_t A1 = 0;
-	A1 = A[1];
-	A[ 1] = A[ 6];
-	A[ 6] = A[ 9];
-	A[ 9] = A[22];
-	A[22] = A[14];
-	A[14] = A[20];
-	A[20] = A[ 2];
-	A[ 2] = A[12];
-	A[12] = A[13];
-	A[13] = A[19];
-	A[19] = A[23];
-	A[23] = A[15];
-	A[15] = A[ 4];
-	A[ 4] = A[24];
-	A[24] = A[21];
-	A[21] = A[ 8];
-	A[ 8] = A[16];
-	A[16] = A[ 5];
-	A[ 5] = A[ 3];
-	A[ 3] = A[18];
-	A[18] = A[17];
-	A[17] = A[11];
-	A[11] = A[ 7];
-	A[ 7] = A[10];
-	A[10] = A1;
-	/* note: A[ 0] is left as is */
+	uint64_t B0, B1, B2, B3, B4;
+	const uint64_t C0 = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+	const uint64_t C1 = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+	const uint64_t C2 = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+	const uint64_t C3 = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+	const uint64_t C4 = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+	const uint64_t D0 = ROTL64(C1, 1) ^ C4;
+	const uint64_t D1 = ROTL64(C2, 1) ^ C0;
+	const uint64_t D2 = ROTL64(C3, 1) ^ C1;
+	const uint64_t D3 = ROTL64(C4, 1) ^ C2;
+	const uint64_t D4 = ROTL64(C0, 1) ^ C3;
+
+	B0 = A[ 0] ^ D0;
+	B1 = ROTL64(A[ 6] ^ D1, 44);
+	B2 = ROTL64(A[12] ^ D2, 43);
+	B3 = ROTL64(A[18] ^ D3, 21);
+	B4 = ROTL64(A[24] ^ D4, 14);
+	R[ 0] = B0 ^ ( B1 | B2) ^ rc;
+	R[ 1] = B1 ^ (~B2 | B3);
+	R[ 2] = B2 ^ ( B3 & B4);
+	R[ 3] = B3 ^ ( B4 | B0);
+	R[ 4] = B4 ^ ( B0 & B1);
+
+	B0 = ROTL64(A[ 3] ^ D3, 28);
+	B1 = ROTL64(A[ 9] ^ D4, 20);
+	B2 = ROTL64(A[10] ^ D0,  3);
+	B3 = ROTL64(A[16] ^ D1, 45);
+	B4 = ROTL64(A[22] ^ D2, 61);
+	R[ 5] = B0 ^ (B1 |  B2);
+	R[ 6] = B1 ^ (B2 &  B3);
+	R[ 7] = B2 ^ (B3 | ~B4);
+	R[ 8] = B3 ^ (B4 |  B0);
+	R[ 9] = B4 ^ (B0 &  B1);
+
+	B0 = ROTL64(A[ 1] ^ D1,  1);
+	B1 = ROTL64(A[ 7] ^ D2,  6);
+	B2 = ROTL64(A[13] ^ D3, 25);
+	B3 = ROTL64(A[19] ^ D4,  8);
+	B4 = ROTL64(A[20] ^ D0, 18);
+	R[10] =  B0 ^ ( B1 | B2);
+	R[11] =  B1 ^ ( B2 & B3);
+	R[12] =  B2 ^ (~B3 & B4);
+	R[13] = ~B3 ^ ( B4 | B0);
+	R[14] =  B4 ^ ( B0 & B1);
+
+	B0 = ROTL64(A[ 4] ^ D4, 27);
+	B1 = ROTL64(A[ 5] ^ D0, 36);
+	B2 = ROTL64(A[11] ^ D1, 10);
+	B3 = ROTL64(A[17] ^ D2, 15);
+	B4 = ROTL64(A[23] ^ D3, 56);
+	R[15] =  B0 ^ ( B1 & B2);
+	R[16] =  B1 ^ ( B2 | B3);
+	R[17] =  B2 ^ (~B3 | B4);
+	R[18] = ~B3 ^ ( B4 & B0);
+	R[19] =  B4 ^ ( B0 | B1);
+
+	B0 = ROTL64(A[ 2] ^ D2, 62);
+	B1 = ROTL64(A[ 8] ^ D3, 55);
+	B2 = ROTL64(A[14] ^ D4, 39);
+	B3 = ROTL64(A[15] ^ D0, 41);
+	B4 = ROTL64(A[21] ^ D1,  2);
+	R[20] =  B0 ^ (~B1 & B2);
+	R[21] = ~B1 ^ ( B2 | B3);
+	R[22] =  B2 ^ ( B3 & B4);
+	R[23] =  B3 ^ ( B4 | B0);
+	R[24] =  B4 ^ ( B0 & B1);
 }
 
-/* Keccak chi() transformation */
-static void keccak_chi(uint64_t *A)
+static inline void keccak_complement_lanes(uint64_t *A)
 {
-	int i = 0;
-	for (i = 0; i < 25; i += 5) {
-		uint64_t A0 = A[0 + i], A1 = A[1 + i];
-		A[0 + i] ^= ~A1 & A[2 + i];
-		A[1 + i] ^= ~A[2 + i] & A[3 + i];
-		A[2 + i] ^= ~A[3 + i] & A[4 + i];
-		A[3 + i] ^= ~A[4 + i] & A0;
-		A[4 + i] ^= ~A0 & A1;
-	}
+	A[ 1] = ~A[ 1];
+	A[ 2] = ~A[ 2];
+	A[ 8] = ~A[ 8];
+	A[12] = ~A[12];
+	A[17] = ~A[17];
+	A[20] = ~A[20];
 }
 
 static void sha3_permutation(uint64_t *state)
 {
+	uint64_t T[25];
+	int round = 0;
 #if BYTE_ORDER == BIG_ENDIAN
 	int i;
 	for (i = 0; i < 25; i++)
@@ -173,43 +201,15 @@ static void sha3_permutation(uint64_t *state)
 		REVERSE64(state[i], state[i]);
 	}
 #endif
-	int round = 0;
-	for (round = 0; round < NumberOfRounds; round++)
+	keccak_complement_lanes(state);
+	/* two rounds per iteration, so that the state goes back and forth between state[] and T[] without copies */
+	for (round = 0; round < NumberOfRounds; round += 2)
 	{
-		keccak_theta(state);
-
-		/* apply Keccak rho() transformation */
-		state[ 1] = ROTL64(state[ 1],  1);
-		state[ 2] = ROTL64(state[ 2], 62);
-		state[ 3] = ROTL64(state[ 3], 28);
-		state[ 4] = ROTL64(state[ 4], 27);
-		state[ 5] = ROTL64(state[ 5], 36);
-		state[ 6] = ROTL64(state[ 6], 44);
-		state[ 7] = ROTL64(state[ 7],  6);
-		state[ 8] = ROTL64(state[ 8], 55);
-		state[ 9] = ROTL64(state[ 9], 20);
-		state[10] = ROTL64(state[10],  3);
-		state[11] = ROTL64(state[11], 10);
-		state[12] = ROTL64(state[12], 43);
-		state[13] = ROTL64(state[13], 25);
-		state[14] = ROTL64(state[14], 39);
-		state[15] = ROTL64(state[15], 41);
-		state[16] = ROTL64(state[16], 45);
-		state[17] = ROTL64(state[17], 15);
-		state[18] = ROTL64(state[18], 21);
-		state[19] = ROTL64(state[19],  8);
-		state[20] = ROTL64(state[20], 18);
-		state[21] = ROTL64(state[21],  2);
-		state[22] = ROTL64(state[22], 61);
-		state[23] = ROTL64(state[23], 56);
-		state[24] = ROTL64(state[24], 14);
-
-		keccak_pi(state);
-		keccak_chi(state);
-
-		/* apply iota(state, round) */
-		*state ^= keccak_round_constants[round];
+		keccak_round(T, state, keccak_round_constants[round]);
+		keccak_round(state, T, keccak_round_constants[round + 1]);
 	}
+	keccak_complement_lanes(state);
+	crypto_memzero(T, sizeof(T));
 #if BYTE_ORDER == BIG_ENDIAN
 	for (i = 0; i < 25; i++)
 	{
@@ -394,6 +394,170 @@ void keccak_512(const unsigned char* data, size_t len, unsigned char* digest)
 	keccak_Update(&ctx, data, len);
 	keccak_Final(&ctx, digest);
 }
+
+#if SHA3_HAVE_AVX2
+/* Keccak-f[1600] on four states at once, lane i of the four states in A[i]. */
+
+#define ROTL256(v, n) _mm256_or_si256(_mm256_slli_epi64((v), (n)), _mm256_srli_epi64((v), 64 - (n)))
+
+/* chi of a row: B0 ^ (~B1 & B2), etc. With the ANDN of AVX2 the lanes are not complemented. */
+#define CHI256(R, i, B0, B1, B2, B3, B4) \
+	R[(i) + 0] = _mm256_xor_si256(B0, _mm256_andnot_si256(B1, B2)); \
+	R[(i) + 1] = _mm256_xor_si256(B1, _mm256_andnot_si256(B2, B3)); \
+	R[(i) + 2] = _mm256_xor_si256(B2, _mm256_andnot_si256(B3, B4)); \
+	R[(i) + 3] = _mm256_xor_si256(B3, _mm256_andnot_si256(B4, B0)); \
+	R[(i) + 4] = _mm256_xor_si256(B4, _mm256_andnot_si256(B0, B1))
+
+__attribute__((target("avx2")))
+static inline void keccak_round_x4(__m256i R[25], const __m256i A[25], uint64_t rc)
+{
+	__m256i B0, B1, B2, B3, B4;
+	const __m256i C0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[0], A[5]), _mm256_xor_si256(A[10], A[15])), A[20]);
+	const __m256i C1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[1], A[6]), _mm256_xor_si256(A[11], A[16])), A[21]);
+	const __m256i C2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[2], A[7]), _mm256_xor_si256(A[12], A[17])), A[22]);
+	const __m256i C3 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[3], A[8]), _mm256_xor_si256(A[13], A[18])), A[23]);
+	const __m256i C4 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[4], A[9]), _mm256_xor_si256(A[14], A[19])), A[24]);
+	const __m256i D0 = _mm256_xor_si256(ROTL256(C1, 1), C4);
+	const __m256i D1 = _mm256_xor_si256(ROTL256(C2, 1), C0);
+	const __m256i D2 = _mm256_xor_si256(ROTL256(C3, 1), C1);
+	const __m256i D3 = _mm256_xor_si256(ROTL256(C4, 1), C2);
+	const __m256i D4 = _mm256_xor_si256(ROTL256(C0, 1), C3);
+
+	B0 = _mm256_xor_si256(A[ 0], D0);
+	B1 = ROTL256(_mm256_xor_si256(A[ 6], D1), 44);
+	B2 = ROTL256(_mm256_xor_si256(A[12], D2), 43);
+	B3 = ROTL256(_mm256_xor_si256(A[18], D3), 21);
+	B4 = ROTL256(_mm256_xor_si256(A[24], D4), 14);
+	CHI256(R, 0, B0, B1, B2, B3, B4);
+	R[0] = _mm256_xor_si256(R[0], _mm256_set1_epi64x((long long)rc));
+
+	B0 = ROTL256(_mm256_xor_si256(A[ 3], D3), 28);
+	B1 = ROTL256(_mm256_xor_si256(A[ 9], D4), 20);
+	B2 = ROTL256(_mm256_xor_si256(A[10], D0),  3);
+	B3 = ROTL256(_mm256_xor_si256(A[16], D1), 45);
+	B4 = ROTL256(_mm256_xor_si256(A[22], D2), 61);
+	CHI256(R, 5, B0, B1, B2, B3, B4);
+
+	B0 = ROTL256(_mm256_xor_si256(A[ 1], D1),  1);
+	B1 = ROTL256(_mm256_xor_si256(A[ 7], D2),  6);
+	B2 = ROTL256(_mm256_xor_si256(A[13], D3), 25);
+	B3 = ROTL256(_mm256_xor_si256(A[19], D4),  8);
+	B4 = ROTL256(_mm256_xor_si256(A[20], D0), 18);
+	CHI256(R, 10, B0, B1, B2, B3, B4);
+
+	B0 = ROTL256(_mm256_xor_si256(A[ 4], D4), 27);
+	B1 = ROTL256(_mm256_xor_si256(A[ 5], D0), 36);
+	B2 = ROTL256(_mm256_xor_si256(A[11], D1), 10);
+	B3 = ROTL256(_mm256_xor_si256(A[17], D2), 15);
+	B4 = ROTL256(_mm256_xor_si256(A[23], D3), 56);
+	CHI256(R, 15, B0, B1, B2, B3, B4);
+
+	B0 = ROTL256(_mm256_xor_si256(A[ 2], D2), 62);
+	B1 = ROTL256(_mm256_xor_si256(A[ 8], D3), 55);
+	B2 = ROTL256(_mm256_xor_si256(A[14], D4), 39);
+	B3 = ROTL256(_mm256_xor_si256(A[15], D0), 41);
+	B4 = ROTL256(_mm256_xor_si256(A[21], D1),  2);
+	CHI256(R, 20, B0, B1, B2, B3, B4);
+}
+
+__attribute__((target("avx2")))
+static void sha3_permutation_x4(__m256i state[25])
+{
+	__m256i T[25];
+	int round = 0;
+	for (round = 0; round < NumberOfRounds; round += 2)
+	{
+		keccak_round_x4(T, state, keccak_round_constants[round]);
+		keccak_round_x4(state, T, keccak_round_constants[round + 1]);
+	}
+	crypto_memzero(T, sizeof(T));
+}
+
+/* XOR a block of each of the four messages into the states. */
+__attribute__((target("avx2")))
+static void sha3_absorb_x4(__m256i state[25], const unsigned char *const block[4], size_t block_size)
+{
+	size_t i = 0;
+	uint64_t lane[4];
+	for (i = 0; i < block_size / 8; i++)
+	{
+		memcpy(&lane[0], block[0] + 8 * i, 8);
+		memcpy(&lane[1], block[1] + 8 * i, 8);
+		memcpy(&lane[2], block[2] + 8 * i, 8);
+		memcpy(&lane[3], block[3] + 8 * i, 8);
+		state[i] = _mm256_xor_si256(state[i], _mm256_loadu_si256((const __m256i *)(const void *)lane));
+	}
+	sha3_permutation_x4(state);
+}
+
+__attribute__((target("avx2")))
+static void keccak_256_x4_avx2(const unsigned char *const data[4], size_t len, unsigned char *const digest[4])
+{
+	const size_t block_size = SHA3_256_BLOCK_LENGTH;
+	const size_t rest = len % block_size;
+	__m256i state[25];
+	unsigned char last[4][SHA3_256_BLOCK_LENGTH];
+	const unsigned char *block[4];
+	uint64_t lanes[4 * 4];
+	size_t offset = 0;
+	int i = 0;
+
+	for (i = 0; i < 25; i++) state[i] = _mm256_setzero_si256();
+	for (offset = 0; offset + block_size <= len; offset += block_size)
+	{
+		for (i = 0; i < 4; i++) block[i] = data[i] + offset;
+		sha3_absorb_x4(state, block, block_size);
+	}
+
+	/* the Keccak padding, as in keccak_Final */
+	memset(last, 0, sizeof(last));
+	for (i = 0; i < 4; i++)
+	{
+		if (rest) memcpy(last[i], data[i] + offset, rest);
+		last[i][rest] |= 0x01;
+		last[i][block_size - 1] |= 0x80;
+		block[i] = last[i];
+	}
+	sha3_absorb_x4(state, block, block_size);
+
+	/* the digest of message i is lane i of state[0..3] */
+	for (i = 0; i < 4; i++) _mm256_storeu_si256((__m256i *)(void *)(lanes + 4 * i), state[i]);
+	for (i = 0; i < 4; i++)
+	{
+		memcpy(digest[i]     , &lanes[ 0 + i], 8);
+		memcpy(digest[i] +  8, &lanes[ 4 + i], 8);
+		memcpy(digest[i] + 16, &lanes[ 8 + i], 8);
+		memcpy(digest[i] + 24, &lanes[12 + i], 8);
+	}
+	crypto_memzero(state, sizeof(state));
+	crypto_memzero(last, sizeof(last));
+	crypto_memzero(lanes, sizeof(lanes));
+}
+#endif /* SHA3_HAVE_AVX2 */
+
+/**
+ * Calculate the Keccak-256 hashes of four messages of the same length.
+ * They are computed together with AVX2 when the CPU supports it, one by one otherwise.
+ *
+ * @param data the four messages
+ * @param len length of each message
+ * @param digest the four 32-byte results
+ */
+void keccak_256_x4(const unsigned char *const data[4], size_t len, unsigned char *const digest[4])
+{
+	int i = 0;
+#if SHA3_HAVE_AVX2
+	if (__builtin_cpu_supports("avx2"))
+	{
+		keccak_256_x4_avx2(data, len, digest);
+		return;
+	}
+#endif
+	for (i = 0; i < 4; i++)
+	{
+		keccak_256(data[i], len, digest[i]);
+	}
+}
 #endif /* USE_KECCAK */
 
 void sha3_256(const unsigned char* data, size_t len, unsigned char* digest)
@@ -78,6 +78,7 @@ void sha3_Final(SHA3_CTX *ctx, unsigned char* result);
 void keccak_Final(SHA3_CTX *ctx, unsigned char* result);
 void keccak_256(const unsigned char* data, size_t len, unsigned char* digest);
 void keccak_512(const unsigned char* data, size_t len, unsigned char* digest);
+void keccak_256_x4(const unsigned char* const data[4], size_t len, unsigned char* const digest[4]);
 #endif
 
 void sha3_256(const unsigned char* data, size_t len, unsigned char* digest);
@@ -5,6 +5,7 @@
 #include <string.h>
 #include "crypto-suites/crypto-hash/common.h"
 #include "crypto-suites/crypto-hash/sha512.h"
+#include "crypto-suites/common/instrumentation.h"
 
 namespace safeheron {
 namespace hash {
@@ -180,6 +181,7 @@ CSHA512 &CSHA512::Write(const unsigned char *data, size_t len) {
 }
 
 void CSHA512::Finalize(unsigned char hash[OUTPUT_SIZE]) {
+    SAFEHERON_COUNT_HASH_BYTES(bytes);
     static const unsigned char pad[128] = {0x80};
     unsigned char sizedesc[16] = {0x00};
     WriteBE64(sizedesc + 8, bytes << 3);
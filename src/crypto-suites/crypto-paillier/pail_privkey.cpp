@@ -2,10 +2,13 @@
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/crypto-paillier/pail_privkey.h"
+#include "crypto-suites/common/custom_assert.h"
 
 
 using std::string;
 using safeheron::bignum::BN;
+using safeheron::bignum::MontContext;
+using safeheron::concurrency::Executor;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
 using google::protobuf::util::JsonStringToMessage;
@@ -85,7 +88,7 @@ std::string PailPrivKey::Inspect() const {
  *
  * @param {BN} c: encrypted number
  */
-BN PailPrivKey::Decrypt(const BN &c) const {
+BN PailPrivKey::Decrypt(const BN &c, Executor *executor) const {
     bool use_slow = ((p_ == 0)
                      || (q_ == 0)
                      || (p_sqr_ == 0)
@@ -101,13 +104,13 @@ BN PailPrivKey::Decrypt(const BN &c) const {
     if (use_slow) {
         return DecryptSlowly(c);
     } else {
-        return DecryptFast(c);
+        return DecryptFast(c, executor);
     }
 }
 
-BN PailPrivKey::DecryptNeg(const BN &c) const {
+BN PailPrivKey::DecryptNeg(const BN &c, Executor *executor) const {
     BN half_n = n_ >> 1;
-    BN m = Decrypt(c);
+    BN m = Decrypt(c, executor);
     if(m > half_n) {
         return m - n_;
     }
@@ -117,22 +120,42 @@ BN PailPrivKey::DecryptNeg(const BN &c) const {
 }
 
 
-BN PailPrivKey::DecryptFast(const BN &c) const {
-    BN x = c.PowM(p_minus_1_, p_sqr_);
-    BN lpx = (x - 1) / p_;
-    BN mp = (lpx * hp_) % p_;
+/**
+ * The Montgomery context of "m" kept in "cache", set up if the cache is empty or holds another modulus.
+ */
+static std::shared_ptr<const MontContext> get_mont_context(std::shared_ptr<const MontContext> &cache, const BN &m) {
+    std::shared_ptr<const MontContext> mont = std::atomic_load(&cache);
+    if (!mont || mont->Modulus() != m) {
+        mont = std::make_shared<MontContext>(m);
+        std::atomic_store(&cache, mont);
+    }
+    return mont;
+}
 
-    x = c.PowM(q_minus_1_, q_sqr_);
-    BN lqx = (x - 1) / q_;
-    BN mq = (lqx * hq_) % q_;
+/**
+ * mp = Lp[c^(p-1) mod p^2] * hp mod p, with c reduced modulo p^2 first.
+ */
+static BN decrypt_mod_prime(const BN &c, const BN &prime, const BN &prime_minus_1, const BN &h, const MontContext &prime_sqr_mont) {
+    BN x = prime_sqr_mont.PowM(c % prime_sqr_mont.Modulus(), prime_minus_1);
+    BN lx = (x - 1) / prime;
+    return lx.MulMod(h, prime);
+}
 
-    // a1 = mp, t1 = q_inv_p, M1 = q, m1 = p
-    // a2 = mq, t2 = p_inv_q, M2 = p, m2 = q
-    // m = CRT(a1, t1, M1, m1, a2, t2, M2, m2)
-    //   = (a1*t1*M1 + a2*t2*M2) mod (m1*m2)
-    BN item1 = (mp * q_inv_p_ * q_) % n_;
-    BN item2 = (mq * p_inv_q_ * p_) % n_;
-    return (item1 + item2) % n_;
+BN PailPrivKey::DecryptFast(const BN &c, Executor *executor) const {
+    std::shared_ptr<const MontContext> p_sqr_mont = get_mont_context(p_sqr_mont_, p_sqr_);
+    std::shared_ptr<const MontContext> q_sqr_mont = get_mont_context(q_sqr_mont_, q_sqr_);
+
+    BN mp, mq;
+    safeheron::concurrency::ParallelInvoke(executor, {
+            [&]() { mp = decrypt_mod_prime(c, p_, p_minus_1_, hp_, *p_sqr_mont); },
+            [&]() { mq = decrypt_mod_prime(c, q_, q_minus_1_, hq_, *q_sqr_mont); },
+    });
+
+    // m = CRT(mp mod p, mq mod q), in Garner's form:
+    //   m = mq + q * ((mp - mq) * q_inv_p mod p)
+    // which is in [0, n) as mq < q and the factor of q is less than p.
+    BN h = (mp - mq).MulMod(q_inv_p_, p_);
+    return mq + q_ * h;
 }
 
 BN PailPrivKey::DecryptSlowly(const BN &c) const {
@@ -141,6 +164,55 @@ BN PailPrivKey::DecryptSlowly(const BN &c) const {
     return (l * mu_) % n_;
 }
 
+bool PailPrivKey::HasFactors() const {
+    return (p_ != 0) && (q_ != 0) && (p_minus_1_ != 0) && (q_minus_1_ != 0) && (q_inv_p_ != 0);
+}
+
+/**
+ * For a unit x:
+ *     xp = x^(y mod (p-1)) mod p
+ *     xq = x^(y mod (q-1)) mod q
+ *     x^y mod n = xq + q * ((xp - xq) * q^(-1) mod p)
+ */
+BN PailPrivKey::PowMModN(const BN &x, const BN &y) const {
+    if (!HasFactors()) return x.PowM(y, n_);
+    BN xp = x % p_;
+    BN xq = x % q_;
+    if (xp == 0 || xq == 0) return x.PowM(y, n_);
+
+    xp = xp.PowM(y % p_minus_1_, p_);
+    xq = xq.PowM(y % q_minus_1_, q_);
+    BN h = ((xp - xq) * q_inv_p_) % p_;
+    return xq + h * q_;
+}
+
+/**
+ * For a unit x, the orders of Z_{p^2}^* and Z_{q^2}^* being p(p-1) and q(q-1):
+ *     xp = x^(y mod p(p-1)) mod p^2
+ *     xq = x^(y mod q(q-1)) mod q^2
+ *     x^y mod n^2 = xq + q^2 * ((xp - xq) * (q^2)^(-1) mod p^2)
+ */
+BN PailPrivKey::PowMModNSqr(const BN &x, const BN &y) const {
+    if (!HasFactors() || p_sqr_ == 0 || q_sqr_ == 0) return x.PowM(y, n_sqr_);
+    BN xp = x % p_sqr_;
+    BN xq = x % q_sqr_;
+    if (xp % p_ == 0 || xq % q_ == 0) return x.PowM(y, n_sqr_);
+
+    xp = get_mont_context(p_sqr_mont_, p_sqr_)->PowM(xp, y % (p_sqr_ - p_));
+    xq = get_mont_context(q_sqr_mont_, q_sqr_)->PowM(xq, y % (q_sqr_ - q_));
+    // (q^2)^(-1) mod p^2 = (q^(-1) mod p^2)^2, with q^(-1) mod p^2 lifted from q^(-1) mod p.
+    BN t = (q_inv_p_ * (BN::TWO - q_ * q_inv_p_)) % p_sqr_;
+    BN h = ((xp - xq) * ((t * t) % p_sqr_)) % p_sqr_;
+    return xq + h * q_sqr_;
+}
+
+BN PailPrivKey::EncryptWithR(const BN &m, const BN &r) const {
+    ASSERT_THROW(BN(0) <= m && m < n_);
+    BN gm = (m * n_ + 1) % n_sqr_;
+    BN rn = PowMModNSqr(r, n_);
+    return (gm * rn) % n_sqr_;
+}
+
 
 bool PailPrivKey::ToProtoObject(safeheron::proto::PailPriv &pail_priv) const {
     bool ok = true;
@@ -1,8 +1,10 @@
 #ifndef SAFEHERON_CRYPTO_PAIL_PRIVKEY_H
 #define SAFEHERON_CRYPTO_PAIL_PRIVKEY_H
 
+#include <memory>
 #include <string>
 #include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/common/executor.h"
 #include "crypto-suites/crypto-paillier/proto_gen/paillier.pb.switch.h"
 
 
@@ -59,18 +61,51 @@ public:
      * Decrypt:
      *     c = L(c^lambda mod n^2) * mu mod n
      *
+     * With the factorization of n, the exponentiations modulo p^2 and q^2 are independent and run as two tasks
+     * on "executor".
+     *
      * @return plain m
      * @param {safeheron::bignum::BN} c: encrypted number
+     * @param executor runs the two halves of the CRT decryption, may be null
      */
-    safeheron::bignum::BN Decrypt(const safeheron::bignum::BN &c) const;
+    safeheron::bignum::BN Decrypt(const safeheron::bignum::BN &c, safeheron::concurrency::Executor *executor = nullptr) const;
 
     /**
      * Decrypt and get m, where m is in [-(n-1)/2, m <= (n-1)/2]
      * @param c
+     * @param executor runs the two halves of the CRT decryption, may be null
      * @return plain m
      * @remark The message decrypted with "PailPrivKey.DecryptNeg" should be encrypted with "PailPubKey.EncryptNeg" or with "PailPubKey.EncryptNegWithR".
      */
-    safeheron::bignum::BN DecryptNeg(const safeheron::bignum::BN &c) const;
+    safeheron::bignum::BN DecryptNeg(const safeheron::bignum::BN &c, safeheron::concurrency::Executor *executor = nullptr) const;
+
+    /**
+     * Compute x^y mod n with the CRT over p and q, the exponent being reduced modulo p-1 and q-1.
+     * The result is the same as x.PowM(y, n). Without the factorization of n, or if x is not a unit, x.PowM(y, n)
+     * is computed instead.
+     * @param x base
+     * @param y exponent, may be negative
+     * @return x^y mod n
+     */
+    safeheron::bignum::BN PowMModN(const safeheron::bignum::BN &x, const safeheron::bignum::BN &y) const;
+
+    /**
+     * Compute x^y mod n^2 with the CRT over p^2 and q^2, the exponent being reduced modulo p(p-1) and q(q-1).
+     * The result is the same as x.PowM(y, n^2). Without the factorization of n, or if x is not a unit, x.PowM(y, n^2)
+     * is computed instead.
+     * @param x base
+     * @param y exponent, may be negative
+     * @return x^y mod n^2
+     */
+    safeheron::bignum::BN PowMModNSqr(const safeheron::bignum::BN &x, const safeheron::bignum::BN &y) const;
+
+    /**
+     * Same as PailPubKey::EncryptWithR(m, r), with r^n mod n^2 computed by PowMModNSqr.
+     * @param m plain number in [0, n)
+     * @param r random number in Z_n^*
+     * @return c = (1 + m*n) * r^n mod n^2
+     */
+    safeheron::bignum::BN EncryptWithR(const safeheron::bignum::BN &m, const safeheron::bignum::BN &r) const;
 
     const safeheron::bignum::BN &n() const { return n_; }
 
@@ -97,8 +132,9 @@ public:
     bool FromJsonString(const std::string &json_str);
 
 private:
-    safeheron::bignum::BN DecryptFast(const safeheron::bignum::BN &c) const;
+    safeheron::bignum::BN DecryptFast(const safeheron::bignum::BN &c, safeheron::concurrency::Executor *executor) const;
     safeheron::bignum::BN DecryptSlowly(const safeheron::bignum::BN &c) const;
+    bool HasFactors() const;
 
 private:
     safeheron::bignum::BN lambda_;  // lambda = (p-1)(q-1)
@@ -116,6 +152,10 @@ private:
     safeheron::bignum::BN hq_;      // hq = Lq[ g^(q-1) mod q^2 ]^(-1) mod q
     safeheron::bignum::BN q_inv_p_;   // q_inv_p = q^(-1) mod p
     safeheron::bignum::BN p_inv_q_;   // p_inv_q = p^(-1) mod q
+
+    // Montgomery contexts of p^2 and q^2, set up on first use and shared by the copies of the key.
+    mutable std::shared_ptr<const safeheron::bignum::MontContext> p_sqr_mont_;
+    mutable std::shared_ptr<const safeheron::bignum::MontContext> q_sqr_mont_;
 };
 
 };
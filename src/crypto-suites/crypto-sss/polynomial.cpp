@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <utility>
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-sss/polynomial.h"
 #include "crypto-suites/common/custom_assert.h"
@@ -5,10 +7,70 @@
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::concurrency::Executor;
 
 namespace safeheron{
 namespace sss{
 
+/**
+ * Horner's rule with lazy reduction: the accumulator is reduced only once it outgrows a double-width product,
+ * so that small x, such as party indexes, cost one reduction every few steps instead of one per step.
+ */
+static BN horner(const vector<BN> &coes, const BN &x, const BN &prime) {
+    BN x_mod = x % prime;
+    size_t limit = 2 * prime.BitLength() + 64;
+    BN r(0);
+    for (size_t i = coes.size(); i > 0; --i) {
+        r *= x_mod;
+        r += coes[i - 1];
+        if (r.BitLength() > limit) r %= prime;
+    }
+    r %= prime;
+    return r;
+}
+
+/**
+ * Whether x[begin], x[begin + 1], ... x[end - 1] is an arithmetic progression.
+ */
+static bool is_progression(const vector<BN> &xArr, size_t begin, size_t end) {
+    if (end - begin < 2) return false;
+    BN step = xArr[begin + 1] - xArr[begin];
+    for (size_t i = begin + 2; i < end; ++i) {
+        if (xArr[i] - xArr[i - 1] != step) return false;
+    }
+    return true;
+}
+
+/**
+ * y[i] = f(x[i]) for i in [begin, end), where x[begin..end) is an arithmetic progression longer than the degree.
+ *
+ * The forward differences D[k] = Δ^k f(x[begin]) are computed from the first (degree + 1) values, then every
+ * next value is f(x + h) = D[0] after D[k] += D[k+1] for k = 0, ..., degree - 1, all in [0, prime).
+ */
+static void difference_range(vector<BN> &yArr, const vector<BN> &coes, const vector<BN> &xArr, const BN &prime,
+                             size_t begin, size_t end) {
+    size_t degree = coes.size() - 1;
+    vector<BN> diffs(degree + 1);
+    for (size_t k = 0; k <= degree; ++k) {
+        diffs[k] = horner(coes, xArr[begin + k], prime);
+    }
+    for (size_t k = 1; k <= degree; ++k) {
+        for (size_t i = degree; i >= k; --i) {
+            diffs[i] -= diffs[i - 1];
+            if (diffs[i] < 0) diffs[i] += prime;
+        }
+    }
+
+    yArr[begin] = diffs[0];
+    for (size_t j = begin + 1; j < end; ++j) {
+        for (size_t k = 0; k < degree; ++k) {
+            diffs[k] += diffs[k + 1];
+            if (diffs[k] >= prime) diffs[k] -= prime;
+        }
+        yArr[j] = diffs[0];
+    }
+}
+
 Polynomial::Polynomial(const vector<BN> &coeArr, const BN &prime) {
     _prime = prime;
     _vecCoe.insert(_vecCoe.begin(), coeArr.begin(), coeArr.end());
@@ -43,26 +105,37 @@ Polynomial Polynomial::CreateRandomPolynomial(const BN &secret, int threshold, c
  * @returns {[x, y]}
  */
 void Polynomial::GetY(BN &y, const BN &x) {
-    BN r(0);
-    for(int i = _vecCoe.size() - 1; i >= 0; --i){
-        r = (_vecCoe[i] + x * r) % _prime;
-    }
-    y = r;
+    y = horner(_vecCoe, x, _prime);
 }
 
-void Polynomial::GetYArray(vector<BN> &yArr, const vector<BN> &xArr) {
-    BN y;
+void Polynomial::GetYArray(vector<BN> &yArr, const vector<BN> &xArr, Executor *executor) {
+    size_t n = xArr.size();
+    yArr.assign(n, BN());
+    if (n == 0) return;
 
-    yArr.clear();
-    for (size_t i = 0; i < xArr.size(); ++i) {
-        GetY(y, xArr[i]);
-        yArr.push_back(y);
-    }
+    // One contiguous chunk of indexes per thread, so that each chunk of a progression is stepped on its own.
+    size_t chunks = std::min(n, safeheron::concurrency::Concurrency(executor));
+    size_t chunk_len = (n + chunks - 1) / chunks;
+    chunks = (n + chunk_len - 1) / chunk_len;
+    // Stepping pays off once a chunk is much longer than the number of coefficients.
+    bool by_differences = _vecCoe.size() > 1 && chunk_len >= 4 * _vecCoe.size() && is_progression(xArr, 0, n);
+
+    safeheron::concurrency::ParallelFor(executor, chunks, [&](size_t c) {
+        size_t begin = c * chunk_len;
+        size_t end = std::min(n, begin + chunk_len);
+        if (by_differences && end - begin >= _vecCoe.size()) {
+            difference_range(yArr, _vecCoe, xArr, _prime, begin, end);
+        } else {
+            for (size_t i = begin; i < end; ++i) {
+                yArr[i] = horner(_vecCoe, xArr[i], _prime);
+            }
+        }
+    });
 }
 
-void Polynomial::GetPoints(vector<Point> &vecPoint, const vector<BN> &xArr) {
+void Polynomial::GetPoints(vector<Point> &vecPoint, const vector<BN> &xArr, Executor *executor) {
     vector<BN> yArr;
-    GetYArray(yArr, xArr);
+    GetYArray(yArr, xArr, executor);
     ASSERT_THROW(xArr.size() == yArr.size());
     for(size_t i = 0; i < xArr.size(); ++i){
         vecPoint.push_back(Point(xArr[i], yArr[i]));
@@ -85,9 +158,15 @@ void Polynomial::GetPoints(vector<Point> &vecPoint, const vector<BN> &xArr) {
  * @param curve
  * @returns {[c0, c1, ... , ct]}
  */
-void Polynomial::GetCommits(vector<CurvePoint> &commits, const CurvePoint &g) {
-    for (size_t i = 0; i < _vecCoe.size(); ++i) {
-        commits.push_back(g * _vecCoe[i]);
+void Polynomial::GetCommits(vector<CurvePoint> &commits, const CurvePoint &g, Executor *executor) {
+    // The coefficients are secret, so they go through operator*. OpenSSL multiplies every point of a short curve,
+    // the generator included, with the same constant-time ladder; only the Ed25519 generator has a precomputed table.
+    vector<CurvePoint> new_commits(_vecCoe.size());
+    safeheron::concurrency::ParallelFor(executor, _vecCoe.size(), [&](size_t i) {
+        new_commits[i] = g * _vecCoe[i];
+    });
+    for (CurvePoint &commit : new_commits) {
+        commits.push_back(std::move(commit));
     }
 }
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/common/executor.h"
 
 namespace safeheron{
 namespace sss{
@@ -25,9 +26,17 @@ public:
     static Polynomial CreateRandomPolynomial(const safeheron::bignum::BN &secret, int threshold, const safeheron::bignum::BN &prime);
 
     void GetY(safeheron::bignum::BN &y, const safeheron::bignum::BN &x);
-    void GetYArray(std::vector<safeheron::bignum::BN> &yArr, const std::vector<safeheron::bignum::BN> &xArr);
-    void GetPoints(std::vector<Point> &vecPoint, const std::vector<safeheron::bignum::BN> &xArr);
-    void GetCommits(std::vector<safeheron::curve::CurvePoint> &commits, const safeheron::curve::CurvePoint &g);
+
+    // Evaluate the polynomial at every x of "xArr". "executor" (optional) splits the indexes among threads,
+    // the results do not depend on it. If the indexes are in arithmetic progression, such as 1, 2, ..., n, and
+    // there are many more of them than coefficients, the values are stepped with finite differences: one
+    // modular addition per coefficient instead of one multiplication.
+    void GetYArray(std::vector<safeheron::bignum::BN> &yArr, const std::vector<safeheron::bignum::BN> &xArr,
+                   safeheron::concurrency::Executor *executor = nullptr);
+    void GetPoints(std::vector<Point> &vecPoint, const std::vector<safeheron::bignum::BN> &xArr,
+                   safeheron::concurrency::Executor *executor = nullptr);
+    void GetCommits(std::vector<safeheron::curve::CurvePoint> &commits, const safeheron::curve::CurvePoint &g,
+                    safeheron::concurrency::Executor *executor = nullptr);
 
     static bool VerifyCommits(const std::vector<safeheron::curve::CurvePoint> &commits, const safeheron::bignum::BN &x, const safeheron::bignum::BN &y, const safeheron::curve::CurvePoint &g, const safeheron::bignum::BN &prime);
     static void LagrangeInterpolate(safeheron::bignum::BN &y, const safeheron::bignum::BN &x, const std::vector<Point> &vecPoint, const safeheron::bignum::BN &prime );
@@ -1,32 +1,36 @@
 #include "crypto-suites/crypto-sss/vsss.h"
+#include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/common/custom_assert.h"
 
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::concurrency::Executor;
 
 namespace safeheron{
 namespace sss {
 namespace vsss {
 
-void MakeShares(vector<Point> &shares, const BN &secret, int threshold, const vector<BN> &shareIndexs, const BN &prime) {
+void MakeShares(vector<Point> &shares, const BN &secret, int threshold, const vector<BN> &shareIndexs, const BN &prime,
+                Executor *executor) {
     Polynomial poly = Polynomial::CreateRandomPolynomial(secret, threshold, prime);
-    poly.GetPoints(shares, shareIndexs);
+    poly.GetPoints(shares, shareIndexs, executor);
 }
 
 void MakeSharesWithCommits(vector<Point> &shares, vector<CurvePoint> &commits, const BN &secret, int threshold,
-                                 const vector<BN> &shareIndexs, const BN &prime, const CurvePoint &g) {
+                                 const vector<BN> &shareIndexs, const BN &prime, const CurvePoint &g, Executor *executor) {
     Polynomial poly = Polynomial::CreateRandomPolynomial(secret, threshold, prime);
-    poly.GetPoints(shares, shareIndexs);
-    poly.GetCommits(commits, g);
+    poly.GetPoints(shares, shareIndexs, executor);
+    poly.GetCommits(commits, g, executor);
 }
 
 void MakeSharesWithCommitsAndCoes(vector<Point> &shares, vector<CurvePoint> &commits, const BN &secret, int threshold,
-                                 const vector<BN> &shareIndexs, const vector<BN> &coeArray, const BN &prime, const CurvePoint &g) {
+                                 const vector<BN> &shareIndexs, const vector<BN> &coeArray, const BN &prime, const CurvePoint &g,
+                                 Executor *executor) {
     ASSERT_THROW((int)(coeArray.size() + 1) == threshold);
     Polynomial poly(secret, coeArray, prime);
-    poly.GetPoints(shares, shareIndexs);
-    poly.GetCommits(commits, g);
+    poly.GetPoints(shares, shareIndexs, executor);
+    poly.GetCommits(commits, g, executor);
 }
 
 bool VerifyShare(const vector<CurvePoint> &commits, int threshold, const BN &shareIndex, const BN &share, const CurvePoint &g, const BN &prime) {
@@ -34,6 +38,66 @@ bool VerifyShare(const vector<CurvePoint> &commits, int threshold, const BN &sha
     return Polynomial::VerifyCommits(commits, shareIndex, share, g, prime);
 }
 
+/**
+ * Check the shares [begin, end) at once with the weights:
+ *     g^{sum w_j y_j} === c0^{sum w_j} c1^{sum w_j x_j} ... cn^{sum w_j x_j^n}
+ */
+static bool VerifyCombination(const vector<CurvePoint> &commits, const vector<Point> &shares, const vector<BN> &weights,
+                              size_t begin, size_t end, const CurvePoint &g, const BN &prime) {
+    BN y_sum(0);
+    vector<BN> coes(commits.size(), BN(0));
+    for (size_t j = begin; j < end; ++j) {
+        y_sum = y_sum.AddMod(weights[j].MulMod(shares[j].y, prime), prime);
+        BN w_x_pow_n = weights[j];
+        for (size_t i = 0; i < commits.size(); ++i) {
+            coes[i] = coes[i].AddMod(w_x_pow_n, prime);
+            w_x_pow_n = w_x_pow_n.MulMod(shares[j].x, prime);
+        }
+    }
+    CurvePoint gy(g.GetCurveType());
+    for (size_t i = 0; i < commits.size(); ++i) {
+        gy += commits[i] * coes[i];
+    }
+    return g * y_sum == gy;
+}
+
+/**
+ * Find the invalid shares in [begin, end), a range known to fail the check.
+ */
+static void BisectInvalidShares(const vector<CurvePoint> &commits, const vector<Point> &shares, const vector<BN> &weights,
+                                size_t begin, size_t end, const CurvePoint &g, const BN &prime, vector<size_t> &invalidIndexes) {
+    if (end - begin == 1) {
+        invalidIndexes.push_back(begin);
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    bool left_ok = VerifyCombination(commits, shares, weights, begin, mid, g, prime);
+    if (!left_ok) BisectInvalidShares(commits, shares, weights, begin, mid, g, prime, invalidIndexes);
+    // If the left half passes, the right half holds the failure.
+    if (left_ok || !VerifyCombination(commits, shares, weights, mid, end, g, prime)) {
+        BisectInvalidShares(commits, shares, weights, mid, end, g, prime, invalidIndexes);
+    }
+}
+
+bool VerifySharesBatch(const vector<CurvePoint> &commits, int threshold, const vector<Point> &shares, const CurvePoint &g, const BN &prime, vector<size_t> &invalidIndexes) {
+    invalidIndexes.clear();
+    if((int)commits.size() != threshold) {
+        for (size_t j = 0; j < shares.size(); ++j) invalidIndexes.push_back(j);
+        return false;
+    }
+    if (shares.empty()) return true;
+
+    vector<BN> weights;
+    weights.reserve(shares.size());
+    for (size_t j = 0; j < shares.size(); ++j) {
+        weights.push_back(safeheron::rand::RandomBNLt(prime));
+    }
+    if (VerifyCombination(commits, shares, weights, 0, shares.size(), g, prime)) return true;
+
+    BisectInvalidShares(commits, shares, weights, 0, shares.size(), g, prime, invalidIndexes);
+    return false;
+}
+
 void RecoverSecret(BN &secret, const vector<Point> &shares, const BN &prime) {
     BN x = BN::ZERO;
     Polynomial::LagrangeInterpolate(secret, x, shares, prime);
@@ -5,40 +5,51 @@ using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
 using safeheron::curve::Curve;
 using safeheron::curve::CurveType;
+using safeheron::concurrency::Executor;
 
 namespace safeheron{
 namespace sss {
 namespace vsss_ed25519 {
 static const Curve *curv = GetCurveParam(CurveType::ED25519);
 
-void MakeShares(vector<Point> &shares, const BN &secret, int threshold, const vector<BN> &shareIndexs) {
-    vsss::MakeShares(shares, secret, threshold, shareIndexs, curv->n);
+void MakeShares(vector<Point> &shares, const BN &secret, int threshold, const vector<BN> &shareIndexs, Executor *executor) {
+    vsss::MakeShares(shares, secret, threshold, shareIndexs, curv->n, executor);
 }
 
 void MakeSharesWithCommits(vector<Point> &shares, vector<CurvePoint> &commits, const BN &secret,
-                                          int threshold, const vector<BN> &shareIndexs) {
-    vsss::MakeSharesWithCommits(shares, commits, secret, threshold, shareIndexs, curv->n, curv->g);
+                                          int threshold, const vector<BN> &shareIndexs, Executor *executor) {
+    vsss::MakeSharesWithCommits(shares, commits, secret, threshold, shareIndexs, curv->n, curv->g, executor);
 }
 
 void MakeSharesWithCommits(vector<Point> &shares, vector<CurvePoint> &commits, const BN &secret,
-                                          int threshold, int num) {
+                                          int threshold, int num, Executor *executor) {
     vector<BN> shareIndexs;
     for(int i = 1; i <= num; i ++){
         shareIndexs.push_back(BN(i));
     }
-    vsss::MakeSharesWithCommits(shares, commits, secret, threshold, shareIndexs, curv->n, curv->g);
+    vsss::MakeSharesWithCommits(shares, commits, secret, threshold, shareIndexs, curv->n, curv->g, executor);
 }
 
 void MakeSharesWithCommitsAndCoes(vector<Point> &shares, vector<CurvePoint> &commits, const BN &secret,
                                                  int threshold, const vector<BN> &shareIndexs,
-                                                 const vector<BN> &coeArray) {
-    vsss::MakeSharesWithCommitsAndCoes(shares, commits, secret, threshold, shareIndexs, coeArray, curv->n, curv->g);
+                                                 const vector<BN> &coeArray, Executor *executor) {
+    vsss::MakeSharesWithCommitsAndCoes(shares, commits, secret, threshold, shareIndexs, coeArray, curv->n, curv->g, executor);
 }
 
 bool VerifyShare(const vector<CurvePoint> &commits, int threshold, const BN &shareIndex, const BN &share) {
     return vsss::VerifyShare(commits, threshold, shareIndex, share, curv->g, curv->n);
 }
 
+bool VerifySharesBatch(const vector<CurvePoint> &commits, int threshold, const vector<Point> &shares,
+                       vector<size_t> &invalidIndexes) {
+    return vsss::VerifySharesBatch(commits, threshold, shares, curv->g, curv->n, invalidIndexes);
+}
+
+bool VerifySharesBatch(const vector<CurvePoint> &commits, int threshold, const vector<Point> &shares) {
+    vector<size_t> invalidIndexes;
+    return vsss::VerifySharesBatch(commits, threshold, shares, curv->g, curv->n, invalidIndexes);
+}
+
 void RecoverSecret(BN &secret, const vector<Point> &shares) {
     vsss::RecoverSecret(secret, shares, curv->n);
 }
@@ -25,7 +25,8 @@ namespace vsss_ed25519 {
  */
 void
 MakeShares(std::vector<Point> &shares, const safeheron::bignum::BN &secret, int threshold,
-           const std::vector<safeheron::bignum::BN> &shareIndexs);
+           const std::vector<safeheron::bignum::BN> &shareIndexs,
+           safeheron::concurrency::Executor *executor = nullptr);
 
 /**
  * Make shares of 'secret'
@@ -50,12 +51,14 @@ MakeShares(std::vector<Point> &shares, const safeheron::bignum::BN &secret, int
 void
 MakeSharesWithCommits(std::vector<Point> &shares, std::vector<safeheron::curve::CurvePoint> &commits,
                       const safeheron::bignum::BN &secret, int threshold,
-                      const std::vector<safeheron::bignum::BN> &shareIndexs);
+                      const std::vector<safeheron::bignum::BN> &shareIndexs,
+                      safeheron::concurrency::Executor *executor = nullptr);
 
 void
 MakeSharesWithCommits(std::vector<Point> &shares, std::vector<safeheron::curve::CurvePoint> &commits,
                       const safeheron::bignum::BN &secret, int threshold,
-                      int num);
+                      int num,
+                      safeheron::concurrency::Executor *executor = nullptr);
 
 /**
  * Make shares of 'secret'
@@ -81,7 +84,8 @@ void
 MakeSharesWithCommitsAndCoes(std::vector<Point> &shares, std::vector<safeheron::curve::CurvePoint> &commits,
                              const safeheron::bignum::BN &secret, int threshold,
                              const std::vector<safeheron::bignum::BN> &shareIndexs,
-                             const std::vector<safeheron::bignum::BN> &coeArray);
+                             const std::vector<safeheron::bignum::BN> &coeArray,
+                             safeheron::concurrency::Executor *executor = nullptr);
 
 /**
  * Verify share in Feldman's scheme
@@ -97,6 +101,30 @@ bool
 VerifyShare(const std::vector<safeheron::curve::CurvePoint> &commits, int threshold, const safeheron::bignum::BN &shareIndex,
             const safeheron::bignum::BN &share);
 
+/**
+ * Verify a batch of shares in Feldman's scheme, with threshold + 1 scalar multiplications for the whole batch.
+ *
+ * @param commits
+ * @param threshold
+ * @param shares
+ * @param invalidIndexes positions in 'shares' of the invalid shares
+ * @returns {boolean} true if all the shares are valid
+ */
+bool
+VerifySharesBatch(const std::vector<safeheron::curve::CurvePoint> &commits, int threshold, const std::vector<Point> &shares,
+                  std::vector<size_t> &invalidIndexes);
+
+/**
+ * Verify a batch of shares in Feldman's scheme, with threshold + 1 scalar multiplications for the whole batch.
+ *
+ * @param commits
+ * @param threshold
+ * @param shares
+ * @returns {boolean} true if all the shares are valid
+ */
+bool
+VerifySharesBatch(const std::vector<safeheron::curve::CurvePoint> &commits, int threshold, const std::vector<Point> &shares);
+
 /**
  * Recover secret
  *
@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/dln_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -25,6 +26,7 @@ namespace dln_proof {
 const int ITERATIONS = 128;
 
 void DLNProof::Prove(const BN &N, const BN &h1, const BN &h2, const BN &p, const BN &q, const BN &x) {
+    SAFEHERON_TRACE_SCOPE("DLNProof::Prove");
     BN pq = p * q;
     std::vector<BN> r_arr;
 
@@ -37,23 +39,18 @@ void DLNProof::Prove(const BN &N, const BN &h1, const BN &h2, const BN &p, const
     }
 
     // Hash( N || h1 || h2 || alpha_arr_)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N);
+    transcript.Append(h1);
+    transcript.Append(h2);
     for(int i = 0; i < ITERATIONS; ++i) {
-        alpha_arr_[i].ToBytesBE(str);
-        sha256.Write((const uint8_t *)(str.c_str()), str.length());
+        transcript.Append(alpha_arr_[i]);
     }
-    sha256.Finalize(sha256_digest);
+    transcript.Finalize(sha256_digest);
 
     for(int i = 0; i < ITERATIONS; ++i) {
         bool flag = ((sha256_digest[i/8] >> (i%8)) & 0x01) != 0;
@@ -63,6 +60,7 @@ void DLNProof::Prove(const BN &N, const BN &h1, const BN &h2, const BN &p, const
 }
 
 bool DLNProof::Verify(const BN &N, const BN &h1, const BN &h2) const {
+    SAFEHERON_TRACE_SCOPE("DLNProof::Verify");
     if( (alpha_arr_.size() < ITERATIONS) || (t_arr_.size() < ITERATIONS) ) return false;
 
     if(N <= 1) return false;
@@ -78,23 +76,18 @@ bool DLNProof::Verify(const BN &N, const BN &h1, const BN &h2) const {
     if(N.BitLength() < 2046)return false;
 
     // Hash( N || h1 || h2 || alpha_arr_)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N);
+    transcript.Append(h1);
+    transcript.Append(h2);
     for(int i = 0; i < ITERATIONS; ++i) {
-        alpha_arr_[i].ToBytesBE(str);
-        sha256.Write((const uint8_t *)(str.c_str()), str.length());
+        transcript.Append(alpha_arr_[i]);
     }
-    sha256.Finalize(sha256_digest);
+    transcript.Finalize(sha256_digest);
 
     for(int i = 0; i < ITERATIONS; ++i) {
         bool flag = ((sha256_digest[i/8] >> (i%8)) & 0x01) != 0;
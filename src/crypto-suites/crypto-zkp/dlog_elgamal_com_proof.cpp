@@ -1,15 +1,17 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/dlog_elgamal_com_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::curve::FixedBaseMul;
 using safeheron::hash::CSafeHash512;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -24,6 +26,7 @@ namespace zkp {
 namespace dlog_elgamal_com {
 
 void DlogElGamalComProof::Prove(const DlogElGamalComStatement &statement, const DlogElGamalComWitness &witness){
+    SAFEHERON_TRACE_SCOPE("DlogElGamalComProof::Prove");
     const safeheron::curve::CurvePoint &g = statement.g_;
     const safeheron::curve::CurvePoint &L = statement.L_;
     const safeheron::curve::CurvePoint &M = statement.M_;
@@ -48,33 +51,22 @@ void DlogElGamalComProof::Prove(const DlogElGamalComStatement &statement, const
     B_ = h * m;
 
     // H( Salt ||  g || L || M || X || Y || h || q || A || N || B )
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    g.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    L.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    M.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    h.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Append(g);
+    transcript.Append(L);
+    transcript.Append(M);
+    transcript.Append(X);
+    transcript.Append(Y);
+    transcript.Append(h);
+    transcript.Append(q);
+    transcript.Append(A_);
+    transcript.Append(N_);
+    transcript.Append(B_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -86,6 +78,7 @@ void DlogElGamalComProof::Prove(const DlogElGamalComStatement &statement, const
 }
 
 bool DlogElGamalComProof::Verify(const DlogElGamalComStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("DlogElGamalComProof::Verify");
     const safeheron::curve::CurvePoint &g = statement.g_;
     const safeheron::curve::CurvePoint &L = statement.L_;
     const safeheron::curve::CurvePoint &M = statement.M_;
@@ -95,33 +88,22 @@ bool DlogElGamalComProof::Verify(const DlogElGamalComStatement &statement) const
     const safeheron::bignum::BN &q = statement.q_;
 
     // H( Salt ||  g || L || M || X || Y || h || q || A || N || B )
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    g.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    L.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    M.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    h.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Append(g);
+    transcript.Append(L);
+    transcript.Append(M);
+    transcript.Append(X);
+    transcript.Append(Y);
+    transcript.Append(h);
+    transcript.Append(q);
+    transcript.Append(A_);
+    transcript.Append(N_);
+    transcript.Append(B_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -131,19 +113,19 @@ bool DlogElGamalComProof::Verify(const DlogElGamalComStatement &statement) const
     CurvePoint right_point;
 
     // g^z = A * L^e
-    left_point = g * z_;
+    left_point = FixedBaseMul(g, statement.g_table_, z_);
     right_point = A_ + L * e;
     ok = left_point == right_point;
     if(!ok) return false;
 
     // g^u * X^z = N * M^e
-    left_point = g * u_ + X * z_;
+    left_point = FixedBaseMul(g, statement.g_table_, u_) + FixedBaseMul(X, statement.X_table_, z_);
     right_point = N_ + M * e;
     ok = left_point == right_point;
     if(!ok) return false;
 
     // h^u = B * Y^e
-    left_point = h * u_;
+    left_point = FixedBaseMul(h, statement.h_table_, u_);
     right_point = B_ + Y * e;
     ok = left_point == right_point;
     if(!ok) return false;
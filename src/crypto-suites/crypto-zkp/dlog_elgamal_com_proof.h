@@ -5,6 +5,7 @@
 #include <utility>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
 #include "crypto-suites/crypto-paillier/pail.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
@@ -41,6 +42,12 @@ struct DlogElGamalComStatement {
                             const safeheron::curve::CurvePoint &Y,
                             const safeheron::curve::CurvePoint &h,
                             safeheron::bignum::BN q): g_(g), L_(L), M_(M), X_(X), Y_(Y), h_(h), q_(std::move(q)){}
+
+    // Optional precomputed tables of g, h and the public key X, to be shared by the proofs over the same points.
+    // Only Verify uses them: Prove multiplies by secret nonces, which must not go through a table.
+    const safeheron::curve::FixedBaseTable *g_table_ = nullptr;
+    const safeheron::curve::FixedBaseTable *h_table_ = nullptr;
+    const safeheron::curve::FixedBaseTable *X_table_ = nullptr;
 };
 
 struct DlogElGamalComWitness {
@@ -1,15 +1,17 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/dlog_equality_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::curve::FixedBaseMul;
 using safeheron::hash::CSafeHash256;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -24,6 +26,7 @@ namespace zkp {
 namespace dlog_equality {
 
 void DlogEqualityProof::Prove(const DlogEqualityStatement &statement, const BN &x){
+    SAFEHERON_TRACE_SCOPE("DlogEqualityProof::Prove");
     const safeheron::curve::CurvePoint &g = statement.g_;
     const safeheron::curve::CurvePoint &h = statement.h_;
     const safeheron::curve::CurvePoint &X = statement.X_;
@@ -40,27 +43,19 @@ void DlogEqualityProof::Prove(const DlogEqualityStatement &statement, const BN &
     B_ = h * alpha;
 
     // H( Salt ||  q || g || h || X || Y || A || B )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    g.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(q);
+    transcript.Append(g);
+    transcript.Append(h);
+    transcript.Append(X);
+    transcript.Append(Y);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
@@ -69,6 +64,7 @@ void DlogEqualityProof::Prove(const DlogEqualityStatement &statement, const BN &
 }
 
 bool DlogEqualityProof::Verify(const DlogEqualityStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("DlogEqualityProof::Verify");
     const safeheron::curve::CurvePoint &g = statement.g_;
     const safeheron::curve::CurvePoint &h = statement.h_;
     const safeheron::curve::CurvePoint &X = statement.X_;
@@ -76,27 +72,19 @@ bool DlogEqualityProof::Verify(const DlogEqualityStatement &statement) const {
     const safeheron::bignum::BN &q = statement.q_;
 
     // H( Salt ||  q || g || h || X || Y || A || B )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    g.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(q);
+    transcript.Append(g);
+    transcript.Append(h);
+    transcript.Append(X);
+    transcript.Append(Y);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
@@ -105,13 +93,13 @@ bool DlogEqualityProof::Verify(const DlogEqualityStatement &statement) const {
     CurvePoint right_point;
 
     // g^z = A * X^e
-    left_point = g * z_;
+    left_point = FixedBaseMul(g, statement.g_table_, z_);
     right_point = A_ + X * e;
     ok = left_point == right_point;
     if(!ok) return false;
 
     // h^z = B * Y^e
-    left_point = h * z_;
+    left_point = FixedBaseMul(h, statement.h_table_, z_);
     right_point = B_ + Y * e;
     ok = left_point == right_point;
     if(!ok) return false;
@@ -4,6 +4,7 @@
 #include <string>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
 #include "crypto-suites/crypto-paillier/pail.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
@@ -35,6 +36,11 @@ struct DlogEqualityStatement {
                              const safeheron::curve::CurvePoint &X,
                              const safeheron::curve::CurvePoint &Y,
                              safeheron::bignum::BN q): g_(g), h_(h), X_(X), Y_(Y), q_(std::move(q)){}
+
+    // Optional precomputed tables of g and h, to be shared by the proofs over the same points.
+    // Only Verify uses them: Prove multiplies by secret nonces, which must not go through a table.
+    const safeheron::curve::FixedBaseTable *g_table_ = nullptr;
+    const safeheron::curve::FixedBaseTable *h_table_ = nullptr;
 };
 
 class DlogEqualityProof {
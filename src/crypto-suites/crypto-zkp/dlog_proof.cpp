@@ -1,10 +1,11 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/dlog_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -33,23 +34,20 @@ void DLogProof::InternalProve(const BN &sk, const CurvePoint &g, const BN &order
 }
 
 void DLogProof::InternalProveWithR(const BN &sk, const CurvePoint &g, const BN &order, const BN &r) {
+    SAFEHERON_TRACE_SCOPE("DLogProof::Prove");
     g_r_ = g * r;
     pk_ = g * sk;
 
     // c = H( Salt || G || g^r || g^sk || UserID || OtherInfo)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    g.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    g_r_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    pk_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(g);
+    transcript.Append(g_r_);
+    transcript.Append(pk_);
+    transcript.Finalize(sha256_digest);
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % order;
 
@@ -59,23 +57,20 @@ void DLogProof::InternalProveWithR(const BN &sk, const CurvePoint &g, const BN &
 }
 
 bool DLogProof::InternalVerify(const CurvePoint &g) const {
+    SAFEHERON_TRACE_SCOPE("DLogProof::Verify");
     const curve::Curve *curv = curve::GetCurveParam(g.GetCurveType());
     if(curv == nullptr) return false;
 
     // c = H( Salt || G || g^r || g^sk || UserID || OtherInfo)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    g.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    g_r_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    pk_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(g);
+    transcript.Append(g_r_);
+    transcript.Append(pk_);
+    transcript.Finalize(sha256_digest);
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % curv->n;
 
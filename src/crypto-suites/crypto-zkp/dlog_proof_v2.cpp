@@ -1,11 +1,12 @@
 #include <cassert>
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/dlog_proof_v2.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -34,23 +35,20 @@ void DLogProof_V2::InternalProve(const BN &x, const CurvePoint &g, const BN &ord
 }
 
 void DLogProof_V2::InternalProveWithR(const BN &x, const CurvePoint &g, const BN &order, const BN &alpha) {
+    SAFEHERON_TRACE_SCOPE("DLogProof_V2::Prove");
     A_ = g * alpha;
     CurvePoint X = g * x;
 
     // c = H( Salt || G || g^alpha || g^x || UserID || OtherInfo)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    g.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(g);
+    transcript.Append(A_);
+    transcript.Append(X);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, 32);
     e = e % order;
 
@@ -60,23 +58,20 @@ void DLogProof_V2::InternalProveWithR(const BN &x, const CurvePoint &g, const BN
 }
 
 bool DLogProof_V2::InternalVerify(const curve::CurvePoint &X) const {
+    SAFEHERON_TRACE_SCOPE("DLogProof_V2::Verify");
     const curve::Curve *curv = curve::GetCurveParam(X.GetCurveType());
     if(curv == nullptr) return false;
 
     // e = H( Salt || G || g^alpha || g^x || UserID || OtherInfo)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    curv->g.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(curv->g);
+    transcript.Append(A_);
+    transcript.Append(X);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, 32);
     e = e % curv->n;
 
@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/dlog_proof_v3.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -28,23 +29,20 @@ void DLogProof_V3::Prove(const BN &x, const CurvePoint &G, const BN &order) {
 }
 
 void DLogProof_V3::ProveWithR(const BN &x, const CurvePoint &G, const BN &order, const BN &alpha) {
+    SAFEHERON_TRACE_SCOPE("DLogProof_V3::Prove");
     A_ = G * alpha;
     CurvePoint X = G * x;
 
     // c = H( Salt || G || g^alpha || g^x || UserID || OtherInfo)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(G);
+    transcript.Append(A_);
+    transcript.Append(X);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, 32);
     e = e % order;
 
@@ -53,20 +51,17 @@ void DLogProof_V3::ProveWithR(const BN &x, const CurvePoint &G, const BN &order,
 }
 
 bool DLogProof_V3::Verify(const curve::CurvePoint &X, const curve::CurvePoint &G, const BN &order) const {
+    SAFEHERON_TRACE_SCOPE("DLogProof_V3::Verify");
     // e = H( Salt || G || g^alpha || g^x || UserID || OtherInfo)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(G);
+    transcript.Append(A_);
+    transcript.Append(X);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, 32);
     e = e % order;
 
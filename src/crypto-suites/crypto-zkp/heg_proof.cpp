@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/heg_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -30,6 +31,7 @@ void HegProof::Prove(const HomoElGamalStatement &delta, const HomoElGamalWitness
 
 void
 HegProof::ProveWithR(const HomoElGamalStatement &delta, const HomoElGamalWitness &witness, const BN &s1, const BN &s2) {
+    SAFEHERON_TRACE_SCOPE("HegProof::Prove");
     // T = H^s1 + Y^s2
     curve::CurvePoint A1 = delta.H_ * s1;
     curve::CurvePoint A2 = delta.Y_ * s2;
@@ -39,27 +41,19 @@ HegProof::ProveWithR(const HomoElGamalStatement &delta, const HomoElGamalWitness
     const curve::Curve * curve = curve::GetCurveParam(delta.H_.GetCurveType());
 
     // e = H( Salt || T || A3 || G || H || Y || D || E)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    T.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A3.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.G_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.H_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.Y_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.D_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.E_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(T);
+    transcript.Append(A3);
+    transcript.Append(delta.G_);
+    transcript.Append(delta.H_);
+    transcript.Append(delta.Y_);
+    transcript.Append(delta.D_);
+    transcript.Append(delta.E_);
+    transcript.Finalize(sha256_digest);
 
     BN e = BN::FromBytesBE(sha256_digest, 32);
 
@@ -79,33 +73,26 @@ HegProof::ProveWithR(const HomoElGamalStatement &delta, const HomoElGamalWitness
 }
 
 bool HegProof::Verify(const HomoElGamalStatement &delta) const {
+    SAFEHERON_TRACE_SCOPE("HegProof::Verify");
     // T = H^s1 + Y^s2
     // A3 = G^s2
     // z1 = s1 + x * e mod q
     // z2 = s2 + r * e mod q
 
     // e = H( Salt || T || A3 || G || H || Y || D || E)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    T_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A3_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.G_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.H_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.Y_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.D_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    delta.E_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(T_);
+    transcript.Append(A3_);
+    transcript.Append(delta.G_);
+    transcript.Append(delta.H_);
+    transcript.Append(delta.Y_);
+    transcript.Append(delta.D_);
+    transcript.Append(delta.E_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, 32);
 
     // H^z1 + Y^z2
@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/heg_proof_v2.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -29,6 +30,7 @@ void HEGProof_V2::Prove(const HEGStatement_V2 &statement, const HEGWitness_V2 &w
 }
 
 void HEGProof_V2::ProveWithR(const HEGStatement_V2 &statement, const HEGWitness_V2 &witness, const BN &a, const BN &b) {
+    SAFEHERON_TRACE_SCOPE("HEGProof_V2::Prove");
     const curve::CurvePoint &G = statement.G_;
     const curve::CurvePoint &V = statement.V_;
     const curve::CurvePoint &R = statement.R_;
@@ -45,29 +47,22 @@ void HEGProof_V2::ProveWithR(const HEGStatement_V2 &statement, const HEGWitness_
     CurvePoint Beta = A * b;
 
     // e = H( Salt || G || V || R || A || B || ord || Alpha || Beta)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    V.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    R.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    B.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    ord.ToBytes32BE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Alpha.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Beta.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(G);
+    transcript.Append(V);
+    transcript.Append(R);
+    transcript.Append(A);
+    transcript.Append(B);
+    uint8_t ord_buf[32];
+    ord.ToBytes32BE(ord_buf);
+    transcript.Write(ord_buf, sizeof(ord_buf));
+    transcript.Append(Alpha);
+    transcript.Append(Beta);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % ord;
@@ -85,6 +80,7 @@ void HEGProof_V2::ProveWithR(const HEGStatement_V2 &statement, const HEGWitness_
 }
 
 bool HEGProof_V2::Verify(const HEGStatement_V2 &statement) const {
+    SAFEHERON_TRACE_SCOPE("HEGProof_V2::Verify");
     const curve::CurvePoint &G = statement.G_;
     const curve::CurvePoint &V = statement.V_;
     const curve::CurvePoint &R = statement.R_;
@@ -93,29 +89,22 @@ bool HEGProof_V2::Verify(const HEGStatement_V2 &statement) const {
     const safeheron::bignum::BN &ord = statement.ord_;
 
     // e = H( Salt || G || V || R || A || B || ord || Alpha || Beta)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    V.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    R.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    A.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    B.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    ord.ToBytes32BE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Alpha_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Beta_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(G);
+    transcript.Append(V);
+    transcript.Append(R);
+    transcript.Append(A);
+    transcript.Append(B);
+    uint8_t ord_buf[32];
+    ord.ToBytes32BE(ord_buf);
+    transcript.Write(ord_buf, sizeof(ord_buf));
+    transcript.Append(Alpha_);
+    transcript.Append(Beta_);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % ord;
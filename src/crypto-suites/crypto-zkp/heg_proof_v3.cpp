@@ -1,14 +1,16 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/heg_proof_v3.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::curve::FixedBaseMul;
 using safeheron::hash::CSafeHash256;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -29,6 +31,7 @@ void HEGProof_V3::Prove(const HEGStatement_V3 &statement, const HEGWitness_V3 &w
 }
 
 void HEGProof_V3::ProveWithR(const HEGStatement_V3 &statement, const HEGWitness_V3 &witness, const BN &a, const BN &b) {
+    SAFEHERON_TRACE_SCOPE("HEGProof_V3::Prove");
     const curve::CurvePoint &T = statement.T_;
     const curve::CurvePoint &G = statement.G_;
     const curve::CurvePoint &H = statement.H_;
@@ -45,29 +48,22 @@ void HEGProof_V3::ProveWithR(const HEGStatement_V3 &statement, const HEGWitness_
     CurvePoint Beta =  G * a + H * b;
 
     // c = H( Salt || T || G || H || S || R || ord || Alpha || Beta)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    T.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    H.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    S.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    R.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    ord.ToBytes32BE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Alpha.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Beta.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(T);
+    transcript.Append(G);
+    transcript.Append(H);
+    transcript.Append(S);
+    transcript.Append(R);
+    uint8_t ord_buf[32];
+    ord.ToBytes32BE(ord_buf);
+    transcript.Write(ord_buf, sizeof(ord_buf));
+    transcript.Append(Alpha);
+    transcript.Append(Beta);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % ord;
@@ -85,6 +81,7 @@ void HEGProof_V3::ProveWithR(const HEGStatement_V3 &statement, const HEGWitness_
 }
 
 bool HEGProof_V3::Verify(const HEGStatement_V3 &statement) const {
+    SAFEHERON_TRACE_SCOPE("HEGProof_V3::Verify");
     const curve::CurvePoint &T = statement.T_;
     const curve::CurvePoint &G = statement.G_;
     const curve::CurvePoint &H = statement.H_;
@@ -93,29 +90,22 @@ bool HEGProof_V3::Verify(const HEGStatement_V3 &statement) const {
     const safeheron::bignum::BN &ord = statement.ord_;
 
     // c = H( Salt || T || G || H || S || R || ord || Alpha || Beta)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    T.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    H.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    S.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    R.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    ord.ToBytes32BE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Alpha_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Beta_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(T);
+    transcript.Append(G);
+    transcript.Append(H);
+    transcript.Append(S);
+    transcript.Append(R);
+    uint8_t ord_buf[32];
+    ord.ToBytes32BE(ord_buf);
+    transcript.Write(ord_buf, sizeof(ord_buf));
+    transcript.Append(Alpha_);
+    transcript.Append(Beta_);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % ord;
@@ -125,13 +115,13 @@ bool HEGProof_V3::Verify(const HEGStatement_V3 &statement) const {
     CurvePoint right_point;
 
     // R^t = Alpha * S^c
-    left_point = R * t_;
+    left_point = FixedBaseMul(R, statement.R_table_, t_);
     right_point = Alpha_ + S * c;
     ok = left_point == right_point;
     if(!ok) return false;
 
     // G^t * H^u = Beta * T^c
-    left_point = G * t_ + H * u_;
+    left_point = FixedBaseMul(G, statement.G_table_, t_) + FixedBaseMul(H, statement.H_table_, u_);
     right_point = Beta_ +  T * c;
     ok = left_point == right_point;
     if(!ok) return false;
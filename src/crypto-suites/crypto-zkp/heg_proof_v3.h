@@ -4,6 +4,7 @@
 #include <string>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -37,6 +38,12 @@ struct HEGStatement_V3 {
                     const curve::CurvePoint &S,
                     const curve::CurvePoint &R,
                     const safeheron::bignum::BN ord): T_(T), G_(G), H_(H), S_(S), R_(R), ord_(ord){}
+
+    // Optional precomputed tables of G, H and R, to be shared by the proofs over the same points.
+    // Only Verify uses them: Prove multiplies by secret nonces, which must not go through a table.
+    const curve::FixedBaseTable *G_table_ = nullptr;
+    const curve::FixedBaseTable *H_table_ = nullptr;
+    const curve::FixedBaseTable *R_table_ = nullptr;
 };
 
 struct HEGWitness_V3 {
@@ -1,14 +1,16 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/linear_combination_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::curve::FixedBaseMul;
 using safeheron::hash::CSafeHash256;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -29,6 +31,7 @@ void LinearCombinationProof::Prove(const LinearCombinationStatement &statement,
 }
 
 void LinearCombinationProof::ProveWithR(const LinearCombinationStatement &statement, const LinearCombinationWitness &witness, const BN &a, const BN &b) {
+    SAFEHERON_TRACE_SCOPE("LinearCombinationProof::Prove");
     const curve::CurvePoint &V = statement.V_;
     const curve::CurvePoint &R = statement.R_;
     const curve::CurvePoint &G = statement.G_;
@@ -41,23 +44,19 @@ void LinearCombinationProof::ProveWithR(const LinearCombinationStatement &statem
     CurvePoint Alpha = R * a + G * b;
 
     // c = H( Salt || V || R || G || ord || Alpha)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    V.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    R.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    ord.ToBytes32BE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Alpha.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(V);
+    transcript.Append(R);
+    transcript.Append(G);
+    uint8_t ord_buf[32];
+    ord.ToBytes32BE(ord_buf);
+    transcript.Write(ord_buf, sizeof(ord_buf));
+    transcript.Append(Alpha);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % ord;
@@ -74,29 +73,26 @@ void LinearCombinationProof::ProveWithR(const LinearCombinationStatement &statem
 }
 
 bool LinearCombinationProof::Verify(const LinearCombinationStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("LinearCombinationProof::Verify");
     const curve::CurvePoint &V = statement.V_;
     const curve::CurvePoint &R = statement.R_;
     const curve::CurvePoint &G = statement.G_;
     const safeheron::bignum::BN &ord = statement.ord_;
 
     // c = H( Salt || V || R || G || ord || Alpha)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    V.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    R.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    G.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    ord.ToBytes32BE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    Alpha_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(V);
+    transcript.Append(R);
+    transcript.Append(G);
+    uint8_t ord_buf[32];
+    ord.ToBytes32BE(ord_buf);
+    transcript.Write(ord_buf, sizeof(ord_buf));
+    transcript.Append(Alpha_);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, 32);
     c = c % ord;
@@ -106,7 +102,7 @@ bool LinearCombinationProof::Verify(const LinearCombinationStatement &statement)
     CurvePoint right_point;
 
     // R^t * G^u = Alpha * V^c
-    left_point = R * t_ + G * u_;
+    left_point = FixedBaseMul(R, statement.R_table_, t_) + FixedBaseMul(G, statement.G_table_, u_);
     right_point = V * c + Alpha_;
     ok = left_point == right_point;
     if(!ok) return false;
@@ -4,6 +4,7 @@
 #include <string>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -31,6 +32,11 @@ struct LinearCombinationStatement {
                     const curve::CurvePoint &R,
                     const curve::CurvePoint &G,
                     const safeheron::bignum::BN ord):V_(V), R_(R), G_(G), ord_(ord){}
+
+    // Optional precomputed tables of R and G, to be shared by the proofs over the same points.
+    // Only Verify uses them: Prove multiplies by secret nonces, which must not go through a table.
+    const curve::FixedBaseTable *R_table_ = nullptr;
+    const curve::FixedBaseTable *G_table_ = nullptr;
 };
 
 struct LinearCombinationWitness {
@@ -1,10 +1,11 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/common.h"
 #include "crypto-suites/crypto-zkp/no_small_factor_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -25,6 +26,7 @@ namespace zkp {
 namespace no_small_factor_proof {
 
 void NoSmallFactorProof::Prove(const NoSmallFactorSetUp &setup, const NoSmallFactorStatement &statement, const NoSmallFactorWitness &witness) {
+    SAFEHERON_TRACE_SCOPE("NoSmallFactorProof::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -68,38 +70,27 @@ void NoSmallFactorProof::Prove(const NoSmallFactorSetUp &setup, const NoSmallFac
     T_ = (Q_.PowM(alpha, N_tilde) * t.PowM(r, N_tilde)) % N_tilde;
 
     // H( Salt ||  N || s || t || N0 || l || varepsilon || P || Q || A || B || T || sigma )
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t buf[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
     uint_to_byte4(buf, l);
-    sha512.Write(buf, sizeof buf);
+    transcript.Write(buf, sizeof buf);
     uint_to_byte4(buf, varepsilon);
-    sha512.Write(buf, sizeof buf);
-    P_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Q_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sigma_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(buf, sizeof buf);
+    transcript.Append(P_);
+    transcript.Append(Q_);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Append(T_);
+    transcript.Append(sigma_);
+    transcript.Finalize(sha512_digest);
     int byte_len = l / 8;
     BN e = BN::FromBytesBE(sha512_digest, byte_len);
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -113,6 +104,7 @@ void NoSmallFactorProof::Prove(const NoSmallFactorSetUp &setup, const NoSmallFac
 }
 
 bool NoSmallFactorProof::Verify(const NoSmallFactorSetUp &setup, const NoSmallFactorStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("NoSmallFactorProof::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -142,38 +134,27 @@ bool NoSmallFactorProof::Verify(const NoSmallFactorSetUp &setup, const NoSmallFa
     if(T_.Gcd(N_tilde) != 1) return false;
 
     // H( Salt ||  N || s || t || N0 || l || varepsilon || P || Q || A || B || T || sigma )
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t buf[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
     uint_to_byte4(buf, l);
-    sha512.Write(buf, sizeof buf);
+    transcript.Write(buf, sizeof buf);
     uint_to_byte4(buf, varepsilon);
-    sha512.Write(buf, sizeof buf);
-    P_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Q_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sigma_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(buf, sizeof buf);
+    transcript.Append(P_);
+    transcript.Append(Q_);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Append(T_);
+    transcript.Append(sigma_);
+    transcript.Finalize(sha512_digest);
     int byte_len = l / 8;
     BN e = BN::FromBytesBE(sha512_digest, byte_len);
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
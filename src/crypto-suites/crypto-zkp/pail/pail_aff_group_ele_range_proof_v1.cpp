@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_aff_group_ele_range_proof_v1.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -23,6 +24,7 @@ namespace zkp {
 namespace pail {
 
 void PailAffGroupEleRangeProof_V1::Prove(const PailAffGroupEleRangeSetUp_V1 &setup, const PailAffGroupEleRangeStatement_V1 &statement, const PailAffGroupEleRangeWitness_V1 &witness){
+    SAFEHERON_TRACE_SCOPE("PailAffGroupEleRangeProof_V1::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &h1 = setup.h1_;
     const BN &h2 = setup.h2_;
@@ -69,41 +71,26 @@ void PailAffGroupEleRangeProof_V1::Prove(const PailAffGroupEleRangeSetUp_V1 &set
     w_ = ( h1.PowM(gamma, N_tilde) * h2.PowM(tau, N_tilde) ) % N_tilde;
 
     // H( Salt || N || h1 || h2 || c1 || c2 || N || X || q || u || z || z_prime || t || v || w )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    pail_pub.n().ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    u_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_prime_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    t_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    v_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(c1);
+    transcript.Append(c2);
+    transcript.Append(pail_pub.n());
+    transcript.Append(X);
+    transcript.Append(q);
+    transcript.Append(u_);
+    transcript.Append(z_);
+    transcript.Append(z_prime_);
+    transcript.Append(t_);
+    transcript.Append(v_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
@@ -120,6 +107,7 @@ void PailAffGroupEleRangeProof_V1::Prove(const PailAffGroupEleRangeSetUp_V1 &set
 }
 
 bool PailAffGroupEleRangeProof_V1::Verify(const PailAffGroupEleRangeSetUp_V1 &setup, const PailAffGroupEleRangeStatement_V1 &statement) const {
+    SAFEHERON_TRACE_SCOPE("PailAffGroupEleRangeProof_V1::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &h1 = setup.h1_;
     const BN &h2 = setup.h2_;
@@ -144,46 +132,33 @@ bool PailAffGroupEleRangeProof_V1::Verify(const PailAffGroupEleRangeSetUp_V1 &se
     if(v_.Gcd(pail_pub.n()) != BN::ONE)return false;
     if(w_.Gcd(N_tilde) != BN::ONE)return false;
     if(s_.Gcd(pail_pub.n()) != BN::ONE)return false;
+    // c2 is raised to -e below.
+    if(c2.Gcd(pail_pub.n()) != BN::ONE)return false;
 
     if(s1_ > q3 || s1_ < BN::ZERO - q3)return false;
     if(t1_ > q7 || t1_ < BN::ZERO - q7)return false;
 
     // H( Salt || N || h1 || h2 || c1 || c2 || N || X || q || u || z || z_prime || t || v || w )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    pail_pub.n().ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    u_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_prime_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    t_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    v_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(c1);
+    transcript.Append(c2);
+    transcript.Append(pail_pub.n());
+    transcript.Append(X);
+    transcript.Append(q);
+    transcript.Append(u_);
+    transcript.Append(z_);
+    transcript.Append(z_prime_);
+    transcript.Append(t_);
+    transcript.Append(v_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
@@ -199,21 +174,28 @@ bool PailAffGroupEleRangeProof_V1::Verify(const PailAffGroupEleRangeSetUp_V1 &se
     ok = left_point == right_point;
     if(!ok) return false;
 
-    // h1^s1 * h2^s2 = z^e * z_prime    mod N_tilde
-    left_num = ( h1.PowM(s1_, N_tilde) * h2.PowM(s2_, N_tilde) ) % N_tilde;
-    right_num = ( z_.PowM(e, N_tilde) * z_prime_ ) % N_tilde;
+    // h1^s1 * h2^s2 * z^(-e) = z_prime    mod N_tilde
+    left_num = BN::MultiPowM({h1, h2, z_}, {s1_, s2_, e.Neg()}, N_tilde);
+    right_num = z_prime_ % N_tilde;
     ok = left_num == right_num;
     if(!ok) return false;
 
-    // h1^t1 * h2^t2 = t^e * w     mod N_tilde
-    left_num = ( h1.PowM(t1_, N_tilde) * h2.PowM(t2_, N_tilde) ) % N_tilde;
-    right_num = ( t_.PowM(e, N_tilde) * w_ ) % N_tilde;
+    // h1^t1 * h2^t2 * t^(-e) = w     mod N_tilde
+    left_num = BN::MultiPowM({h1, h2, t_}, {t1_, t2_, e.Neg()}, N_tilde);
+    right_num = w_ % N_tilde;
     ok = left_num == right_num;
     if(!ok) return false;
 
-    // c1^s1 * s^N * Gamma^t1 = c2^e * v    mod N^2
-    left_num = ( c1.PowM(s1_, pail_pub.n_sqr()) * s_.PowM(pail_pub.n(), pail_pub.n_sqr()) * pail_pub.g().PowM(t1_, pail_pub.n_sqr()) ) % pail_pub.n_sqr();
-    right_num = ( c2.PowM(e, pail_pub.n_sqr()) * v_ ) % pail_pub.n_sqr();
+    // c1^s1 * s^N * Gamma^t1 * c2^(-e) = v    mod N^2
+    const BN &N = pail_pub.n();
+    const BN &NSqr = pail_pub.n_sqr();
+    if (pail_pub.g() == N + 1) {
+        // Gamma^t1 = (1 + N)^t1 = 1 + t1 * N    mod N^2
+        left_num = ( BN::MultiPowM({c1, s_, c2}, {s1_, N, e.Neg()}, NSqr) * (N * t1_ + 1) ) % NSqr;
+    } else {
+        left_num = BN::MultiPowM({c1, s_, pail_pub.g(), c2}, {s1_, N, t1_, e.Neg()}, NSqr);
+    }
+    right_num = v_ % NSqr;
     ok = left_num == right_num;
     if(!ok) return false;
 
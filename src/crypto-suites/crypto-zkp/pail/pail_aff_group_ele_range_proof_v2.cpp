@@ -1,15 +1,18 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/common.h"
 #include "crypto-suites/crypto-zkp/pail/pail_aff_group_ele_range_proof_v2.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
+using safeheron::zkp::RingPedersenBatch;
 using safeheron::curve::CurvePoint;
+using safeheron::concurrency::ParallelInvoke;
 using safeheron::hash::CSafeHash512;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -23,7 +26,8 @@ namespace safeheron{
 namespace zkp {
 namespace pail {
 
-void PailAffGroupEleRangeProof_V2::Prove(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement, const PailAffGroupEleRangeWitness_V2 &witness){
+void PailAffGroupEleRangeProof_V2::Prove(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement, const PailAffGroupEleRangeWitness_V2 &witness, safeheron::concurrency::Executor *executor){
+    SAFEHERON_TRACE_SCOPE("PailAffGroupEleRangeProof_V2::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -72,71 +76,70 @@ void PailAffGroupEleRangeProof_V2::Prove(const PailAffGroupEleRangeSetUp_V2 &set
     BN delta = RandomNegBNInSymInterval(limit_delta);
     BN mu = RandomNegBNInSymInterval(limit_mu);
 
-    // A = C^alpha * (1 + N0)^beta * r^N0  mod N0^2
-    //   = C^alpha * (1 + N0 * beta) * r^N0  mod N0^2
-    A_ = ( C.PowM(alpha, N0Sqr) * ( N0 * beta + 1 ) * r.PowM(N0, N0Sqr) ) % N0Sqr;
-    // Bx = g^alpha
-    Bx_ = curv->g * alpha;
-    // By = (1 + N1)^beta * ry^N1  mod N1^2
-    By_ = ( ( N1 * beta + 1 ) * ry.PowM(N1, N1Sqr) ) % N1Sqr;
-    // E = s^alpha * t^gamma mod N_tilde
-    E_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
-    // S = s^x * t^m mod N_tilde
-    S_ = ( s.PowM(x, N_tilde) * t.PowM(m, N_tilde) ) % N_tilde;
-    // F = s^beta * t^delta mod N_tilde
-    F_ = ( s.PowM(beta, N_tilde) * t.PowM(delta, N_tilde) ) % N_tilde;
-    // T = s^y * t^mu mod N_tilde
-    T_ = ( s.PowM(y, N_tilde) * t.PowM(mu, N_tilde) ) % N_tilde;
+    // The commitments are independent of each other.
+    ParallelInvoke(executor, {
+        [&] {
+            // A = C^alpha * (1 + N0)^beta * r^N0  mod N0^2
+            //   = C^alpha * (1 + N0 * beta) * r^N0  mod N0^2
+            A_ = ( C.PowM(alpha, N0Sqr) * ( N0 * beta + 1 ) * r.PowM(N0, N0Sqr) ) % N0Sqr;
+        },
+        [&] {
+            // Bx = g^alpha
+            Bx_ = curv->g * alpha;
+        },
+        [&] {
+            // By = (1 + N1)^beta * ry^N1  mod N1^2
+            By_ = ( ( N1 * beta + 1 ) * ry.PowM(N1, N1Sqr) ) % N1Sqr;
+        },
+        [&] {
+            // E = s^alpha * t^gamma mod N_tilde
+            E_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // S = s^x * t^m mod N_tilde
+            S_ = ( s.PowM(x, N_tilde) * t.PowM(m, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // F = s^beta * t^delta mod N_tilde
+            F_ = ( s.PowM(beta, N_tilde) * t.PowM(delta, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // T = s^y * t^mu mod N_tilde
+            T_ = ( s.PowM(y, N_tilde) * t.PowM(mu, N_tilde) ) % N_tilde;
+        },
+    });
 
     // H( Salt || N || s || t || N0 || N1 || C || D || Y || X || q || l || l_prime || varepsilon || S || T || A || Bx || By || E || F )
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N1.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(N1);
+    transcript.Append(C);
+    transcript.Append(D);
+    transcript.Append(Y);
+    transcript.Append(X);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, l_prime);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Bx_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    By_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    E_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    F_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(T_);
+    transcript.Append(A_);
+    transcript.Append(Bx_);
+    transcript.Append(By_);
+    transcript.Append(E_);
+    transcript.Append(F_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -149,13 +152,45 @@ void PailAffGroupEleRangeProof_V2::Prove(const PailAffGroupEleRangeSetUp_V2 &set
     z3_ = e * m + gamma;
     // z4 = e * mu + delta
     z4_ = e * mu + delta;
-    // w = r * rho^e   mod N0
-    w_ = ( r * rho.PowM(e, N0) ) % N0;
-    // wy = ry * rho_y^e   mode N1
-    wy_ = ( ry * rho_y.PowM(e, N1) ) % N1;
+    ParallelInvoke(executor, {
+        [&] {
+            // w = r * rho^e   mod N0
+            w_ = ( r * rho.PowM(e, N0) ) % N0;
+        },
+        [&] {
+            // wy = ry * rho_y^e   mode N1
+            wy_ = ( ry * rho_y.PowM(e, N1) ) % N1;
+        },
+    });
+}
+
+bool PailAffGroupEleRangeProof_V2::Verify(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement, safeheron::concurrency::Executor *executor) const {
+    return VerifyInternal(setup, statement, executor, nullptr);
+}
+
+bool PailAffGroupEleRangeProof_V2::BatchVerify(const PailAffGroupEleRangeSetUp_V2 &setup, const std::vector<PailAffGroupEleRangeStatement_V2> &statements,
+                                               const std::vector<PailAffGroupEleRangeProof_V2> &proofs, std::vector<bool> &results,
+                                               safeheron::concurrency::Executor *executor) {
+    SAFEHERON_TRACE_SCOPE("PailAffGroupEleRangeProof_V2::BatchVerify");
+    if(statements.size() != proofs.size()) {
+        results.assign(proofs.size(), false);
+        return false;
+    }
+    return safeheron::zkp::BatchVerifyRingPedersen(setup.N_tilde_, setup.s_, setup.t_, proofs.size(),
+                                                   [&](size_t i, RingPedersenBatch *batch) {
+                                                       return proofs[i].VerifyInternal(setup, statements[i], nullptr, batch);
+                                                   }, results, executor);
 }
 
-bool PailAffGroupEleRangeProof_V2::Verify(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement) const {
+bool PailAffGroupEleRangeProof_V2::BatchVerify(const PailAffGroupEleRangeSetUp_V2 &setup, const std::vector<PailAffGroupEleRangeStatement_V2> &statements,
+                                               const std::vector<PailAffGroupEleRangeProof_V2> &proofs, safeheron::concurrency::Executor *executor) {
+    std::vector<bool> results;
+    return BatchVerify(setup, statements, proofs, results, executor);
+}
+
+bool PailAffGroupEleRangeProof_V2::VerifyInternal(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement,
+                                                  safeheron::concurrency::Executor *executor, RingPedersenBatch *batch) const {
+    SAFEHERON_TRACE_SCOPE("PailAffGroupEleRangeProof_V2::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -193,98 +228,79 @@ bool PailAffGroupEleRangeProof_V2::Verify(const PailAffGroupEleRangeSetUp_V2 &se
     if(T_ % N_tilde == BN::ZERO) return false;
     if(w_.Gcd(N0) != BN::ONE) return false;
     if(wy_.Gcd(N1) != BN::ONE) return false;
+    // D, Y, S and T are raised to -e below.
+    if(D.Gcd(N0) != BN::ONE) return false;
+    if(Y.Gcd(N1) != BN::ONE) return false;
+    if(S_.Gcd(N_tilde) != BN::ONE) return false;
+    if(T_.Gcd(N_tilde) != BN::ONE) return false;
 
     if(z1_ > limit_alpha || z1_ < BN::ZERO - limit_alpha)return false;
     if(z2_ > limit_beta || z2_ < BN::ZERO - limit_beta)return false;
 
     // H( Salt || N || s || t || N0 || N1 || C || D || Y || X || q || l || l_prime || varepsilon || S || T || A || Bx || By || E || F )
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N1.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(N1);
+    transcript.Append(C);
+    transcript.Append(D);
+    transcript.Append(Y);
+    transcript.Append(X);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, l_prime);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Bx_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    By_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    E_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    F_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(T_);
+    transcript.Append(A_);
+    transcript.Append(Bx_);
+    transcript.Append(By_);
+    transcript.Append(E_);
+    transcript.Append(F_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
 
-    bool ok = true;
     CurvePoint left_point;
     CurvePoint right_point;
-    BN left_num;
-    BN right_num;
-
-    // C^z1 * (1 + N0)^z2 * w^N0 = A * D^e    mod N0^2
-    left_num = ( C.PowM(z1_, N0Sqr) * (N0 * z2_ + 1) * w_.PowM(N0, N0Sqr) ) % N0Sqr;
-    right_num = ( A_ * D.PowM(e, N0Sqr) ) % N0Sqr;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    // g^z1 = Bx * X^e
-    left_point = curv->g * z1_;
-    right_point = Bx_ + X * e;
-    ok = left_point == right_point;
-    if(!ok) return false;
-
-    // (1 + N1)^z2 * wy^N1 = By * Y^e    mod N1^2
-    left_num = ( (N1 * z2_ + 1) * wy_.PowM(N1, N1Sqr) ) % N1Sqr;
-    right_num = ( By_ * Y.PowM(e, N1Sqr) ) % N1Sqr;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    // s^z1 * t^z3 = E * S^e    mod N_tilde
-    left_num = ( s.PowM(z1_, N_tilde) * t.PowM(z3_, N_tilde) ) % N_tilde;
-    right_num = ( E_ * S_.PowM(e, N_tilde) ) % N_tilde;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    // s^z2 * t^z4 = F * T^e    mod N_tilde
-    left_num = ( s.PowM(z2_, N_tilde) * t.PowM(z4_, N_tilde) ) % N_tilde;
-    right_num = ( F_ * T_.PowM(e, N_tilde) ) % N_tilde;
-    ok = left_num == right_num;
-    if(!ok) return false;
+    BN left_num[4];
+
+    // Every equation is checked as one multi-exponentiation, the equations are independent of each other.
+    ParallelInvoke(executor, {
+        // C^z1 * (1 + N0)^z2 * w^N0 * D^(-e) = A    mod N0^2
+        [&] { left_num[0] = ( BN::MultiPowM({C, w_, D}, {z1_, N0, e.Neg()}, N0Sqr) * (N0 * z2_ + 1) ) % N0Sqr; },
+        // g^z1 = Bx * X^e
+        [&] { left_point = curv->g * z1_; },
+        [&] { right_point = Bx_ + X * e; },
+        // (1 + N1)^z2 * wy^N1 * Y^(-e) = By    mod N1^2
+        [&] { left_num[1] = ( BN::MultiPowM({wy_, Y}, {N1, e.Neg()}, N1Sqr) * (N1 * z2_ + 1) ) % N1Sqr; },
+        // s^z1 * t^z3 * S^(-e) = E    mod N_tilde
+        [&] { if(!batch) left_num[2] = BN::MultiPowM({s, t, S_}, {z1_, z3_, e.Neg()}, N_tilde); },
+        // s^z2 * t^z4 * T^(-e) = F    mod N_tilde
+        [&] { if(!batch) left_num[3] = BN::MultiPowM({s, t, T_}, {z2_, z4_, e.Neg()}, N_tilde); },
+    });
+
+    if(left_num[0] != A_ % N0Sqr) return false;
+    if(left_point != right_point) return false;
+    if(left_num[1] != By_ % N1Sqr) return false;
+    if(batch) {
+        batch->Add(z1_, z3_, {S_}, {e.Neg()}, E_);
+        batch->Add(z2_, z4_, {T_}, {e.Neg()}, F_);
+    } else {
+        if(left_num[2] != E_ % N_tilde) return false;
+        if(left_num[3] != F_ % N_tilde) return false;
+    }
 
     return true;
 }
@@ -3,9 +3,12 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
+#include "crypto-suites/crypto-zkp/ring_pedersen_batch.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -103,8 +106,22 @@ public:
 
     void SetSalt(const std::string &salt) { salt_ = salt; }
 
-    void Prove(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement, const PailAffGroupEleRangeWitness_V2 &witness);
-    bool Verify(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement) const;
+    // "executor" (optional) runs the independent exponentiations in parallel, the transcript does not depend on it.
+    void Prove(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement, const PailAffGroupEleRangeWitness_V2 &witness,
+               safeheron::concurrency::Executor *executor = nullptr);
+    bool Verify(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement,
+                safeheron::concurrency::Executor *executor = nullptr) const;
+
+    // Verify the proofs of many statements against the same setup, such as those of all the other parties. The
+    // equations mod N_tilde of all the proofs are checked at once (see RingPedersenBatch), and each proof is verified
+    // on its own only if this check fails. results[i] is the result of proofs[i].
+    // Unlike Verify, which is exact, BatchVerify accepts the equations mod N_tilde up to a factor of order 2, such as
+    // a commitment sent as -S instead of S.
+    static bool BatchVerify(const PailAffGroupEleRangeSetUp_V2 &setup, const std::vector<PailAffGroupEleRangeStatement_V2> &statements,
+                            const std::vector<PailAffGroupEleRangeProof_V2> &proofs, std::vector<bool> &results,
+                            safeheron::concurrency::Executor *executor = nullptr);
+    static bool BatchVerify(const PailAffGroupEleRangeSetUp_V2 &setup, const std::vector<PailAffGroupEleRangeStatement_V2> &statements,
+                            const std::vector<PailAffGroupEleRangeProof_V2> &proofs, safeheron::concurrency::Executor *executor = nullptr);
 
     bool ToProtoObject(safeheron::proto::PailAffGroupEleRangeProof_V2 &proof) const;
     bool FromProtoObject(const safeheron::proto::PailAffGroupEleRangeProof_V2 &proof);
@@ -114,6 +131,10 @@ public:
 
     bool ToJsonString(std::string &json_str) const;
     bool FromJsonString(const std::string &json_str);
+
+private:
+    bool VerifyInternal(const PailAffGroupEleRangeSetUp_V2 &setup, const PailAffGroupEleRangeStatement_V2 &statement,
+                        safeheron::concurrency::Executor *executor, RingPedersenBatch *batch) const;
 };
 
 }
@@ -1,14 +1,17 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_aff_range_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
+using safeheron::zkp::RingPedersenBatch;
 using safeheron::curve::CurvePoint;
+using safeheron::concurrency::ParallelInvoke;
 using safeheron::hash::CSafeHash256;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -22,7 +25,8 @@ namespace safeheron{
 namespace zkp {
 namespace pail {
 
-void PailAffRangeProof::Prove(const PailAffRangeSetUp &setup, const PailAffRangeStatement &statement, const PailAffRangeWitness &witness){
+void PailAffRangeProof::Prove(const PailAffRangeSetUp &setup, const PailAffRangeStatement &statement, const PailAffRangeWitness &witness, safeheron::concurrency::Executor *executor){
+    SAFEHERON_TRACE_SCOPE("PailAffRangeProof::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &h1 = setup.h1_;
     const BN &h2 = setup.h2_;
@@ -52,49 +56,49 @@ void PailAffRangeProof::Prove(const PailAffRangeSetUp &setup, const PailAffRange
     BN gamma = RandomBNLt(q7);
     BN tau = RandomBNLt(q3_N_tilde);
 
-    // z = h1^x * h2^rho mod N_tilde
-    z_ = ( h1.PowM(x, N_tilde) * h2.PowM(rho, N_tilde) ) % N_tilde;
-    // z' = h1^alpha * h2^rho_prime mod N_tilde
-    z_prime_ = ( h1.PowM(alpha, N_tilde) * h2.PowM(rho_prime, N_tilde) ) % N_tilde;
-    // t = h1^y * h2^sigma mod N_tilde
-    t_ = ( h1.PowM(y, N_tilde) * h2.PowM(sigma, N_tilde) ) % N_tilde;
-    // v = c1^alpha * Gamma^gamma * beta^N mod N^2
-    v_ = ( c1.PowM(alpha, pail_pub.n_sqr()) * pail_pub.g().PowM(gamma, pail_pub.n_sqr()) * beta.PowM(pail_pub.n(), pail_pub.n_sqr()) ) % pail_pub.n_sqr();
-    // w = h1^gamma * h2^tau mod N_tilde
-    w_ = ( h1.PowM(gamma, N_tilde) * h2.PowM(tau, N_tilde) ) % N_tilde;
+    // The commitments are independent of each other.
+    ParallelInvoke(executor, {
+        [&] {
+            // z = h1^x * h2^rho mod N_tilde
+            z_ = ( h1.PowM(x, N_tilde) * h2.PowM(rho, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // z' = h1^alpha * h2^rho_prime mod N_tilde
+            z_prime_ = ( h1.PowM(alpha, N_tilde) * h2.PowM(rho_prime, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // t = h1^y * h2^sigma mod N_tilde
+            t_ = ( h1.PowM(y, N_tilde) * h2.PowM(sigma, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // v = c1^alpha * Gamma^gamma * beta^N mod N^2
+            v_ = ( c1.PowM(alpha, pail_pub.n_sqr()) * pail_pub.g().PowM(gamma, pail_pub.n_sqr()) * beta.PowM(pail_pub.n(), pail_pub.n_sqr()) ) % pail_pub.n_sqr();
+        },
+        [&] {
+            // w = h1^gamma * h2^tau mod N_tilde
+            w_ = ( h1.PowM(gamma, N_tilde) * h2.PowM(tau, N_tilde) ) % N_tilde;
+        },
+    });
 
     // H( Salt ||  N_tilde || h1 || h2 || c1 || c2 || q || N || z || z_prime || t || v || w )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    pail_pub.n().ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_prime_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    t_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    v_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(c1);
+    transcript.Append(c2);
+    transcript.Append(q);
+    transcript.Append(pail_pub.n());
+    transcript.Append(z_);
+    transcript.Append(z_prime_);
+    transcript.Append(t_);
+    transcript.Append(v_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
@@ -110,7 +114,33 @@ void PailAffRangeProof::Prove(const PailAffRangeSetUp &setup, const PailAffRange
     t2_ = e * sigma + tau;
 }
 
-bool PailAffRangeProof::Verify(const PailAffRangeSetUp &setup, const PailAffRangeStatement &statement) const {
+bool PailAffRangeProof::Verify(const PailAffRangeSetUp &setup, const PailAffRangeStatement &statement, safeheron::concurrency::Executor *executor) const {
+    return VerifyInternal(setup, statement, executor, nullptr);
+}
+
+bool PailAffRangeProof::BatchVerify(const PailAffRangeSetUp &setup, const std::vector<PailAffRangeStatement> &statements,
+                                    const std::vector<PailAffRangeProof> &proofs, std::vector<bool> &results,
+                                    safeheron::concurrency::Executor *executor) {
+    SAFEHERON_TRACE_SCOPE("PailAffRangeProof::BatchVerify");
+    if(statements.size() != proofs.size()) {
+        results.assign(proofs.size(), false);
+        return false;
+    }
+    return safeheron::zkp::BatchVerifyRingPedersen(setup.N_tilde_, setup.h1_, setup.h2_, proofs.size(),
+                                                   [&](size_t i, RingPedersenBatch *batch) {
+                                                       return proofs[i].VerifyInternal(setup, statements[i], nullptr, batch);
+                                                   }, results, executor);
+}
+
+bool PailAffRangeProof::BatchVerify(const PailAffRangeSetUp &setup, const std::vector<PailAffRangeStatement> &statements,
+                                    const std::vector<PailAffRangeProof> &proofs, safeheron::concurrency::Executor *executor) {
+    std::vector<bool> results;
+    return BatchVerify(setup, statements, proofs, results, executor);
+}
+
+bool PailAffRangeProof::VerifyInternal(const PailAffRangeSetUp &setup, const PailAffRangeStatement &statement,
+                                       safeheron::concurrency::Executor *executor, RingPedersenBatch *batch) const {
+    SAFEHERON_TRACE_SCOPE("PailAffRangeProof::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &h1 = setup.h1_;
     const BN &h2 = setup.h2_;
@@ -133,66 +163,63 @@ bool PailAffRangeProof::Verify(const PailAffRangeSetUp &setup, const PailAffRang
     if(v_.Gcd(pail_pub.n()) != BN::ONE)return false;
     if(w_.Gcd(N_tilde) != BN::ONE)return false;
     if(s_.Gcd(pail_pub.n()) != BN::ONE)return false;
+    // c2 is raised to -e below.
+    if(c2.Gcd(pail_pub.n()) != BN::ONE)return false;
 
     if(s1_ > q3 || s1_ < BN::ZERO)return false;
     if(t1_ > q7 || t1_ < BN::ZERO)return false;
 
     // H( Salt ||  N_tilde || h1 || h2 || c1 || c2 || q || N || z || z_prime || t || v || w )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    pail_pub.n().ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_prime_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    t_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    v_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(c1);
+    transcript.Append(c2);
+    transcript.Append(q);
+    transcript.Append(pail_pub.n());
+    transcript.Append(z_);
+    transcript.Append(z_prime_);
+    transcript.Append(t_);
+    transcript.Append(v_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
-    bool ok = true;
-    BN left_num;
-    BN right_num;
-
-    // h1^s1 * h2^s2 = z^e * z_prime    mod N_tilde
-    left_num = ( h1.PowM(s1_, N_tilde) * h2.PowM(s2_, N_tilde) ) % N_tilde;
-    right_num = ( z_.PowM(e, N_tilde) * z_prime_ ) % N_tilde;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    // h1^t1 * h2^t2 = t^e * w     mod N_tilde
-    left_num = ( h1.PowM(t1_, N_tilde) * h2.PowM(t2_, N_tilde) ) % N_tilde;
-    right_num = ( t_.PowM(e, N_tilde) * w_ ) % N_tilde;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    // c1^s1 * s^N * Gamma^t1 = c2^e * v    mod N^2
-    left_num = ( c1.PowM(s1_, pail_pub.n_sqr()) * s_.PowM(pail_pub.n(), pail_pub.n_sqr()) * pail_pub.g().PowM(t1_, pail_pub.n_sqr()) ) % pail_pub.n_sqr();
-    right_num = ( c2.PowM(e, pail_pub.n_sqr()) * v_ ) % pail_pub.n_sqr();
-    ok = left_num == right_num;
-    if(!ok) return false;
+    const BN &N = pail_pub.n();
+    const BN &NSqr = pail_pub.n_sqr();
+    BN left_num[3];
+
+    // Every equation is checked as one multi-exponentiation, the equations are independent of each other.
+    ParallelInvoke(executor, {
+        // h1^s1 * h2^s2 * z^(-e) = z_prime    mod N_tilde
+        [&] { if(!batch) left_num[0] = BN::MultiPowM({h1, h2, z_}, {s1_, s2_, e.Neg()}, N_tilde); },
+        // h1^t1 * h2^t2 * t^(-e) = w     mod N_tilde
+        [&] { if(!batch) left_num[1] = BN::MultiPowM({h1, h2, t_}, {t1_, t2_, e.Neg()}, N_tilde); },
+        // c1^s1 * s^N * Gamma^t1 * c2^(-e) = v    mod N^2
+        [&] {
+            if (pail_pub.g() == N + 1) {
+                // Gamma^t1 = (1 + N)^t1 = 1 + t1 * N    mod N^2
+                left_num[2] = ( BN::MultiPowM({c1, s_, c2}, {s1_, N, e.Neg()}, NSqr) * (N * t1_ + 1) ) % NSqr;
+            } else {
+                left_num[2] = BN::MultiPowM({c1, s_, pail_pub.g(), c2}, {s1_, N, t1_, e.Neg()}, NSqr);
+            }
+        },
+    });
+
+    if(left_num[2] != v_ % NSqr) return false;
+    if(batch) {
+        batch->Add(s1_, s2_, {z_}, {e.Neg()}, z_prime_);
+        batch->Add(t1_, t2_, {t_}, {e.Neg()}, w_);
+    } else {
+        if(left_num[0] != z_prime_ % N_tilde) return false;
+        if(left_num[1] != w_ % N_tilde) return false;
+    }
 
     return true;
 }
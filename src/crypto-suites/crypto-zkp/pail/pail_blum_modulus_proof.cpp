@@ -4,6 +4,7 @@
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_blum_modulus_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 #define PRIME_UTIL 6370
 
@@ -168,6 +169,7 @@ bool PailBlumModulusProof::GetQuarticSqrt(const safeheron::bignum::BN &N, const
 }
 
 bool PailBlumModulusProof::Prove(const safeheron::bignum::BN &N, const safeheron::bignum::BN &p, const safeheron::bignum::BN &q) {
+    SAFEHERON_TRACE_SCOPE("PailBlumModulusProof::Prove");
     if(N != p * q) return false;
 
     w_ = RandomBNLt(N);
@@ -198,6 +200,7 @@ bool PailBlumModulusProof::Prove(const safeheron::bignum::BN &N, const safeheron
 }
 
 bool PailBlumModulusProof::Verify(const BN &N) const {
+    SAFEHERON_TRACE_SCOPE("PailBlumModulusProof::Verify");
     if( (x_arr_.size() < ITERATIONS_BlumInt_Proof) || (a_arr_.size() < ITERATIONS_BlumInt_Proof)  || (b_arr_.size() < ITERATIONS_BlumInt_Proof)  || (z_arr_.size() < ITERATIONS_PailN_Proof) ) return false;
 
     if(N <= 1 || N.BitLength() < 2046) return false;
@@ -1,13 +1,16 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_dec_modulo_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
+using safeheron::zkp::RingPedersenBatch;
+using safeheron::pail::PailPrivKey;
 using safeheron::curve::CurvePoint;
 using safeheron::hash::CSafeHash512;
 using google::protobuf::util::Status;
@@ -23,6 +26,17 @@ namespace zkp {
 namespace pail {
 
 void PailDecModuloProof::Prove(const PailDecModuloSetUp &setup, const PailDecModuloStatement &statement, const PailDecModuloWitness &witness){
+    ProveInternal(setup, statement, witness, nullptr);
+}
+
+void PailDecModuloProof::Prove(const PailDecModuloSetUp &setup, const PailDecModuloStatement &statement, const PailDecModuloWitness &witness,
+                               const PailPrivKey &pail_priv){
+    ProveInternal(setup, statement, witness, (pail_priv.n() == statement.N0_) ? &pail_priv : nullptr);
+}
+
+void PailDecModuloProof::ProveInternal(const PailDecModuloSetUp &setup, const PailDecModuloStatement &statement, const PailDecModuloWitness &witness,
+                                       const PailPrivKey *pail_priv){
+    SAFEHERON_TRACE_SCOPE("PailDecModuloProof::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -57,40 +71,29 @@ void PailDecModuloProof::Prove(const PailDecModuloSetUp &setup, const PailDecMod
     // T = s^alpha * t^v mod N_tilde
     T_ = ( s.PowM(alpha, N_tilde) * t.PowM(v, N_tilde) ) % N_tilde;
     // A = (1 + N0)^alpha * r^N0 mod N0^2
-    A_ = ( (N0 * alpha + 1) * r.PowM(N0, N0Sqr) ) % N0Sqr;
+    BN r_N0 = pail_priv ? pail_priv->PowMModNSqr(r, N0) : r.PowM(N0, N0Sqr);
+    A_ = ( (N0 * alpha + 1) * r_N0 ) % N0Sqr;
     // gamma = alpha  mod q
     gamma_ = alpha % q;
 
     // H( Salt || N_tilde || s || t || N0 || q || C || x || S || T || A || gamma_)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    x.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    gamma_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(q);
+    transcript.Append(C);
+    transcript.Append(x);
+    transcript.Append(S_);
+    transcript.Append(T_);
+    transcript.Append(A_);
+    transcript.Append(gamma_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -100,10 +103,37 @@ void PailDecModuloProof::Prove(const PailDecModuloSetUp &setup, const PailDecMod
     // z2 = v + e * mu
     z2_ = v + e * mu;
     // w = r * rho^e  mod N0
-    w_ = ( r * rho.PowM(e, N0Sqr) ) % N0;
+    // rho^e mod N0^2 mod N0 = rho^e mod N0
+    BN rho_e = pail_priv ? pail_priv->PowMModN(rho, e) : rho.PowM(e, N0Sqr);
+    w_ = ( r * rho_e ) % N0;
 }
 
 bool PailDecModuloProof::Verify(const PailDecModuloSetUp &setup, const PailDecModuloStatement &statement) const {
+    return VerifyInternal(setup, statement, nullptr);
+}
+
+bool PailDecModuloProof::BatchVerify(const PailDecModuloSetUp &setup, const std::vector<PailDecModuloStatement> &statements,
+                                     const std::vector<PailDecModuloProof> &proofs, std::vector<bool> &results,
+                                     safeheron::concurrency::Executor *executor) {
+    SAFEHERON_TRACE_SCOPE("PailDecModuloProof::BatchVerify");
+    if(statements.size() != proofs.size()) {
+        results.assign(proofs.size(), false);
+        return false;
+    }
+    return safeheron::zkp::BatchVerifyRingPedersen(setup.N_tilde_, setup.s_, setup.t_, proofs.size(),
+                                                   [&](size_t i, RingPedersenBatch *batch) {
+                                                       return proofs[i].VerifyInternal(setup, statements[i], batch);
+                                                   }, results, executor);
+}
+
+bool PailDecModuloProof::BatchVerify(const PailDecModuloSetUp &setup, const std::vector<PailDecModuloStatement> &statements,
+                                     const std::vector<PailDecModuloProof> &proofs, safeheron::concurrency::Executor *executor) {
+    std::vector<bool> results;
+    return BatchVerify(setup, statements, proofs, results, executor);
+}
+
+bool PailDecModuloProof::VerifyInternal(const PailDecModuloSetUp &setup, const PailDecModuloStatement &statement, RingPedersenBatch *batch) const {
+    SAFEHERON_TRACE_SCOPE("PailDecModuloProof::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -121,37 +151,28 @@ bool PailDecModuloProof::Verify(const PailDecModuloSetUp &setup, const PailDecMo
     if(T_ % N_tilde == 0) return false;
     if(A_.Gcd(N0) != BN::ONE) return false;
     if(w_.Gcd(N0) != BN::ONE) return false;
+    // C and S are raised to -e below.
+    if(C.Gcd(N0) != BN::ONE) return false;
+    if(S_.Gcd(N_tilde) != BN::ONE) return false;
 
     // H( Salt || N_tilde || s || t || N0 || q || C || x || S || T || A || gamma_)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    x.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    gamma_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(q);
+    transcript.Append(C);
+    transcript.Append(x);
+    transcript.Append(S_);
+    transcript.Append(T_);
+    transcript.Append(A_);
+    transcript.Append(gamma_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -160,9 +181,9 @@ bool PailDecModuloProof::Verify(const PailDecModuloSetUp &setup, const PailDecMo
     BN left_num;
     BN right_num;
 
-    // (1 + N0)^z1 * w^N0 = A * C^e mod N0^2
-    left_num = ( (N0 * z1_ + 1) * w_.PowM(N0, N0Sqr) ) % N0Sqr;
-    right_num = ( C.PowM(e, N0Sqr) * A_ ) % N0Sqr;
+    // (1 + N0)^z1 * w^N0 * C^(-e) = A mod N0^2
+    left_num = ( (N0 * z1_ + 1) * BN::MultiPowM({w_, C}, {N0, e.Neg()}, N0Sqr) ) % N0Sqr;
+    right_num = A_ % N0Sqr;
     ok = left_num == right_num;
     if(!ok) return false;
 
@@ -172,9 +193,13 @@ bool PailDecModuloProof::Verify(const PailDecModuloSetUp &setup, const PailDecMo
     ok = left_num == right_num;
     if(!ok) return false;
 
-    // s^z1 * t^z2 = T * S^e    mod N_tilde
-    left_num = ( s.PowM(z1_, N_tilde) * t.PowM(z2_, N_tilde) ) % N_tilde;
-    right_num = ( T_ *  S_.PowM(e, N_tilde) ) % N_tilde;
+    // s^z1 * t^z2 * S^(-e) = T    mod N_tilde
+    if(batch) {
+        batch->Add(z1_, z2_, {S_}, {e.Neg()}, T_);
+        return true;
+    }
+    left_num = BN::MultiPowM({s, t, S_}, {z1_, z2_, e.Neg()}, N_tilde);
+    right_num = T_ % N_tilde;
     ok = left_num == right_num;
     if(!ok) return false;
 
@@ -1,11 +1,12 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/common.h"
 #include "crypto-suites/crypto-zkp/pail/pail_enc_elgamal_com_range_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -25,6 +26,7 @@ namespace zkp {
 namespace pail {
 
 void PailEncElGamalComRangeProof::Prove(const PailEncElGamalComRangeSetUp &setup, const PailEncElGamalComRangeStatement &statement, const PailEncElGamalComRangeWitness &witness){
+    SAFEHERON_TRACE_SCOPE("PailEncElGamalComRangeProof::Prove");
     const safeheron::curve::Curve *curv = safeheron::curve::GetCurveParam(statement.X_.GetCurveType());
     ASSERT_THROW(curv);
 
@@ -74,46 +76,31 @@ void PailEncElGamalComRangeProof::Prove(const PailEncElGamalComRangeSetUp &setup
     T_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
 
     // H( Salt || N_tilde || s || t || N0 || C || A || B || X || q || l || varepsilon || S || T || D || Y || Z)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(C);
+    transcript.Append(A);
+    transcript.Append(B);
+    transcript.Append(X);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Z_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(T_);
+    transcript.Append(D_);
+    transcript.Append(Y_);
+    transcript.Append(Z_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -125,6 +112,7 @@ void PailEncElGamalComRangeProof::Prove(const PailEncElGamalComRangeSetUp &setup
 }
 
 bool PailEncElGamalComRangeProof::Verify(const PailEncElGamalComRangeSetUp &setup, const PailEncElGamalComRangeStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("PailEncElGamalComRangeProof::Verify");
     const safeheron::curve::Curve *curv = safeheron::curve::GetCurveParam(statement.X_.GetCurveType());
     if(!curv) return false;
 
@@ -151,6 +139,9 @@ bool PailEncElGamalComRangeProof::Verify(const PailEncElGamalComRangeSetUp &setu
     if(D_.Gcd(N0) != BN::ONE) return false;
     if(T_ % N_tilde == 0) return false;
     if(z2_.Gcd(N0) != BN::ONE) return false;
+    // C and S are raised to -e below.
+    if(C.Gcd(N0) != BN::ONE) return false;
+    if(S_.Gcd(N_tilde) != BN::ONE) return false;
 
     // 2^(l + varepsilon)
     const BN limit_alpha = BN::ONE << (l + varepsilon);
@@ -158,46 +149,31 @@ bool PailEncElGamalComRangeProof::Verify(const PailEncElGamalComRangeSetUp &setu
     if(z1_ > limit_alpha || z1_ < BN::ZERO - limit_alpha) return false;
 
     // H( Salt || N_tilde || s || t || N0 || C || A || B || X || q || l || varepsilon || S || T || D || Y || Z)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(C);
+    transcript.Append(A);
+    transcript.Append(B);
+    transcript.Append(X);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    T_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Z_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(T_);
+    transcript.Append(D_);
+    transcript.Append(Y_);
+    transcript.Append(Z_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -208,9 +184,9 @@ bool PailEncElGamalComRangeProof::Verify(const PailEncElGamalComRangeSetUp &setu
     BN left_num;
     BN right_num;
 
-    // (1 + N0)^z1 * z2^N0 = D * C^e  mod N0Sqr
-    left_num = ( ( N0 * z1_ + 1 ) * z2_.PowM(N0, N0Sqr) ) % N0Sqr;
-    right_num = ( D_ * C.PowM(e, N0Sqr) ) % N0Sqr;
+    // (1 + N0)^z1 * z2^N0 * C^(-e) = D  mod N0Sqr
+    left_num = ( ( N0 * z1_ + 1 ) * BN::MultiPowM({z2_, C}, {N0, e.Neg()}, N0Sqr) ) % N0Sqr;
+    right_num = D_ % N0Sqr;
     ok = left_num == right_num;
     if(!ok) return false;
 
@@ -226,9 +202,9 @@ bool PailEncElGamalComRangeProof::Verify(const PailEncElGamalComRangeSetUp &setu
     ok = left_point == right_point;
     if(!ok) return false;
 
-    // s^z1 * t^z3 = T * S^e  mod N_tilde
-    left_num = ( s.PowM(z1_, N_tilde) * t.PowM(z3_, N_tilde) ) % N_tilde;
-    right_num = ( T_ * S_.PowM(e, N_tilde) ) % N_tilde;
+    // s^z1 * t^z3 * S^(-e) = T  mod N_tilde
+    left_num = BN::MultiPowM({s, t, S_}, {z1_, z3_, e.Neg()}, N_tilde);
+    right_num = T_ % N_tilde;
     ok = left_num == right_num;
     if(!ok) return false;
 
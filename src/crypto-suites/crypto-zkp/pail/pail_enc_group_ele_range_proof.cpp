@@ -1,15 +1,18 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/common.h"
 #include "crypto-suites/crypto-zkp/pail/pail_enc_group_ele_range_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
+using safeheron::zkp::RingPedersenBatch;
 using safeheron::curve::CurvePoint;
+using safeheron::concurrency::ParallelInvoke;
 using safeheron::hash::CSafeHash512;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -23,7 +26,8 @@ namespace safeheron{
 namespace zkp {
 namespace pail {
 
-void PailEncGroupEleRangeProof::Prove(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement, const PailEncGroupEleRangeWitness &witness){
+void PailEncGroupEleRangeProof::Prove(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement, const PailEncGroupEleRangeWitness &witness, safeheron::concurrency::Executor *executor){
+    SAFEHERON_TRACE_SCOPE("PailEncGroupEleRangeProof::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -53,53 +57,51 @@ void PailEncGroupEleRangeProof::Prove(const PailEncGroupEleRangeSetUp &setup, co
     BN r = RandomBNLtCoPrime(N0);
     BN gamma = RandomNegBNInSymInterval(limit_gamma);
 
-    // S = s^x * t^mu mod N_tilde
-    S_ = ( s.PowM(x, N_tilde) * t.PowM(mu, N_tilde) ) % N_tilde;
-    // A = (1 + N0)^alpha * r^N0  mod N0Sqr
-    //   = (1 + N0 * alpha) * r^N0 mod N0Sqr
-    A_ = ( (N0 * alpha + 1) * r.PowM(N0, N0Sqr) ) % N0Sqr;
-    // Y = g^alpha
-    Y_ = g * alpha;
-    // D = s^alpha * t^gamma mod N_tilde
-    D_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
+    // The commitments are independent of each other.
+    ParallelInvoke(executor, {
+        [&] {
+            // S = s^x * t^mu mod N_tilde
+            S_ = ( s.PowM(x, N_tilde) * t.PowM(mu, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // A = (1 + N0)^alpha * r^N0  mod N0Sqr
+            //   = (1 + N0 * alpha) * r^N0 mod N0Sqr
+            A_ = ( (N0 * alpha + 1) * r.PowM(N0, N0Sqr) ) % N0Sqr;
+        },
+        [&] {
+            // Y = g^alpha
+            Y_ = g * alpha;
+        },
+        [&] {
+            // D = s^alpha * t^gamma mod N_tilde
+            D_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
+        },
+    });
 
     // H( Salt || N_tilde || s || t || N0 || C || q || g || X ||  l || varepsilon || S || A || Y || D)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    g.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(C);
+    transcript.Append(q);
+    transcript.Append(g);
+    transcript.Append(X);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(A_);
+    transcript.Append(Y_);
+    transcript.Append(D_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -109,7 +111,33 @@ void PailEncGroupEleRangeProof::Prove(const PailEncGroupEleRangeSetUp &setup, co
     z3_ = e * mu + gamma;
 }
 
-bool PailEncGroupEleRangeProof::Verify(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement) const {
+bool PailEncGroupEleRangeProof::Verify(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement, safeheron::concurrency::Executor *executor) const {
+    return VerifyInternal(setup, statement, executor, nullptr);
+}
+
+bool PailEncGroupEleRangeProof::BatchVerify(const PailEncGroupEleRangeSetUp &setup, const std::vector<PailEncGroupEleRangeStatement> &statements,
+                                            const std::vector<PailEncGroupEleRangeProof> &proofs, std::vector<bool> &results,
+                                            safeheron::concurrency::Executor *executor) {
+    SAFEHERON_TRACE_SCOPE("PailEncGroupEleRangeProof::BatchVerify");
+    if(statements.size() != proofs.size()) {
+        results.assign(proofs.size(), false);
+        return false;
+    }
+    return safeheron::zkp::BatchVerifyRingPedersen(setup.N_tilde_, setup.s_, setup.t_, proofs.size(),
+                                                   [&](size_t i, RingPedersenBatch *batch) {
+                                                       return proofs[i].VerifyInternal(setup, statements[i], nullptr, batch);
+                                                   }, results, executor);
+}
+
+bool PailEncGroupEleRangeProof::BatchVerify(const PailEncGroupEleRangeSetUp &setup, const std::vector<PailEncGroupEleRangeStatement> &statements,
+                                            const std::vector<PailEncGroupEleRangeProof> &proofs, safeheron::concurrency::Executor *executor) {
+    std::vector<bool> results;
+    return BatchVerify(setup, statements, proofs, results, executor);
+}
+
+bool PailEncGroupEleRangeProof::VerifyInternal(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement,
+                                               safeheron::concurrency::Executor *executor, RingPedersenBatch *batch) const {
+    SAFEHERON_TRACE_SCOPE("PailEncGroupEleRangeProof::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -135,70 +163,60 @@ bool PailEncGroupEleRangeProof::Verify(const PailEncGroupEleRangeSetUp &setup, c
     if(A_.Gcd(N0) != BN::ONE) return false;
     if(D_ % N_tilde == BN::ZERO) return false;
     if(z2_.Gcd(N0) != BN::ONE) return false;
+    // C and S are raised to -e below.
+    if(C.Gcd(N0) != BN::ONE) return false;
+    if(S_.Gcd(N_tilde) != BN::ONE) return false;
 
     // H( Salt || N_tilde || s || t || N0 || C || q || g || X ||  l || varepsilon || S || A || Y || D)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    g.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(C);
+    transcript.Append(q);
+    transcript.Append(g);
+    transcript.Append(X);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(A_);
+    transcript.Append(Y_);
+    transcript.Append(D_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
 
-    bool ok = true;
     CurvePoint left_point;
     CurvePoint right_point;
-    BN left_num;
-    BN right_num;
-
-    // (1 + N0)^z1 * z2^N0 = A * C^e  mod N0Sqr
-    left_num = ( ( N0 * z1_ + 1 ) * z2_.PowM(N0, N0Sqr) ) % N0Sqr;
-    right_num = ( A_ * C.PowM(e, N0Sqr) ) % N0Sqr;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    left_point = g * z1_;
-    right_point = Y_ + X * e;
-    ok = left_point == right_point;
-    if(!ok) return false;
-
-    // s^z1 * t^z3 = D * S^e  mod N_tilde
-    left_num = ( s.PowM(z1_, N_tilde) * t.PowM(z3_, N_tilde) ) % N_tilde;
-    right_num = ( D_ * S_.PowM(e, N_tilde) ) % N_tilde;
-    ok = left_num == right_num;
-    if(!ok) return false;
+    BN left_num[2];
+
+    // Every equation is checked as one multi-exponentiation, the equations are independent of each other.
+    ParallelInvoke(executor, {
+        // (1 + N0)^z1 * z2^N0 * C^(-e) = A  mod N0Sqr
+        [&] { left_num[0] = ( BN::MultiPowM({z2_, C}, {N0, e.Neg()}, N0Sqr) * ( N0 * z1_ + 1 ) ) % N0Sqr; },
+        // g^z1 = Y * X^e
+        [&] { left_point = g * z1_; },
+        [&] { right_point = Y_ + X * e; },
+        // s^z1 * t^z3 * S^(-e) = D  mod N_tilde
+        [&] { if(!batch) left_num[1] = BN::MultiPowM({s, t, S_}, {z1_, z3_, e.Neg()}, N_tilde); },
+    });
+
+    if(left_num[0] != A_ % N0Sqr) return false;
+    if(left_point != right_point) return false;
+    if(batch) {
+        batch->Add(z1_, z3_, {S_}, {e.Neg()}, D_);
+    } else {
+        if(left_num[1] != D_ % N_tilde) return false;
+    }
 
     return true;
 }
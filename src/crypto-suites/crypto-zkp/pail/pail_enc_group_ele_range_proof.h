@@ -3,9 +3,12 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
+#include "crypto-suites/crypto-zkp/ring_pedersen_batch.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -83,8 +86,22 @@ public:
 
     void SetSalt(const std::string &salt) { salt_ = salt; }
 
-    void Prove(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement, const PailEncGroupEleRangeWitness &witness);
-    bool Verify(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement) const;
+    // "executor" (optional) runs the independent exponentiations in parallel, the transcript does not depend on it.
+    void Prove(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement, const PailEncGroupEleRangeWitness &witness,
+               safeheron::concurrency::Executor *executor = nullptr);
+    bool Verify(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement,
+                safeheron::concurrency::Executor *executor = nullptr) const;
+
+    // Verify the proofs of many statements against the same setup, such as those of all the other parties. The
+    // equations mod N_tilde of all the proofs are checked at once (see RingPedersenBatch), and each proof is verified
+    // on its own only if this check fails. results[i] is the result of proofs[i].
+    // Unlike Verify, which is exact, BatchVerify accepts the equations mod N_tilde up to a factor of order 2, such as
+    // a commitment sent as -S instead of S.
+    static bool BatchVerify(const PailEncGroupEleRangeSetUp &setup, const std::vector<PailEncGroupEleRangeStatement> &statements,
+                            const std::vector<PailEncGroupEleRangeProof> &proofs, std::vector<bool> &results,
+                            safeheron::concurrency::Executor *executor = nullptr);
+    static bool BatchVerify(const PailEncGroupEleRangeSetUp &setup, const std::vector<PailEncGroupEleRangeStatement> &statements,
+                            const std::vector<PailEncGroupEleRangeProof> &proofs, safeheron::concurrency::Executor *executor = nullptr);
 
     bool ToProtoObject(safeheron::proto::PailEncGroupEleRangeProof &proof) const;
     bool FromProtoObject(const safeheron::proto::PailEncGroupEleRangeProof &proof);
@@ -94,6 +111,10 @@ public:
 
     bool ToJsonString(std::string &json_str) const;
     bool FromJsonString(const std::string &json_str);
+
+private:
+    bool VerifyInternal(const PailEncGroupEleRangeSetUp &setup, const PailEncGroupEleRangeStatement &statement,
+                        safeheron::concurrency::Executor *executor, RingPedersenBatch *batch) const;
 };
 
 }
@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_enc_mul_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -23,6 +24,7 @@ namespace zkp {
 namespace pail {
 
 void PailEncMulProof::Prove(const PailEncMulStatement &statement, const PailEncMulWitness &witness){
+    SAFEHERON_TRACE_SCOPE("PailEncMulProof::Prove");
     const BN &N = statement.N_;
     const BN &NSqr = statement.NSqr_;
     const BN &X = statement.X_;
@@ -46,27 +48,19 @@ void PailEncMulProof::Prove(const PailEncMulStatement &statement, const PailEncM
     B_ = ( ( N * alpha + 1 ) * s.PowM(N, NSqr) ) % NSqr;
 
     // H( Salt ||  N || X || Y || C || q || A || B)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Append(N);
+    transcript.Append(X);
+    transcript.Append(Y);
+    transcript.Append(C);
+    transcript.Append(q);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -80,6 +74,7 @@ void PailEncMulProof::Prove(const PailEncMulStatement &statement, const PailEncM
 }
 
 bool PailEncMulProof::Verify(const PailEncMulStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("PailEncMulProof::Verify");
     const BN &N = statement.N_;
     const BN &NSqr = statement.NSqr_;
     const BN &X = statement.X_;
@@ -91,29 +86,24 @@ bool PailEncMulProof::Verify(const PailEncMulStatement &statement) const {
 
     if(A_.Gcd(N) != BN::ONE) return false;
     if(B_.Gcd(N) != BN::ONE) return false;
+    // C and X are raised to -e below.
+    if(C.Gcd(N) != BN::ONE) return false;
+    if(X.Gcd(N) != BN::ONE) return false;
 
     // H( Salt ||  N || X || Y || C || q || A || B)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    Y.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Append(N);
+    transcript.Append(X);
+    transcript.Append(Y);
+    transcript.Append(C);
+    transcript.Append(q);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -122,15 +112,15 @@ bool PailEncMulProof::Verify(const PailEncMulStatement &statement) const {
     BN left_num;
     BN right_num;
 
-    // Y^z * u^N = A * C^e     mod NSqr
-    left_num = ( Y.PowM(z_, NSqr) * u_.PowM(N, NSqr) ) % NSqr;
-    right_num = ( A_ * C.PowM(e, NSqr) ) % NSqr;
+    // Y^z * u^N * C^(-e) = A     mod NSqr
+    left_num = BN::MultiPowM({Y, u_, C}, {z_, N, e.Neg()}, NSqr);
+    right_num = A_ % NSqr;
     ok = left_num == right_num;
     if(!ok) return false;
 
-    // (1 + N)^z * c^N = B * X^e     mod NSqr
-    left_num =( ( N * z_ + 1 ) * v_.PowM(N, NSqr) ) % NSqr;
-    right_num = ( B_ * X.PowM(e, NSqr) ) % NSqr;
+    // (1 + N)^z * c^N * X^(-e) = B     mod NSqr
+    left_num =( ( N * z_ + 1 ) * BN::MultiPowM({v_, X}, {N, e.Neg()}, NSqr) ) % NSqr;
+    right_num = B_ % NSqr;
     ok = left_num == right_num;
     if(!ok) return false;
 
@@ -1,15 +1,17 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_enc_range_proof_v1.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
 using safeheron::hash::CSafeHash256;
+using safeheron::pail::PailPrivKey;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
 using google::protobuf::util::JsonStringToMessage;
@@ -23,6 +25,17 @@ namespace zkp {
 namespace pail {
 
 void PailEncRangeProof_V1::Prove(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement, const PailEncRangeWitness_V1 &witness){
+    ProveInternal(setup, statement, witness, nullptr);
+}
+
+void PailEncRangeProof_V1::Prove(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement, const PailEncRangeWitness_V1 &witness,
+                                 const PailPrivKey &pail_priv){
+    ProveInternal(setup, statement, witness, (pail_priv.n() == statement.N_) ? &pail_priv : nullptr);
+}
+
+void PailEncRangeProof_V1::ProveInternal(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement, const PailEncRangeWitness_V1 &witness,
+                                         const PailPrivKey *pail_priv){
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V1::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &h1 = setup.h1_;
     const BN &h2 = setup.h2_;
@@ -51,45 +64,38 @@ void PailEncRangeProof_V1::Prove(const PailEncRangeSetUp_V1 &setup, const PailEn
     // u = Gamma^alpha * beta^N mod N^2
     //   = ( (1+N).PowM(alpha, N2) * beta.PowM(N, N2) ) % N2;
     //   = ( (1 + alpha * N) % N2 * beta.PowM(N, N2) ) % N2;
-    u_ = ( (N * alpha + 1) % N2 * beta.PowM(N, N2) ) % N2;
+    BN beta_N = pail_priv ? pail_priv->PowMModNSqr(beta, N) : beta.PowM(N, N2);
+    u_ = ( (N * alpha + 1) % N2 * beta_N ) % N2;
     // w = h1^alpha * h2^gamma mod N_tilde
     w_ = ( h1.PowM(alpha, N_tilde) * h2.PowM(gamma, N_tilde) ) % N_tilde;
 
     // H( Salt || N_tilde || h1 || h2 || N || c || q || z || u || w )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    N.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    u_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(N);
+    transcript.Append(c);
+    transcript.Append(q);
+    transcript.Append(z_);
+    transcript.Append(u_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
-    s_ = ( r.PowM(e, N) * beta ) % N;
+    BN r_e = pail_priv ? pail_priv->PowMModN(r, e) : r.PowM(e, N);
+    s_ = ( r_e * beta ) % N;
     s1_ = e * x + alpha;
     s2_ = e * rho + gamma;
 }
 
 bool PailEncRangeProof_V1::Verify(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement) const {
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V1::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &h1 = setup.h1_;
     const BN &h2 = setup.h2_;
@@ -113,39 +119,29 @@ bool PailEncRangeProof_V1::Verify(const PailEncRangeSetUp_V1 &setup, const PailE
     if(s1_ < (BN::ZERO - q3) || s1_ > q3)return false;
 
     // H( Salt || N_tilde || h1 || h2 || N || c || q || z || u || w )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    N.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    u_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(N);
+    transcript.Append(c);
+    transcript.Append(q);
+    transcript.Append(z_);
+    transcript.Append(u_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
     // u = Gamma^s1 * s^N * c^(-e) mod N^2 = Enc(s1, s) (+) c (*) (-e)
     //   = (1 + N * s1) % N2 * s^N * c^(-e) mod N^2 = Enc(N, s1, s) (+) c (*) (-e)
-    BN u = ( (N * s1_ + 1) % N2 * s_.PowM(N, N2) * c.PowM(e, N2).InvM(N2) ) % N2;
+    BN u = ( (N * s1_ + 1) % N2 * BN::MultiPowM({s_, c}, {N, e.Neg()}, N2) ) % N2;
     // w = h1^s1 * h2^s2 * z^(-e) mod N_tilde
-    BN w = ( h1.PowM(s1_, N_tilde) * h2.PowM(s2_, N_tilde) * z_.PowM(e, N_tilde).InvM(N_tilde) ) % N_tilde;
+    BN w = BN::MultiPowM({h1, h2, z_}, {s1_, s2_, e.Neg()}, N_tilde);
     return (u == u_) && (w == w_);
 }
 
@@ -71,6 +71,9 @@ public:
     void SetSalt(const std::string &salt) { salt_ = salt; }
 
     void Prove(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement, const PailEncRangeWitness_V1 &witness);
+    // Same proof, the terms mod N and N^2 being computed with the CRT when "pail_priv" is the private key of N.
+    void Prove(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement, const PailEncRangeWitness_V1 &witness,
+               const safeheron::pail::PailPrivKey &pail_priv);
     bool Verify(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement) const;
 
     bool ToProtoObject(safeheron::proto::PailEncRangeProof_V1 &proof) const;
@@ -81,6 +84,10 @@ public:
 
     bool ToJsonString(std::string &json_str) const;
     bool FromJsonString(const std::string &json_str);
+
+private:
+    void ProveInternal(const PailEncRangeSetUp_V1 &setup, const PailEncRangeStatement_V1 &statement, const PailEncRangeWitness_V1 &witness,
+                       const safeheron::pail::PailPrivKey *pail_priv);
 };
 
 }
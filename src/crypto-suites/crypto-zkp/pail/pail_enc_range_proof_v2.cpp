@@ -1,14 +1,17 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/common.h"
 #include "crypto-suites/crypto-zkp/pail/pail_enc_range_proof_v2.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
+using safeheron::zkp::RingPedersenBatch;
+using safeheron::pail::PailPrivKey;
 using safeheron::curve::CurvePoint;
 using safeheron::hash::CSafeHash512;
 using google::protobuf::util::Status;
@@ -24,6 +27,17 @@ namespace zkp {
 namespace pail {
 
 void PailEncRangeProof_V2::Prove(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, const PailEncRangeWitness_V2 &witness){
+    ProveInternal(setup, statement, witness, nullptr);
+}
+
+void PailEncRangeProof_V2::Prove(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, const PailEncRangeWitness_V2 &witness,
+                                 const PailPrivKey &pail_priv){
+    ProveInternal(setup, statement, witness, (pail_priv.n() == statement.N0_) ? &pail_priv : nullptr);
+}
+
+void PailEncRangeProof_V2::ProveInternal(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, const PailEncRangeWitness_V2 &witness,
+                                         const PailPrivKey *pail_priv){
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V2::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -55,51 +69,68 @@ void PailEncRangeProof_V2::Prove(const PailEncRangeSetUp_V2 &setup, const PailEn
     S_ = ( s.PowM(k, N_tilde) * t.PowM(mu, N_tilde) ) % N_tilde;
     // A = (1 + N0)^alpha * r^N0  mod N0Sqr
     //   = (1 + N0 * alpha) * r^N0 mod N0Sqr
-    A_ = ( (N0 * alpha + 1) * r.PowM(N0, N0Sqr) ) % N0Sqr;
+    BN r_N0 = pail_priv ? pail_priv->PowMModNSqr(r, N0) : r.PowM(N0, N0Sqr);
+    A_ = ( (N0 * alpha + 1) * r_N0 ) % N0Sqr;
     // C = s^alpha * t^gamma mod N_tilde
     C_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
 
     // H( Salt || N_tilde || s || t || N0 || K || q || l || varepsilon || S || A || C)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    K.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(K);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(A_);
+    transcript.Append(C_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
 
     z1_ = e * k + alpha;
-    z2_ = ( r * rho.PowM(e, N0) ) % N0;
+    BN rho_e = pail_priv ? pail_priv->PowMModN(rho, e) : rho.PowM(e, N0);
+    z2_ = ( r * rho_e ) % N0;
     z3_ = e * mu + gamma;
 }
 
 bool PailEncRangeProof_V2::Verify(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement) const {
+    return VerifyInternal(setup, statement, nullptr);
+}
+
+bool PailEncRangeProof_V2::BatchVerify(const PailEncRangeSetUp_V2 &setup, const std::vector<PailEncRangeStatement_V2> &statements,
+                                       const std::vector<PailEncRangeProof_V2> &proofs, std::vector<bool> &results,
+                                       safeheron::concurrency::Executor *executor) {
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V2::BatchVerify");
+    if(statements.size() != proofs.size()) {
+        results.assign(proofs.size(), false);
+        return false;
+    }
+    return safeheron::zkp::BatchVerifyRingPedersen(setup.N_tilde_, setup.s_, setup.t_, proofs.size(),
+                                                   [&](size_t i, RingPedersenBatch *batch) {
+                                                       return proofs[i].VerifyInternal(setup, statements[i], batch);
+                                                   }, results, executor);
+}
+
+bool PailEncRangeProof_V2::BatchVerify(const PailEncRangeSetUp_V2 &setup, const std::vector<PailEncRangeStatement_V2> &statements,
+                                       const std::vector<PailEncRangeProof_V2> &proofs, safeheron::concurrency::Executor *executor) {
+    std::vector<bool> results;
+    return BatchVerify(setup, statements, proofs, results, executor);
+}
+
+bool PailEncRangeProof_V2::VerifyInternal(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, RingPedersenBatch *batch) const {
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V2::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -121,40 +152,33 @@ bool PailEncRangeProof_V2::Verify(const PailEncRangeSetUp_V2 &setup, const PailE
     if( A_.Gcd(N0) != BN::ONE ) return false;
     if( C_ % N_tilde == 0 ) return false;
     if( z2_.Gcd(N0) != BN::ONE ) return false;
+    // K and S are raised to -e below.
+    if( K.Gcd(N0) != BN::ONE ) return false;
+    if( S_.Gcd(N_tilde) != BN::ONE ) return false;
 
     if(z1_ > limit_alpha || z1_ < BN::ZERO - limit_alpha) return false;
 
     // H( Salt || N_tilde || s || t || N0 || K || q || l || varepsilon || S || A || C)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    K.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(K);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(S_);
+    transcript.Append(A_);
+    transcript.Append(C_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -164,15 +188,19 @@ bool PailEncRangeProof_V2::Verify(const PailEncRangeSetUp_V2 &setup, const PailE
     BN left_num;
     BN right_num;
 
-    // (1 + N0)^z1 * z2^N0 = A * K^e  mod N0Sqr
-    left_num = ( ( N0 * z1_ + 1 ) * z2_.PowM(N0, N0Sqr) ) % N0Sqr;
-    right_num = ( A_ * K.PowM(e, N0Sqr) ) % N0Sqr;
+    // (1 + N0)^z1 * z2^N0 * K^(-e) = A  mod N0Sqr
+    left_num = ( ( N0 * z1_ + 1 ) * BN::MultiPowM({z2_, K}, {N0, e.Neg()}, N0Sqr) ) % N0Sqr;
+    right_num = A_ % N0Sqr;
     ok = left_num == right_num;
     if(!ok) return false;
 
-    // s^z1 * t^z3 = C * S^e  mod N_tilde
-    left_num = ( s.PowM(z1_, N_tilde) * t.PowM(z3_, N_tilde) ) % N_tilde;
-    right_num = ( C_ * S_.PowM(e, N_tilde) ) % N_tilde;
+    // s^z1 * t^z3 * S^(-e) = C  mod N_tilde
+    if(batch) {
+        batch->Add(z1_, z3_, {S_}, {e.Neg()}, C_);
+        return true;
+    }
+    left_num = BN::MultiPowM({s, t, S_}, {z1_, z3_, e.Neg()}, N_tilde);
+    right_num = C_ % N_tilde;
     ok = left_num == right_num;
     if(!ok) return false;
 
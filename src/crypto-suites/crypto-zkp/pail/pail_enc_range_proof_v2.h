@@ -3,9 +3,12 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
+#include "crypto-suites/crypto-zkp/ring_pedersen_batch.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -77,8 +80,22 @@ public:
     void SetSalt(const std::string &salt) { salt_ = salt; }
 
     void Prove(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, const PailEncRangeWitness_V2 &witness);
+    // Same proof, the terms mod N0 and N0^2 being computed with the CRT when "pail_priv" is the private key of N0.
+    void Prove(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, const PailEncRangeWitness_V2 &witness,
+               const safeheron::pail::PailPrivKey &pail_priv);
     bool Verify(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement) const;
 
+    // Verify the proofs of many statements against the same setup, such as those of all the other parties. The
+    // equations mod N_tilde of all the proofs are checked at once (see RingPedersenBatch), and each proof is verified
+    // on its own only if this check fails. results[i] is the result of proofs[i].
+    // Unlike Verify, which is exact, BatchVerify accepts the equations mod N_tilde up to a factor of order 2, such as
+    // a commitment sent as -S instead of S.
+    static bool BatchVerify(const PailEncRangeSetUp_V2 &setup, const std::vector<PailEncRangeStatement_V2> &statements,
+                            const std::vector<PailEncRangeProof_V2> &proofs, std::vector<bool> &results,
+                            safeheron::concurrency::Executor *executor = nullptr);
+    static bool BatchVerify(const PailEncRangeSetUp_V2 &setup, const std::vector<PailEncRangeStatement_V2> &statements,
+                            const std::vector<PailEncRangeProof_V2> &proofs, safeheron::concurrency::Executor *executor = nullptr);
+
     bool ToProtoObject(safeheron::proto::PailEncRangeProof_V2 &proof) const;
     bool FromProtoObject(const safeheron::proto::PailEncRangeProof_V2 &proof);
 
@@ -87,6 +104,11 @@ public:
 
     bool ToJsonString(std::string &json_str) const;
     bool FromJsonString(const std::string &json_str);
+
+private:
+    void ProveInternal(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, const PailEncRangeWitness_V2 &witness,
+                       const safeheron::pail::PailPrivKey *pail_priv);
+    bool VerifyInternal(const PailEncRangeSetUp_V2 &setup, const PailEncRangeStatement_V2 &statement, RingPedersenBatch *batch) const;
 };
 
 }
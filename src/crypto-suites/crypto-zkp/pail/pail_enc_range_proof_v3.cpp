@@ -1,11 +1,12 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-paillier/pail.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_enc_range_proof_v3.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -34,6 +35,17 @@ static BN SampleRange(const BN &min, const BN &max){
 }
 
 void PailEncRangeProof_V3::Prove(const PailEncRangeStatement_V3 &statement, const PailEncRangeWitness_V3 &witness) {
+    ProveInternal(statement, witness, nullptr);
+}
+
+void PailEncRangeProof_V3::Prove(const PailEncRangeStatement_V3 &statement, const PailEncRangeWitness_V3 &witness,
+                                 const PailPrivKey &pail_priv) {
+    ProveInternal(statement, witness, (pail_priv.n() == statement.pail_pub_.n()) ? &pail_priv : nullptr);
+}
+
+void PailEncRangeProof_V3::ProveInternal(const PailEncRangeStatement_V3 &statement, const PailEncRangeWitness_V3 &witness,
+                                         const PailPrivKey *pail_priv) {
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V3::Prove");
     ASSERT_THROW(CSafeHash256::OUTPUT_SIZE * 8 >= SECURITY_PARAMETER);
     ASSERT_THROW(statement.pail_pub_.n().BitLength() >= 2046);
     const BN l = statement.l_;
@@ -50,28 +62,25 @@ void PailEncRangeProof_V3::Prove(const PailEncRangeStatement_V3 &statement, cons
 
         // c1 = Enc(pail_pub, w1, r1)
         c1_arr_.emplace_back(BN());
-        c1_arr_[i] = statement.pail_pub_.EncryptWithR(z_arr_[i].w1_, z_arr_[i].r1_);
+        c1_arr_[i] = pail_priv ? pail_priv->EncryptWithR(z_arr_[i].w1_, z_arr_[i].r1_)
+                               : statement.pail_pub_.EncryptWithR(z_arr_[i].w1_, z_arr_[i].r1_);
 
         // c2 = Enc(pail_pub, w2, r2)
         c2_arr_.emplace_back(BN());
-        c2_arr_[i] = statement.pail_pub_.EncryptWithR(z_arr_[i].w2_, z_arr_[i].r2_);
+        c2_arr_[i] = pail_priv ? pail_priv->EncryptWithR(z_arr_[i].w2_, z_arr_[i].r2_)
+                               : statement.pail_pub_.EncryptWithR(z_arr_[i].w2_, z_arr_[i].r2_);
     }
 
     // e = hash(c1_arr[1], c2_arr[1], c1_arr[2], c2_arr[2], ... , c1_arr[n], c2_arr[n] )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
-    statement.pail_pub_.n().ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    statement.c_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(statement.pail_pub_.n());
+    transcript.Append(statement.c_);
     for (uint32_t i = 0; i < SECURITY_PARAMETER; ++i) {
-        c1_arr_[i].ToBytesBE(str);
-        sha256.Write((const uint8_t *)(str.c_str()), str.length());
-        c2_arr_[i].ToBytesBE(str);
-        sha256.Write((const uint8_t *)(str.c_str()), str.length());
+        transcript.Append(c1_arr_[i]);
+        transcript.Append(c2_arr_[i]);
     }
-    sha256.Finalize(sha256_digest);
+    transcript.Finalize(sha256_digest);
 
     // for every bit in e
     for (uint32_t i = 0; i < SECURITY_PARAMETER; ++i) {
@@ -96,26 +105,22 @@ void PailEncRangeProof_V3::Prove(const PailEncRangeStatement_V3 &statement, cons
 }
 
 bool PailEncRangeProof_V3::Verify(const PailEncRangeStatement_V3 &statement) const {
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V3::Verify");
     if(statement.pail_pub_.n().BitLength() < 2046)return false;
 
     const BN l = statement.l_;
     const BN double_l = statement.l_ * 2;
 
     // e = hash(c1_arr[1], c2_arr[1], c1_arr[2], c2_arr[2], ... , c1_arr[n], c2_arr[n] )
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
-    statement.pail_pub_.n().ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    statement.c_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(statement.pail_pub_.n());
+    transcript.Append(statement.c_);
     for (uint32_t i = 0; i < SECURITY_PARAMETER; ++i) {
-        c1_arr_[i].ToBytesBE(str);
-        sha256.Write((const uint8_t *)(str.c_str()), str.length());
-        c2_arr_[i].ToBytesBE(str);
-        sha256.Write((const uint8_t *)(str.c_str()), str.length());
+        transcript.Append(c1_arr_[i]);
+        transcript.Append(c2_arr_[i]);
     }
-    sha256.Finalize(sha256_digest);
+    transcript.Finalize(sha256_digest);
 
     bool ok = true;
     for (uint32_t i = 0; i < SECURITY_PARAMETER; ++i) {
@@ -168,6 +173,25 @@ bool PailEncRangeProof_V3::Verify(const PailEncRangeStatement_V3 &statement) con
     return true;
 }
 
+bool PailEncRangeProof_V3::BatchVerify(const std::vector<PailEncRangeStatement_V3> &statements, const std::vector<PailEncRangeProof_V3> &proofs,
+                                       std::vector<bool> &results, safeheron::concurrency::Executor *executor) {
+    SAFEHERON_TRACE_SCOPE("PailEncRangeProof_V3::BatchVerify");
+    results.assign(proofs.size(), false);
+    if(statements.size() != proofs.size()) return false;
+
+    vector<char> ok(proofs.size(), 0);
+    safeheron::concurrency::ParallelFor(executor, proofs.size(), [&](size_t i) {
+        ok[i] = proofs[i].Verify(statements[i]) ? 1 : 0;
+    });
+
+    bool all_ok = true;
+    for(size_t i = 0; i < proofs.size(); ++i) {
+        results[i] = (ok[i] != 0);
+        all_ok = all_ok && results[i];
+    }
+    return all_ok;
+}
+
 bool PailEncRangeProof_V3::ToProtoObject(safeheron::proto::PailEncRangeProof_V3 &proof) const {
     if(c1_arr_.size() < SECURITY_PARAMETER) return false;
     if(c2_arr_.size() < SECURITY_PARAMETER) return false;
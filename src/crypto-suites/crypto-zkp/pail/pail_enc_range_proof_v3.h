@@ -2,10 +2,12 @@
 #define SAFEHERON_CRYPTO_ZKP_PAIL_ENCRYPTION_RANGE_1_PROOF_H
 
 #include <string>
+#include <vector>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 #include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
 
 namespace safeheron{
 namespace zkp {
@@ -60,8 +62,16 @@ public:
     PailEncRangeProof_V3(){};
 
     void Prove(const PailEncRangeStatement_V3 &statement, const PailEncRangeWitness_V3 &witness);
+    // Same proof, the commitments being encrypted with the CRT when "pail_priv" is the private key of the statement.
+    void Prove(const PailEncRangeStatement_V3 &statement, const PailEncRangeWitness_V3 &witness,
+               const safeheron::pail::PailPrivKey &pail_priv);
     bool Verify(const PailEncRangeStatement_V3 &statement) const;
 
+    // Verify the proofs of many statements, in parallel on "executor". Each statement is over the Paillier key of its
+    // prover, there is no common modulus whose equations could be combined. results[i] is the result of proofs[i].
+    static bool BatchVerify(const std::vector<PailEncRangeStatement_V3> &statements, const std::vector<PailEncRangeProof_V3> &proofs,
+                            std::vector<bool> &results, safeheron::concurrency::Executor *executor = nullptr);
+
     bool ToProtoObject(safeheron::proto::PailEncRangeProof_V3 &proof) const;
     bool FromProtoObject(const safeheron::proto::PailEncRangeProof_V3 &proof);
 
@@ -75,6 +85,9 @@ public:
     const static uint32_t SECURITY_PARAMETER = 128;
 
 private:
+    void ProveInternal(const PailEncRangeStatement_V3 &statement, const PailEncRangeWitness_V3 &witness,
+                       const safeheron::pail::PailPrivKey *pail_priv);
+
     std::vector<safeheron::bignum::BN> c1_arr_;
     std::vector<safeheron::bignum::BN> c2_arr_;
     std::vector<Z_Struct> z_arr_;
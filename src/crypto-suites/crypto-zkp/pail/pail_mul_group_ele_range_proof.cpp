@@ -1,15 +1,17 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash512.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/common.h"
 #include "crypto-suites/crypto-zkp/pail/pail_mul_group_ele_range_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
+using safeheron::concurrency::ParallelInvoke;
 using safeheron::hash::CSafeHash512;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -23,7 +25,8 @@ namespace safeheron{
 namespace zkp {
 namespace pail {
 
-void PailMulGroupEleRangeProof::Prove(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement, const PailMulGroupEleRangeWitness &witness){
+void PailMulGroupEleRangeProof::Prove(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement, const PailMulGroupEleRangeWitness &witness, safeheron::concurrency::Executor *executor){
+    SAFEHERON_TRACE_SCOPE("PailMulGroupEleRangeProof::Prove");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -55,54 +58,51 @@ void PailMulGroupEleRangeProof::Prove(const PailMulGroupEleRangeSetUp &setup, co
     BN m = RandomNegBNInSymInterval(limit_m);
 
     // 公式跟论文不一样
-    // A = C^alpha * r^N0  mod N0Sqr
-    A_ = ( C.PowM(alpha, N0Sqr) * r.PowM(N0, N0Sqr) ) % N0Sqr;
-    // B = g^alpha
-    B_ = g * alpha;
-    // E = s^alpha * t^gamma mod N_tilde
-    E_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
-    // S = s^x * t^m mod N_tilde
-    S_ = ( s.PowM(x, N_tilde) * t.PowM(m, N_tilde) ) % N_tilde;
+    // The commitments are independent of each other.
+    ParallelInvoke(executor, {
+        [&] {
+            // A = C^alpha * r^N0  mod N0Sqr
+            A_ = ( C.PowM(alpha, N0Sqr) * r.PowM(N0, N0Sqr) ) % N0Sqr;
+        },
+        [&] {
+            // B = g^alpha
+            B_ = g * alpha;
+        },
+        [&] {
+            // E = s^alpha * t^gamma mod N_tilde
+            E_ = ( s.PowM(alpha, N_tilde) * t.PowM(gamma, N_tilde) ) % N_tilde;
+        },
+        [&] {
+            // S = s^x * t^m mod N_tilde
+            S_ = ( s.PowM(x, N_tilde) * t.PowM(m, N_tilde) ) % N_tilde;
+        },
+    });
 
     // H( Salt || N_tilde || s || t || N0 || C || D || X || g || q || l || varepsilon || A || B || E || S)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    g.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(C);
+    transcript.Append(D);
+    transcript.Append(X);
+    transcript.Append(g);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    E_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Append(E_);
+    transcript.Append(S_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
@@ -112,7 +112,8 @@ void PailMulGroupEleRangeProof::Prove(const PailMulGroupEleRangeSetUp &setup, co
     w_ = ( r * rho.PowM(e, N0) ) % N0;
 }
 
-bool PailMulGroupEleRangeProof::Verify(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement) const {
+bool PailMulGroupEleRangeProof::Verify(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement, safeheron::concurrency::Executor *executor) const {
+    SAFEHERON_TRACE_SCOPE("PailMulGroupEleRangeProof::Verify");
     const BN &N_tilde = setup.N_tilde_;
     const BN &s = setup.s_;
     const BN &t = setup.t_;
@@ -134,77 +135,61 @@ bool PailMulGroupEleRangeProof::Verify(const PailMulGroupEleRangeSetUp &setup, c
     if(E_ % N_tilde == BN::ZERO) return false;
     if(S_ % N_tilde == BN::ZERO) return false;
     if(w_.Gcd(N0) != BN::ONE) return false;
+    // D and S are raised to -e below.
+    if(D.Gcd(N0) != BN::ONE) return false;
+    if(S_.Gcd(N_tilde) != BN::ONE) return false;
 
     const BN limit_alpha = BN::ONE << (l + varepsilon);
 
     if(z1_ > limit_alpha || z1_ < (BN::ZERO - limit_alpha) ) return false;
 
     // H( Salt || N_tilde || s || t || N0 || C || D || X || g || q || l || varepsilon || A || B || E || S)
-    CSafeHash512 sha512;
+    Transcript512 transcript;
     uint8_t sha512_digest[CSafeHash512::OUTPUT_SIZE];
-    string str;
     uint8_t byte4[4];
     if(salt_.length() > 0) {
-        sha512.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    s.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    t.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    N0.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    C.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    D.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    X.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    g.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    q.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(N_tilde);
+    transcript.Append(s);
+    transcript.Append(t);
+    transcript.Append(N0);
+    transcript.Append(C);
+    transcript.Append(D);
+    transcript.Append(X);
+    transcript.Append(g);
+    transcript.Append(q);
     uint_to_byte4(byte4, l);
-    sha512.Write(byte4, 4);
+    transcript.Write(byte4, 4);
     uint_to_byte4(byte4, varepsilon);
-    sha512.Write(byte4, 4);
-    A_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    B_.EncodeFull(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    E_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    S_.ToBytesBE(str);
-    sha512.Write((const uint8_t *)(str.c_str()), str.length());
-    sha512.Finalize(sha512_digest);
+    transcript.Write(byte4, 4);
+    transcript.Append(A_);
+    transcript.Append(B_);
+    transcript.Append(E_);
+    transcript.Append(S_);
+    transcript.Finalize(sha512_digest);
     BN e = BN::FromBytesBE(sha512_digest, sizeof(sha512_digest) - 1);
     e = e % q;
     if(sha512_digest[CSafeHash512::OUTPUT_SIZE - 1] & 0x01) e = e.Neg();
 
-    bool ok = true;
     CurvePoint left_point;
     CurvePoint right_point;
-    BN left_num;
-    BN right_num;
-
-    // C^z1 * w^N0 = A * D^e  mod N0Sqr
-    left_num = ( C.PowM(z1_, N0Sqr) * w_.PowM(N0, N0Sqr) ) % N0Sqr;
-    right_num = ( A_ * D.PowM(e, N0Sqr) ) % N0Sqr;
-    ok = left_num == right_num;
-    if(!ok) return false;
-
-    // g^z1 = Bx * X^e
-    left_point = g * z1_;
-    right_point = B_ + X * e;
-    ok = left_point == right_point;
-    if(!ok) return false;
-
-    // s^z1 * t^z2 = E * S^e  mod N_tilde
-    left_num = ( s.PowM(z1_, N_tilde) * t.PowM(z2_, N_tilde) ) % N_tilde;
-    right_num = ( E_ * S_.PowM(e, N_tilde) ) % N_tilde;
-    ok = left_num == right_num;
-    if(!ok) return false;
+    BN left_num[2];
+
+    // Every equation is checked as one multi-exponentiation, the equations are independent of each other.
+    ParallelInvoke(executor, {
+        // C^z1 * w^N0 * D^(-e) = A  mod N0Sqr
+        [&] { left_num[0] = BN::MultiPowM({C, w_, D}, {z1_, N0, e.Neg()}, N0Sqr); },
+        // g^z1 = Bx * X^e
+        [&] { left_point = g * z1_; },
+        [&] { right_point = B_ + X * e; },
+        // s^z1 * t^z2 * S^(-e) = E  mod N_tilde
+        [&] { left_num[1] = BN::MultiPowM({s, t, S_}, {z1_, z2_, e.Neg()}, N_tilde); },
+    });
+
+    if(left_num[0] != A_ % N0Sqr) return false;
+    if(left_point != right_point) return false;
+    if(left_num[1] != E_ % N_tilde) return false;
 
     return true;
 }
@@ -6,6 +6,7 @@
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -81,8 +82,11 @@ public:
 
     void SetSalt(const std::string &salt) { salt_ = salt; }
 
-    void Prove(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement, const PailMulGroupEleRangeWitness &witness);
-    bool Verify(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement) const;
+    // "executor" (optional) runs the independent exponentiations in parallel, the transcript does not depend on it.
+    void Prove(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement, const PailMulGroupEleRangeWitness &witness,
+               safeheron::concurrency::Executor *executor = nullptr);
+    bool Verify(const PailMulGroupEleRangeSetUp &setup, const PailMulGroupEleRangeStatement &statement,
+                safeheron::concurrency::Executor *executor = nullptr) const;
 
     bool ToProtoObject(safeheron::proto::PailMulGroupEleRangeProof &proof) const;
     bool FromProtoObject(const safeheron::proto::PailMulGroupEleRangeProof &proof);
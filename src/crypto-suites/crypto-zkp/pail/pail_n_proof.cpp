@@ -6,6 +6,7 @@
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail/pail_n_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -108,16 +109,19 @@ void PailNProof::GenerateXs(std::vector<BN> &x_arr, const BN &N, uint32_t proof_
 }
 
 void PailNProof::Prove(const PailPrivKey &pail_priv, uint32_t proof_iters) {
+    SAFEHERON_TRACE_SCOPE("PailNProof::Prove");
     vector<BN> x_arr;
     BN M = pail_priv.n().InvM(pail_priv.lambda());
     GenerateXs(x_arr, pail_priv.n(), proof_iters);
     for(uint32_t i = 0; i < proof_iters; ++i){
-        BN y_N = x_arr[i].PowM(M, pail_priv.n());
+        // x^M mod N, with the CRT over p and q if the key holds them
+        BN y_N = pail_priv.PowMModN(x_arr[i], M);
         y_N_arr_.push_back(y_N);
     }
 }
 
 bool PailNProof::Verify(const PailPubKey &pail_pub, uint32_t proof_iters) const {
+    SAFEHERON_TRACE_SCOPE("PailNProof::Verify");
     if(pail_pub.n().BitLength() < 2046)return false;
     if(pail_pub.n() <= 1 || pail_pub.g() <= 1)return false;
     if(pail_pub.n() + 1 != pail_pub.g())return false;
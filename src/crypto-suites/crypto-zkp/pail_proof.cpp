@@ -6,6 +6,7 @@
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pail_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -123,6 +124,7 @@ void PailProof::GenerateXs(std::vector<BN> &x_arr, const BN &index, const BN &po
 }
 
 void PailProof::Prove(const PailPrivKey &pail_priv, const BN &index, const BN &point_x, const BN &point_y, uint32_t proof_iters) {
+    SAFEHERON_TRACE_SCOPE("PailProof::Prove");
     vector<BN> x_arr;
     BN M = pail_priv.n().InvM(pail_priv.lambda());
     GenerateXs(x_arr, index, point_x, point_y, pail_priv.n(), proof_iters);
@@ -133,6 +135,7 @@ void PailProof::Prove(const PailPrivKey &pail_priv, const BN &index, const BN &p
 }
 
 bool PailProof::Verify(const PailPubKey &pail_pub, const BN &index, const BN &point_x, const BN &point_y, uint32_t proof_iters) const {
+    SAFEHERON_TRACE_SCOPE("PailProof::Verify");
     if(pail_pub.n().BitLength() < 2046)return false;
     if(pail_pub.n() <= 1 || pail_pub.g() <= 1)return false;
     if(pail_pub.n() + 1 != pail_pub.g())return false;
@@ -1,16 +1,18 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/pedersen_proof.h"
 #include "crypto-suites/common/custom_assert.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
 using safeheron::bignum::BN;
 using safeheron::curve::CurvePoint;
 using safeheron::curve::Curve;
+using safeheron::curve::FixedBaseMul;
 using safeheron::hash::CSafeHash256;
 using google::protobuf::util::Status;
 using google::protobuf::util::MessageToJsonString;
@@ -36,6 +38,7 @@ void PedersenProof::ProveWithR(const PedersenStatement &statement,
                                const PedersenWitness &witness,
                                const safeheron::bignum::BN &a_lt_curveN,
                                const safeheron::bignum::BN &b_lt_curveN) {
+    SAFEHERON_TRACE_SCOPE("PedersenProof::Prove");
     const safeheron::curve::Curve * curv = curve::GetCurveParam(statement.G_.GetCurveType());
     ASSERT_THROW(curv);
 
@@ -45,25 +48,20 @@ void PedersenProof::ProveWithR(const PedersenStatement &statement,
     curve::CurvePoint Alpha = A1 + A2;
 
     // c = H( Salt || Alpha || T || G || H)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
     // Alpha
-    Alpha.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(Alpha);
     // T
-    statement.T_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(statement.T_);
     // G
-    statement.G_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(statement.G_);
     // H
-    statement.H_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(statement.H_);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
 
@@ -81,36 +79,32 @@ void PedersenProof::ProveWithR(const PedersenStatement &statement,
 }
 
 bool PedersenProof::Verify(const PedersenStatement &statement) const {
+    SAFEHERON_TRACE_SCOPE("PedersenProof::Verify");
     // T = sigma*G + l*H
     // Alpha = a*G + b*H
     // t = (a + c * sigma) % q
     // u = (b + c * l) % q
 
     // c = H( Salt || Alpha || T || G || H)
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
     // Alpha
-    Alpha_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(Alpha_);
     // T
-    statement.T_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(statement.T_);
     // G
-    statement.G_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
+    transcript.Append(statement.G_);
     // H
-    statement.H_.EncodeFull(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(statement.H_);
+    transcript.Finalize(sha256_digest);
 
     BN c = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
 
     // left = t*G + u*H
-    curve::CurvePoint left = statement.G_ * t_ + statement.H_ * u_;
+    curve::CurvePoint left = FixedBaseMul(statement.G_, statement.G_table_, t_) + FixedBaseMul(statement.H_, statement.H_table_, u_);
     // right = Alpha + c * T
     curve::CurvePoint right = Alpha_ + statement.T_ * c;
     return left == right;
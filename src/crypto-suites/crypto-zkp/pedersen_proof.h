@@ -5,6 +5,7 @@
 #include <utility>
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
 #include "crypto-suites/crypto-zkp/proto_gen/zkp.pb.switch.h"
 
 namespace safeheron{
@@ -34,6 +35,11 @@ struct PedersenStatement{
     curve::CurvePoint T_; // T = sigma*G + l*H
     PedersenStatement() {}
     PedersenStatement(const curve::CurvePoint &G, const curve::CurvePoint &H, const curve::CurvePoint &T): G_(G), H_(H), T_(T){}
+
+    // Optional precomputed tables of G and H, to be shared by the proofs over the same points.
+    // Only Verify uses them: Prove multiplies by secret nonces, which must not go through a table.
+    const curve::FixedBaseTable *G_table_ = nullptr;
+    const curve::FixedBaseTable *H_table_ = nullptr;
 };
 
 
@@ -1,9 +1,10 @@
 #include <google/protobuf/util/json_util.h>
-#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/range_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -23,6 +24,7 @@ namespace zkp {
 namespace range_proof {
 
 void AliceRangeProof::Prove(const BN &q, const BN &N, const BN &g, const BN &N_tilde, const BN &h1, const BN &h2, const BN &c, const BN &m, const BN &r) {
+    SAFEHERON_TRACE_SCOPE("AliceRangeProof::Prove");
     BN q2 = q * q;
     BN q3 = q * q2;
     BN q_N_tilde = q * N_tilde;
@@ -42,29 +44,20 @@ void AliceRangeProof::Prove(const BN &q, const BN &N, const BN &g, const BN &N_t
     // w = h1^alpha * h2^gamma mod N_tilde
     w_ = ( h1.PowM(alpha, N_tilde) * h2.PowM(gamma, N_tilde) ) % N_tilde;
 
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    N.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    u_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(N);
+    transcript.Append(c);
+    transcript.Append(z_);
+    transcript.Append(u_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
@@ -74,6 +67,7 @@ void AliceRangeProof::Prove(const BN &q, const BN &N, const BN &g, const BN &N_t
 }
 
 bool AliceRangeProof::Verify(const BN &q, const BN &N, const BN &g, const BN &N_tilde, const BN &h1, const BN &h2, const BN &c) const {
+    SAFEHERON_TRACE_SCOPE("AliceRangeProof::Verify");
     BN q2 = q * q;
     BN q3 = q * q2;
     BN q_N_tilde = q * N_tilde;
@@ -89,29 +83,20 @@ bool AliceRangeProof::Verify(const BN &q, const BN &N, const BN &g, const BN &N_
 
     if(s1_ > q3)return false;
 
-    CSafeHash256 sha256;
+    Transcript transcript;
     uint8_t sha256_digest[CSafeHash256::OUTPUT_SIZE];
-    string str;
     if(salt_.length() > 0) {
-        sha256.Write((const uint8_t *)(salt_.c_str()), salt_.length());
+        transcript.Append(salt_);
     }
-    N_tilde.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h1.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    h2.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    N.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    c.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    z_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    u_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    w_.ToBytesBE(str);
-    sha256.Write((const uint8_t *)(str.c_str()), str.length());
-    sha256.Finalize(sha256_digest);
+    transcript.Append(N_tilde);
+    transcript.Append(h1);
+    transcript.Append(h2);
+    transcript.Append(N);
+    transcript.Append(c);
+    transcript.Append(z_);
+    transcript.Append(u_);
+    transcript.Append(w_);
+    transcript.Finalize(sha256_digest);
     BN e = BN::FromBytesBE(sha256_digest, sizeof(sha256_digest));
     e = e % q;
 
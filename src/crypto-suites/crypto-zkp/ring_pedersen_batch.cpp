@@ -0,0 +1,86 @@
+#include "crypto-suites/crypto-zkp/ring_pedersen_batch.h"
+#include "crypto-suites/crypto-bn/rand.h"
+
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::concurrency::Executor;
+using safeheron::concurrency::ParallelFor;
+
+namespace safeheron{
+namespace zkp {
+
+RingPedersenBatch::RingPedersenBatch(const BN &N_tilde, const BN &s, const BN &t)
+        : N_tilde_(N_tilde), s_(s), t_(t) {
+}
+
+void RingPedersenBatch::Add(const BN &a, const BN &b, const vector<BN> &bases, const vector<BN> &exps, const BN &y) {
+    equations_.push_back(Equation{a, b, bases, exps, y});
+}
+
+void RingPedersenBatch::Append(const RingPedersenBatch &other) {
+    equations_.insert(equations_.end(), other.equations_.begin(), other.equations_.end());
+}
+
+/**
+ * With random weights w_i:
+ *     ( s^sum(w_i * a_i) * t^sum(w_i * b_i) * prod(X_ij^(w_i * x_ij)) * prod(Y_i^(-w_i)) )^2 = 1    mod N_tilde
+ */
+bool RingPedersenBatch::Check() const {
+    if (equations_.empty()) return true;
+
+    vector<BN> bases{s_, t_};
+    vector<BN> exps{BN::ZERO, BN::ZERO};
+    for (const Equation &eq : equations_) {
+        if (eq.bases.size() != eq.exps.size()) return false;
+        // The left side is a unit, so is the right side of a valid equation.
+        if (eq.y.Gcd(N_tilde_) != BN::ONE) return false;
+
+        BN w = safeheron::rand::RandomBNStrict(WEIGHT_BITS);
+        exps[0] += w * eq.a;
+        exps[1] += w * eq.b;
+        for (size_t j = 0; j < eq.bases.size(); ++j) {
+            bases.push_back(eq.bases[j]);
+            exps.push_back(w * eq.exps[j]);
+        }
+        bases.push_back(eq.y);
+        exps.push_back(w.Neg());
+    }
+    BN prod = BN::MultiPowM(bases, exps, N_tilde_);
+    return (prod * prod) % N_tilde_ == BN::ONE;
+}
+
+bool BatchVerifyRingPedersen(const BN &N_tilde, const BN &s, const BN &t,
+                             size_t n, const std::function<bool(size_t, RingPedersenBatch *)> &verify,
+                             vector<bool> &results, Executor *executor) {
+    results.assign(n, false);
+    if (n == 0) return true;
+
+    // The other equations of every proof, their equations mod N_tilde being collected.
+    vector<RingPedersenBatch> batches(n, RingPedersenBatch(N_tilde, s, t));
+    vector<char> ok(n, 0);
+    ParallelFor(executor, n, [&](size_t i) {
+        ok[i] = verify(i, &batches[i]) ? 1 : 0;
+    });
+
+    RingPedersenBatch batch(N_tilde, s, t);
+    for (size_t i = 0; i < n; ++i) {
+        if (ok[i]) batch.Append(batches[i]);
+    }
+
+    if (!batch.Check()) {
+        // Find the invalid proofs.
+        ParallelFor(executor, n, [&](size_t i) {
+            if (ok[i]) ok[i] = verify(i, nullptr) ? 1 : 0;
+        });
+    }
+
+    bool all_ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        results[i] = (ok[i] != 0);
+        all_ok = all_ok && results[i];
+    }
+    return all_ok;
+}
+
+}
+}
@@ -0,0 +1,87 @@
+#ifndef SAFEHERON_CRYPTO_ZKP_RING_PEDERSEN_BATCH_H
+#define SAFEHERON_CRYPTO_ZKP_RING_PEDERSEN_BATCH_H
+
+#include <functional>
+#include <vector>
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/common/executor.h"
+
+namespace safeheron{
+namespace zkp {
+
+/**
+ * Equations of ring-Pedersen commitments over the same setup (N_tilde, s, t), checked all at once.
+ *
+ * Every equation
+ *     s^a * t^b * X_1^x_1 * ... * X_k^x_k = Y    mod N_tilde
+ * is raised to a random weight w of WEIGHT_BITS bits, and the product of all of them is checked as a single
+ * multi-exponentiation, in which s and t appear only once with exponents sum(w * a) and sum(w * b).
+ *
+ * The equations are only checked up to a factor of order 2: the product is squared before it is compared with 1.
+ * Without the squaring, a factor -1 on one equation, which anyone can introduce by negating a commitment, would pass
+ * the weighted check half of the time. The squares of Z_N_tilde^* have odd order when N_tilde is a product of two
+ * safe primes, as it is in a ring-Pedersen setup, so any other wrong equation makes the check fail except with
+ * probability about 2^-WEIGHT_BITS. A factor of order 2 does not weaken the proofs: s and t are squares, and besides
+ * -1 such a factor is a square root of 1 which would give the factorization of N_tilde.
+ */
+class RingPedersenBatch {
+public:
+    static const size_t WEIGHT_BITS = 64;
+
+    RingPedersenBatch(const safeheron::bignum::BN &N_tilde, const safeheron::bignum::BN &s, const safeheron::bignum::BN &t);
+
+    /**
+     * Add the equation s^a * t^b * bases[0]^exps[0] * ... = y mod N_tilde.
+     * The bases must be invertible modulo N_tilde.
+     */
+    void Add(const safeheron::bignum::BN &a, const safeheron::bignum::BN &b,
+             const std::vector<safeheron::bignum::BN> &bases, const std::vector<safeheron::bignum::BN> &exps,
+             const safeheron::bignum::BN &y);
+
+    /**
+     * Add the equations of "other", which has the same setup.
+     */
+    void Append(const RingPedersenBatch &other);
+
+    size_t Size() const { return equations_.size(); }
+
+    /**
+     * @return true if the random combination of all the equations holds.
+     */
+    bool Check() const;
+
+private:
+    struct Equation {
+        safeheron::bignum::BN a;
+        safeheron::bignum::BN b;
+        std::vector<safeheron::bignum::BN> bases;
+        std::vector<safeheron::bignum::BN> exps;
+        safeheron::bignum::BN y;
+    };
+
+    safeheron::bignum::BN N_tilde_;
+    safeheron::bignum::BN s_;
+    safeheron::bignum::BN t_;
+    std::vector<Equation> equations_;
+};
+
+/**
+ * Verify "n" proofs against the same ring-Pedersen setup.
+ *
+ * verify(i, batch) checks all the equations of the i-th proof except those mod N_tilde, which it adds to "batch".
+ * verify(i, nullptr) is the exact verification of the i-th proof.
+ * The proofs run in parallel on "executor". The equations mod N_tilde of every proof are checked at once with a
+ * RingPedersenBatch, and only if this check fails each proof is verified on its own to find the invalid ones.
+ * A passing batch thus accepts the equations mod N_tilde up to a factor of order 2, where verify(i, nullptr) is exact.
+ *
+ * @param results results[i] is true if the i-th proof is accepted.
+ * @return true if every proof is accepted.
+ */
+bool BatchVerifyRingPedersen(const safeheron::bignum::BN &N_tilde, const safeheron::bignum::BN &s, const safeheron::bignum::BN &t,
+                             size_t n, const std::function<bool(size_t, RingPedersenBatch *)> &verify,
+                             std::vector<bool> &results, safeheron::concurrency::Executor *executor);
+
+}
+}
+
+#endif //SAFEHERON_CRYPTO_ZKP_RING_PEDERSEN_BATCH_H
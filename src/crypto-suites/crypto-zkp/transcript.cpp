@@ -0,0 +1,119 @@
+#include <cstring>
+#include <openssl/bn.h>
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/exception/safeheron_exceptions.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
+
+using std::string;
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+using safeheron::exception::OpensslException;
+
+namespace safeheron{
+namespace zkp {
+
+namespace {
+
+// Big enough for N^2 with a 4096-bits Paillier modulus.
+const int MAX_STACK_BN_BYTES = 1024;
+const size_t FULL_POINT_BYTES = 65;
+
+/**
+ * Full encodings of the generators, computed once.
+ */
+class GeneratorEncodings {
+private:
+    struct Entry {
+        const CurvePoint *g;
+        uint8_t bytes[FULL_POINT_BYTES];
+    };
+    Entry entries_[4];
+    size_t count_;
+
+    void add(CurveType c_type) {
+        const Curve *curv = safeheron::curve::GetCurveParam(c_type);
+        if (curv == nullptr) return;
+        entries_[count_].g = &curv->g;
+        curv->g.EncodeFull(entries_[count_].bytes);
+        ++count_;
+    }
+
+public:
+    GeneratorEncodings(): entries_(), count_(0) {
+        add(CurveType::SECP256K1);
+        add(CurveType::P256);
+        add(CurveType::ED25519);
+#if ENABLE_STARK
+        add(CurveType::STARK);
+#endif //ENABLE_STARK
+    }
+
+    const uint8_t *find(const CurvePoint &point) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].g == &point) return entries_[i].bytes;
+        }
+        return nullptr;
+    }
+
+    static const GeneratorEncodings &instance() {
+        static const GeneratorEncodings encodings;
+        return encodings;
+    }
+};
+
+}
+
+template <class SafeHash>
+TranscriptT<SafeHash>& TranscriptT<SafeHash>::Append(const BN &bn) {
+    int len = (int)bn.ByteLength();
+    if (len > MAX_STACK_BN_BYTES) {
+        string str;
+        bn.ToBytesBE(str);
+        return Append(str);
+    }
+
+    uint8_t buf[MAX_STACK_BN_BYTES];
+    if (len > 0) {
+        int ret = BN_bn2bin(bn.GetBIGNUM(), buf);
+        if (ret != len) {
+            throw OpensslException(__FILE__, __LINE__, __FUNCTION__, ret, "BN_bn2bin(bn.GetBIGNUM(), buf) != len");
+        }
+    }
+    sha.Write(buf, (size_t)len);
+    return *this;
+}
+
+template <class SafeHash>
+TranscriptT<SafeHash>& TranscriptT<SafeHash>::Append(const CurvePoint &point) {
+    if (point.GetCurveType() == CurveType::INVALID_CURVE) {
+        // Let EncodeFull raise the usual exception.
+        string str;
+        point.EncodeFull(str);
+        return Append(str);
+    }
+
+    if (point.IsInfinity()) {
+        const uint8_t zero = 0x00;
+        sha.Write(&zero, 1);
+        return *this;
+    }
+
+    const uint8_t *cached = GeneratorEncodings::instance().find(point);
+    if (cached != nullptr) {
+        sha.Write(cached, FULL_POINT_BYTES);
+        return *this;
+    }
+
+    uint8_t buf[FULL_POINT_BYTES];
+    point.EncodeFull(buf);
+    sha.Write(buf, FULL_POINT_BYTES);
+    return *this;
+}
+
+template class TranscriptT<safeheron::hash::CSafeHash256>;
+template class TranscriptT<safeheron::hash::CSafeHash512>;
+
+}
+}
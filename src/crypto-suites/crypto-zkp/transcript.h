@@ -0,0 +1,74 @@
+#ifndef SAFEHERON_CRYPTO_ZKP_TRANSCRIPT_H
+#define SAFEHERON_CRYPTO_ZKP_TRANSCRIPT_H
+
+#include <string>
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/crypto-curve/curve_point.h"
+#include "crypto-suites/crypto-hash/safe_hash256.h"
+#include "crypto-suites/crypto-hash/safe_hash512.h"
+
+namespace safeheron{
+namespace zkp {
+
+/**
+ * @brief Fiat-Shamir transcript on top of a safe hasher (CSafeHash256 or CSafeHash512).
+ *
+ * Each Append writes exactly one element, with the same bytes as the usual
+ * "x.ToBytesBE(str); sha.Write(str)" and "P.EncodeFull(str); sha.Write(str)" sequences,
+ * so a challenge derived from a transcript is identical to the one derived with the hasher directly.
+ * The difference is that the element is serialized into a stack buffer instead of a heap string,
+ * and that the encoding of a curve generator is computed only once per process.
+ */
+template <class SafeHash>
+class TranscriptT {
+private:
+    SafeHash sha;
+public:
+    static const size_t OUTPUT_SIZE = SafeHash::OUTPUT_SIZE;
+
+    /**
+     * Append raw bytes as one element.
+     */
+    TranscriptT& Write(const unsigned char *data, size_t len) {
+        sha.Write(data, len);
+        return *this;
+    }
+
+    /**
+     * Append a string as one element.
+     */
+    TranscriptT& Append(const std::string &str) {
+        sha.Write((const unsigned char *)str.c_str(), str.length());
+        return *this;
+    }
+
+    /**
+     * Append a big number as one element: |bn| in big endian without leading zeros (empty for zero).
+     */
+    TranscriptT& Append(const safeheron::bignum::BN &bn);
+
+    /**
+     * Append a curve point as one element: 0x04 || x || y, or a single 0x00 byte for the point at infinity.
+     */
+    TranscriptT& Append(const safeheron::curve::CurvePoint &point);
+
+    void Finalize(unsigned char hash[OUTPUT_SIZE]) {
+        sha.Finalize(hash);
+    }
+
+    TranscriptT& Reset() {
+        sha.Reset();
+        return *this;
+    }
+};
+
+typedef TranscriptT<safeheron::hash::CSafeHash256> Transcript;
+typedef TranscriptT<safeheron::hash::CSafeHash512> Transcript512;
+
+extern template class TranscriptT<safeheron::hash::CSafeHash256>;
+extern template class TranscriptT<safeheron::hash::CSafeHash512>;
+
+}
+}
+
+#endif //SAFEHERON_CRYPTO_ZKP_TRANSCRIPT_H
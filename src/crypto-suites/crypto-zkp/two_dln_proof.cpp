@@ -4,6 +4,7 @@
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-zkp/two_dln_proof.h"
+#include "crypto-suites/common/instrumentation.h"
 
 using std::string;
 using std::vector;
@@ -70,6 +71,7 @@ bool GenerateN_tilde_with_PQ(const safeheron::bignum::BN &P, const safeheron::bi
 }
 
 void TwoDLNProof::Prove(const BN &N, const BN &h1, const BN &h2, const BN &p, const BN &q, const BN &alpha, const BN &beta) {
+    SAFEHERON_TRACE_SCOPE("TwoDLNProof::Prove");
     dln_proof_1_.SetSalt(salt_);
     dln_proof_1_.Prove(N, h1, h2, p, q, alpha);
     dln_proof_2_.SetSalt(salt_);
@@ -77,6 +79,7 @@ void TwoDLNProof::Prove(const BN &N, const BN &h1, const BN &h2, const BN &p, co
 }
 
 bool TwoDLNProof::Verify(const BN &N, const BN &h1, const BN &h2) const {
+    SAFEHERON_TRACE_SCOPE("TwoDLNProof::Verify");
     return dln_proof_1_.Verify(N, h1, h2) && dln_proof_2_.Verify(N, h2, h1);
 }
 
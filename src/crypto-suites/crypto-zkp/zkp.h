@@ -2,6 +2,7 @@
 #define SAFEHERON_CRYPTO_ZKP_H
 
 #include "crypto-suites/crypto-zkp/ring_pedersen_param.h"
+#include "crypto-suites/crypto-zkp/ring_pedersen_batch.h"
 #include "crypto-suites/crypto-zkp/dln_proof.h"
 #include "crypto-suites/crypto-zkp/dlog_elgamal_com_proof.h"
 #include "crypto-suites/crypto-zkp/dlog_equality_proof.h"
@@ -13,11 +13,23 @@
 
 #include "ed25519-donna-portable.h"
 
+/*
+ * ED25519_DONNA_64BIT selects the field elements in 5 limbs of 51 bits and the scalars in 5 limbs of 56 bits, with
+ * 64x64->128 bit products. Otherwise the 32 bit implementation is used, e.g. in SGX.
+ */
+#if defined(ED25519_DONNA_64BIT)
+#include "curve25519-donna-64bit.h"
+#else
 #include "curve25519-donna-32bit.h"
+#endif
 
 #include "curve25519-donna-helpers.h"
 
+#if defined(ED25519_DONNA_64BIT)
+#include "modm-donna-64bit.h"
+#else
 #include "modm-donna-32bit.h"
+#endif
 
 typedef unsigned char hash_512bits[64];
 
@@ -45,7 +57,11 @@ typedef struct ge25519_pniels_t {
 
 #include "ed25519-donna-basepoint-table.h"
 
+#if defined(ED25519_DONNA_64BIT)
+#include "ed25519-donna-64bit-tables.h"
+#else
 #include "ed25519-donna-32bit-tables.h"
+#endif
 
 #include "ed25519-donna-impl-base.h"
 
@@ -0,0 +1,258 @@
+#include <cstdio>
+#include <vector>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-aes/gcm.h"
+#include "crypto-suites/crypto-aes/gcm_stream.h"
+
+using namespace safeheron;
+using namespace safeheron::aes;
+
+static std::string make_payload(size_t len)
+{
+    std::string data(len, '\0');
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (char)((i * 131 + 7) & 0xFF);
+    }
+    return data;
+}
+
+TEST(aes_gcm_stream, incremental_equals_one_shot)
+{
+    const std::string key = "12345678901234567890123456789012";
+    const std::string iv = "123456789012";
+    const std::string associated_data = "aaaabbbccc";
+    const std::string plain = make_payload(1000);
+    uint8_t tag[GCMStream::TAG_SIZE];
+    uint8_t expected_tag[GCM::TAG_SIZE];
+    std::string cipher(plain.length(), '\0');
+    std::string expected_cipher(plain.length(), '\0');
+    std::string decrypted(plain.length(), '\0');
+
+    GCM gcm(key);
+    EXPECT_TRUE(gcm.Encrypt((uint8_t*)plain.c_str(), plain.length(),
+                            (uint8_t*)iv.c_str(), iv.length(),
+                            (uint8_t*)associated_data.c_str(), associated_data.length(),
+                            expected_tag, (uint8_t*)&expected_cipher[0]));
+
+    // Feed the message in uneven chunks.
+    GCMStream stream(key);
+    const size_t chunks[] = {1, 15, 16, 17, 300, 651};
+    size_t offset = 0;
+    EXPECT_TRUE(stream.EncryptInit((uint8_t*)iv.c_str(), iv.length(),
+                                   (uint8_t*)associated_data.c_str(), associated_data.length()));
+    for (size_t chunk : chunks) {
+        EXPECT_TRUE(stream.EncryptUpdate((uint8_t*)plain.c_str() + offset, chunk, (uint8_t*)&cipher[offset]));
+        offset += chunk;
+    }
+    EXPECT_EQ(offset, plain.length());
+    EXPECT_TRUE(stream.EncryptFinal(tag));
+    EXPECT_EQ(cipher, expected_cipher);
+    EXPECT_TRUE(memcmp(tag, expected_tag, GCMStream::TAG_SIZE) == 0);
+
+    offset = 0;
+    EXPECT_TRUE(stream.DecryptInit((uint8_t*)iv.c_str(), iv.length(),
+                                   (uint8_t*)associated_data.c_str(), associated_data.length()));
+    for (size_t chunk : chunks) {
+        EXPECT_TRUE(stream.DecryptUpdate((uint8_t*)cipher.c_str() + offset, chunk, (uint8_t*)&decrypted[offset]));
+        offset += chunk;
+    }
+    EXPECT_TRUE(stream.DecryptFinal(tag, GCMStream::TAG_SIZE));
+    EXPECT_EQ(decrypted, plain);
+
+    // Update without Init is refused.
+    EXPECT_FALSE(stream.EncryptUpdate((uint8_t*)plain.c_str(), 1, (uint8_t*)&cipher[0]));
+}
+
+TEST(aes_gcm_stream, pack_format_compatible_with_gcm)
+{
+    const std::string key = "1234567890123456";
+    const std::string associated_data = "aaaabbbccc";
+    const std::string plain = make_payload(10000);
+    std::string decrypted;
+
+    GCMStream stream(key, 1024);
+    std::string pack(stream.CipherLength(GCMStream::Format::Pack, plain.length()), '\0');
+    EXPECT_TRUE(stream.Encrypt(GCMStream::Format::Pack, (uint8_t*)plain.c_str(), plain.length(),
+                               (uint8_t*)associated_data.c_str(), associated_data.length(),
+                               (uint8_t*)&pack[0], pack.length()));
+
+    GCM gcm(key);
+    EXPECT_TRUE(gcm.DecryptPack(pack, associated_data, decrypted));
+    EXPECT_EQ(decrypted, plain);
+
+    std::string gcm_pack;
+    EXPECT_TRUE(gcm.EncryptPack(plain, associated_data, gcm_pack));
+    uint64_t plain_len = plain.length();
+    std::string out(plain_len, '\0');
+    EXPECT_TRUE(stream.Decrypt((uint8_t*)gcm_pack.c_str(), gcm_pack.length(),
+                               (uint8_t*)associated_data.c_str(), associated_data.length(),
+                               (uint8_t*)&out[0], plain_len));
+    EXPECT_EQ(out, plain);
+}
+
+TEST(aes_gcm_stream, segmented_random_access)
+{
+    const std::string key = "123456789012345678901234";
+    const std::string associated_data = "backup-2024";
+    const uint32_t segment_size = 256;
+    const std::string plain = make_payload(segment_size * 5 + 100);
+
+    GCMStream stream(key, segment_size);
+    std::string cipher(stream.CipherLength(GCMStream::Format::Segmented, plain.length()), '\0');
+    EXPECT_TRUE(stream.Encrypt(GCMStream::Format::Segmented, (uint8_t*)plain.c_str(), plain.length(),
+                               (uint8_t*)associated_data.c_str(), associated_data.length(),
+                               (uint8_t*)&cipher[0], cipher.length()));
+
+    uint64_t plain_len = 0;
+    EXPECT_TRUE(stream.PlainLength((uint8_t*)cipher.c_str(), cipher.length(), plain_len));
+    EXPECT_EQ(plain_len, plain.length());
+
+    std::string out(plain_len, '\0');
+    EXPECT_TRUE(stream.Decrypt((uint8_t*)cipher.c_str(), cipher.length(),
+                               (uint8_t*)associated_data.c_str(), associated_data.length(),
+                               (uint8_t*)&out[0], plain_len));
+    EXPECT_EQ(out, plain);
+
+    // Every segment can be decrypted on its own, the last one is shorter.
+    uint8_t segment[segment_size];
+    uint32_t segment_len = 0;
+    for (uint64_t i = 0; i < 6; i++) {
+        segment_len = sizeof(segment);
+        EXPECT_TRUE(stream.DecryptSegment((uint8_t*)cipher.c_str(), cipher.length(),
+                                          (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                          i, segment, segment_len));
+        EXPECT_EQ(segment_len, i < 5 ? segment_size : 100u);
+        EXPECT_TRUE(memcmp(segment, plain.c_str() + i * segment_size, segment_len) == 0);
+    }
+    segment_len = sizeof(segment);
+    EXPECT_FALSE(stream.DecryptSegment((uint8_t*)cipher.c_str(), cipher.length(),
+                                       (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                       6, segment, segment_len));
+
+    // Swapping two segments, flipping a bit or using other associated data is detected.
+    std::string swapped = cipher;
+    size_t seg0 = GCMStream::SEGMENTED_HEADER_SIZE;
+    size_t seg1 = seg0 + segment_size + GCMStream::TAG_SIZE;
+    swapped.replace(seg0, segment_size + GCMStream::TAG_SIZE, cipher.substr(seg1, segment_size + GCMStream::TAG_SIZE));
+    segment_len = sizeof(segment);
+    EXPECT_FALSE(stream.DecryptSegment((uint8_t*)swapped.c_str(), swapped.length(),
+                                       (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                       0, segment, segment_len));
+    std::string flipped = cipher;
+    flipped[seg1 + 3] ^= 0x01;
+    EXPECT_FALSE(stream.Decrypt((uint8_t*)flipped.c_str(), flipped.length(),
+                                (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                (uint8_t*)&out[0], plain_len));
+    segment_len = sizeof(segment);
+    EXPECT_FALSE(stream.DecryptSegment((uint8_t*)cipher.c_str(), cipher.length(),
+                                       (uint8_t*)"other", 5, 0, segment, segment_len));
+    // Truncation is detected.
+    EXPECT_FALSE(stream.Decrypt((uint8_t*)cipher.c_str(), cipher.length() - 1,
+                                (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                (uint8_t*)&out[0], plain_len));
+}
+
+TEST(aes_gcm_stream, segment_larger_than_buffer)
+{
+    // A header announcing a larger segment size, with a consistent length, must not overflow the output buffer
+    // sized for the segment size of the instance.
+    const std::string key = "12345678901234567890123456789012";
+    const uint32_t segment_size = 1024;
+    const std::string plain = make_payload(segment_size * 8);
+
+    GCMStream large_stream(key, segment_size * 8);
+    std::string cipher(large_stream.CipherLength(GCMStream::Format::Segmented, plain.length()), '\0');
+    ASSERT_TRUE(large_stream.Encrypt(GCMStream::Format::Segmented, (uint8_t*)plain.c_str(), plain.length(),
+                                     nullptr, 0, (uint8_t*)&cipher[0], cipher.length()));
+
+    GCMStream stream(key, segment_size);
+    std::vector<uint8_t> out(segment_size + 64, 0xAA);
+    uint32_t segment_len = segment_size;
+    EXPECT_FALSE(stream.DecryptSegment((uint8_t*)cipher.c_str(), cipher.length(), nullptr, 0,
+                                       0, out.data(), segment_len));
+    for (size_t i = segment_size; i < out.size(); i++) {
+        EXPECT_EQ(out[i], 0xAA);
+    }
+
+    FILE *cipher_file = tmpfile();
+    ASSERT_TRUE(cipher_file);
+    int cipher_fd = fileno(cipher_file);
+    ASSERT_EQ(pwrite(cipher_fd, cipher.c_str(), cipher.length(), 0), (ssize_t)cipher.length());
+    segment_len = segment_size;
+    EXPECT_FALSE(stream.DecryptSegmentFd(cipher_fd, nullptr, 0, 0, out.data(), segment_len));
+    for (size_t i = segment_size; i < out.size(); i++) {
+        EXPECT_EQ(out[i], 0xAA);
+    }
+    fclose(cipher_file);
+
+    // With a buffer large enough the segment is decrypted.
+    out.assign(plain.length(), 0);
+    segment_len = (uint32_t)out.size();
+    EXPECT_TRUE(stream.DecryptSegment((uint8_t*)cipher.c_str(), cipher.length(), nullptr, 0,
+                                      0, out.data(), segment_len));
+    EXPECT_EQ(segment_len, plain.length());
+    EXPECT_TRUE(memcmp(out.data(), plain.c_str(), plain.length()) == 0);
+}
+
+TEST(aes_gcm_stream, file_descriptors)
+{
+    const std::string key = "12345678901234567890123456789012";
+    const std::string associated_data = "audit-archive";
+    const uint32_t segment_size = 4096;
+    const std::string plain = make_payload(segment_size * 10 + 123);
+    const GCMStream::Format formats[] = {GCMStream::Format::Pack, GCMStream::Format::Segmented};
+
+    GCMStream stream(key, segment_size);
+    for (GCMStream::Format format : formats) {
+        FILE *plain_file = tmpfile();
+        FILE *cipher_file = tmpfile();
+        FILE *decrypted_file = tmpfile();
+        ASSERT_TRUE(plain_file && cipher_file && decrypted_file);
+        int plain_fd = fileno(plain_file);
+        int cipher_fd = fileno(cipher_file);
+        int decrypted_fd = fileno(decrypted_file);
+
+        ASSERT_EQ(pwrite(plain_fd, plain.c_str(), plain.length(), 0), (ssize_t)plain.length());
+        ASSERT_EQ(lseek(plain_fd, 0, SEEK_SET), 0);
+        EXPECT_TRUE(stream.EncryptFd(format, plain_fd, plain.length(),
+                                     (uint8_t*)associated_data.c_str(), associated_data.length(), cipher_fd));
+        EXPECT_EQ(lseek(cipher_fd, 0, SEEK_END), (off_t)stream.CipherLength(format, plain.length()));
+
+        EXPECT_TRUE(stream.DecryptFd(cipher_fd, (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                     decrypted_fd));
+        std::string decrypted(plain.length(), '\0');
+        EXPECT_EQ(pread(decrypted_fd, &decrypted[0], decrypted.length(), 0), (ssize_t)plain.length());
+        EXPECT_EQ(decrypted, plain);
+
+        // The file content is identical to the in-memory format.
+        std::string cipher(stream.CipherLength(format, plain.length()), '\0');
+        EXPECT_EQ(pread(cipher_fd, &cipher[0], cipher.length(), 0), (ssize_t)cipher.length());
+        uint64_t plain_len = plain.length();
+        std::string out(plain_len, '\0');
+        EXPECT_TRUE(stream.Decrypt((uint8_t*)cipher.c_str(), cipher.length(),
+                                   (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                   (uint8_t*)&out[0], plain_len));
+        EXPECT_EQ(out, plain);
+
+        if (format == GCMStream::Format::Segmented) {
+            uint8_t segment[segment_size];
+            uint32_t segment_len = sizeof(segment);
+            EXPECT_TRUE(stream.DecryptSegmentFd(cipher_fd, (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                                10, segment, segment_len));
+            EXPECT_EQ(segment_len, 123u);
+            EXPECT_TRUE(memcmp(segment, plain.c_str() + 10 * segment_size, segment_len) == 0);
+        }
+
+        fclose(plain_file);
+        fclose(cipher_file);
+        fclose(decrypted_file);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}
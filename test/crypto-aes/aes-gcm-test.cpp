@@ -105,6 +105,68 @@ TEST(aes_gcm, batch_encrypt_pack)
     }
 }
 
+TEST(aes_gcm, reuse_context_with_caller_buffers)
+{
+    const int DATA_COUNT = 3;
+    const std::string plain[DATA_COUNT] = {"This is a test string!", "&^(%($%))ABC)(*(*(*)))", "1234560987653134000"};
+    const std::string associated_data = "aaaabbbccc";
+    const std::string key = "12345678901234567890123456789012";
+    const std::string iv[DATA_COUNT] = {"123456789012", "abcdefghijkl", "210987654321"};
+    uint8_t tag[GCM::TAG_SIZE];
+    uint8_t cipher[64];
+    uint8_t decrypted[64];
+    int tag_len = 0;
+    int cipher_len = 0;
+    uint8_t* p_tag = nullptr;
+    uint8_t* p_cipher = nullptr;
+
+    // One instance, many messages: only the iv changes between calls.
+    GCM gcm(key);
+    for (int round = 0; round < 2; round++) {
+        for (int j = 0; j < DATA_COUNT; j++) {
+            int len = (int)plain[j].length();
+            EXPECT_TRUE(gcm.Encrypt((uint8_t*)plain[j].c_str(), len,
+                                    (uint8_t*)iv[j].c_str(), iv[j].length(),
+                                    (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                    tag, cipher));
+
+            // Same result as a fresh instance with allocated outputs.
+            GCM fresh(key);
+            EXPECT_TRUE(fresh.Encrypt((uint8_t*)plain[j].c_str(), len,
+                                      (uint8_t*)iv[j].c_str(), iv[j].length(),
+                                      (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                      p_tag, tag_len, p_cipher, cipher_len));
+            EXPECT_EQ(cipher_len, len);
+            EXPECT_EQ(tag_len, GCM::TAG_SIZE);
+            EXPECT_TRUE(memcmp(p_cipher, cipher, len) == 0);
+            EXPECT_TRUE(memcmp(p_tag, tag, GCM::TAG_SIZE) == 0);
+            delete[] p_tag;
+            delete[] p_cipher;
+
+            // A forged tag is rejected, and the context is still usable afterwards.
+            tag[0] ^= 0x01;
+            EXPECT_FALSE(gcm.Decrypt(cipher, len,
+                                     (uint8_t*)iv[j].c_str(), iv[j].length(),
+                                     (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                     tag, GCM::TAG_SIZE, decrypted));
+            tag[0] ^= 0x01;
+            EXPECT_TRUE(gcm.Decrypt(cipher, len,
+                                    (uint8_t*)iv[j].c_str(), iv[j].length(),
+                                    (uint8_t*)associated_data.c_str(), associated_data.length(),
+                                    tag, GCM::TAG_SIZE, decrypted));
+            EXPECT_TRUE(memcmp(decrypted, plain[j].c_str(), len) == 0);
+        }
+    }
+
+    // A copy owns its own contexts.
+    std::string cipher_pack;
+    std::string decrypted_str;
+    GCM copy(gcm);
+    EXPECT_TRUE(copy.EncryptPack(plain[0], associated_data, cipher_pack));
+    EXPECT_TRUE(gcm.DecryptPack(cipher_pack, associated_data, decrypted_str));
+    EXPECT_EQ(decrypted_str, plain[0]);
+}
+
 
 int main(int argc, char** argv)
 {
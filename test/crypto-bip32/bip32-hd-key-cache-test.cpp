@@ -0,0 +1,133 @@
+#include <google/protobuf/stubs/common.h>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-bip32/bip32.h"
+#include "crypto-suites/crypto-bip32/hd_key_cache.h"
+#include "crypto-suites/crypto-encode/hex.h"
+
+using std::string;
+using safeheron::bignum::BN;
+using safeheron::curve::CurveType;
+using safeheron::bip32::HDKey;
+using safeheron::bip32::HDKeyCache;
+using namespace safeheron::encode;
+
+static HDKey root_from_seed(CurveType c_type) {
+    string seed = hex::DecodeFromHex("000102030405060708090a0b0c0d0e0f");
+    HDKey root;
+    EXPECT_TRUE(root.FromSeed(c_type, (const uint8_t *)seed.c_str(), (int)seed.length()));
+    return root;
+}
+
+static void expect_same_key(const HDKey &a, const HDKey &b) {
+    string s_a, s_b;
+    EXPECT_TRUE(a.ToExtendedPublicKey(s_a));
+    EXPECT_TRUE(b.ToExtendedPublicKey(s_b));
+    EXPECT_EQ(s_a, s_b);
+    if (a.HasPrivateKey() || b.HasPrivateKey()) {
+        EXPECT_TRUE(a.ToExtendedPrivateKey(s_a));
+        EXPECT_TRUE(b.ToExtendedPrivateKey(s_b));
+        EXPECT_EQ(s_a, s_b);
+    }
+}
+
+TEST(bip32, HDKeyCache_SameAsDirectDerivation) {
+    const CurveType curves[] = {CurveType::SECP256K1, CurveType::P256, CurveType::ED25519};
+    for (CurveType c_type : curves) {
+        HDKey root = root_from_seed(c_type);
+        HDKey xpub_root;
+        string xpub;
+        EXPECT_TRUE(root.ToExtendedPublicKey(xpub));
+        EXPECT_TRUE(xpub_root.FromExtendedPublicKey(xpub, c_type));
+
+        HDKeyCache cache(64);
+        for (uint32_t i = 0; i < 5; i++) {
+            string priv_path = "m/44'/60'/0'/0/" + std::to_string(i);
+            HDKey expected = root.PrivateCKDPath(priv_path);
+            HDKey derived;
+            EXPECT_TRUE(cache.PrivateCKDPath(root, priv_path, derived));
+            expect_same_key(derived, expected);
+
+            string pub_path = "m/44/60/0/0/" + std::to_string(i);
+            const HDKey *roots[] = {&root, &xpub_root};
+            for (const HDKey *r : roots) {
+                BN expected_delta, delta;
+                expected = r->PublicCKDPath(pub_path, expected_delta);
+                EXPECT_TRUE(cache.PublicCKDPath(*r, pub_path, derived, delta));
+                expect_same_key(derived, expected);
+                EXPECT_EQ(delta, expected_delta);
+            }
+        }
+
+        // Hardened public derivation is refused, and a public root has no private derivation.
+        HDKey derived;
+        EXPECT_FALSE(cache.PublicCKDPath(xpub_root, "m/44'/0", derived));
+        EXPECT_FALSE(cache.PrivateCKDPath(xpub_root, "m/44/0", derived));
+        EXPECT_FALSE(cache.PrivateCKDPath(root, "m/x", derived));
+    }
+}
+
+TEST(bip32, HDKeyCache_SiblingCostsOneStep) {
+    HDKey root = root_from_seed(CurveType::SECP256K1);
+    HDKeyCache cache;
+    HDKey derived;
+
+    EXPECT_TRUE(cache.PrivateCKDPath(root, "m/44'/60'/0'/0/0", derived));
+    EXPECT_EQ(cache.CKDSteps(), 5u);
+    EXPECT_EQ(cache.Misses(), 1u);
+    // m/44', m/44'/60', m/44'/60'/0' and m/44'/60'/0'/0
+    EXPECT_EQ(cache.Size(), 4u);
+
+    for (uint32_t i = 1; i <= 10; i++) {
+        EXPECT_TRUE(cache.PrivateCKDPath(root, "m/44'/60'/0'/0/" + std::to_string(i), derived));
+        EXPECT_EQ(cache.CKDSteps(), 5u + i);
+    }
+    EXPECT_EQ(cache.Hits(), 10u);
+    EXPECT_EQ(cache.Size(), 4u);
+
+    // A sibling branch reuses the common prefix.
+    EXPECT_TRUE(cache.PrivateCKDPath(root, "m/44'/60'/0'/1/0", derived));
+    EXPECT_EQ(cache.CKDSteps(), 17u);
+    expect_same_key(derived, root.PrivateCKDPath("m/44'/60'/0'/1/0"));
+
+    // Public and private derivations of the same root do not share nodes.
+    EXPECT_TRUE(cache.PublicCKDPath(root, "m/44/60/0/0/0", derived));
+    EXPECT_EQ(cache.CKDSteps(), 22u);
+
+    // Another root never hits the nodes of the first one.
+    HDKey other = root.PrivateCKD(7);
+    EXPECT_TRUE(cache.PrivateCKDPath(other, "m/44'/60'/0'/0/0", derived));
+    EXPECT_EQ(cache.CKDSteps(), 27u);
+    expect_same_key(derived, other.PrivateCKDPath("m/44'/60'/0'/0/0"));
+
+    cache.Clear();
+    EXPECT_EQ(cache.Size(), 0u);
+}
+
+TEST(bip32, HDKeyCache_Eviction) {
+    HDKey root = root_from_seed(CurveType::ED25519);
+    HDKeyCache cache(2);
+    HDKey derived;
+    for (uint32_t i = 0; i < 4; i++) {
+        string path = "m/" + std::to_string(i) + "'/1'/2'";
+        EXPECT_TRUE(cache.PrivateCKDPath(root, path, derived));
+        EXPECT_LE(cache.Size(), 2u);
+        expect_same_key(derived, root.PrivateCKDPath(path));
+    }
+    // m/3'/1' is still cached.
+    uint64_t steps = cache.CKDSteps();
+    EXPECT_TRUE(cache.PrivateCKDPath(root, "m/3'/1'/5'", derived));
+    EXPECT_EQ(cache.CKDSteps(), steps + 1);
+    // m/0' has been evicted.
+    steps = cache.CKDSteps();
+    EXPECT_TRUE(cache.PrivateCKDPath(root, "m/0'/1'/5'", derived));
+    EXPECT_EQ(cache.CKDSteps(), steps + 3);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    google::protobuf::ShutdownProtobufLibrary();
+    return ret;
+}
@@ -0,0 +1,100 @@
+#include <google/protobuf/stubs/common.h>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/bn.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-bip32/bip32.h"
+#include "crypto-suites/crypto-encode/hex.h"
+#include "crypto-suites/common/executor.h"
+
+using std::string;
+using safeheron::bignum::BN;
+using safeheron::curve::CurveType;
+using safeheron::bip32::HDKey;
+using safeheron::concurrency::Executor;
+using safeheron::concurrency::ThreadPoolExecutor;
+using namespace safeheron::encode;
+
+static HDKey root_from_seed(CurveType c_type) {
+    string seed = hex::DecodeFromHex("fffcf9f6f3f0edeae7e4e1dedbd8d5d2cfccc9c6c3c0bdbab7b4b1aeaba8a5a29f9c999693908d8a8784817e7b7875726f6c696663605d5a5754514e4b484542");
+    HDKey root;
+    EXPECT_TRUE(root.FromSeed(c_type, (const uint8_t *)seed.c_str(), (int)seed.length()));
+    return root;
+}
+
+static string xpub_of(const HDKey &key) {
+    string xpub;
+    EXPECT_TRUE(key.ToExtendedPublicKey(xpub));
+    return xpub;
+}
+
+TEST(bip32, PublicCKDRange) {
+    const CurveType curves[] = {CurveType::SECP256K1, CurveType::P256, CurveType::ED25519};
+    ThreadPoolExecutor pool(3);
+    Executor *executors[] = {nullptr, &pool};
+    for (CurveType c_type : curves) {
+        HDKey root = root_from_seed(c_type);
+        HDKey account = root.PrivateCKDPath("m/44'/0'/0'");
+        HDKey xpub_account;
+        EXPECT_TRUE(xpub_account.FromExtendedPublicKey(xpub_of(account), c_type));
+        const HDKey *parents[] = {&account, &xpub_account};
+        for (const HDKey *parent : parents) {
+            for (Executor *executor : executors) {
+                std::vector<HDKey> children;
+                std::vector<BN> deltas;
+                EXPECT_TRUE(parent->PublicCKDRange(1000, 25, children, deltas, executor));
+                ASSERT_EQ(children.size(), 25u);
+                ASSERT_EQ(deltas.size(), 25u);
+                for (uint32_t k = 0; k < 25; k++) {
+                    BN delta;
+                    HDKey expected = parent->PublicCKD(1000 + k, delta);
+                    EXPECT_EQ(xpub_of(children[k]), xpub_of(expected));
+                    EXPECT_FALSE(children[k].HasPrivateKey());
+                    EXPECT_EQ(deltas[k], delta);
+                }
+            }
+        }
+
+        // Path template.
+        std::vector<HDKey> children;
+        EXPECT_TRUE(root.PublicCKDRange("m/44'/0'/0'/0/*", 5, 10, children, &pool));
+        ASSERT_EQ(children.size(), 10u);
+        HDKey change = root.PrivateCKDPath("m/44'/0'/0'/0");
+        for (uint32_t k = 0; k < 10; k++) {
+            EXPECT_EQ(xpub_of(children[k]), xpub_of(change.PublicCKD(5 + k)));
+        }
+        EXPECT_TRUE(xpub_account.PublicCKDRange("m/1/*", 0, 3, children));
+        EXPECT_EQ(xpub_of(children[2]), xpub_of(xpub_account.PublicCKDPath("m/1/2")));
+
+        // Hardened indexes are refused.
+        EXPECT_FALSE(account.PublicCKDRange(0x7ffffffe, 3, children));
+        EXPECT_FALSE(account.PublicCKDRange(0x80000000, 1, children));
+        EXPECT_FALSE(xpub_account.PublicCKDRange("m/0'/*", 0, 3, children));
+        EXPECT_FALSE(root.PublicCKDRange("m/44'/0'/0'/0", 0, 3, children));
+        EXPECT_FALSE(root.PublicCKDRange("m/44'/0'/0'/*'", 0, 3, children));
+        EXPECT_TRUE(account.PublicCKDRange(0, 0, children));
+        EXPECT_TRUE(children.empty());
+    }
+}
+
+TEST(bip32, PublicCKDRange_ManyChildren) {
+    const uint32_t count = 200;
+    HDKey root = root_from_seed(CurveType::SECP256K1);
+    HDKey change = root.PrivateCKDPath("m/44'/0'/0'/0");
+    HDKey xpub_change;
+    EXPECT_TRUE(xpub_change.FromExtendedPublicKey(xpub_of(change), CurveType::SECP256K1));
+
+    ThreadPoolExecutor pool;
+    std::vector<HDKey> children;
+    EXPECT_TRUE(xpub_change.PublicCKDRange(0, count, children, &pool));
+    ASSERT_EQ(children.size(), count);
+    for (uint32_t i = 0; i < count; i++) {
+        EXPECT_EQ(xpub_of(children[i]), xpub_of(xpub_change.PublicCKD(i)));
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    google::protobuf::ShutdownProtobufLibrary();
+    return ret;
+}
@@ -0,0 +1,128 @@
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bip39/bip39.h"
+#include "crypto-suites/crypto-hash/hmac_sha512.h"
+#include "crypto-suites/crypto-hash/pbkdf2_hmac_sha512.h"
+#include "crypto-suites/crypto-encode/hex.h"
+#include "crypto-suites/common/executor.h"
+
+using safeheron::bip39::Language;
+using safeheron::encode::hex::EncodeToHex;
+
+static std::vector<std::vector<std::string>> seed_vec = {
+        {
+                "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about",
+                "TREZOR",
+                "c55257c360c07c72029aebc1b53c05ed0362ada38ead3e3e9efa3708e53495531f09a6987599d18264c1e1c92f2cf141630c7a3c4ab7c81b2f001698e7463b04",
+        },
+        {
+                "legal winner thank year wave sausage worth useful legal winner thank yellow",
+                "TREZOR",
+                "2e8905819b8723fe2c1d161860e5ee1830318dbf49a83bd451cfb8440c28bd6fa457fe1296106559a3c80937a1c1069be3a3a5bd381ee6260e8d9739fce1f607",
+        },
+        {
+                "abandon math mimic master filter design carbon crystal rookie group knife wrap absurd much snack melt grid rough chapter fever rubber humble room trophy",
+                "",
+                "559da5e7655dd1fbe657c100870512afb2b654b0acfd32f2c549344407e555bc16c2e71219eefc24acc7ed2cfaeac8a1808d543a5de4890bb2d95a7bb58af5b7",
+        },
+};
+
+// PBKDF2 keying a new HMAC at every iteration.
+static void naive_pbkdf2_hmac_sha512(const std::string &password, const std::string &salt, uint32_t iterations,
+                                     unsigned char out[64]) {
+    unsigned char u[64];
+    std::string first = salt + std::string("\x00\x00\x00\x01", 4);
+    safeheron::hash::CHMAC_SHA512((const unsigned char *) password.c_str(), password.length())
+            .Write((const unsigned char *) first.c_str(), first.length()).Finalize(u);
+    memcpy(out, u, 64);
+    for (uint32_t i = 1; i < iterations; i++) {
+        safeheron::hash::CHMAC_SHA512((const unsigned char *) password.c_str(), password.length())
+                .Write(u, 64).Finalize(u);
+        for (int k = 0; k < 64; k++) out[k] ^= u[k];
+    }
+}
+
+TEST(bip39, PBKDF2_HMAC_SHA512) {
+    // RFC 8018 has no SHA-512 vectors, these are checked against other implementations.
+    unsigned char out[80];
+    const std::string password = "password";
+    const std::string salt = "salt";
+    safeheron::hash::PBKDF2_HMAC_SHA512((const unsigned char *) password.c_str(), password.length(),
+                                        (const unsigned char *) salt.c_str(), salt.length(), 1, out, 64);
+    EXPECT_EQ(EncodeToHex(out, 64), "867f70cf1ade02cff3752599a3a53dc4af34c7a669815ae5d513554e1c8cf252c02d470a285a0501bad999bfe943c08f050235d7d68b1da55e63f73b60a57fce");
+    safeheron::hash::PBKDF2_HMAC_SHA512((const unsigned char *) password.c_str(), password.length(),
+                                        (const unsigned char *) salt.c_str(), salt.length(), 2, out, 64);
+    EXPECT_EQ(EncodeToHex(out, 64), "e1d9c16aa681708a45f5c7c4e215ceb66e011a2e9f0040713f18aefdb866d53cf76cab2868a39b9f7840edce4fef5a82be67335c77a6068e04112754f27ccf4e");
+
+    // Output longer than one block, and a key longer than the block size of SHA-512.
+    const std::string long_password(200, 'k');
+    safeheron::hash::PBKDF2_HMAC_SHA512((const unsigned char *) long_password.c_str(), long_password.length(),
+                                        (const unsigned char *) salt.c_str(), salt.length(), 10, out, sizeof(out));
+    EXPECT_EQ(EncodeToHex(out, sizeof(out)), "a1d7f0838cd79b674489f08f5c06b56aa66bfd490c5e389b7d93fd1ddfe869bbf742d63d285b8a80bd819ab0c5b219de97065355d2197a8b7addf1e9bae86ef989f7c78c84c6b073bc2a28a976fef2f5");
+}
+
+TEST(bip39, MnemonicToSeed) {
+    std::string seed;
+    for (const auto &item : seed_vec) {
+        EXPECT_TRUE(safeheron::bip39::MnemonicToSeed(seed, item[0], item[1], Language::ENGLISH));
+        EXPECT_EQ(EncodeToHex(seed), item[2]);
+    }
+
+    // Extra spaces are ignored.
+    EXPECT_TRUE(safeheron::bip39::MnemonicToSeed(seed, "  legal winner thank year wave sausage worth useful legal  winner thank yellow ", "TREZOR", Language::ENGLISH));
+    EXPECT_EQ(EncodeToHex(seed), seed_vec[1][2]);
+
+    EXPECT_TRUE(safeheron::bip39::MnemonicToSeed(seed, "的 雄 粗 尺 载 属 海 酸 柯 沙 赶 祸 人 桥 滩 典 欢 悲 转 找 票 促 页 亭", "passphrase", Language::SIMPLIFIED_CHINESE));
+    EXPECT_EQ(EncodeToHex(seed), "3482f72f0889f12daf77d1fe8dbafb4c943811b6ef3100818fa92891f92cff1057d0b023a7dc2820e6091f0ef149e7ffbe4dff0d9af836e8f932a6cf85a8e83a");
+
+    // Bad checksum, unknown word
+    EXPECT_FALSE(safeheron::bip39::MnemonicToSeed(seed, "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon", "", Language::ENGLISH));
+    EXPECT_FALSE(safeheron::bip39::MnemonicToSeed(seed, "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandonn", "", Language::ENGLISH));
+}
+
+TEST(bip39, MnemonicToSeedMany) {
+    std::vector<std::string> mnemonics;
+    std::vector<std::string> passphrases;
+    for (const auto &item : seed_vec) {
+        mnemonics.push_back(item[0]);
+        passphrases.push_back(item[1]);
+    }
+    mnemonics.push_back("zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo");
+    passphrases.push_back("");
+
+    safeheron::concurrency::ThreadPoolExecutor pool(3);
+    safeheron::concurrency::Executor *executors[] = {nullptr, &pool};
+    for (auto *executor : executors) {
+        std::vector<std::string> seeds;
+        EXPECT_FALSE(safeheron::bip39::MnemonicToSeedMany(seeds, mnemonics, passphrases, Language::ENGLISH, executor));
+        ASSERT_EQ(seeds.size(), mnemonics.size());
+        for (size_t i = 0; i < seed_vec.size(); i++) {
+            EXPECT_EQ(EncodeToHex(seeds[i]), seed_vec[i][2]);
+        }
+        EXPECT_TRUE(seeds.back().empty());
+
+        mnemonics.pop_back();
+        std::vector<std::string> shared(1, "TREZOR");
+        EXPECT_TRUE(safeheron::bip39::MnemonicToSeedMany(seeds, mnemonics, shared, Language::ENGLISH, executor));
+        EXPECT_EQ(EncodeToHex(seeds[1]), seed_vec[1][2]);
+        mnemonics.push_back("zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo zoo");
+    }
+    std::vector<std::string> seeds;
+    EXPECT_FALSE(safeheron::bip39::MnemonicToSeedMany(seeds, mnemonics, std::vector<std::string>(2), Language::ENGLISH));
+}
+
+TEST(bip39, MnemonicToSeed_NaivePBKDF2) {
+    // The seed matches a PBKDF2 which keys a new HMAC at every iteration.
+    unsigned char naive_seed[64];
+    std::string seed;
+    naive_pbkdf2_hmac_sha512(seed_vec[0][0], "mnemonic" + seed_vec[0][1], 2048, naive_seed);
+    EXPECT_TRUE(safeheron::bip39::MnemonicToSeed(seed, seed_vec[0][0], seed_vec[0][1], Language::ENGLISH));
+    EXPECT_EQ(EncodeToHex(naive_seed, 64), seed_vec[0][2]);
+    EXPECT_EQ(EncodeToHex(seed), EncodeToHex(naive_seed, 64));
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -143,6 +143,27 @@ TEST(BN, Modular) {
     EXPECT_EQ(bn3, 7);
 }
 
+TEST(BN, FusedModular) {
+    BN m = safeheron::rand::RandomBNStrict(1024);
+    for (int i = 0; i < 50; ++i) {
+        BN a = safeheron::rand::RandomBN(1024);
+        BN b = safeheron::rand::RandomBN(1100);
+        if (i % 3 == 0) a = a.Neg();
+        EXPECT_EQ(a.AddMod(b, m), (a + b) % m);
+        EXPECT_EQ(a.SubMod(b, m), (a - b) % m);
+        EXPECT_EQ(a.MulMod(b, m), (a * b) % m);
+        EXPECT_TRUE(a.SubMod(b, m) >= 0 && a.SubMod(b, m) < m);
+
+        BN c = a;
+        c *= b;
+        c %= m;
+        EXPECT_EQ(c, a.MulMod(b, m));
+    }
+    BN d(-7);
+    d %= BN(5);
+    EXPECT_EQ(d, 3);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
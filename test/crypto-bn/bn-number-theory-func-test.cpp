@@ -247,6 +247,82 @@ TEST(BN, ModPow2)
     EXPECT_TRUE(b3.PowM(b3, b7) == 6);
 }
 
+TEST(BN, MultiPowM)
+{
+    // Small values: 3^2 * 5^(-1) * 2^0 mod 7 = 2 * 3 = 6
+    EXPECT_TRUE(BN::MultiPowM({BN(3), BN(5), BN(2)}, {BN(2), BN(-1), BN(0)}, BN(7)) == 6);
+    EXPECT_TRUE(BN::MultiPowM({}, {}, BN(7)) == 1);
+    EXPECT_TRUE(BN::MultiPowM({BN(3)}, {BN(5)}, BN(1)) == 0);
+    // Even modulus: 3^3 * 5^2 mod 16 = 11 * 9 mod 16 = 3
+    EXPECT_TRUE(BN::MultiPowM({BN(3), BN(5)}, {BN(3), BN(2)}, BN(16)) == 3);
+    EXPECT_THROW(BN::MultiPowM({BN(3), BN(5)}, {BN(3)}, BN(7)), LocatedException);
+
+    // Same result as the product of PowM, with exponents of very different sizes, negative exponents and bases
+    // larger than the modulus.
+    for (int i = 0; i < 20; ++i) {
+        BN m = safeheron::rand::RandomBN(2048);
+        m.SetBit(0);
+        std::vector<BN> bases;
+        std::vector<BN> exponents;
+        BN expected(1);
+        const int exp_bits[] = {1, 7, 30, 256, 768, 2048, 2816};
+        for (int bits : exp_bits) {
+            BN b = safeheron::rand::RandomBNLtCoPrime(m) + (i % 2 ? m : BN(0));
+            BN e = safeheron::rand::RandomBN(bits);
+            if ((bits + i) % 3 == 0) e = e.Neg();
+            bases.push_back(b);
+            exponents.push_back(e);
+            expected = (expected * b.PowM(e, m)) % m;
+        }
+        EXPECT_TRUE(BN::MultiPowM(bases, exponents, m) == expected);
+    }
+}
+
+TEST(BN, MultiPowM_Performance)
+{
+    // s^z1 * t^z3 * S^(-e) mod N_tilde, as in the verifiers of the Paillier range proofs.
+    BN m = safeheron::rand::RandomBN(2048);
+    m.SetBit(0);
+    m.SetBit(2047);
+    std::vector<BN> bases = {safeheron::rand::RandomBNLtCoPrime(m), safeheron::rand::RandomBNLtCoPrime(m),
+                             safeheron::rand::RandomBNLtCoPrime(m)};
+    std::vector<BN> exponents = {safeheron::rand::RandomBN(768), safeheron::rand::RandomBN(2816),
+                                 safeheron::rand::RandomBN(256).Neg()};
+    const int rounds = 10;
+    BN r1, r2;
+
+    clock_t start = clock();
+    for (int j = 0; j < rounds; j++) {
+        r1 = ( bases[0].PowM(exponents[0], m) * bases[1].PowM(exponents[1], m) * bases[2].PowM(exponents[2], m) ) % m;
+    }
+    clock_t t_pow = clock() - start;
+    start = clock();
+    for (int j = 0; j < rounds; j++) {
+        r2 = BN::MultiPowM(bases, exponents, m);
+    }
+    clock_t t_multi = clock() - start;
+
+    EXPECT_TRUE(r1 == r2);
+    std::cout << "PowM x 3: " << double(t_pow) / CLOCKS_PER_SEC << "s, MultiPowM: "
+              << double(t_multi) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+TEST(BN, MontContext)
+{
+    BN m = safeheron::rand::RandomBNStrict(1024) * 2 + 1;
+    safeheron::bignum::MontContext mont(m);
+    EXPECT_EQ(mont.Modulus(), m);
+    for (int i = 0; i < 20; ++i) {
+        BN x = safeheron::rand::RandomBN(1100);
+        BN y = safeheron::rand::RandomBN(300);
+        EXPECT_EQ(mont.PowM(x, y), x.PowM(y, m));
+        x = safeheron::rand::RandomBNLtCoPrime(m);
+        EXPECT_EQ(mont.PowM(x, y.Neg()), x.PowM(y.Neg(), m));
+    }
+    EXPECT_EQ(mont.PowM(BN(5), BN::ZERO), BN::ONE);
+    EXPECT_THROW({ safeheron::bignum::MontContext even_mont{BN(10)}; }, LocatedException);
+}
+
 TEST(BN, ExtendedEuclidean)
 {
     // Given a, b, compute x, y, d, st. ax + by = d
@@ -2,7 +2,14 @@
 // Created by 何剑虹 on 2020/10/22.
 //
 #include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
 #include "gtest/gtest.h"
 #include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/exception/safeheron_exceptions.h"
@@ -228,6 +235,87 @@ TEST(Rand, RandomBNInRange)
     }
 }
 
+static std::string random_string(size_t size) {
+    std::string str(size, '\0');
+    safeheron::rand::RandomBytes((unsigned char *)&str[0], size);
+    return str;
+}
+
+TEST(Rand, ThreadGenerator)
+{
+    // Sizes around the keystream buffer, and more than the reseed interval in total
+    std::set<std::string> outputs;
+    for (size_t size : {1, 31, 32, 33, 64, 991, 992, 993, 1024, 3000, 100000, 1100000}) {
+        std::string str = random_string(size);
+        EXPECT_TRUE(outputs.insert(str).second);
+        if (size >= 1024) {
+            // Not stuck on a repeated block
+            EXPECT_NE(str.substr(0, 32), str.substr(size - 32, 32));
+        }
+    }
+
+    // Each thread has its own generator
+    std::vector<std::string> thread_outputs(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_outputs.size(); ++i) {
+        threads.emplace_back([&thread_outputs, i]() { thread_outputs[i] = random_string(64); });
+    }
+    for (auto &t : threads) t.join();
+    for (const auto &str : thread_outputs) {
+        EXPECT_TRUE(outputs.insert(str).second);
+    }
+
+    safeheron::rand::Reseed();
+    EXPECT_TRUE(outputs.insert(random_string(64)).second);
+}
+
+TEST(Rand, ForkedChildReseeds)
+{
+    // Leave buffered keystream behind in the parent
+    random_string(16);
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        std::string str = random_string(32);
+        ssize_t n = write(fds[1], str.c_str(), str.size());
+        _exit(n == 32 ? 0 : 1);
+    }
+    std::string parent = random_string(32);
+    char buf[32];
+    ASSERT_EQ(read(fds[0], buf, sizeof(buf)), (ssize_t)sizeof(buf));
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+    EXPECT_NE(parent, std::string(buf, sizeof(buf)));
+}
+
+TEST(Rand, RandomBNsLtCoPrime)
+{
+    // Small factors, a factor above the screened primes, and a Paillier-like modulus
+    BN p = safeheron::rand::RandomPrimeStrict(512);
+    BN q = safeheron::rand::RandomPrimeStrict(512);
+    std::vector<BN> moduli = {BN(2), BN(30), BN(2 * 3 * 5 * 7) * BN(257) * BN(263), BN(257 * 257), p * q, p * q * p * q};
+    for (const BN &max : moduli) {
+        for (size_t count : {0, 1, 7, 100}) {
+            std::vector<BN> ns = safeheron::rand::RandomBNsLtCoPrime(max, count);
+            ASSERT_EQ(ns.size(), count);
+            for (const BN &n : ns) {
+                EXPECT_TRUE(n > 0 && n < max);
+                EXPECT_EQ(n.Gcd(max), 1);
+            }
+        }
+    }
+
+    std::vector<BN> ns = safeheron::rand::RandomBNsLtCoPrime(p * q, 50, true);
+    ASSERT_EQ(ns.size(), 50);
+    for (const BN &n : ns) {
+        EXPECT_TRUE(n > 0 && n < p * q);
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
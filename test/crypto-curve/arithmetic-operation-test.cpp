@@ -1,4 +1,6 @@
 #include <cstring>
+#include <utility>
+#include <vector>
 #include <google/protobuf/stubs/common.h>
 #include "gtest/gtest.h"
 #include "crypto-suites/crypto-bn/rand.h"
@@ -388,6 +390,58 @@ TEST(CurvePoint, Neg)
     testNeg(CurveType::ED25519);
 }
 
+void testMoveAndInPlace(CurveType cType){
+    CurvePoint zero(cType); // Initialize as zero
+    const Curve *curv = safeheron::curve::GetCurveParam(cType);
+    BN a = safeheron::rand::RandomBNLt(curv->n);
+    BN b = safeheron::rand::RandomBNLt(curv->n);
+    CurvePoint p = curv->g * a;
+    CurvePoint q = curv->g * b;
+
+    // Operators on temporaries reuse the temporary, and must agree with the copying ones.
+    CurvePoint expected_sum = p + q;
+    EXPECT_TRUE(curv->g * a + q == expected_sum);
+    EXPECT_TRUE(curv->g * a + curv->g * b == expected_sum);
+    EXPECT_TRUE(curv->g * a - q == p - q);
+    EXPECT_TRUE((p + q) * b == p * b + q * b);
+    EXPECT_TRUE((p + q) * 10 == p * 10 + q * 10);
+    EXPECT_TRUE((p + q).Neg() == p.Neg() + q.Neg());
+    EXPECT_TRUE(CurvePoint(p).Neg() + p == zero);
+
+    // In-place subtraction, including "p -= p"
+    CurvePoint r = p;
+    r -= q;
+    EXPECT_TRUE(r == curv->g * ((a - b) % curv->n));
+    r += q;
+    EXPECT_TRUE(r == p);
+    r -= r;
+    EXPECT_TRUE(r == zero);
+    r = curv->g;
+    r *= a;
+    EXPECT_TRUE(r == p);
+
+    // Moved-from points are left empty and can be assigned again.
+    CurvePoint s(std::move(r));
+    EXPECT_TRUE(s == p);
+    EXPECT_EQ(r.GetCurveType(), CurveType::INVALID_CURVE);
+    r = std::move(s);
+    EXPECT_TRUE(r == p);
+    EXPECT_EQ(s.GetCurveType(), CurveType::INVALID_CURVE);
+    s = q;
+    EXPECT_TRUE(s == q);
+
+    std::vector<CurvePoint> points;
+    for (int i = 0; i < 20; ++i) points.push_back(curv->g * (i + 1));
+    for (int i = 0; i < 20; ++i) EXPECT_TRUE(points[i] == curv->g * (i + 1));
+}
+
+TEST(CurvePoint, MoveAndInPlace)
+{
+    testMoveAndInPlace(CurveType::SECP256K1);
+    testMoveAndInPlace(CurveType::P256);
+    testMoveAndInPlace(CurveType::ED25519);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -0,0 +1,112 @@
+#include <cstring>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/eddsa.h"
+
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+
+/**
+ * Public key and signature of "msg" computed by OpenSSL with the secret key "seed" (RFC 8032).
+ */
+static void openssl_sign(const uint8_t seed[32], const uint8_t *msg, size_t len, uint8_t pub[32], uint8_t sig[64]) {
+    EVP_PKEY *pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, seed, 32);
+    ASSERT_NE(pkey, nullptr);
+    size_t pub_len = 32;
+    EXPECT_EQ(EVP_PKEY_get_raw_public_key(pkey, pub, &pub_len), 1);
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    size_t sig_len = 64;
+    EXPECT_EQ(EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, pkey), 1);
+    EXPECT_EQ(EVP_DigestSign(ctx, sig, &sig_len, msg, len), 1);
+    EVP_MD_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+}
+
+static bool openssl_verify(const uint8_t pub[32], const uint8_t *msg, size_t len, const uint8_t sig[64]) {
+    EVP_PKEY *pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, pub, 32);
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+    bool ok = EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, pkey) == 1 &&
+              EVP_DigestVerify(ctx, sig, 64, msg, len) == 1;
+    EVP_MD_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    return ok;
+}
+
+TEST(curve, ed25519_sign_against_openssl)
+{
+    const Curve *curv = GetCurveParam(CurveType::ED25519);
+    for (int i = 0; i < 200; ++i) {
+        uint8_t seed[32], msg[100], pub[32], sig[64];
+        safeheron::rand::RandomBytes(seed, sizeof(seed));
+        size_t len = i % sizeof(msg);
+        safeheron::rand::RandomBytes(msg, len);
+        openssl_sign(seed, msg, len, pub, sig);
+
+        // The public key is G * clamp(SHA512(seed)[0..32]).
+        uint8_t h[64];
+        SHA512(seed, sizeof(seed), h);
+        h[0] &= 248;
+        h[31] &= 127;
+        h[31] |= 64;
+        uint8_t encoded[32];
+        (curv->g * BN::FromBytesLE(h, 32)).EncodeEdwardsPoint(encoded);
+        EXPECT_EQ(memcmp(encoded, pub, 32), 0);
+
+        CurvePoint pub_point;
+        ASSERT_TRUE(pub_point.DecodeEdwardsPoint(pub, CurveType::ED25519));
+        std::string signature = safeheron::curve::eddsa::Sign(CurveType::ED25519, BN::FromBytesLE(seed, 32), pub_point, msg, len);
+        EXPECT_EQ(signature, std::string((const char *)sig, sizeof(sig)));
+        EXPECT_TRUE(safeheron::curve::eddsa::Verify(CurveType::ED25519, pub_point, sig, msg, len));
+
+        sig[i % 64] ^= 0x10;
+        EXPECT_FALSE(safeheron::curve::eddsa::Verify(CurveType::ED25519, pub_point, sig, msg, len));
+    }
+}
+
+TEST(curve, ed25519_verify_against_openssl)
+{
+    const Curve *curv = GetCurveParam(CurveType::ED25519);
+    for (int i = 0; i < 100; ++i) {
+        BN priv = safeheron::rand::RandomBNLt(curv->n);
+        uint8_t msg[32], pub[32];
+        safeheron::rand::RandomBytes(msg, sizeof(msg));
+        (curv->g * priv).EncodeEdwardsPoint(pub);
+        std::string sig = safeheron::curve::eddsa::Sign(CurveType::ED25519, priv, msg, sizeof(msg));
+        EXPECT_TRUE(openssl_verify(pub, msg, sizeof(msg), (const uint8_t *)sig.c_str()));
+        EXPECT_TRUE(safeheron::curve::eddsa::Verify(CurveType::ED25519, curv->g * priv, (const uint8_t *)sig.c_str(), msg, sizeof(msg)));
+    }
+}
+
+TEST(curve, ed25519_arithmetic)
+{
+    const Curve *curv = GetCurveParam(CurveType::ED25519);
+    for (int i = 0; i < 100; ++i) {
+        BN a = safeheron::rand::RandomBNLt(curv->n);
+        BN b = safeheron::rand::RandomBNLt(curv->n);
+        CurvePoint p = curv->g * a;
+        // (a * b) * G = b * (a * G), a * G + b * G = (a + b) * G, a * G - b * G = (a - b) * G
+        EXPECT_EQ(p * b, curv->g * ((a * b) % curv->n));
+        EXPECT_EQ(p + curv->g * b, curv->g * ((a + b) % curv->n));
+        EXPECT_EQ(p - curv->g * b, curv->g * ((a - b) % curv->n));
+        EXPECT_EQ(p.Neg() + p, CurvePoint(CurveType::ED25519));
+
+        uint8_t encoded[32];
+        p.EncodeEdwardsPoint(encoded);
+        CurvePoint q;
+        ASSERT_TRUE(q.DecodeEdwardsPoint(encoded, CurveType::ED25519));
+        EXPECT_EQ(p, q);
+    }
+    EXPECT_EQ(curv->g * (curv->n - 1), curv->g.Neg());
+    EXPECT_TRUE((curv->g * curv->n).IsInfinity());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}
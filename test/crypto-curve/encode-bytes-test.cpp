@@ -1,4 +1,6 @@
 #include <cstring>
+#include <thread>
+#include <vector>
 #include <google/protobuf/stubs/common.h>
 #include "gtest/gtest.h"
 #include "crypto-suites/crypto-bn/rand.h"
@@ -530,6 +532,88 @@ TEST(CurvePoint, EncodeBytes_1)
     testEncodeEdwards_OldVersion(CurveType::ED25519);
 }
 
+static std::string encode_full(const CurvePoint &point) {
+    std::string bytes;
+    point.EncodeFull(bytes);
+    return bytes;
+}
+
+static void testAffineCache(CurveType cType) {
+    const Curve *curv = safeheron::curve::GetCurveParam(cType);
+    BN a = safeheron::rand::RandomBNLt(curv->n);
+    BN b = safeheron::rand::RandomBNLt(curv->n);
+
+    // Every mutation after the cache is filled must show up in x(), y() and the encodings.
+    CurvePoint p = curv->g * a;
+    std::string pub_a = encode_full(p);
+    EXPECT_EQ(p.x(), BN::FromBytesBE((const uint8_t *)pub_a.c_str() + 1, 32));
+    EXPECT_EQ(p.y(), BN::FromBytesBE((const uint8_t *)pub_a.c_str() + 33, 32));
+    p += curv->g * b;
+    EXPECT_EQ(encode_full(p), encode_full(curv->g * ((a + b) % curv->n)));
+    p.x();
+    p -= curv->g * b;
+    EXPECT_EQ(encode_full(p), pub_a);
+    p *= b;
+    EXPECT_EQ(encode_full(p), encode_full(curv->g * ((a * b) % curv->n)));
+    p = std::move(p).Neg();
+    EXPECT_EQ(encode_full(p), encode_full((curv->g * ((a * b) % curv->n)).Neg()));
+    uint8_t pub33[33];
+    p.EncodeCompressed(pub33);
+    CurvePoint q;
+    ASSERT_TRUE(q.DecodeCompressed(pub33, cType));
+    EXPECT_EQ(q, p);
+    p = curv->g * a;
+    EXPECT_EQ(encode_full(p), pub_a);
+    p -= p;
+    EXPECT_TRUE(p.IsInfinity());
+    EXPECT_EQ(encode_full(p), std::string(1, '\0'));
+
+    // Copies and moves carry the cache along
+    CurvePoint r = curv->g * b;
+    r.x();
+    CurvePoint r_copy(r);
+    CurvePoint r_moved(std::move(r_copy));
+    EXPECT_EQ(r_moved, curv->g * b);
+    EXPECT_EQ(encode_full(r_moved), encode_full(curv->g * b));
+
+    // A batch of points normalized at once
+    std::vector<CurvePoint> points;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 20; ++i) {
+        BN k = safeheron::rand::RandomBNLt(curv->n);
+        points.push_back(curv->g * k + curv->g);
+        expected.push_back(encode_full(curv->g * ((k + 1) % curv->n)));
+    }
+    points.push_back(CurvePoint(cType));
+    expected.push_back(std::string(1, '\0'));
+    CurvePoint::NormalizeBatch(points);
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_EQ(encode_full(points[i]), expected[i]);
+    }
+
+    // Concurrent readers of a shared point
+    const CurvePoint shared = curv->g * a + curv->g * b;
+    std::vector<std::string> results(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&shared, &results, i] { results[i] = encode_full(shared); });
+    }
+    for (std::thread &t : threads) t.join();
+    for (const std::string &res : results) {
+        EXPECT_EQ(res, encode_full(curv->g * ((a + b) % curv->n)));
+    }
+}
+
+TEST(CurvePoint, AffineCache)
+{
+    testAffineCache(CurveType::SECP256K1);
+    testAffineCache(CurveType::P256);
+#if ENABLE_STARK
+    testAffineCache(CurveType::STARK);
+#endif // ENABLE_STARK
+    testAffineCache(CurveType::ED25519);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -0,0 +1,86 @@
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-curve/fixed_base_table.h"
+#include "crypto-suites/exception/located_exception.h"
+
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+using safeheron::curve::FixedBaseTable;
+using safeheron::curve::FixedBaseMul;
+
+static void testFixedBaseTable(CurveType c_type) {
+    const Curve *curv = GetCurveParam(c_type);
+    CurvePoint P = curv->g * safeheron::rand::RandomBNLt(curv->n);
+
+    vector<BN> scalars = {BN::ZERO, BN::ONE, BN(2), BN(15), BN(16), BN(255), curv->n - 1, curv->n, curv->n + 1,
+                          BN(-1), BN(-7), curv->n * 3, BN::ONE << 256, (BN::ONE << 255) - 1};
+    for (int i = 0; i < 20; ++i) scalars.push_back(safeheron::rand::RandomBNLt(curv->n));
+
+    for (int w : {1, 3, 4, 5, 8}) {
+        FixedBaseTable table(P, w);
+        EXPECT_EQ(table.Base(), P);
+        for (const BN &k : scalars) {
+            EXPECT_EQ(table.Mul(k), P * k);
+            EXPECT_EQ(FixedBaseMul(P, &table, k), P * k);
+        }
+    }
+
+    // The generator and the point at infinity
+    FixedBaseTable g_table(curv->g);
+    CurvePoint inf(c_type);
+    FixedBaseTable inf_table(inf);
+    for (const BN &k : scalars) {
+        EXPECT_EQ(g_table.Mul(k), curv->g * k);
+        EXPECT_TRUE(inf_table.Mul(k).IsInfinity());
+        EXPECT_EQ(FixedBaseMul(P, nullptr, k), P * k);
+    }
+
+    // A table belongs to its own base
+    FixedBaseTable table(P);
+    EXPECT_THROW(FixedBaseMul(P + curv->g, &table, BN::ONE), safeheron::exception::LocatedException);
+    EXPECT_THROW(FixedBaseTable table0(P, 0), safeheron::exception::LocatedException);
+    EXPECT_THROW(FixedBaseTable table9(P, 9), safeheron::exception::LocatedException);
+    CurvePoint invalid;
+    EXPECT_THROW(FixedBaseTable table2(invalid), safeheron::exception::LocatedException);
+
+    // Shared by several threads
+    vector<BN> ks;
+    vector<CurvePoint> expected;
+    for (int i = 0; i < 40; ++i) {
+        ks.push_back(safeheron::rand::RandomBNLt(curv->n));
+        expected.push_back(P * ks.back());
+    }
+    vector<int> ok(4, 0);
+    vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            bool all = true;
+            for (size_t i = 0; i < ks.size(); ++i) all = all && (table.Mul(ks[i]) == expected[i]);
+            ok[t] = all ? 1 : 0;
+        });
+    }
+    for (std::thread &th : threads) th.join();
+    EXPECT_EQ(ok, vector<int>(4, 1));
+}
+
+TEST(FixedBaseTable, Mul)
+{
+    testFixedBaseTable(CurveType::SECP256K1);
+    testFixedBaseTable(CurveType::P256);
+    testFixedBaseTable(CurveType::ED25519);
+#if ENABLE_STARK
+    testFixedBaseTable(CurveType::STARK);
+#endif //ENABLE_STARK
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}
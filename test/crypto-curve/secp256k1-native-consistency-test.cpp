@@ -0,0 +1,117 @@
+#include <cstring>
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::CurveType;
+
+/**
+ * k * point computed by OpenSSL, encoded in 65 bytes, or empty for the point at infinity.
+ */
+static std::string openssl_mul(const CurvePoint &point, const BN &k) {
+    EC_GROUP *grp = EC_GROUP_new_by_curve_name(NID_secp256k1);
+    EC_POINT *p = EC_POINT_new(grp);
+    BIGNUM *x = BN_new();
+    BIGNUM *y = BN_new();
+    BIGNUM *bn = BN_new();
+    std::string x_bytes, y_bytes, k_bytes;
+    point.x().ToBytes32BE(x_bytes);
+    point.y().ToBytes32BE(y_bytes);
+    BN k_mod = k % GetCurveParam(CurveType::SECP256K1)->n;
+    k_mod.ToBytesBE(k_bytes);
+    BN_bin2bn((const uint8_t *)x_bytes.c_str(), 32, x);
+    BN_bin2bn((const uint8_t *)y_bytes.c_str(), 32, y);
+    BN_bin2bn((const uint8_t *)k_bytes.c_str(), (int)k_bytes.length(), bn);
+    EXPECT_EQ(EC_POINT_set_affine_coordinates(grp, p, x, y, nullptr), 1);
+    EXPECT_EQ(EC_POINT_mul(grp, p, nullptr, p, bn, nullptr), 1);
+
+    std::string res;
+    if (!EC_POINT_is_at_infinity(grp, p)) {
+        uint8_t buf[65];
+        EXPECT_EQ(EC_POINT_point2oct(grp, p, POINT_CONVERSION_UNCOMPRESSED, buf, sizeof(buf), nullptr), sizeof(buf));
+        res.assign((const char *)buf, sizeof(buf));
+    }
+    BN_free(bn);
+    BN_free(y);
+    BN_free(x);
+    EC_POINT_free(p);
+    EC_GROUP_free(grp);
+    return res;
+}
+
+static std::string encode(const CurvePoint &point) {
+    if (point.IsInfinity()) return std::string();
+    uint8_t buf[65];
+    point.EncodeFull(buf);
+    return std::string((const char *)buf, sizeof(buf));
+}
+
+static void check_mul(const CurvePoint &point, const BN &k) {
+    std::string expected = openssl_mul(point, k);
+    EXPECT_EQ(encode(point * k), expected);
+    CurvePoint p = point;
+    p *= k;
+    EXPECT_EQ(encode(p), expected);
+}
+
+TEST(curve, secp256k1_native_random)
+{
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    for (int i = 0; i < 200; ++i) {
+        CurvePoint point = curv->g * safeheron::rand::RandomBNLt(curv->n);
+        check_mul(point, safeheron::rand::RandomBNLt(curv->n));
+        check_mul(curv->g, safeheron::rand::RandomBNLt(curv->n));
+        // Scalars of 128 bits, and scalars close to the order
+        check_mul(point, safeheron::rand::RandomBN(128));
+        check_mul(point, curv->n - safeheron::rand::RandomBN(128));
+    }
+}
+
+TEST(curve, secp256k1_native_edge_scalars)
+{
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    const BN lambda = BN::FromHexStr("5363AD4CC05C30E0A5261C028812645A122E22EA20816678DF02967C1B23BD72");
+    std::vector<BN> scalars = {
+            BN::ZERO, BN::ONE, BN::TWO, BN::THREE, BN(16), BN(17),
+            curv->n - 1, curv->n - 2, curv->n, curv->n + 1, curv->n * 2 + 5, BN(-1), BN(-7),
+            (curv->n - 1) / 2, (curv->n + 1) / 2,
+            BN::ONE << 128, (BN::ONE << 128) - 1, BN::ONE << 255, (BN::ONE << 256) - 1,
+            lambda, curv->n - lambda, lambda * lambda, lambda + 1, curv->n - lambda - 1,
+    };
+    CurvePoint point = curv->g * safeheron::rand::RandomBNLt(curv->n);
+    for (const BN &k : scalars) {
+        check_mul(curv->g, k);
+        check_mul(point, k);
+        check_mul(point.Neg(), k);
+    }
+
+    CurvePoint inf(CurveType::SECP256K1);
+    EXPECT_TRUE((inf * BN(5)).IsInfinity());
+    EXPECT_TRUE((point * curv->n).IsInfinity());
+}
+
+TEST(curve, secp256k1_native_arithmetic)
+{
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    for (int i = 0; i < 50; ++i) {
+        BN a = safeheron::rand::RandomBNLt(curv->n);
+        BN b = safeheron::rand::RandomBNLt(curv->n);
+        CurvePoint p = curv->g * a;
+        // (a * b) * G = b * (a * G), a * G + b * G = (a + b) * G
+        EXPECT_EQ(p * b, curv->g * ((a * b) % curv->n));
+        EXPECT_EQ(p + curv->g * b, curv->g * ((a + b) % curv->n));
+        EXPECT_EQ(p * b - p * b, CurvePoint(CurveType::SECP256K1));
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}
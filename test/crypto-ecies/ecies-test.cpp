@@ -8,6 +8,7 @@
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/crypto-encode/hex.h"
+#include "crypto-suites/common/executor.h"
 
 using namespace safeheron::bignum;
 using namespace safeheron::curve;
@@ -104,6 +105,70 @@ TEST(Curve_ENC, ECIES)
     }
 }
 
+TEST(Curve_ENC, ECIES_ReuseInstance)
+{
+    // One instance keeps its KDF/cipher/HMAC contexts across many messages.
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN priv = RandomBNLt(curv->n);
+    CurvePoint pub = curv->g * priv;
+    ECIES enc;
+    enc.set_curve_type(CurveType::SECP256K1);
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < message_arr.size(); i++) {
+            std::string cypher;
+            std::string plain;
+            EXPECT_TRUE(enc.EncryptPack(pub, message_arr[i], cypher));
+            EXPECT_TRUE(enc.DecryptPack(priv, cypher, plain));
+            EXPECT_EQ(plain, message_arr[i]);
+        }
+    }
+}
+
+TEST(Curve_ENC, ECIES_EncryptPackMany)
+{
+    const size_t recipients = 32;
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    std::vector<BN> privs;
+    std::vector<CurvePoint> pubs;
+    std::vector<std::string> plains;
+    for (size_t i = 0; i < recipients; i++) {
+        privs.push_back(RandomBNLt(curv->n));
+        pubs.push_back(curv->g * privs.back());
+        plains.push_back(message_arr[i % message_arr.size()]);
+    }
+
+    ECIES enc;
+    enc.set_curve_type(CurveType::SECP256K1);
+    safeheron::concurrency::SequentialExecutor sequential;
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    safeheron::concurrency::Executor *executors[] = {nullptr, &sequential, &pool};
+    for (safeheron::concurrency::Executor *executor : executors) {
+        std::vector<std::string> cyphers;
+        EXPECT_TRUE(enc.EncryptPackMany(pubs, plains, cyphers, executor));
+        ASSERT_EQ(cyphers.size(), recipients);
+        for (size_t i = 0; i < recipients; i++) {
+            std::string plain;
+            EXPECT_TRUE(enc.DecryptPack(privs[i], cyphers[i], plain));
+            EXPECT_EQ(plain, plains[i]);
+        }
+
+        // One plain text for all the recipients, each cypher has its own ephemeral key.
+        EXPECT_TRUE(enc.EncryptPackMany(pubs, {message_arr[2]}, cyphers, executor));
+        for (size_t i = 0; i < recipients; i++) {
+            std::string plain;
+            EXPECT_TRUE(enc.DecryptPack(privs[i], cyphers[i], plain));
+            EXPECT_EQ(plain, message_arr[2]);
+            if (i > 0) {
+                EXPECT_NE(cyphers[i].substr(0, 65), cyphers[i - 1].substr(0, 65));
+            }
+        }
+    }
+
+    std::vector<std::string> cyphers;
+    EXPECT_FALSE(enc.EncryptPackMany(pubs, {message_arr[0], message_arr[1]}, cyphers));
+    EXPECT_FALSE(enc.EncryptPackMany({}, plains, cyphers));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
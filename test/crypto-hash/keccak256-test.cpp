@@ -4,6 +4,8 @@
 
 #include "gtest/gtest.h"
 #include "crypto-suites/crypto-hash/keccak256.h"
+#include "crypto-suites/crypto-hash/sha3_imp.h"
+#include "crypto-suites/crypto-bn/rand.h"
 #include "crypto-suites/crypto-encode/hex.h"
 #include "util-test.h"
 
@@ -97,6 +99,43 @@ TEST(hash, keccak256){
     }
 }
 
+TEST(hash, sha3_256){
+    // The permutation is shared with SHA3-256, which differs by its padding.
+    uint8_t hash[32];
+    sha3_256((const uint8_t *)"", 0, hash);
+    EXPECT_EQ(safeheron::encode::hex::EncodeToHex(hash, 32), "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a");
+    sha3_256((const uint8_t *)"abc", 3, hash);
+    EXPECT_EQ(safeheron::encode::hex::EncodeToHex(hash, 32), "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+}
+
+TEST(hash, keccak256_many){
+    // Runs of four messages of the same length, lengths around the block size of 136 bytes, and single messages.
+    std::vector<std::string> inputs;
+    for (size_t len : {0, 1, 64, 135, 136, 137, 272, 300}) {
+        for (int i = 0; i < 4; ++i) {
+            std::string msg(len, '\0');
+            if (len) safeheron::rand::RandomBytes((uint8_t *)&msg[0], len);
+            inputs.push_back(msg);
+        }
+        inputs.push_back(std::string(len + 1, 'a'));
+    }
+    for (auto &it: digest_message_arr) {
+        inputs.emplace_back(it.data);
+    }
+
+    std::vector<std::string> expected;
+    for (const auto &input: inputs) {
+        uint8_t hash[32];
+        safeheron::hash::CKeccak256().Write((const uint8_t *)input.data(), input.size()).Finalize(hash);
+        expected.emplace_back((const char *)hash, 32);
+    }
+
+    EXPECT_EQ(safeheron::hash::Keccak256Many(inputs), expected);
+    safeheron::concurrency::ThreadPoolExecutor pool(3);
+    EXPECT_EQ(safeheron::hash::Keccak256Many(inputs, &pool), expected);
+    EXPECT_TRUE(safeheron::hash::Keccak256Many({}).empty());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
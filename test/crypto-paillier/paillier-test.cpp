@@ -3,6 +3,7 @@
 #include "crypto-suites/crypto-bn/bn.h"
 #include "crypto-suites/exception/located_exception.h"
 #include "crypto-suites/crypto-paillier/pail.h"
+#include "crypto-suites/common/executor.h"
 #include "CTimer.h"
 using namespace std;
 using namespace safeheron::bignum;
@@ -585,6 +586,109 @@ TEST(PaillierTest, Key_2048_Decrypt10_Slow) {
     }
 }
 
+TEST(PaillierTest, Key_2048_Decrypt_Parallel) {
+    PailPrivKey priv = safeheron::pail::CreatePailPrivKey(
+            priv2048["lambda"],
+            priv2048["mu"],
+            priv2048["n"],
+            priv2048["nSqr"],
+            priv2048["p"],
+            priv2048["q"],
+            priv2048["pSqr"],
+            priv2048["qSqr"],
+            priv2048["pMinus1"],
+            priv2048["qMinus1"],
+            priv2048["hp"],
+            priv2048["hq"],
+            priv2048["qInvP"],
+            priv2048["pInvQ"]);
+    PailPubKey pub = safeheron::pail::CreatePailPubKey(
+            pub2048["n"],
+            pub2048["g"]);
+    safeheron::concurrency::ThreadPoolExecutor pool(2);
+    for(int i = 0; i < 10; i++){
+        BN m = BN::FromHexStr(mrc2048[i][0]);
+        BN c = BN::FromHexStr(mrc2048[i][2]);
+        EXPECT_EQ(priv.Decrypt(c, &pool), m);
+        // A copy shares the Montgomery contexts set up by the first decryption
+        PailPrivKey copy = priv;
+        EXPECT_EQ(copy.Decrypt(c, &pool), m);
+    }
+    for(int i = 0; i < 10; i++){
+        BN m = safeheron::rand::RandomNegBNInSymInterval(priv.n() >> 1);
+        BN c = pub.EncryptNeg(m);
+        EXPECT_EQ(priv.DecryptNeg(c, &pool), m);
+        EXPECT_EQ(priv.DecryptNeg(c), m);
+    }
+
+    BN c = BN::FromHexStr(mrc2048[0][2]);
+    CTimer timer_seq("Decrypt(CRT) * 20");
+    for(int i = 0; i < 20; i++) priv.Decrypt(c);
+    timer_seq.End();
+    CTimer timer_par("Decrypt(CRT, 2 threads) * 20");
+    for(int i = 0; i < 20; i++) priv.Decrypt(c, &pool);
+    timer_par.End();
+}
+
+TEST(PaillierTest, Key_2048_PowM_CRT) {
+    PailPrivKey priv = safeheron::pail::CreatePailPrivKey(
+            priv2048["lambda"],
+            priv2048["mu"],
+            priv2048["n"],
+            priv2048["nSqr"],
+            priv2048["p"],
+            priv2048["q"],
+            priv2048["pSqr"],
+            priv2048["qSqr"],
+            priv2048["pMinus1"],
+            priv2048["qMinus1"],
+            priv2048["hp"],
+            priv2048["hq"],
+            priv2048["qInvP"],
+            priv2048["pInvQ"]);
+    PailPrivKey slow_priv = safeheron::pail::CreatePailPrivKey(
+            priv2048["lambda"],
+            priv2048["mu"],
+            priv2048["n"]);
+    PailPubKey pub = safeheron::pail::CreatePailPubKey(
+            pub2048["n"],
+            pub2048["g"]);
+    const BN &n = priv.n();
+    const BN &n_sqr = priv.n_sqr();
+
+    for(int i = 0; i < 10; i++){
+        BN x = safeheron::rand::RandomBNLt(n_sqr);
+        BN y = safeheron::rand::RandomBN(256 + i * 256);
+        if(i % 2) y = y.Neg();
+        EXPECT_EQ(priv.PowMModN(x, y), x.PowM(y, n));
+        EXPECT_EQ(priv.PowMModNSqr(x, y), x.PowM(y, n_sqr));
+        EXPECT_EQ(slow_priv.PowMModNSqr(x, y), x.PowM(y, n_sqr));
+    }
+
+    // Bases which are not units
+    BN x = priv.p() * 3;
+    EXPECT_EQ(priv.PowMModN(x, n), x.PowM(n, n));
+    EXPECT_EQ(priv.PowMModNSqr(x, n), x.PowM(n, n_sqr));
+    EXPECT_EQ(priv.PowMModNSqr(BN::ZERO, n), BN::ZERO);
+
+    for(int i = 0; i < 10; i++){
+        BN m = BN::FromHexStr(mrc2048[i][0]);
+        BN r = BN::FromHexStr(mrc2048[i][1]);
+        BN c = BN::FromHexStr(mrc2048[i][2]);
+        EXPECT_EQ(priv.EncryptWithR(m, r), c);
+        EXPECT_EQ(slow_priv.EncryptWithR(m, r), c);
+    }
+
+    BN r = safeheron::rand::RandomBNLtCoPrime(n);
+    BN m = safeheron::rand::RandomBNLt(n);
+    CTimer timer_pub("EncryptWithR(pub) * 20");
+    for(int i = 0; i < 20; i++) pub.EncryptWithR(m, r);
+    timer_pub.End();
+    CTimer timer_priv("EncryptWithR(priv, CRT) * 20");
+    for(int i = 0; i < 20; i++) priv.EncryptWithR(m, r);
+    timer_priv.End();
+}
+
 TEST(PaillierTest, KeyTransform) {
     std::string s;
     PailPrivKey priv = safeheron::pail::CreatePailPrivKey(
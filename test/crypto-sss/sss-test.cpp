@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <vector>
 #include <google/protobuf/stubs/common.h>
@@ -6,6 +7,7 @@
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/crypto-curve/curve.h"
 #include "crypto-suites/crypto-sss/vsss_secp256k1.h"
+#include "crypto-suites/crypto-sss/vsss_ed25519.h"
 
 using safeheron::bignum::BN;
 using namespace safeheron::rand;
@@ -182,6 +184,102 @@ TEST(Secret_Sharing_Scheme, Example5)
     EXPECT_TRUE(secret == recovered_secret);
 }
 
+TEST(Secret_Sharing_Scheme, VerifySharesBatch)
+{
+    for (CurveType c_type : {CurveType::SECP256K1, CurveType::ED25519}) {
+        const Curve * curv = GetCurveParam(c_type);
+        BN secret = RandomBNLt(curv->n);
+        int threshold = 4;
+        vector<CurvePoint> cmts;
+        vector<Point> shares;
+        if (c_type == CurveType::SECP256K1) {
+            vsss_secp256k1::MakeSharesWithCommits(shares, cmts, secret, threshold, 13);
+        } else {
+            vsss_ed25519::MakeSharesWithCommits(shares, cmts, secret, threshold, 13);
+        }
+        auto verify_batch = [&](const vector<Point> &batch, vector<size_t> &invalid) {
+            return c_type == CurveType::SECP256K1 ? vsss_secp256k1::VerifySharesBatch(cmts, threshold, batch, invalid)
+                                                  : vsss_ed25519::VerifySharesBatch(cmts, threshold, batch, invalid);
+        };
+
+        vector<size_t> invalid;
+        EXPECT_TRUE(verify_batch(shares, invalid));
+        EXPECT_TRUE(invalid.empty());
+        EXPECT_TRUE(verify_batch(vector<Point>(), invalid));
+        EXPECT_FALSE(vsss_secp256k1::VerifySharesBatch(cmts, threshold + 1, shares, invalid));
+        EXPECT_EQ(invalid.size(), shares.size());
+
+        // Corrupt some shares, one of them by its index only
+        vector<Point> bad_shares = shares;
+        bad_shares[0].y = (bad_shares[0].y + 1) % curv->n;
+        bad_shares[5].y = (bad_shares[5].y + 1) % curv->n;
+        bad_shares[6].x = bad_shares[6].x + 1;
+        bad_shares[12].y = RandomBNLt(curv->n);
+        EXPECT_FALSE(verify_batch(bad_shares, invalid));
+        EXPECT_EQ(invalid, vector<size_t>({0, 5, 6, 12}));
+        for (size_t j = 0; j < bad_shares.size(); ++j) {
+            bool expected = std::find(invalid.begin(), invalid.end(), j) == invalid.end();
+            EXPECT_EQ(vsss::VerifyShare(cmts, threshold, bad_shares[j].x, bad_shares[j].y, curv->g, curv->n), expected);
+        }
+
+        vector<Point> one_bad(1, bad_shares[5]);
+        EXPECT_FALSE(verify_batch(one_bad, invalid));
+        EXPECT_EQ(invalid, vector<size_t>({0}));
+    }
+}
+
+TEST(Secret_Sharing_Scheme, PolynomialEvaluation)
+{
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    for (int threshold : {1, 2, 5, 17}) {
+        vector<BN> coes;
+        for (int i = 0; i < threshold; ++i) coes.push_back(RandomBNLt(curv->n));
+        Polynomial poly(coes, curv->n);
+
+        // Progressions (stepped by differences) and arbitrary indexes (Horner), both against the textbook evaluation.
+        vector<vector<BN>> indexArrays(4);
+        for (int i = 1; i <= 200; ++i) indexArrays[0].push_back(BN(i));
+        for (int i = 0; i < 150; ++i) indexArrays[1].push_back(BN(7) + BN(i) * BN(-3));
+        for (int i = 0; i < 150; ++i) indexArrays[2].push_back(RandomBNLt(curv->n));
+        indexArrays[3].push_back(BN(5));
+        for (const vector<BN> &xArr : indexArrays) {
+            vector<BN> expected;
+            for (const BN &x : xArr) {
+                BN r(0);
+                for (int i = threshold - 1; i >= 0; --i) r = (coes[i] + x * r) % curv->n;
+                expected.push_back(r);
+            }
+            vector<BN> yArr;
+            poly.GetYArray(yArr, xArr);
+            EXPECT_EQ(yArr, expected);
+            poly.GetYArray(yArr, xArr, &pool);
+            EXPECT_EQ(yArr, expected);
+        }
+
+        vector<CurvePoint> commits, parallel_commits;
+        poly.GetCommits(commits, curv->g);
+        poly.GetCommits(parallel_commits, curv->g, &pool);
+        EXPECT_EQ(commits, parallel_commits);
+        for (int i = 0; i < threshold; ++i) EXPECT_EQ(commits[i], curv->g * coes[i]);
+
+        // Another base point
+        CurvePoint H = curv->g * RandomBNLt(curv->n);
+        vector<CurvePoint> h_commits;
+        poly.GetCommits(h_commits, H, &pool);
+        for (int i = 0; i < threshold; ++i) EXPECT_EQ(h_commits[i], H * coes[i]);
+    }
+
+    BN secret = RandomBNLt(curv->n);
+    vector<Point> shares;
+    vector<CurvePoint> cmts;
+    vsss_secp256k1::MakeSharesWithCommits(shares, cmts, secret, 3, 64, &pool);
+    EXPECT_TRUE(vsss_secp256k1::VerifySharesBatch(cmts, 3, shares));
+    BN recovered_secret;
+    vsss_secp256k1::RecoverSecret(recovered_secret, vector<Point>(shares.begin() + 30, shares.begin() + 33));
+    EXPECT_TRUE(secret == recovered_secret);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
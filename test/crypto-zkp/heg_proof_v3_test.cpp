@@ -79,6 +79,48 @@ TEST(ZKP, HegProof_V3)
     EXPECT_TRUE((proof.Alpha_ == proof2.Alpha_) && proof2.Verify(statement));
 }
 
+TEST(ZKP, HegProof_V3_WithTables)
+{
+    for (CurveType c_type : {CurveType::SECP256K1, CurveType::ED25519}) {
+        const Curve * curv = GetCurveParam(c_type);
+        BN sigma = RandomBNLt(curv->n);
+        BN l = RandomBNLt(curv->n);
+        heg::HEGWitness_V3 witness(sigma, l);
+        CurvePoint H = curv->g * RandomBNLt(curv->n);
+        CurvePoint R = curv->g * RandomBNLt(curv->n);
+        CurvePoint T = curv->g * sigma + H * l;
+        CurvePoint S = R * sigma;
+        heg::HEGStatement_V3 statement(T, curv->g, H, S, R, curv->n);
+
+        // Tables built once for the session
+        safeheron::curve::FixedBaseTable G_table(curv->g), H_table(H), R_table(R);
+        heg::HEGStatement_V3 statement_with_tables = statement;
+        statement_with_tables.G_table_ = &G_table;
+        statement_with_tables.H_table_ = &H_table;
+        statement_with_tables.R_table_ = &R_table;
+
+        // Same randomness, same proof
+        BN a = RandomBNLt(curv->n);
+        BN b = RandomBNLt(curv->n);
+        heg::HEGProof_V3 proof, proof_with_tables;
+        proof.ProveWithR(statement, witness, a, b);
+        proof_with_tables.ProveWithR(statement_with_tables, witness, a, b);
+        EXPECT_TRUE(proof.Alpha_ == proof_with_tables.Alpha_);
+        EXPECT_TRUE(proof.Beta_ == proof_with_tables.Beta_);
+        EXPECT_TRUE(proof.t_ == proof_with_tables.t_);
+        EXPECT_TRUE(proof.u_ == proof_with_tables.u_);
+        EXPECT_TRUE(proof.Verify(statement_with_tables));
+        EXPECT_TRUE(proof_with_tables.Verify(statement));
+
+        proof_with_tables.t_ = (proof_with_tables.t_ + 1) % curv->n;
+        EXPECT_FALSE(proof_with_tables.Verify(statement_with_tables));
+
+        // A table of another point is rejected
+        statement_with_tables.H_table_ = &R_table;
+        EXPECT_THROW(proof.Verify(statement_with_tables), safeheron::exception::LocatedException);
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
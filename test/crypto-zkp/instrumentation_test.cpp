@@ -0,0 +1,95 @@
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <google/protobuf/stubs/common.h>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-hash/sha256.h"
+#include "crypto-suites/crypto-zkp/zkp.h"
+#include "crypto-suites/common/instrumentation.h"
+
+using std::string;
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::curve::Curve;
+using safeheron::curve::CurveType;
+using safeheron::curve::GetCurveParam;
+using safeheron::hash::CSHA256;
+using safeheron::zkp::dlog::DLogProof;
+using namespace safeheron::instrumentation;
+using namespace safeheron::rand;
+
+TEST(Instrumentation, Counters)
+{
+    BN m = RandomPrimeStrict(1024);
+    BN x = RandomBNLtGcd(m);
+    ResetThreadCounters();
+    x.PowM(BN(65537), m);
+    BN::MultiPowM({x, x + 1, x + 2}, {BN(3), BN(5), BN(7)}, m);
+    x.InvM(m);
+    EXPECT_EQ(ThreadCounters().powm.at(1024), 4u);
+    EXPECT_EQ(ThreadCounters().PowMTotal(), 4u);
+    EXPECT_EQ(ThreadCounters().invm, 1u);
+
+    ResetThreadCounters();
+    unsigned char buf[100];
+    RandomBytes(buf, sizeof(buf));
+    unsigned char digest[CSHA256::OUTPUT_SIZE];
+    CSHA256().Write(buf, sizeof(buf)).Finalize(digest);
+    EXPECT_EQ(ThreadCounters().random_bytes, 100u);
+    EXPECT_EQ(ThreadCounters().hash_bytes, 100u);
+
+    ResetThreadCounters();
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    curv->g * RandomBNLt(curv->n);
+    EXPECT_EQ(ThreadCounters().curve_mul.at(static_cast<uint32_t>(CurveType::SECP256K1)), 1u);
+
+    // Another thread has its own counters.
+    std::thread([] { BN(2).PowM(BN(3), BN(101)); }).join();
+    EXPECT_EQ(ThreadCounters().PowMTotal(), 0u);
+}
+
+TEST(Instrumentation, ChromeTrace)
+{
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    BN sk = RandomBNLt(curv->n);
+
+    vector<TraceEvent> events;
+    std::ostringstream out;
+    {
+        ChromeTraceWriter writer(out);
+        SetTraceSink([&](const TraceEvent &event) {
+            events.push_back(event);
+            writer.Write(event);
+        });
+        DLogProof proof(CurveType::SECP256K1);
+        proof.Prove(sk);
+        EXPECT_TRUE(proof.Verify());
+        SetTraceSink(nullptr);
+        // Without a sink no event is reported.
+        proof.Prove(sk);
+    }
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_STREQ(events[0].name, "DLogProof::Prove");
+    EXPECT_EQ(events[0].curve_mul, 2u);
+    EXPECT_GT(events[0].hash_bytes, 0u);
+    EXPECT_STREQ(events[1].name, "DLogProof::Verify");
+    EXPECT_EQ(events[1].curve_mul, 2u);
+    EXPECT_EQ(events[1].random_bytes, 0u);
+    EXPECT_GE(events[1].start_ns, events[0].start_ns + events[0].duration_ns);
+
+    string json = out.str();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"name\":\"DLogProof::Prove\",\"cat\":\"safeheron\",\"ph\":\"X\""), string::npos);
+    EXPECT_NE(json.find("\"name\":\"DLogProof::Verify\""), string::npos);
+    EXPECT_NE(json.find("\"curve_mul\":2"), string::npos);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    google::protobuf::ShutdownProtobufLibrary();
+    return ret;
+}
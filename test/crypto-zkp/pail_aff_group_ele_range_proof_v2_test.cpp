@@ -8,6 +8,7 @@
 #include "crypto-suites/crypto-paillier/pail.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
+#include "crypto-suites/common/executor.h"
 #include "CTimer.h"
 
 using std::string;
@@ -91,6 +92,98 @@ TEST(ZKP, Pail_ENC_Range_Proof_2)
     ASSERT_TRUE(range_proof2.FromBase64(base64));
     range_proof2.SetSalt("Salt");
     ASSERT_TRUE(range_proof2.Verify(setup, statement));
+
+    // The exponentiations are spread over a thread pool, sequential and parallel proofs verify either way.
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    ASSERT_TRUE(range_proof.Verify(setup, statement, &pool));
+    safeheron::zkp::pail::PailAffGroupEleRangeProof_V2 range_proof3;
+    range_proof3.SetSalt("Salt");
+    range_proof3.Prove(setup, statement, witness, &pool);
+    ASSERT_TRUE(range_proof3.Verify(setup, statement, &pool));
+    ASSERT_TRUE(range_proof3.Verify(setup, statement));
+    range_proof3.SetSalt("Other salt");
+    ASSERT_FALSE(range_proof3.Verify(setup, statement, &pool));
+}
+
+TEST(ZKP, Pail_ENC_Range_Proof_2_BatchVerify)
+{
+    std::string n_tilde_hex = "C11A2F1A0EA592008BAFCAE756038DE028BA195E73B60F773F7399B4B94E26F8F90C488DEEA7ADB6910BCBCA8BA558E527B67B0B098420D4282411863B3FF39049C420CEB61D4C3683D2264957E583066F9C08C71E7A2A9E8E628E7853C962C4240E2E6FDB1F0F547A33EF0C31BD2B9739E0191AAF948AADE86519CD01A7B944A37C7150DF78A6E6FF4E5B8598F06334374BA068316C73484A07C2A0DF96DFE25931D0C67CE3A8B0E14635F0B34C1937F376EAB077281553F9F81E563DE7111136D95C8A5F9B87D91681AB412A8B62409CD2A2C3386E9B3E2FA3A7B7BE75368415315C1F905B7F38F4ED6758AD88563C41F28B717C7C13573062E6A6D4AA2A8D";
+    BN N_tilde = BN::FromHexStr(n_tilde_hex);
+    BN h1 = RandomBNLtGcd(N_tilde);
+    h1 = ( h1 * h1 ) % N_tilde;
+    BN h2 = RandomBNLtGcd(N_tilde);
+    h2 = ( h2 * h2 ) % N_tilde;
+
+    std::string n0_hex = "a346603c869f5b159fde34715551985ab2fbb2254bf828801b750e422f22d652403e9258aeb65b983070e32dc1b439a91c6593ec8c93896dbf421b5d7d86f7e620bef3010560d29f377257afc2e1d6d396197f2ae80f70fd6741bc2282db8dc38947785e31e23ba0706340ee38f995241e222e92db89c47b0889b44797aae93ebba20d55770b1418b5815595db9c07a7682ab9a0125e54357ab76919eb7ce2818d702729fc28f130b4eb28de0dd5bd4c8d7030945856335a1bf9d3d29d923bde4692b6481ef549bd22b5c2010aecd98efb1fbe895ce4d5212728c9815ce4eae36c4b514b53b01657f29d2010e750526ef9bba5c7d011a6ed82e87fa166794611";
+    std::string g0_hex = "a346603c869f5b159fde34715551985ab2fbb2254bf828801b750e422f22d652403e9258aeb65b983070e32dc1b439a91c6593ec8c93896dbf421b5d7d86f7e620bef3010560d29f377257afc2e1d6d396197f2ae80f70fd6741bc2282db8dc38947785e31e23ba0706340ee38f995241e222e92db89c47b0889b44797aae93ebba20d55770b1418b5815595db9c07a7682ab9a0125e54357ab76919eb7ce2818d702729fc28f130b4eb28de0dd5bd4c8d7030945856335a1bf9d3d29d923bde4692b6481ef549bd22b5c2010aecd98efb1fbe895ce4d5212728c9815ce4eae36c4b514b53b01657f29d2010e750526ef9bba5c7d011a6ed82e87fa166794612";
+    PailPubKey pail_pub_0 = CreatePailPubKey(n0_hex, g0_hex);
+    const BN &N0 = pail_pub_0.n();
+    const BN &N0Sqr = pail_pub_0.n_sqr();
+
+    std::string n1_hex = "D798499AE710CAE21A6390BDC93B4E1137125A8A2E4F8C5CEE94CF30773DB4305A8A2B399C94E0861954C6CFB192F0FA0F869A700C4E47966A5EF28777BE7AAC5F338A2A4B56495B695EA019D56766B47A895642A907A12888A7011BECED6BC316B872970078A98FCC7C70B82270216AA6EC4847FBBD708693BACED47E08E95C62F30440E4D07166951B52D2FDE642D016C3EEFE202BC162D7B15B511FEBCA6758F19667E114C85E4408D25BB34E78A2E835129D0CC15B50BDCE290FF6D601E3300B490262896B19D973C82AFCE7B0D457BE9FEDE4A23E0165311B7B8D62A3C7AF277E14AFA1ACA9F0CAA7FE46B274BF76ED02E0761DEA58ED8C532900BF6355";
+    std::string g1_hex = "D798499AE710CAE21A6390BDC93B4E1137125A8A2E4F8C5CEE94CF30773DB4305A8A2B399C94E0861954C6CFB192F0FA0F869A700C4E47966A5EF28777BE7AAC5F338A2A4B56495B695EA019D56766B47A895642A907A12888A7011BECED6BC316B872970078A98FCC7C70B82270216AA6EC4847FBBD708693BACED47E08E95C62F30440E4D07166951B52D2FDE642D016C3EEFE202BC162D7B15B511FEBCA6758F19667E114C85E4408D25BB34E78A2E835129D0CC15B50BDCE290FF6D601E3300B490262896B19D973C82AFCE7B0D457BE9FEDE4A23E0165311B7B8D62A3C7AF277E14AFA1ACA9F0CAA7FE46B274BF76ED02E0761DEA58ED8C532900BF6356";
+    PailPubKey pail_pub_1 = CreatePailPubKey(n1_hex, g1_hex);
+    const BN &N1 = pail_pub_1.n();
+    const BN &N1Sqr = pail_pub_1.n_sqr();
+
+    const uint32_t l = 256;
+    const uint32_t l_prime = 1280;
+    const uint32_t varepsilon = 512;
+
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    BN q = curv->n;
+
+    safeheron::zkp::pail::PailAffGroupEleRangeSetUp_V2 setup(N_tilde, h1, h2);
+
+    // One proof per other party of a 6-party ceremony.
+    const size_t n = 5;
+    std::vector<safeheron::zkp::pail::PailAffGroupEleRangeStatement_V2> statements;
+    std::vector<safeheron::zkp::pail::PailAffGroupEleRangeProof_V2> proofs;
+    for (size_t i = 0; i < n; ++i) {
+        BN x0 = RandomBNLt(q);
+        BN r0 = RandomBNLtCoPrime(N0);
+        BN x = RandomNegBNInSymInterval(BN::ONE << l);
+        BN y = RandomNegBNInSymInterval(BN::ONE << l_prime);
+        BN rho = RandomBNLtCoPrime(N0);
+        BN rho_y = RandomBNLtCoPrime(N1);
+        BN C = pail_pub_0.EncryptNegWithR(x0, r0);
+        BN Y = pail_pub_1.EncryptNegWithR(y, rho_y);
+        BN D = ( C.PowM(x, N0Sqr) * pail_pub_0.EncryptNegWithR(y, rho) ) % N0Sqr;
+        safeheron::curve::CurvePoint X = curv->g * x;
+
+        statements.emplace_back(N0, N0Sqr, N1, N1Sqr, C, D, Y, X, q, l, l_prime, varepsilon);
+        safeheron::zkp::pail::PailAffGroupEleRangeWitness_V2 witness(x, y, rho, rho_y);
+        proofs.emplace_back();
+        proofs.back().Prove(setup, statements.back(), witness);
+    }
+
+    CTimer timer_single("Verify * 5");
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_TRUE(proofs[i].Verify(setup, statements[i]));
+    }
+    timer_single.End();
+
+    std::vector<bool> results;
+    CTimer timer_batch("BatchVerify(5)");
+    ASSERT_TRUE(safeheron::zkp::pail::PailAffGroupEleRangeProof_V2::BatchVerify(setup, statements, proofs, results));
+    timer_batch.End();
+    ASSERT_EQ(results, std::vector<bool>(n, true));
+
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    ASSERT_TRUE(safeheron::zkp::pail::PailAffGroupEleRangeProof_V2::BatchVerify(setup, statements, proofs, &pool));
+
+    // z3 only appears in an equation mod N_tilde, the batch fails and the invalid proof is found.
+    proofs[2].z3_ = proofs[2].z3_ + 1;
+    ASSERT_FALSE(safeheron::zkp::pail::PailAffGroupEleRangeProof_V2::BatchVerify(setup, statements, proofs, results, &pool));
+    ASSERT_EQ(results, std::vector<bool>({true, true, false, true, true}));
+
+    // A proof of another statement
+    proofs[2] = proofs[3];
+    ASSERT_FALSE(safeheron::zkp::pail::PailAffGroupEleRangeProof_V2::BatchVerify(setup, statements, proofs, results));
+    ASSERT_EQ(results, std::vector<bool>({true, true, false, true, true}));
+
+    statements.pop_back();
+    ASSERT_FALSE(safeheron::zkp::pail::PailAffGroupEleRangeProof_V2::BatchVerify(setup, statements, proofs, results));
 }
 
 int main(int argc, char **argv) {
@@ -69,6 +69,44 @@ TEST(ZKP, Pail_ENC_pail_dec_modulo_proof_3)
     ASSERT_TRUE(proof2.Verify(setup, statement));
 }
 
+TEST(ZKP, Pail_ENC_pail_dec_modulo_proof_3_CRT)
+{
+    PailPrivKey pail_priv;
+    PailPubKey pail_pub;
+    safeheron::pail::CreateKeyPair2048(pail_priv, pail_pub);
+    std::string n_tilde_hex = "C11A2F1A0EA592008BAFCAE756038DE028BA195E73B60F773F7399B4B94E26F8F90C488DEEA7ADB6910BCBCA8BA558E527B67B0B098420D4282411863B3FF39049C420CEB61D4C3683D2264957E583066F9C08C71E7A2A9E8E628E7853C962C4240E2E6FDB1F0F547A33EF0C31BD2B9739E0191AAF948AADE86519CD01A7B944A37C7150DF78A6E6FF4E5B8598F06334374BA068316C73484A07C2A0DF96DFE25931D0C67CE3A8B0E14635F0B34C1937F376EAB077281553F9F81E563DE7111136D95C8A5F9B87D91681AB412A8B62409CD2A2C3386E9B3E2FA3A7B7BE75368415315C1F905B7F38F4ED6758AD88563C41F28B717C7C13573062E6A6D4AA2A8D";
+    BN N_tilde = BN::FromHexStr(n_tilde_hex);
+
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    const BN &q = curv->n;
+    BN y = RandomBNLtCoPrime(pail_pub.n());
+    BN x = y % curv->n;
+    BN rho = RandomBNLtGcd(pail_pub.n());
+    BN C = pail_pub.EncryptWithR(y, rho);
+
+    BN h1 = RandomBNLtGcd(N_tilde);
+    h1 = ( h1 * h1 ) % N_tilde;
+
+    BN h2 = RandomBNLtGcd(N_tilde);
+    h2 = ( h2 * h2 ) % N_tilde;
+
+    safeheron::zkp::pail::PailDecModuloSetUp setup(N_tilde, h1, h2);
+    safeheron::zkp::pail::PailDecModuloStatement statement(q, pail_pub.n(), pail_pub.n_sqr(), C, x, 256, 512);
+    safeheron::zkp::pail::PailDecModuloWitness witness(y, rho);
+
+    CTimer timer("time_cost_of_proof(CRT)");
+    safeheron::zkp::pail::PailDecModuloProof proof;
+    proof.Prove(setup, statement, witness, pail_priv);
+    timer.End();
+    ASSERT_TRUE(proof.Verify(setup, statement));
+
+    std::string base64;
+    proof.ToBase64(base64);
+    safeheron::zkp::pail::PailDecModuloProof proof2;
+    ASSERT_TRUE(proof2.FromBase64(base64));
+    ASSERT_TRUE(proof2.Verify(setup, statement));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -66,6 +66,44 @@ TEST(ZKP, Pail_ENC_Range_Proof_2)
     ASSERT_TRUE(range_proof2.Verify(setup, statement));
 }
 
+TEST(ZKP, Pail_ENC_Range_Proof_2_CRT)
+{
+    PailPrivKey pail_priv;
+    PailPubKey pail_pub;
+    safeheron::pail::CreateKeyPair2048(pail_priv, pail_pub);
+    std::string n_tilde_hex = "C11A2F1A0EA592008BAFCAE756038DE028BA195E73B60F773F7399B4B94E26F8F90C488DEEA7ADB6910BCBCA8BA558E527B67B0B098420D4282411863B3FF39049C420CEB61D4C3683D2264957E583066F9C08C71E7A2A9E8E628E7853C962C4240E2E6FDB1F0F547A33EF0C31BD2B9739E0191AAF948AADE86519CD01A7B944A37C7150DF78A6E6FF4E5B8598F06334374BA068316C73484A07C2A0DF96DFE25931D0C67CE3A8B0E14635F0B34C1937F376EAB077281553F9F81E563DE7111136D95C8A5F9B87D91681AB412A8B62409CD2A2C3386E9B3E2FA3A7B7BE75368415315C1F905B7F38F4ED6758AD88563C41F28B717C7C13573062E6A6D4AA2A8D";
+    BN N_tilde = BN::FromHexStr(n_tilde_hex);
+
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    BN x = RandomBNLt(curv->n);
+    BN r = RandomBNLtGcd(pail_pub.n());
+    BN c = pail_pub.EncryptWithR(x, r);
+
+    BN h1 = RandomBNLtGcd(N_tilde);
+    h1 = ( h1 * h1 ) % N_tilde;
+
+    BN h2 = RandomBNLtGcd(N_tilde);
+    h2 = ( h2 * h2 ) % N_tilde;
+
+    safeheron::zkp::pail::PailEncRangeSetUp_V1 setup(N_tilde, h1, h2);
+    safeheron::zkp::pail::PailEncRangeStatement_V1 statement(c, pail_pub.n(), pail_pub.n_sqr(), curv->n);
+    safeheron::zkp::pail::PailEncRangeWitness_V1 witness(x, r);
+
+    CTimer timer("time_cost_of_proof(CRT)");
+    safeheron::zkp::pail::PailEncRangeProof_V1 range_proof;
+    range_proof.SetSalt("Salt");
+    range_proof.Prove(setup, statement, witness, pail_priv);
+    timer.End();
+    ASSERT_TRUE(range_proof.Verify(setup, statement));
+
+    std::string base64;
+    range_proof.ToBase64(base64);
+    safeheron::zkp::pail::PailEncRangeProof_V1 range_proof2;
+    ASSERT_TRUE(range_proof2.FromBase64(base64));
+    range_proof2.SetSalt("Salt");
+    ASSERT_TRUE(range_proof2.Verify(setup, statement));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
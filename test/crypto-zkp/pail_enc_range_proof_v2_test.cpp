@@ -69,6 +69,94 @@ TEST(ZKP, Pail_ENC_Range_Proof_3)
     ASSERT_TRUE(range_proof2.Verify(setup, statement));
 }
 
+TEST(ZKP, Pail_ENC_Range_Proof_3_CRT)
+{
+    PailPrivKey pail_priv;
+    PailPubKey pail_pub;
+    safeheron::pail::CreateKeyPair2048(pail_priv, pail_pub);
+    std::string n_tilde_hex = "C11A2F1A0EA592008BAFCAE756038DE028BA195E73B60F773F7399B4B94E26F8F90C488DEEA7ADB6910BCBCA8BA558E527B67B0B098420D4282411863B3FF39049C420CEB61D4C3683D2264957E583066F9C08C71E7A2A9E8E628E7853C962C4240E2E6FDB1F0F547A33EF0C31BD2B9739E0191AAF948AADE86519CD01A7B944A37C7150DF78A6E6FF4E5B8598F06334374BA068316C73484A07C2A0DF96DFE25931D0C67CE3A8B0E14635F0B34C1937F376EAB077281553F9F81E563DE7111136D95C8A5F9B87D91681AB412A8B62409CD2A2C3386E9B3E2FA3A7B7BE75368415315C1F905B7F38F4ED6758AD88563C41F28B717C7C13573062E6A6D4AA2A8D";
+    BN N_tilde = BN::FromHexStr(n_tilde_hex);
+
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    BN x = RandomBNLt(curv->n);
+    BN r = RandomBNLtGcd(pail_pub.n());
+    BN c = pail_pub.EncryptWithR(x, r);
+
+    BN h1 = RandomBNLtGcd(N_tilde);
+    h1 = ( h1 * h1 ) % N_tilde;
+
+    BN h2 = RandomBNLtGcd(N_tilde);
+    h2 = ( h2 * h2 ) % N_tilde;
+
+    safeheron::zkp::pail::PailEncRangeSetUp_V2 setup(N_tilde, h1, h2);
+    safeheron::zkp::pail::PailEncRangeStatement_V2 statement(c, pail_pub.n(), pail_pub.n_sqr(), curv->n, 256, 512);
+    safeheron::zkp::pail::PailEncRangeWitness_V2 witness(x, r);
+
+    CTimer timer("time_cost_of_proof(CRT)");
+    safeheron::zkp::pail::PailEncRangeProof_V2 range_proof;
+    range_proof.SetSalt("Salt");
+    range_proof.Prove(setup, statement, witness, pail_priv);
+    timer.End();
+    ASSERT_TRUE(range_proof.Verify(setup, statement));
+
+    // A key of another modulus is ignored.
+    PailPrivKey other_priv;
+    PailPubKey other_pub;
+    safeheron::pail::CreateKeyPair2048(other_priv, other_pub);
+    safeheron::zkp::pail::PailEncRangeProof_V2 range_proof2;
+    range_proof2.SetSalt("Salt");
+    range_proof2.Prove(setup, statement, witness, other_priv);
+    ASSERT_TRUE(range_proof2.Verify(setup, statement));
+}
+
+TEST(ZKP, Pail_ENC_Range_Proof_3_BatchVerify)
+{
+    std::string n_hex = "a346603c869f5b159fde34715551985ab2fbb2254bf828801b750e422f22d652403e9258aeb65b983070e32dc1b439a91c6593ec8c93896dbf421b5d7d86f7e620bef3010560d29f377257afc2e1d6d396197f2ae80f70fd6741bc2282db8dc38947785e31e23ba0706340ee38f995241e222e92db89c47b0889b44797aae93ebba20d55770b1418b5815595db9c07a7682ab9a0125e54357ab76919eb7ce2818d702729fc28f130b4eb28de0dd5bd4c8d7030945856335a1bf9d3d29d923bde4692b6481ef549bd22b5c2010aecd98efb1fbe895ce4d5212728c9815ce4eae36c4b514b53b01657f29d2010e750526ef9bba5c7d011a6ed82e87fa166794611";
+    std::string g_hex = "a346603c869f5b159fde34715551985ab2fbb2254bf828801b750e422f22d652403e9258aeb65b983070e32dc1b439a91c6593ec8c93896dbf421b5d7d86f7e620bef3010560d29f377257afc2e1d6d396197f2ae80f70fd6741bc2282db8dc38947785e31e23ba0706340ee38f995241e222e92db89c47b0889b44797aae93ebba20d55770b1418b5815595db9c07a7682ab9a0125e54357ab76919eb7ce2818d702729fc28f130b4eb28de0dd5bd4c8d7030945856335a1bf9d3d29d923bde4692b6481ef549bd22b5c2010aecd98efb1fbe895ce4d5212728c9815ce4eae36c4b514b53b01657f29d2010e750526ef9bba5c7d011a6ed82e87fa166794612";
+    std::string n_tilde_hex = "C11A2F1A0EA592008BAFCAE756038DE028BA195E73B60F773F7399B4B94E26F8F90C488DEEA7ADB6910BCBCA8BA558E527B67B0B098420D4282411863B3FF39049C420CEB61D4C3683D2264957E583066F9C08C71E7A2A9E8E628E7853C962C4240E2E6FDB1F0F547A33EF0C31BD2B9739E0191AAF948AADE86519CD01A7B944A37C7150DF78A6E6FF4E5B8598F06334374BA068316C73484A07C2A0DF96DFE25931D0C67CE3A8B0E14635F0B34C1937F376EAB077281553F9F81E563DE7111136D95C8A5F9B87D91681AB412A8B62409CD2A2C3386E9B3E2FA3A7B7BE75368415315C1F905B7F38F4ED6758AD88563C41F28B717C7C13573062E6A6D4AA2A8D";
+    PailPubKey pail_pub = CreatePailPubKey(n_hex, g_hex);
+
+    BN N_tilde = BN::FromHexStr(n_tilde_hex);
+
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    BN h1 = RandomBNLtGcd(N_tilde);
+    h1 = ( h1 * h1 ) % N_tilde;
+    BN h2 = RandomBNLtGcd(N_tilde);
+    h2 = ( h2 * h2 ) % N_tilde;
+    safeheron::zkp::pail::PailEncRangeSetUp_V2 setup(N_tilde, h1, h2);
+
+    const size_t n = 8;
+    std::vector<safeheron::zkp::pail::PailEncRangeStatement_V2> statements;
+    std::vector<safeheron::zkp::pail::PailEncRangeProof_V2> proofs;
+    for (size_t i = 0; i < n; ++i) {
+        BN x = RandomBNLt(curv->n);
+        BN r = RandomBNLtGcd(pail_pub.n());
+        BN c = pail_pub.EncryptWithR(x, r);
+        statements.emplace_back(c, pail_pub.n(), pail_pub.n_sqr(), curv->n, 256, 512);
+        safeheron::zkp::pail::PailEncRangeWitness_V2 witness(x, r);
+        proofs.emplace_back();
+        proofs.back().Prove(setup, statements.back(), witness);
+    }
+
+    CTimer timer_single("Verify * 8");
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_TRUE(proofs[i].Verify(setup, statements[i]));
+    }
+    timer_single.End();
+
+    std::vector<bool> results;
+    CTimer timer_batch("BatchVerify(8)");
+    ASSERT_TRUE(safeheron::zkp::pail::PailEncRangeProof_V2::BatchVerify(setup, statements, proofs, results));
+    timer_batch.End();
+    ASSERT_EQ(results, std::vector<bool>(n, true));
+
+    proofs[5].z3_ = proofs[5].z3_ + 1;
+    ASSERT_FALSE(safeheron::zkp::pail::PailEncRangeProof_V2::BatchVerify(setup, statements, proofs, results));
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(results[i], i != 5);
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
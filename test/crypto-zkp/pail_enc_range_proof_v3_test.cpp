@@ -152,6 +152,39 @@ TEST(ZKP, PailEncRangeProof_V3Failed_Range_2l_)
     timer_verify.End();
 }
 
+TEST(ZKP, PailEncRangeProof_V3_CRT)
+{
+    const Curve * curv = GetCurveParam(CurveType::SECP256K1);
+    PailPrivKey pail_priv;
+    PailPubKey pail_pub;
+    safeheron::pail::CreateKeyPair2048(pail_priv, pail_pub);
+
+    BN l = curv->n / 3;
+    BN x = RandomBNLt(l);
+    BN r = RandomBNLtCoPrime(pail_pub.n());
+    pail::PailEncRangeWitness_V3 witness(x, r);
+    BN c = pail_pub.EncryptWithR(x, r);
+    pail::PailEncRangeStatement_V3 statement(c, pail_pub, l);
+
+    CTimer timer("Prove");
+    pail::PailEncRangeProof_V3 proof;
+    proof.Prove(statement, witness);
+    timer.End();
+    EXPECT_TRUE(proof.Verify(statement));
+
+    CTimer timer_crt("Prove(CRT)");
+    pail::PailEncRangeProof_V3 proof_crt;
+    proof_crt.Prove(statement, witness, pail_priv);
+    timer_crt.End();
+    EXPECT_TRUE(proof_crt.Verify(statement));
+
+    std::string base64;
+    pail::PailEncRangeProof_V3 proof2;
+    EXPECT_TRUE(proof_crt.ToBase64(base64));
+    EXPECT_TRUE(proof2.FromBase64(base64));
+    EXPECT_TRUE(proof2.Verify(statement));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int ret = RUN_ALL_TESTS();
@@ -8,6 +8,7 @@
 #include "crypto-suites/crypto-paillier/pail.h"
 #include "crypto-suites/crypto-encode/base64.h"
 #include "crypto-suites/exception/located_exception.h"
+#include "crypto-suites/common/executor.h"
 #include "CTimer.h"
 
 using std::string;
@@ -72,6 +73,17 @@ TEST(ZKP, Pail_ENC_Range_Proof_3)
     ASSERT_TRUE(range_proof2.FromBase64(base64));
     range_proof2.SetSalt("Salt");
     ASSERT_TRUE(range_proof2.Verify(setup, statement));
+
+    // The exponentiations are spread over a thread pool, sequential and parallel proofs verify either way.
+    safeheron::concurrency::ThreadPoolExecutor pool(4);
+    ASSERT_TRUE(range_proof.Verify(setup, statement, &pool));
+    safeheron::zkp::pail::PailMulGroupEleRangeProof range_proof3;
+    range_proof3.SetSalt("Salt");
+    range_proof3.Prove(setup, statement, witness, &pool);
+    ASSERT_TRUE(range_proof3.Verify(setup, statement, &pool));
+    ASSERT_TRUE(range_proof3.Verify(setup, statement));
+    range_proof3.SetSalt("Other salt");
+    ASSERT_FALSE(range_proof3.Verify(setup, statement, &pool));
 }
 
 int main(int argc, char **argv) {
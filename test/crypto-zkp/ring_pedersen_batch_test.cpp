@@ -0,0 +1,72 @@
+#include <vector>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-zkp/ring_pedersen_batch.h"
+
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::zkp::RingPedersenBatch;
+using namespace safeheron::rand;
+
+// The N_tilde of the proof tests
+static const char *N_TILDE_HEX = "C11A2F1A0EA592008BAFCAE756038DE028BA195E73B60F773F7399B4B94E26F8F90C488DEEA7ADB6910BCBCA8BA558E527B67B0B098420D4282411863B3FF39049C420CEB61D4C3683D2264957E583066F9C08C71E7A2A9E8E628E7853C962C4240E2E6FDB1F0F547A33EF0C31BD2B9739E0191AAF948AADE86519CD01A7B944A37C7150DF78A6E6FF4E5B8598F06334374BA068316C73484A07C2A0DF96DFE25931D0C67CE3A8B0E14635F0B34C1937F376EAB077281553F9F81E563DE7111136D95C8A5F9B87D91681AB412A8B62409CD2A2C3386E9B3E2FA3A7B7BE75368415315C1F905B7F38F4ED6758AD88563C41F28B717C7C13573062E6A6D4AA2A8D";
+
+struct Equation {
+    BN a, b, X, x, y;
+};
+
+// s^a * t^b * X^x = y  mod N_tilde
+static Equation RandomEquation(const BN &N_tilde, const BN &s, const BN &t) {
+    Equation eq;
+    eq.a = RandomBN(1024);
+    eq.b = RandomBN(2048);
+    eq.X = RandomBNLtGcd(N_tilde);
+    eq.x = RandomBN(256).Neg();
+    eq.y = BN::MultiPowM({s, t, eq.X}, {eq.a, eq.b, eq.x}, N_tilde);
+    return eq;
+}
+
+static bool Check(const BN &N_tilde, const BN &s, const BN &t, const vector<Equation> &equations) {
+    RingPedersenBatch batch(N_tilde, s, t);
+    for (const Equation &eq : equations) {
+        batch.Add(eq.a, eq.b, {eq.X}, {eq.x}, eq.y);
+    }
+    return batch.Check();
+}
+
+TEST(ZKP, RingPedersenBatch)
+{
+    BN N_tilde = BN::FromHexStr(N_TILDE_HEX);
+    BN s = RandomBNLtGcd(N_tilde);
+    s = ( s * s ) % N_tilde;
+    BN t = RandomBNLtGcd(N_tilde);
+    t = ( t * t ) % N_tilde;
+
+    vector<Equation> equations;
+    for (int i = 0; i < 8; ++i) {
+        equations.push_back(RandomEquation(N_tilde, s, t));
+    }
+    EXPECT_TRUE(Check(N_tilde, s, t, equations));
+
+    // Each try draws new weights, the result must not depend on them.
+    for (int i = 0; i < 32; ++i) {
+        vector<Equation> wrong = equations;
+        // A factor -1, as a prover sending -S with an odd challenge would get, is accepted every time.
+        wrong[3].y = N_tilde - wrong[3].y;
+        EXPECT_TRUE(Check(N_tilde, s, t, wrong));
+
+        // Any other factor is rejected.
+        wrong[5].y = ( wrong[5].y * 2 ) % N_tilde;
+        EXPECT_FALSE(Check(N_tilde, s, t, wrong));
+    }
+
+    // A right side which is not invertible
+    equations[0].y = equations[0].y * N_tilde;
+    EXPECT_FALSE(Check(N_tilde, s, t, equations));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}
@@ -0,0 +1,96 @@
+#include <cstring>
+#include "gtest/gtest.h"
+#include "crypto-suites/crypto-bn/rand.h"
+#include "crypto-suites/crypto-curve/curve.h"
+#include "crypto-suites/crypto-zkp/transcript.h"
+#include "crypto-suites/exception/located_exception.h"
+
+using std::string;
+using std::vector;
+using safeheron::bignum::BN;
+using safeheron::curve::CurvePoint;
+using safeheron::curve::Curve;
+using safeheron::curve::CurveType;
+using safeheron::curve::GetCurveParam;
+using safeheron::hash::CSafeHash256;
+using safeheron::hash::CSafeHash512;
+using safeheron::zkp::Transcript;
+using safeheron::zkp::Transcript512;
+
+// Elements hashed the way the proofs used to do it: serialize to a string first, then write it.
+template <class SafeHash>
+static string reference_digest(const string &salt, const vector<BN> &bns, const vector<const CurvePoint *> &points) {
+    SafeHash sha;
+    string str;
+    sha.Write((const uint8_t *)(salt.c_str()), salt.length());
+    for (const BN &bn : bns) {
+        bn.ToBytesBE(str);
+        sha.Write((const uint8_t *)(str.c_str()), str.length());
+    }
+    for (const CurvePoint *point : points) {
+        point->EncodeFull(str);
+        sha.Write((const uint8_t *)(str.c_str()), str.length());
+    }
+    uint8_t digest[SafeHash::OUTPUT_SIZE];
+    sha.Finalize(digest);
+    return string((const char *)digest, sizeof(digest));
+}
+
+template <class T>
+static string transcript_digest(const string &salt, const vector<BN> &bns, const vector<const CurvePoint *> &points) {
+    T transcript;
+    transcript.Append(salt);
+    for (const BN &bn : bns) transcript.Append(bn);
+    for (const CurvePoint *point : points) transcript.Append(*point);
+    uint8_t digest[T::OUTPUT_SIZE];
+    transcript.Finalize(digest);
+    return string((const char *)digest, sizeof(digest));
+}
+
+TEST(Transcript, SameDigestAsSafeHash)
+{
+    const CurveType types[] = {CurveType::SECP256K1, CurveType::P256, CurveType::ED25519};
+    vector<BN> bns = {BN::ZERO, BN::ONE, BN(-255), BN(256),
+                      safeheron::rand::RandomBN(255), safeheron::rand::RandomBN(4096),
+                      safeheron::rand::RandomBN(8192), safeheron::rand::RandomBN(8200)};
+    for (CurveType c_type : types) {
+        const Curve *curv = GetCurveParam(c_type);
+        vector<const CurvePoint *> points;
+        // The generator itself goes through the cached encoding, a copy of it does not.
+        CurvePoint g_copy = curv->g;
+        CurvePoint point = curv->g * safeheron::rand::RandomBNLt(curv->n);
+        CurvePoint inf(c_type);
+        points.push_back(&curv->g);
+        points.push_back(&g_copy);
+        points.push_back(&point);
+        points.push_back(&inf);
+
+        for (int i = 0; i < 4; ++i) {
+            string salt = i == 0 ? string() : string("salt") + std::to_string(i);
+            EXPECT_EQ((transcript_digest<Transcript>(salt, bns, points)), (reference_digest<CSafeHash256>(salt, bns, points)));
+            EXPECT_EQ((transcript_digest<Transcript512>(salt, bns, points)), (reference_digest<CSafeHash512>(salt, bns, points)));
+        }
+    }
+
+    Transcript transcript;
+    EXPECT_THROW(transcript.Append(CurvePoint()), safeheron::exception::LocatedException);
+}
+
+TEST(Transcript, Reset)
+{
+    const Curve *curv = GetCurveParam(CurveType::SECP256K1);
+    Transcript transcript;
+    uint8_t d0[Transcript::OUTPUT_SIZE], d1[Transcript::OUTPUT_SIZE];
+    transcript.Append(curv->n).Append(curv->g);
+    transcript.Finalize(d0);
+    transcript.Reset();
+    transcript.Append(curv->n).Append(curv->g);
+    transcript.Finalize(d1);
+    EXPECT_EQ(memcmp(d0, d1, sizeof(d0)), 0);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    return ret;
+}